@@ -0,0 +1,322 @@
+#include "BSPBooleanOperations.hpp"
+#include "BSPTree.hpp"
+#include "TriangleUtils.hpp"
+#include "Geometry.hpp"
+#include "BasicShapes.hpp"
+#include "BoundingShapes.hpp"
+#include "CompactMeshBuilder.hpp"
+
+#include <array>
+#include <algorithm>
+#include <stdexcept>
+
+namespace BSPOperations
+{
+
+enum class BooleanOperation
+{
+	Difference,
+	Intersection,
+	Union
+};
+
+enum class KeptSide
+{
+	Outside,
+	Inside
+};
+
+enum class NormalDirection
+{
+	Original,
+	Reversed
+};
+
+class SourceTriangle
+{
+public:
+	SourceTriangle (const Geometry::Triangle& triangle, const glm::dvec3& n1, const glm::dvec3& n2, const glm::dvec3& n3, Modeler::MaterialId material) :
+		triangle (triangle),
+		normals ({ n1, n2, n3 }),
+		material (material)
+	{
+	}
+
+	Geometry::Triangle			triangle;
+	std::array<glm::dvec3, 3>	normals;
+	Modeler::MaterialId			material;
+};
+
+class ClipSettings
+{
+public:
+	ClipSettings (Geometry::BSPCoplanarSide sameDirectionSide, Geometry::BSPCoplanarSide oppositeDirectionSide, KeptSide keptSide, NormalDirection normalDir) :
+		sameDirectionSide (sameDirectionSide),
+		oppositeDirectionSide (oppositeDirectionSide),
+		keptSide (keptSide),
+		normalDir (normalDir)
+	{
+	}
+
+	Geometry::BSPCoplanarSide	sameDirectionSide;
+	Geometry::BSPCoplanarSide	oppositeDirectionSide;
+	KeptSide					keptSide;
+	NormalDirection				normalDir;
+};
+
+class FragmentCollector : public Geometry::BSPTriangleClipper
+{
+public:
+	FragmentCollector (KeptSide keptSide) :
+		keptSide (keptSide),
+		fragments ()
+	{
+	}
+
+	virtual void FrontTrianglesFound (const Geometry::TriangleCutList& triangles) override
+	{
+		if (keptSide == KeptSide::Outside) {
+			fragments.insert (fragments.end (), triangles.begin (), triangles.end ());
+		}
+	}
+
+	virtual void BackTrianglesFound (const Geometry::TriangleCutList& triangles) override
+	{
+		if (keptSide == KeptSide::Inside) {
+			fragments.insert (fragments.end (), triangles.begin (), triangles.end ());
+		}
+	}
+
+	virtual void PlaneTrianglesFound (const Geometry::TriangleCutList&) override
+	{
+
+	}
+
+	KeptSide						keptSide;
+	std::vector<Geometry::Triangle>	fragments;
+};
+
+static std::vector<SourceTriangle> GetSourceTriangles (const Modeler::Mesh& mesh, Modeler::Mesh& resultMesh)
+{
+	const Modeler::MeshGeometry& geometry = mesh.GetGeometry ();
+	const Modeler::MeshMaterials& materials = mesh.GetMaterials ();
+	const glm::dmat4& transformation = mesh.GetTransformation ();
+
+	std::vector<glm::dvec3> vertices;
+	geometry.EnumerateVertices (transformation, [&] (const glm::dvec3& vertex) {
+		vertices.push_back (vertex);
+	});
+	std::vector<glm::dvec3> normals;
+	geometry.EnumerateNormals (transformation, [&] (const glm::dvec3& normal) {
+		normals.push_back (normal);
+	});
+
+	std::vector<Modeler::MaterialId> materialMap (materials.MaterialCount (), -1);
+	std::vector<SourceTriangle> triangles;
+	triangles.reserve (geometry.TriangleCount ());
+	for (unsigned int i = 0; i < geometry.TriangleCount (); i++) {
+		const Modeler::MeshTriangle& meshTriangle = geometry.GetTriangle (i);
+		Modeler::MaterialId material = materials.GetTriangleMaterial (i);
+		if (materialMap[material] == -1) {
+			materialMap[material] = resultMesh.AddMaterial (materials.GetMaterial (material));
+		}
+		triangles.push_back (SourceTriangle (
+			Geometry::Triangle (vertices[meshTriangle.v1], vertices[meshTriangle.v2], vertices[meshTriangle.v3]),
+			normals[meshTriangle.n1], normals[meshTriangle.n2], normals[meshTriangle.n3],
+			materialMap[material]
+		));
+	}
+	return triangles;
+}
+
+static void AddFragment (const SourceTriangle& source, const Geometry::Triangle& fragment, NormalDirection normalDir, Modeler::Mesh& resultMesh, Modeler::CompactMeshBuilder& builder)
+{
+	glm::dvec3 cross = glm::cross (fragment[1] - fragment[0], fragment[2] - fragment[0]);
+	if (glm::length (cross) == 0.0) {
+		return;
+	}
+
+	const Geometry::Triangle& triangle = source.triangle;
+	std::array<unsigned int, 3> vertices;
+	std::array<unsigned int, 3> normals;
+	for (size_t i = 0; i < 3; i++) {
+		glm::dvec3 normal = glm::normalize (Geometry::BarycentricInterpolation (
+			triangle[0], triangle[1], triangle[2],
+			source.normals[0], source.normals[1], source.normals[2],
+			fragment[i]
+		));
+		if (normalDir == NormalDirection::Reversed) {
+			normal *= -1.0;
+		}
+		vertices[i] = builder.AddVertex (fragment[i]);
+		normals[i] = builder.AddNormal (normal);
+	}
+
+	if (normalDir == NormalDirection::Original) {
+		resultMesh.AddTriangle (vertices[0], vertices[1], vertices[2], normals[0], normals[1], normals[2], source.material);
+	} else {
+		resultMesh.AddTriangle (vertices[0], vertices[2], vertices[1], normals[0], normals[2], normals[1], source.material);
+	}
+}
+
+static bool IsSeparated (const Geometry::Triangle& triangle, const Geometry::BoundingBox& box)
+{
+	const glm::dvec3& boxMin = box.GetMin ();
+	const glm::dvec3& boxMax = box.GetMax ();
+	for (glm::length_t i = 0; i < 3; i++) {
+		double triangleMin = std::min (std::min (triangle[0][i], triangle[1][i]), triangle[2][i]);
+		double triangleMax = std::max (std::max (triangle[0][i], triangle[1][i]), triangle[2][i]);
+		if (Geometry::IsLower (triangleMax, boxMin[i]) || Geometry::IsGreater (triangleMin, boxMax[i])) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static void ClipTriangles (const std::vector<SourceTriangle>& triangles, const Geometry::BalancedBSPTree& tree, const Geometry::BoundingBox& treeBox, const ClipSettings& settings, Modeler::Mesh& resultMesh, Modeler::CompactMeshBuilder& builder)
+{
+	FragmentCollector collector (settings.keptSide);
+	Geometry::BalancedBSPTree::ClipStack clipStack;
+	for (const SourceTriangle& triangle : triangles) {
+		// triangles far from the other operand are entirely outside of it,
+		// so there is no need to split them with the planes of the tree
+		if (tree.NodeCount () == 0 || !treeBox.IsValid () || IsSeparated (triangle.triangle, treeBox)) {
+			if (settings.keptSide == KeptSide::Outside) {
+				AddFragment (triangle, triangle.triangle, settings.normalDir, resultMesh, builder);
+			}
+			continue;
+		}
+		collector.fragments.clear ();
+		tree.ClipTriangle (triangle.triangle, collector, settings.sameDirectionSide, settings.oppositeDirectionSide, clipStack);
+		for (const Geometry::Triangle& fragment : collector.fragments) {
+			AddFragment (triangle, fragment, settings.normalDir, resultMesh, builder);
+		}
+	}
+}
+
+static Geometry::BoundingBox GetBoundingBox (const std::vector<SourceTriangle>& sourceTriangles)
+{
+	Geometry::BoundingBox box;
+	for (const SourceTriangle& sourceTriangle : sourceTriangles) {
+		for (size_t i = 0; i < 3; i++) {
+			box.AddPoint (sourceTriangle.triangle[i]);
+		}
+	}
+	return box;
+}
+
+static std::vector<Geometry::Triangle> GetTriangles (const std::vector<SourceTriangle>& sourceTriangles)
+{
+	std::vector<Geometry::Triangle> triangles;
+	triangles.reserve (sourceTriangles.size ());
+	for (const SourceTriangle& sourceTriangle : sourceTriangles) {
+		triangles.push_back (sourceTriangle.triangle);
+	}
+	return triangles;
+}
+
+static bool MeshBooleanOperation (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, BooleanOperation operation, Modeler::Mesh& resultMesh)
+{
+	using Geometry::BSPCoplanarSide;
+
+	resultMesh.Clear ();
+	std::vector<SourceTriangle> aTriangles = GetSourceTriangles (aMesh, resultMesh);
+	std::vector<SourceTriangle> bTriangles = GetSourceTriangles (bMesh, resultMesh);
+
+	Geometry::BalancedBSPTree aTree (GetTriangles (aTriangles));
+	Geometry::BalancedBSPTree bTree (GetTriangles (bTriangles));
+	Geometry::BoundingBox aBox = GetBoundingBox (aTriangles);
+	Geometry::BoundingBox bBox = GetBoundingBox (bTriangles);
+	Modeler::CompactMeshBuilder builder (resultMesh);
+
+	// coplanar faces are kept only once: from the first operand if they face
+	// the same direction, and from none of them if they face each other
+	if (operation == BooleanOperation::Difference) {
+		ClipTriangles (aTriangles, bTree, bBox, ClipSettings (BSPCoplanarSide::Back, BSPCoplanarSide::Front, KeptSide::Outside, NormalDirection::Original), resultMesh, builder);
+		ClipTriangles (bTriangles, aTree, aBox, ClipSettings (BSPCoplanarSide::Front, BSPCoplanarSide::Front, KeptSide::Inside, NormalDirection::Reversed), resultMesh, builder);
+	} else if (operation == BooleanOperation::Intersection) {
+		ClipTriangles (aTriangles, bTree, bBox, ClipSettings (BSPCoplanarSide::Back, BSPCoplanarSide::Front, KeptSide::Inside, NormalDirection::Original), resultMesh, builder);
+		ClipTriangles (bTriangles, aTree, aBox, ClipSettings (BSPCoplanarSide::Front, BSPCoplanarSide::Front, KeptSide::Inside, NormalDirection::Original), resultMesh, builder);
+	} else if (operation == BooleanOperation::Union) {
+		ClipTriangles (aTriangles, bTree, bBox, ClipSettings (BSPCoplanarSide::Front, BSPCoplanarSide::Back, KeptSide::Outside, NormalDirection::Original), resultMesh, builder);
+		ClipTriangles (bTriangles, aTree, aBox, ClipSettings (BSPCoplanarSide::Back, BSPCoplanarSide::Back, KeptSide::Outside, NormalDirection::Original), resultMesh, builder);
+	} else {
+		throw std::logic_error ("invalid boolean operation");
+	}
+
+	resultMesh.GroupTrianglesByMaterial ();
+	return true;
+}
+
+static Modeler::ShapePtr ShapeBooleanOperation (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape, BooleanOperation operation)
+{
+	Modeler::Mesh aMesh = aShape->GenerateMesh ();
+	Modeler::Mesh bMesh = bShape->GenerateMesh ();
+	Modeler::Mesh resultMesh;
+	if (!MeshBooleanOperation (aMesh, bMesh, operation, resultMesh)) {
+		return nullptr;
+	}
+	return std::shared_ptr<Modeler::MeshShape> (new Modeler::MeshShape (glm::dmat4 (1.0), resultMesh));
+}
+
+bool MeshDifference (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, Modeler::Mesh& resultMesh)
+{
+	return MeshBooleanOperation (aMesh, bMesh, BooleanOperation::Difference, resultMesh);
+}
+
+bool MeshIntersection (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, Modeler::Mesh& resultMesh)
+{
+	return MeshBooleanOperation (aMesh, bMesh, BooleanOperation::Intersection, resultMesh);
+}
+
+bool MeshUnion (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, Modeler::Mesh& resultMesh)
+{
+	return MeshBooleanOperation (aMesh, bMesh, BooleanOperation::Union, resultMesh);
+}
+
+bool MeshUnion (const std::vector<Modeler::Mesh>& meshes, Modeler::Mesh& resultMesh)
+{
+	if (meshes.empty ()) {
+		return false;
+	}
+	resultMesh = meshes[0];
+	for (size_t i = 1; i < meshes.size (); i++) {
+		Modeler::Mesh aMesh = resultMesh;
+		const Modeler::Mesh& bMesh = meshes[i];
+		if (!MeshUnion (aMesh, bMesh, resultMesh)) {
+			resultMesh.Clear ();
+			return false;
+		}
+	}
+	return true;
+}
+
+Modeler::ShapePtr ShapeDifference (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape)
+{
+	return ShapeBooleanOperation (aShape, bShape, BooleanOperation::Difference);
+}
+
+Modeler::ShapePtr ShapeIntersection (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape)
+{
+	return ShapeBooleanOperation (aShape, bShape, BooleanOperation::Intersection);
+}
+
+Modeler::ShapePtr ShapeUnion (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape)
+{
+	return ShapeBooleanOperation (aShape, bShape, BooleanOperation::Union);
+}
+
+Modeler::ShapePtr ShapeUnion (const std::vector<Modeler::ShapeConstPtr>& shapes)
+{
+	std::vector<Modeler::Mesh> meshes;
+	for (const Modeler::ShapeConstPtr& shape : shapes) {
+		meshes.push_back (shape->GenerateMesh ());
+	}
+	Modeler::Mesh resultMesh;
+	if (!MeshUnion (meshes, resultMesh)) {
+		return nullptr;
+	}
+	return std::shared_ptr<Modeler::MeshShape> (new Modeler::MeshShape (glm::dmat4 (1.0), resultMesh));
+}
+
+}
@@ -0,0 +1,28 @@
+#ifndef BSP_BOOLEANOPERATIONS_HPP
+#define BSP_BOOLEANOPERATIONS_HPP
+
+#include "Shape.hpp"
+#include "Mesh.hpp"
+
+#include <vector>
+
+// Boolean operations by clipping the triangles of each operand with a BSP tree
+// built from the other one. It works in double precision, so it is much faster
+// than the exact operations, but the result may contain small cracks and slivers.
+
+namespace BSPOperations
+{
+
+bool					MeshDifference (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, Modeler::Mesh& resultMesh);
+bool					MeshIntersection (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, Modeler::Mesh& resultMesh);
+bool					MeshUnion (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, Modeler::Mesh& resultMesh);
+bool					MeshUnion (const std::vector<Modeler::Mesh>& meshes, Modeler::Mesh& resultMesh);
+
+Modeler::ShapePtr		ShapeDifference (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape);
+Modeler::ShapePtr		ShapeIntersection (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape);
+Modeler::ShapePtr		ShapeUnion (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape);
+Modeler::ShapePtr		ShapeUnion (const std::vector<Modeler::ShapeConstPtr>& shapes);
+
+}
+
+#endif
@@ -2,6 +2,16 @@
 #include "TriangleUtils.hpp"
 #include "IncludeGLM.hpp"
 #include "BasicShapes.hpp"
+#include "LRUCache.hpp"
+#include "MeshClusters.hpp"
+#include "MeshOverlap.hpp"
+#include "CompactMeshBuilder.hpp"
+#include "ParallelTasks.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <exception>
 
 #pragma warning (push)
 #pragma warning (disable : 4456)
@@ -12,6 +22,9 @@
 #include <CGAL/Exact_predicates_exact_constructions_kernel.h>
 #include <CGAL/Surface_mesh.h>
 #include <CGAL/Polygon_mesh_processing/corefinement.h>
+#include <CGAL/Polygon_mesh_processing/bbox.h>
+#include <CGAL/Polygon_mesh_processing/orientation.h>
+#include <CGAL/Aff_transformation_3.h>
 #include <CGAL/Polyhedron_incremental_builder_3.h>
 #include <CGAL/Polyhedron_3.h>
 #include <CGAL/Cartesian_converter.h>
@@ -66,12 +79,14 @@ static void ConvertMeshToCGALMesh (const Modeler::Mesh& mesh, CGAL_Mesh& cgalMes
 	geometry.EnumerateVertices (transformation, [&] (const glm::dvec3& vertex) {
 		cgalMesh.add_vertex (CGAL_Point (vertex.x, vertex.y, vertex.z));
 	});
+	// a mirroring transformation turns the surface inside out, so the faces are reversed
+	bool isMirrored = glm::determinant (transformation) < 0.0;
 	for (unsigned int triangleIndex = 0; triangleIndex < geometry.TriangleCount (); ++triangleIndex) {
 		const Modeler::MeshTriangle& triangle = geometry.GetTriangle (triangleIndex);
 		CGAL_Mesh::Face_index faceIndex = cgalMesh.add_face (
 			CGAL_Mesh::Vertex_index (triangle.v1),
-			CGAL_Mesh::Vertex_index (triangle.v2),
-			CGAL_Mesh::Vertex_index (triangle.v3)
+			CGAL_Mesh::Vertex_index (isMirrored ? triangle.v3 : triangle.v2),
+			CGAL_Mesh::Vertex_index (isMirrored ? triangle.v2 : triangle.v3)
 		);
 		propertyMap[faceIndex] = FaceId (&mesh, triangleIndex, normalDir);
 	}
@@ -79,11 +94,25 @@ static void ConvertMeshToCGALMesh (const Modeler::Mesh& mesh, CGAL_Mesh& cgalMes
 
 static void ConvertCGALMeshToMesh (const CGAL_Mesh& cgalMesh, const CGAL_Mesh::Property_map<CGAL_Mesh::Face_index, FaceId>& propertyMap, Modeler::Mesh& mesh) 
 {
+	// vertices and normals of the original meshes are transformed once, and
+	// interpolated normals are added only once, so the result is compact
+	class SourceMeshData
+	{
+	public:
+		std::vector<glm::dvec3>									vertices;
+		std::vector<glm::dvec3>									normals;
+		std::unordered_map<Modeler::MaterialId, Modeler::MaterialId>	materialMap;
+	};
+
 	class MeshBuilder
 	{
 	public:
 		MeshBuilder (Modeler::Mesh& resultMesh) :
-			resultMesh (resultMesh)
+			resultMesh (resultMesh),
+			compactBuilder (resultMesh),
+			sourceMeshDataMap (),
+			lastSourceMesh (nullptr),
+			lastSourceMeshData (nullptr)
 		{
 		}
 
@@ -94,17 +123,16 @@ static void ConvertCGALMeshToMesh (const CGAL_Mesh& cgalMesh, const CGAL_Mesh::P
 
 		void AddTriangle (unsigned int v1, unsigned int v2, unsigned int v3, const FaceId& faceId)
 		{
-			const Modeler::Mesh& oldMesh = *faceId.mesh;
-			const Modeler::MeshGeometry& oldGeometry = oldMesh.GetGeometry ();
-			const Modeler::MeshTriangle& oldTriangle = oldGeometry.GetTriangle (faceId.faceIndex);
-
-			const glm::dvec3& oldV1 = GetTransformedVertex (faceId.mesh, oldTriangle.v1);
-			const glm::dvec3& oldV2 = GetTransformedVertex (faceId.mesh, oldTriangle.v2);
-			const glm::dvec3& oldV3 = GetTransformedVertex (faceId.mesh, oldTriangle.v3);
-			const glm::dvec3& oldN1 = GetTransformedNormal (faceId.mesh, oldTriangle.n1);
-			const glm::dvec3& oldN2 = GetTransformedNormal (faceId.mesh, oldTriangle.n2);
-			const glm::dvec3& oldN3 = GetTransformedNormal (faceId.mesh, oldTriangle.n3);
-			
+			SourceMeshData& sourceData = GetSourceMeshData (faceId.mesh);
+			const Modeler::MeshTriangle& oldTriangle = faceId.mesh->GetGeometry ().GetTriangle (faceId.faceIndex);
+
+			const glm::dvec3& oldV1 = sourceData.vertices[oldTriangle.v1];
+			const glm::dvec3& oldV2 = sourceData.vertices[oldTriangle.v2];
+			const glm::dvec3& oldV3 = sourceData.vertices[oldTriangle.v3];
+			const glm::dvec3& oldN1 = sourceData.normals[oldTriangle.n1];
+			const glm::dvec3& oldN2 = sourceData.normals[oldTriangle.n2];
+			const glm::dvec3& oldN3 = sourceData.normals[oldTriangle.n3];
+
 			const glm::dvec3& newV1 = resultMesh.GetGeometry ().GetVertex (v1);
 			const glm::dvec3& newV2 = resultMesh.GetGeometry ().GetVertex (v2);
 			const glm::dvec3& newV3 = resultMesh.GetGeometry ().GetVertex (v3);
@@ -118,58 +146,57 @@ static void ConvertCGALMeshToMesh (const CGAL_Mesh& cgalMesh, const CGAL_Mesh::P
 				newN3 *= -1.0;
 			}
 
-			unsigned int n1 = resultMesh.AddNormal (newN1);
-			unsigned int n2 = resultMesh.AddNormal (newN2);
-			unsigned int n3 = resultMesh.AddNormal (newN3);
+			unsigned int n1 = compactBuilder.AddNormal (newN1);
+			unsigned int n2 = compactBuilder.AddNormal (newN2);
+			unsigned int n3 = compactBuilder.AddNormal (newN3);
 
-			Modeler::MaterialId materialId = GetMaterialId (faceId);
+			Modeler::MaterialId materialId = GetMaterialId (sourceData, faceId);
 			resultMesh.AddTriangle (v1, v2, v3, n1, n2, n3, materialId);
 		}
 
 	private:
-		const glm::dvec3& GetTransformedVertex (const Modeler::Mesh* mesh, unsigned int vertexId)
+		SourceMeshData& GetSourceMeshData (const Modeler::Mesh* mesh)
 		{
-			if (transformedVertexMap.find (mesh) == transformedVertexMap.end ()) {
-				transformedVertexMap.insert ({ mesh, std::vector<glm::dvec3> () });
-				std::vector<glm::dvec3>& vertices = transformedVertexMap.at (mesh);
-				mesh->GetGeometry ().EnumerateVertices (mesh->GetTransformation (), [&] (const glm::dvec3& vertex) {
-					vertices.push_back (vertex);
-				});
+			// faces of the same original mesh usually follow each other
+			if (mesh == lastSourceMesh) {
+				return *lastSourceMeshData;
 			}
-			return transformedVertexMap.at (mesh)[vertexId];
-		}
-
-		const glm::dvec3& GetTransformedNormal (const Modeler::Mesh* mesh, unsigned int normalId)
-		{
-			if (transformedNormalMap.find (mesh) == transformedNormalMap.end ()) {
-				transformedNormalMap.insert ({ mesh, std::vector<glm::dvec3> () });
-				std::vector<glm::dvec3>& normals = transformedNormalMap.at (mesh);
-				mesh->GetGeometry ().EnumerateNormals (mesh->GetTransformation (), [&] (const glm::dvec3& normal) {
-					normals.push_back (normal);
+			auto found = sourceMeshDataMap.find (mesh);
+			if (found == sourceMeshDataMap.end ()) {
+				found = sourceMeshDataMap.insert ({ mesh, SourceMeshData () }).first;
+				SourceMeshData& sourceData = found->second;
+				const Modeler::MeshGeometry& geometry = mesh->GetGeometry ();
+				sourceData.vertices.reserve (geometry.VertexCount ());
+				geometry.EnumerateVertices (mesh->GetTransformation (), [&] (const glm::dvec3& vertex) {
+					sourceData.vertices.push_back (vertex);
+				});
+				sourceData.normals.reserve (geometry.NormalCount ());
+				geometry.EnumerateNormals (mesh->GetTransformation (), [&] (const glm::dvec3& normal) {
+					sourceData.normals.push_back (normal);
 				});
 			}
-			return transformedNormalMap.at (mesh)[normalId];
+			lastSourceMesh = mesh;
+			lastSourceMeshData = &found->second;
+			return found->second;
 		}
 
-		Modeler::MaterialId GetMaterialId (const FaceId& faceId)
+		Modeler::MaterialId GetMaterialId (SourceMeshData& sourceData, const FaceId& faceId)
 		{
-			if (materialMap.find (faceId.mesh) == materialMap.end ()) {
-				materialMap.insert ({ faceId.mesh, std::unordered_map<Modeler::MaterialId, Modeler::MaterialId> () });
-			}
-			std::unordered_map<Modeler::MaterialId, Modeler::MaterialId>& meshMap = materialMap.at (faceId.mesh);
 			const Modeler::MeshMaterials& materials = faceId.mesh->GetMaterials ();
 			Modeler::MaterialId oldMaterialId = materials.GetTriangleMaterial (faceId.faceIndex);
-			if (meshMap.find (oldMaterialId) == meshMap.end ()) {
+			auto found = sourceData.materialMap.find (oldMaterialId);
+			if (found == sourceData.materialMap.end ()) {
 				Modeler::MaterialId newMaterialId = resultMesh.AddMaterial (materials.GetMaterial (oldMaterialId));
-				meshMap.insert ({ oldMaterialId, newMaterialId });
+				found = sourceData.materialMap.insert ({ oldMaterialId, newMaterialId }).first;
 			}
-			return meshMap.at (oldMaterialId);
+			return found->second;
 		}
 
-		Modeler::Mesh& resultMesh;
-		std::unordered_map<const Modeler::Mesh*, std::vector<glm::dvec3>> transformedVertexMap;
-		std::unordered_map<const Modeler::Mesh*, std::vector<glm::dvec3>> transformedNormalMap;
-		std::unordered_map<const Modeler::Mesh*, std::unordered_map<Modeler::MaterialId, Modeler::MaterialId>> materialMap;
+		Modeler::Mesh&												resultMesh;
+		Modeler::CompactMeshBuilder									compactBuilder;
+		std::unordered_map<const Modeler::Mesh*, SourceMeshData>	sourceMeshDataMap;
+		const Modeler::Mesh*										lastSourceMesh;
+		SourceMeshData*												lastSourceMeshData;
 	};
 
 	MeshBuilder builder (mesh);
@@ -193,19 +220,107 @@ static void ConvertCGALMeshToMesh (const CGAL_Mesh& cgalMesh, const CGAL_Mesh::P
 		}
 		builder.AddTriangle ((unsigned int) vertices[0], (unsigned int) vertices[1], (unsigned int) vertices[2], faceId);
 	}
+
+	mesh.GroupTrianglesByMaterial ();
 }
 
+// Thrown by the visitor to stop a cancelled corefinement. The calculation
+// catches every exception, so the operation fails, and the caller tells the
+// cancelled operation from the failed one by the progress.
+class OperationCancelled
+{
+};
+
+// Corefinement runs in stages, each stage reports into its own range of the
+// progress. The stages report the number of their steps at the beginning, the
+// progress is reported only when it changes at least a percent, because the
+// steps are called for every face. The visitor is copied by the corefinement,
+// so the state of the stages is shared between the copies. Older versions of
+// CGAL do not call the stage functions, then only cancellation is checked.
+class CGALMeshVisitorProgress
+{
+public:
+	CGALMeshVisitorProgress (Modeler::OperationProgress* progress) :
+		progress (progress),
+		rangeStart (0.0),
+		rangeEnd (0.0),
+		stepCount (0),
+		currentStep (0),
+		reportedProgress (0.0)
+	{
+
+	}
+
+	void StartStage (double newRangeStart, double newRangeEnd, size_t newStepCount)
+	{
+		rangeStart = newRangeStart;
+		rangeEnd = newRangeEnd;
+		stepCount = newStepCount;
+		currentStep = 0;
+		Report (newRangeStart);
+	}
+
+	void StageProgress (double stageProgress)
+	{
+		CheckCancelled ();
+		double newProgress = rangeStart + stageProgress * (rangeEnd - rangeStart);
+		if (newProgress - reportedProgress >= 0.01) {
+			Report (newProgress);
+		}
+	}
+
+	void StageStep ()
+	{
+		currentStep++;
+		if (stepCount > 0) {
+			StageProgress ((double) std::min (currentStep, stepCount) / (double) stepCount);
+		} else {
+			CheckCancelled ();
+		}
+	}
+
+	void EndStage ()
+	{
+		Report (rangeEnd);
+	}
+
+	void CheckCancelled () const
+	{
+		if (Modeler::IsOperationCancelled (progress)) {
+			throw OperationCancelled ();
+		}
+	}
+
+private:
+	void Report (double newProgress)
+	{
+		CheckCancelled ();
+		reportedProgress = newProgress;
+		Modeler::SetOperationProgress (progress, newProgress);
+	}
+
+	Modeler::OperationProgress*		progress;
+	double							rangeStart;
+	double							rangeEnd;
+	size_t							stepCount;
+	size_t							currentStep;
+	double							reportedProgress;
+};
+
 class CGALMeshVisitor : public CGAL::Polygon_mesh_processing::Corefinement::Default_visitor<CGAL_Mesh>
 {
 public:
-	CGALMeshVisitor () :
-		faceId ()
+	CGALMeshVisitor (Modeler::OperationProgress* progress) :
+		faceId (),
+		properties (),
+		stages (std::make_shared<CGALMeshVisitorProgress> (progress))
 	{
 
 	}
 
 	void before_subface_creations (CGAL_Mesh::Face_index splitFace, CGAL_Mesh& mesh)
 	{
+		stages->CheckCancelled ();
 		faceId = properties[&mesh][splitFace];
 	}
 
@@ -216,11 +331,83 @@ public:
 
 	void after_face_copy (face_descriptor sourceFace, CGAL_Mesh& sourceMesh, face_descriptor targetFace, CGAL_Mesh& targetMesh)
 	{
+		stages->CheckCancelled ();
 		properties[&targetMesh][targetFace] = properties[&sourceMesh][sourceFace];
 	}
 
+	void start_filtering_intersections () const
+	{
+		stages->StartStage (0.0, 0.3, 0);
+	}
+
+	void progress_filtering_intersections (double filteringProgress) const
+	{
+		stages->StageProgress (filteringProgress);
+	}
+
+	void end_filtering_intersections () const
+	{
+		stages->EndStage ();
+	}
+
+	void start_handling_intersection_of_coplanar_faces (std::size_t faceCount) const
+	{
+		stages->StartStage (0.3, 0.4, faceCount);
+	}
+
+	void intersection_of_coplanar_faces_step () const
+	{
+		stages->StageStep ();
+	}
+
+	void end_handling_intersection_of_coplanar_faces () const
+	{
+		stages->EndStage ();
+	}
+
+	void start_handling_edge_face_intersections (std::size_t edgeCount) const
+	{
+		stages->StartStage (0.4, 0.6, edgeCount);
+	}
+
+	void edge_face_intersections_step () const
+	{
+		stages->StageStep ();
+	}
+
+	void end_handling_edge_face_intersections () const
+	{
+		stages->EndStage ();
+	}
+
+	void start_triangulating_faces (std::size_t faceCount) const
+	{
+		stages->StartStage (0.6, 0.9, faceCount);
+	}
+
+	void triangulating_faces_step () const
+	{
+		stages->StageStep ();
+	}
+
+	void end_triangulating_faces () const
+	{
+		stages->EndStage ();
+	}
+
+	void start_building_output () const
+	{
+		stages->StartStage (0.9, 1.0, 0);
+	}
+
+	void end_building_output () const
+	{
+		stages->EndStage ();
+	}
+
 	FaceId faceId;
 	std::unordered_map<const CGAL_Mesh*, CGAL_Mesh::Property_map<CGAL_Mesh::Face_index, FaceId>> properties;
+	std::shared_ptr<CGALMeshVisitorProgress> stages;
 };
 
 class CGALMeshData
@@ -251,6 +438,136 @@ private:
 	CGAL_Mesh::Property_map<CGAL_Mesh::Face_index, FaceId>	cgalMeshPropertyMap;
 };
 
+// Exact surface of a boolean result. Faces refer to the faces of the original
+// meshes for normals and materials, so the original meshes are kept with it.
+class ExactMesh
+{
+public:
+	ExactMesh () :
+		cgalMesh (),
+		propertyMap (),
+		sourceMeshes (),
+		hash (),
+		meshMutex (),
+		mesh (nullptr),
+		conversionError (nullptr)
+	{
+		propertyMap = cgalMesh.add_property_map<CGAL_Mesh::Face_index, FaceId> ("faceid", FaceId ()).first;
+	}
+
+	ExactMesh (const Modeler::Mesh& sourceMesh, NormalDirection normalDir) :
+		cgalMesh (),
+		propertyMap (),
+		sourceMeshes ({ std::make_shared<const Modeler::Mesh> (sourceMesh) }),
+		hash (),
+		meshMutex (),
+		mesh (nullptr),
+		conversionError (nullptr)
+	{
+		ConvertMeshToCGALMesh (*sourceMeshes[0], cgalMesh, normalDir, propertyMap);
+	}
+
+	// Copies the exact mesh for an operation, which modifies its operands.
+	// Original meshes are transformed together with the exact points, so the
+	// normals of the result are interpolated in the same coordinate system.
+	// The faces are reversed by a mirroring transformation to keep the surface
+	// oriented outwards, the transformed normals are already outwards.
+	ExactMesh (const ExactMesh& source, const glm::dmat4& transformation, NormalDirection normalDir) :
+		cgalMesh (source.cgalMesh),
+		propertyMap (),
+		sourceMeshes (),
+		hash (),
+		meshMutex (),
+		mesh (nullptr),
+		conversionError (nullptr)
+	{
+		propertyMap = cgalMesh.property_map<CGAL_Mesh::Face_index, FaceId> ("faceid").first;
+		std::unordered_map<const Modeler::Mesh*, const Modeler::Mesh*> sourceMeshMap;
+		bool isIdentity = (transformation == glm::dmat4 (1.0));
+		for (const std::shared_ptr<const Modeler::Mesh>& sourceMesh : source.sourceMeshes) {
+			if (isIdentity) {
+				sourceMeshes.push_back (sourceMesh);
+			} else {
+				std::shared_ptr<Modeler::Mesh> transformedMesh (new Modeler::Mesh (*sourceMesh));
+				transformedMesh->AddTransformation (transformation);
+				sourceMeshes.push_back (transformedMesh);
+			}
+			sourceMeshMap.insert ({ sourceMesh.get (), sourceMeshes.back ().get () });
+		}
+
+		if (!isIdentity) {
+			const glm::dmat4& m = transformation;
+			CGAL::Aff_transformation_3<CGAL_Kernel> cgalTransformation (
+				m[0][0], m[1][0], m[2][0], m[3][0],
+				m[0][1], m[1][1], m[2][1], m[3][1],
+				m[0][2], m[1][2], m[2][2], m[3][2]
+			);
+			for (CGAL_Mesh::Vertex_index vertIndex : cgalMesh.vertices ()) {
+				cgalMesh.point (vertIndex) = cgalTransformation.transform (cgalMesh.point (vertIndex));
+			}
+			if (glm::determinant (transformation) < 0.0) {
+				CGAL::Polygon_mesh_processing::reverse_face_orientations (cgalMesh);
+			}
+		}
+		for (CGAL_Mesh::Face_index faceIndex : cgalMesh.faces ()) {
+			FaceId& faceId = propertyMap[faceIndex];
+			faceId.mesh = sourceMeshMap.at (faceId.mesh);
+			if (normalDir == NormalDirection::Reversed) {
+				faceId.normalDir = (faceId.normalDir == NormalDirection::Original ? NormalDirection::Reversed : NormalDirection::Original);
+			}
+		}
+	}
+
+	ExactMesh (const ExactMesh& rhs) = delete;
+	ExactMesh& operator= (const ExactMesh& rhs) = delete;
+
+	// The mesh is converted on the first request, and kept for later ones. A
+	// failed conversion is kept too, and its exception is thrown on every call.
+	const Modeler::Mesh& GetMesh () const
+	{
+		std::lock_guard<std::mutex> lock (meshMutex);
+		if (mesh == nullptr && conversionError == nullptr) {
+			CGAL::Protect_FPU_rounding<true> protect (CGAL_FE_UPWARD);
+			std::shared_ptr<Modeler::Mesh> convertedMesh (new Modeler::Mesh ());
+			try {
+				ConvertCGALMeshToMesh (cgalMesh, propertyMap, *convertedMesh);
+				mesh = convertedMesh;
+			} catch (...) {
+				conversionError = std::current_exception ();
+			}
+		}
+		if (conversionError != nullptr) {
+			std::rethrow_exception (conversionError);
+		}
+		return *mesh;
+	}
+
+	// Approximate memory usage of the connectivity, the face properties and the
+	// points. A point is a handle of a lazy representation, which holds an
+	// interval approximation and the exact point once it is calculated, the
+	// numbers of the exact point are allocated separately, so they are not
+	// included.
+	size_t CalcMemoryUsage () const
+	{
+		typedef CGAL_Kernel::Approximate_kernel::Point_3 ApproximatePoint;
+		typedef CGAL_Kernel::Exact_kernel::Point_3 ExactPoint;
+		size_t vertexSize = sizeof (CGAL_Mesh::Halfedge_index) + sizeof (CGAL_Point) + sizeof (ApproximatePoint) + sizeof (ExactPoint) + sizeof (bool);
+		size_t halfedgeSize = sizeof (CGAL_Mesh::Face_index) + sizeof (CGAL_Mesh::Vertex_index) + 2 * sizeof (CGAL_Mesh::Halfedge_index) + sizeof (bool);
+		size_t faceSize = sizeof (CGAL_Mesh::Halfedge_index) + sizeof (FaceId) + sizeof (bool);
+		return sizeof (ExactMesh) + cgalMesh.number_of_vertices () * vertexSize + cgalMesh.number_of_halfedges () * halfedgeSize + cgalMesh.number_of_faces () * faceSize;
+	}
+
+	CGAL_Mesh												cgalMesh;
+	CGAL_Mesh::Property_map<CGAL_Mesh::Face_index, FaceId>	propertyMap;
+	std::vector<std::shared_ptr<const Modeler::Mesh>>		sourceMeshes;
+	Modeler::ContentHash									hash;
+
+private:
+	mutable std::mutex										meshMutex;
+	mutable std::shared_ptr<const Modeler::Mesh>			mesh;
+	mutable std::exception_ptr								conversionError;
+};
+
 enum class BooleanOperation
 {
 	Difference,
@@ -258,13 +575,15 @@ enum class BooleanOperation
 	Union
 };
 
-static bool MeshBooleanOperationWithCGALMesh (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, BooleanOperation operation, Modeler::Mesh& resultMesh)
+// The visitor throws on cancellation, so this is called only through
+// CalculateExactMeshBooleanOperation, which catches every exception.
+static bool MeshBooleanOperationWithCGALMesh (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, BooleanOperation operation, Modeler::Mesh& resultMesh, Modeler::OperationProgress* progress)
 {
 	CGALMeshData aCGALMesh (aMesh, NormalDirection::Original);
 	CGALMeshData bCGALMesh (bMesh, operation == BooleanOperation::Difference ? NormalDirection::Reversed : NormalDirection::Original);
 	CGALMeshData resultCGALMesh;
 
-	CGALMeshVisitor visitor;
+	CGALMeshVisitor visitor (progress);
 	visitor.properties.insert ({ &aCGALMesh.GetCGALMesh (), aCGALMesh.GetPropertyMap () } );
 	visitor.properties.insert ({ &bCGALMesh.GetCGALMesh (), bCGALMesh.GetPropertyMap () } );
 	visitor.properties.insert ({ &resultCGALMesh.GetCGALMesh (), resultCGALMesh.GetPropertyMap () } );
@@ -277,7 +596,7 @@ static bool MeshBooleanOperationWithCGALMesh (const Modeler::Mesh& aMesh, const
 	} else if (operation == BooleanOperation::Union) {
 		opResult = CGAL::Polygon_mesh_processing::corefine_and_compute_union (aCGALMesh.GetCGALMesh (), bCGALMesh.GetCGALMesh (), resultCGALMesh.GetCGALMesh (), CGAL::Polygon_mesh_processing::parameters::visitor (visitor));
 	} else {
-		throw std::exception ("invalid boolean operation");
+		throw std::logic_error ("invalid boolean operation");
 	}
 
 	if (!opResult) {
@@ -288,7 +607,7 @@ static bool MeshBooleanOperationWithCGALMesh (const Modeler::Mesh& aMesh, const
 	return true;
 }
 
-static bool MeshBooleanOperation (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, BooleanOperation operation, Modeler::Mesh& resultMesh)
+static bool CalculateExactMeshBooleanOperation (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, BooleanOperation operation, Modeler::Mesh& resultMesh, Modeler::OperationProgress* progress)
 {
 	// use the same rounding for mesh generation as for operation
 	// also workaround a CGAL bug of not resetting the rounding value sometimes
@@ -296,7 +615,7 @@ static bool MeshBooleanOperation (const Modeler::Mesh& aMesh, const Modeler::Mes
 
 	bool success = false;
 	try {
-		success = MeshBooleanOperationWithCGALMesh (aMesh, bMesh, operation, resultMesh);
+		success = MeshBooleanOperationWithCGALMesh (aMesh, bMesh, operation, resultMesh, progress);
 	} catch (...) {
 		success = false;
 	}
@@ -304,15 +623,623 @@ static bool MeshBooleanOperation (const Modeler::Mesh& aMesh, const Modeler::Mes
 	return success;
 }
 
-static Modeler::ShapePtr ShapeBooleanOperation (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape, BooleanOperation operation)
+static bool IsEmptyMesh (const Modeler::Mesh& mesh)
 {
-	Modeler::Mesh aMesh = aShape->GenerateMesh ();
-	Modeler::Mesh bMesh = bShape->GenerateMesh ();
-	Modeler::Mesh resultMesh;
-	if (!MeshBooleanOperation (aMesh, bMesh, operation, resultMesh)) {
+	return mesh.GetGeometry ().TriangleCount () == 0;
+}
+
+// Only the components of the operands with surface contact go to the exact
+// calculation, the result of separated and contained components is known
+// from the operation, so they are concatenated to the result. Components of
+// the second operand inside the first one would be cavities of a difference,
+// in this case the whole operation is calculated exactly.
+static bool CalculateMeshBooleanOperation (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, BooleanOperation operation, Modeler::Mesh& resultMesh, Modeler::OperationProgress* progress)
+{
+	Modeler::MeshOverlapPartition aPartition;
+	Modeler::MeshOverlapPartition bPartition;
+	Modeler::PartitionMeshOverlap (aMesh, bMesh, aPartition, bPartition);
+	if (Modeler::IsOperationCancelled (progress)) {
+		return false;
+	}
+	if (operation == BooleanOperation::Difference && !IsEmptyMesh (bPartition.inside)) {
+		return CalculateExactMeshBooleanOperation (aMesh, bMesh, operation, resultMesh, progress);
+	}
+
+	std::vector<Modeler::Mesh> resultParts;
+	if (operation == BooleanOperation::Difference) {
+		resultParts.push_back (aPartition.outside);
+	} else if (operation == BooleanOperation::Intersection) {
+		resultParts.push_back (aPartition.inside);
+		resultParts.push_back (bPartition.inside);
+	} else if (operation == BooleanOperation::Union) {
+		resultParts.push_back (aPartition.outside);
+		resultParts.push_back (bPartition.outside);
+	}
+
+	resultParts.erase (std::remove_if (resultParts.begin (), resultParts.end (), IsEmptyMesh), resultParts.end ());
+	if (!IsEmptyMesh (aPartition.touching) && !IsEmptyMesh (bPartition.touching)) {
+		Modeler::Mesh exactMesh;
+		if (!CalculateExactMeshBooleanOperation (aPartition.touching, bPartition.touching, operation, exactMesh, progress)) {
+			return false;
+		}
+		if (resultParts.empty ()) {
+			resultMesh = exactMesh;
+			return true;
+		}
+		resultParts.push_back (exactMesh);
+	}
+
+	resultMesh = Modeler::MergeMeshes (resultParts);
+	return true;
+}
+
+// results are cached by the content hash of the operation and its operands,
+// so evaluating the same operation again does not run the exact calculation,
+// the operands are kept with the result to compare them on every hit
+static const size_t MaxCachedResultSize = 256 * 1024 * 1024;
+
+class CachedBooleanResult
+{
+public:
+	BooleanOperation			operation;
+	std::vector<Modeler::Mesh>	operands;
+	bool						success;
+	Modeler::Mesh				mesh;
+};
+
+using BooleanResultCache = Modeler::LRUCache<Modeler::ContentHash, CachedBooleanResult>;
+
+static BooleanResultCache& GetBooleanResultCache ()
+{
+	static BooleanResultCache resultCache (MaxCachedResultSize, [] (const CachedBooleanResult& result) {
+		size_t size = sizeof (CachedBooleanResult) + result.mesh.CalcMemoryUsage ();
+		for (const Modeler::Mesh& operand : result.operands) {
+			size += operand.CalcMemoryUsage ();
+		}
+		return size;
+	});
+	return resultCache;
+}
+
+static Modeler::ContentHash GetBooleanOperationHash (BooleanOperation operation, const std::vector<const Modeler::Mesh*>& operands)
+{
+	Modeler::ContentHash hash;
+	hash.Add ((int) operation);
+	hash.Add (operands.size ());
+	for (const Modeler::Mesh* operand : operands) {
+		hash.Add (operand->CalcContentHash ());
+	}
+	return hash;
+}
+
+static bool IsCachedBooleanOperation (const CachedBooleanResult& cachedResult, BooleanOperation operation, const std::vector<const Modeler::Mesh*>& operands)
+{
+	if (cachedResult.operation != operation || cachedResult.operands.size () != operands.size ()) {
+		return false;
+	}
+	for (size_t i = 0; i < operands.size (); i++) {
+		if (!cachedResult.operands[i].IsIdentical (*operands[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool GetCachedBooleanResult (const Modeler::ContentHash& hash, BooleanOperation operation, const std::vector<const Modeler::Mesh*>& operands, Modeler::Mesh& resultMesh, BooleanDiagnostic& diagnostic)
+{
+	CachedBooleanResult cachedResult;
+	if (!GetBooleanResultCache ().Get (hash, cachedResult)) {
+		return false;
+	}
+	if (!IsCachedBooleanOperation (cachedResult, operation, operands)) {
+		return false;
+	}
+	resultMesh = cachedResult.mesh;
+	if (!cachedResult.success) {
+		diagnostic = BooleanDiagnostic (BooleanDiagnostic::Status::CalculationFailed, 0, Modeler::MeshValidation ());
+	}
+	return true;
+}
+
+static void AddCachedBooleanResult (const Modeler::ContentHash& hash, BooleanOperation operation, const std::vector<const Modeler::Mesh*>& operands, bool success, const Modeler::Mesh& resultMesh)
+{
+	CachedBooleanResult cachedResult { operation, {}, success, success ? resultMesh : Modeler::Mesh () };
+	for (const Modeler::Mesh* operand : operands) {
+		cachedResult.operands.push_back (*operand);
+	}
+	GetBooleanResultCache ().Add (hash, cachedResult);
+}
+
+static bool ValidateOperand (const Modeler::Mesh& mesh, size_t operand, BooleanDiagnostic& diagnostic)
+{
+	Modeler::MeshValidation validation = Modeler::ValidateMeshCached (mesh);
+	if (!validation.IsValid ()) {
+		diagnostic = BooleanDiagnostic (BooleanDiagnostic::Status::InvalidOperand, operand, validation);
+		return false;
+	}
+	return true;
+}
+
+// cancelled results are not cached, the next evaluation calculates them again
+static bool MeshBooleanOperation (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, BooleanOperation operation, Modeler::Mesh& resultMesh, BooleanDiagnostic& diagnostic, Modeler::OperationProgress* progress)
+{
+	diagnostic = BooleanDiagnostic ();
+	std::vector<const Modeler::Mesh*> operands = { &aMesh, &bMesh };
+	Modeler::ContentHash hash = GetBooleanOperationHash (operation, operands);
+	if (GetCachedBooleanResult (hash, operation, operands, resultMesh, diagnostic)) {
+		return diagnostic.status == BooleanDiagnostic::Status::Success;
+	}
+
+	if (!ValidateOperand (aMesh, 0, diagnostic) || !ValidateOperand (bMesh, 1, diagnostic)) {
+		return false;
+	}
+	bool success = CalculateMeshBooleanOperation (aMesh, bMesh, operation, resultMesh, progress);
+	if (Modeler::IsOperationCancelled (progress)) {
+		diagnostic = BooleanDiagnostic (BooleanDiagnostic::Status::Cancelled, 0, Modeler::MeshValidation ());
+		resultMesh.Clear ();
+		return false;
+	}
+	AddCachedBooleanResult (hash, operation, operands, success, resultMesh);
+	if (!success) {
+		diagnostic = BooleanDiagnostic (BooleanDiagnostic::Status::CalculationFailed, 0, Modeler::MeshValidation ());
+		return false;
+	}
+	Modeler::SetOperationProgress (progress, 1.0);
+	return true;
+}
+
+static bool MeshBooleanOperation (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, BooleanOperation operation, Modeler::Mesh& resultMesh)
+{
+	BooleanDiagnostic diagnostic;
+	return MeshBooleanOperation (aMesh, bMesh, operation, resultMesh, diagnostic, nullptr);
+}
+
+// Pairwise unions are cached too, so after changing one operand only the
+// results on its path to the root of the reduction tree are calculated again.
+static bool CalculateCachedMeshUnion (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, Modeler::Mesh& resultMesh, Modeler::OperationProgress* progress)
+{
+	std::vector<const Modeler::Mesh*> operands = { &aMesh, &bMesh };
+	Modeler::ContentHash hash = GetBooleanOperationHash (BooleanOperation::Union, operands);
+	BooleanDiagnostic diagnostic;
+	if (GetCachedBooleanResult (hash, BooleanOperation::Union, operands, resultMesh, diagnostic)) {
+		return diagnostic.status == BooleanDiagnostic::Status::Success;
+	}
+	bool success = CalculateMeshBooleanOperation (aMesh, bMesh, BooleanOperation::Union, resultMesh, progress);
+	if (Modeler::IsOperationCancelled (progress)) {
+		return false;
+	}
+	AddCachedBooleanResult (hash, BooleanOperation::Union, operands, success, resultMesh);
+	return success;
+}
+
+// Every cluster of touching operands is reduced with a balanced tree, the
+// unions of a tree level are independent, so they run in parallel together
+// with the levels of the other clusters. Each calculation protects the FPU
+// rounding mode of its own thread. Clusters are separated by a gap, so the
+// union of their results is their concatenation. The progress is the ratio
+// of the calculated pairwise unions, the parallel unions only check the
+// cancellation, so their stages do not report into the same progress.
+static bool CalculateMeshUnionTree (const std::vector<Modeler::Mesh>& meshes, Modeler::Mesh& resultMesh, size_t& failedOperand, Modeler::OperationProgress* progress)
+{
+	class ReductionNode
+	{
+	public:
+		Modeler::Mesh	mesh;
+		size_t			firstOperand;
+	};
+
+	std::vector<std::vector<size_t>> clusters = Modeler::GetMeshClusters (meshes);
+	std::vector<std::vector<ReductionNode>> levels;
+	size_t unionCount = 0;
+	for (const std::vector<size_t>& cluster : clusters) {
+		std::vector<ReductionNode> level;
+		for (size_t index : cluster) {
+			level.push_back (ReductionNode { meshes[index], index });
+		}
+		levels.push_back (level);
+		unionCount += cluster.size () - 1;
+	}
+
+	std::atomic<size_t> calculatedUnionCount (0);
+
+	while (true) {
+		std::vector<std::pair<size_t, size_t>> tasks;
+		std::vector<std::vector<ReductionNode>> nextLevels (levels.size ());
+		for (size_t i = 0; i < levels.size (); i++) {
+			const std::vector<ReductionNode>& level = levels[i];
+			nextLevels[i].resize ((level.size () + 1) / 2);
+			for (size_t j = 0; j + 1 < level.size (); j += 2) {
+				tasks.push_back ({ i, j });
+			}
+			if (level.size () % 2 == 1) {
+				nextLevels[i].back () = level.back ();
+			}
+		}
+		if (tasks.empty ()) {
+			break;
+		}
+
+		std::vector<char> succeeded (tasks.size (), 0);
+		Modeler::RunParallelTasks (tasks.size (), 0, [&] (size_t taskIndex) {
+			if (Modeler::IsOperationCancelled (progress)) {
+				return;
+			}
+			const std::vector<ReductionNode>& level = levels[tasks[taskIndex].first];
+			size_t first = tasks[taskIndex].second;
+			ReductionNode& node = nextLevels[tasks[taskIndex].first][first / 2];
+			node.firstOperand = level[first].firstOperand;
+			Modeler::OperationProgress taskProgress (nullptr, [=] () {
+				return Modeler::IsOperationCancelled (progress);
+			});
+			try {
+				succeeded[taskIndex] = CalculateCachedMeshUnion (level[first].mesh, level[first + 1].mesh, node.mesh, &taskProgress) ? 1 : 0;
+			} catch (...) {
+				// an exception fails only this union, so the failed operand can be reported
+				succeeded[taskIndex] = 0;
+			}
+			size_t calculated = ++calculatedUnionCount;
+			Modeler::SetOperationProgress (progress, (double) calculated / (double) unionCount);
+		});
+		if (Modeler::IsOperationCancelled (progress)) {
+			return false;
+		}
+		for (size_t i = 0; i < tasks.size (); i++) {
+			if (!succeeded[i]) {
+				const std::vector<ReductionNode>& level = levels[tasks[i].first];
+				failedOperand = level[tasks[i].second + 1].firstOperand;
+				return false;
+			}
+		}
+		levels = std::move (nextLevels);
+	}
+
+	if (levels.size () == 1) {
+		resultMesh = levels[0][0].mesh;
+	} else {
+		std::vector<Modeler::Mesh> clusterMeshes;
+		for (const std::vector<ReductionNode>& level : levels) {
+			clusterMeshes.push_back (level[0].mesh);
+		}
+		resultMesh = Modeler::MergeMeshes (clusterMeshes);
+	}
+	return true;
+}
+
+// Exact results of shape operations are cached the same way. An exact operand
+// is identified by its exact mesh and transformation, other operands by their
+// mesh, and these are kept with the result to compare them on every hit. Exact
+// operands are referenced weakly, so an entry matches only while its exact
+// operands exist.
+class CachedExactOperand
+{
+public:
+	bool							isExact;
+	std::weak_ptr<const ExactMesh>	exactMesh;
+	glm::dmat4						transformation;
+	Modeler::Mesh					mesh;
+};
+
+class CachedExactResult
+{
+public:
+	BooleanOperation					operation;
+	std::vector<CachedExactOperand>		operands;
+	std::shared_ptr<const ExactMesh>	exactMesh;
+};
+
+using ExactMeshCache = Modeler::LRUCache<Modeler::ContentHash, CachedExactResult>;
+
+static ExactMeshCache& GetExactMeshCache ()
+{
+	static ExactMeshCache exactMeshCache (MaxCachedResultSize, [] (const CachedExactResult& result) {
+		size_t size = sizeof (CachedExactResult) + (result.exactMesh != nullptr ? result.exactMesh->CalcMemoryUsage () : 0);
+		for (const CachedExactOperand& operand : result.operands) {
+			size += sizeof (CachedExactOperand) + (operand.isExact ? 0 : operand.mesh.CalcMemoryUsage ());
+		}
+		return size;
+	});
+	return exactMeshCache;
+}
+
+class ExactOperand
+{
+public:
+	ExactOperand (const Modeler::ShapeConstPtr& shape) :
+		exactShape (std::dynamic_pointer_cast<const ExactMeshShape> (shape)),
+		mesh (),
+		hash ()
+	{
+		if (exactShape != nullptr) {
+			hash.Add (exactShape->GetExactMesh ()->hash);
+			const glm::dmat4& transformation = exactShape->GetTransformation ();
+			for (glm::length_t i = 0; i < 4; i++) {
+				for (glm::length_t j = 0; j < 4; j++) {
+					hash.Add (transformation[i][j]);
+				}
+			}
+		} else {
+			mesh = shape->GenerateMesh ();
+			hash.Add (mesh.CalcContentHash ());
+		}
+	}
+
+	bool Validate (size_t operand, BooleanDiagnostic& diagnostic) const
+	{
+		return exactShape != nullptr || ValidateOperand (mesh, operand, diagnostic);
+	}
+
+	std::shared_ptr<ExactMesh> CreateExactMesh (NormalDirection normalDir) const
+	{
+		CGAL::Protect_FPU_rounding<true> protect (CGAL_FE_UPWARD);
+		if (exactShape != nullptr) {
+			return std::shared_ptr<ExactMesh> (new ExactMesh (*exactShape->GetExactMesh (), exactShape->GetTransformation (), normalDir));
+		}
+		return std::shared_ptr<ExactMesh> (new ExactMesh (mesh, normalDir));
+	}
+
+	CachedExactOperand GetCachedOperand () const
+	{
+		if (exactShape != nullptr) {
+			return CachedExactOperand { true, exactShape->GetExactMesh (), exactShape->GetTransformation (), Modeler::Mesh () };
+		}
+		return CachedExactOperand { false, std::weak_ptr<const ExactMesh> (), glm::dmat4 (1.0), mesh };
+	}
+
+	bool IsCachedOperand (const CachedExactOperand& cachedOperand) const
+	{
+		if (exactShape != nullptr) {
+			return cachedOperand.isExact && cachedOperand.exactMesh.lock () == exactShape->GetExactMesh () && cachedOperand.transformation == exactShape->GetTransformation ();
+		}
+		return !cachedOperand.isExact && cachedOperand.mesh.IsIdentical (mesh);
+	}
+
+	std::shared_ptr<const ExactMeshShape>	exactShape;
+	Modeler::Mesh							mesh;
+	Modeler::ContentHash					hash;
+};
+
+static Modeler::ContentHash GetExactOperationHash (BooleanOperation operation, const std::vector<ExactOperand>& operands)
+{
+	Modeler::ContentHash hash;
+	hash.Add ((int) operation);
+	hash.Add (operands.size ());
+	for (const ExactOperand& operand : operands) {
+		hash.Add (operand.hash);
+	}
+	return hash;
+}
+
+static bool GetCachedExactResult (const Modeler::ContentHash& hash, BooleanOperation operation, const std::vector<ExactOperand>& operands, std::shared_ptr<const ExactMesh>& resultExactMesh)
+{
+	CachedExactResult cachedResult;
+	if (!GetExactMeshCache ().Get (hash, cachedResult)) {
+		return false;
+	}
+	if (cachedResult.operation != operation || cachedResult.operands.size () != operands.size ()) {
+		return false;
+	}
+	for (size_t i = 0; i < operands.size (); i++) {
+		if (!operands[i].IsCachedOperand (cachedResult.operands[i])) {
+			return false;
+		}
+	}
+	resultExactMesh = cachedResult.exactMesh;
+	return true;
+}
+
+static void AddCachedExactResult (const Modeler::ContentHash& hash, BooleanOperation operation, const std::vector<ExactOperand>& operands, const std::shared_ptr<const ExactMesh>& resultExactMesh)
+{
+	CachedExactResult cachedResult { operation, {}, resultExactMesh };
+	for (const ExactOperand& operand : operands) {
+		cachedResult.operands.push_back (operand.GetCachedOperand ());
+	}
+	GetExactMeshCache ().Add (hash, cachedResult);
+}
+
+static std::shared_ptr<ExactMesh> CalculateExactMeshBooleanOperation (const std::shared_ptr<ExactMesh>& aExactMesh, const std::shared_ptr<ExactMesh>& bExactMesh, BooleanOperation operation, Modeler::OperationProgress* progress)
+{
+	CGAL::Protect_FPU_rounding<true> protect (CGAL_FE_UPWARD);
+
+	// a difference with a separated operand is the first operand itself
+	CGAL::Bbox_3 aBoundingBox = CGAL::Polygon_mesh_processing::bbox (aExactMesh->cgalMesh);
+	CGAL::Bbox_3 bBoundingBox = CGAL::Polygon_mesh_processing::bbox (bExactMesh->cgalMesh);
+	if (operation == BooleanOperation::Difference && !CGAL::do_overlap (aBoundingBox, bBoundingBox)) {
+		return aExactMesh;
+	}
+
+	std::shared_ptr<ExactMesh> resultExactMesh (new ExactMesh ());
+	CGALMeshVisitor visitor (progress);
+	visitor.properties.insert ({ &aExactMesh->cgalMesh, aExactMesh->propertyMap });
+	visitor.properties.insert ({ &bExactMesh->cgalMesh, bExactMesh->propertyMap });
+	visitor.properties.insert ({ &resultExactMesh->cgalMesh, resultExactMesh->propertyMap });
+
+	bool opResult = false;
+	try {
+		if (operation == BooleanOperation::Difference) {
+			opResult = CGAL::Polygon_mesh_processing::corefine_and_compute_difference (aExactMesh->cgalMesh, bExactMesh->cgalMesh, resultExactMesh->cgalMesh, CGAL::Polygon_mesh_processing::parameters::visitor (visitor));
+		} else if (operation == BooleanOperation::Intersection) {
+			opResult = CGAL::Polygon_mesh_processing::corefine_and_compute_intersection (aExactMesh->cgalMesh, bExactMesh->cgalMesh, resultExactMesh->cgalMesh, CGAL::Polygon_mesh_processing::parameters::visitor (visitor));
+		} else if (operation == BooleanOperation::Union) {
+			opResult = CGAL::Polygon_mesh_processing::corefine_and_compute_union (aExactMesh->cgalMesh, bExactMesh->cgalMesh, resultExactMesh->cgalMesh, CGAL::Polygon_mesh_processing::parameters::visitor (visitor));
+		}
+	} catch (...) {
+		opResult = false;
+	}
+	if (!opResult) {
 		return nullptr;
 	}
-	return std::shared_ptr<Modeler::MeshShape> (new Modeler::MeshShape (glm::dmat4 (1.0), resultMesh));
+
+	resultExactMesh->sourceMeshes = aExactMesh->sourceMeshes;
+	resultExactMesh->sourceMeshes.insert (resultExactMesh->sourceMeshes.end (), bExactMesh->sourceMeshes.begin (), bExactMesh->sourceMeshes.end ());
+	return resultExactMesh;
+}
+
+static Modeler::ShapePtr ShapeBooleanOperation (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape, BooleanOperation operation, BooleanDiagnostic& diagnostic, Modeler::OperationProgress* progress)
+{
+	diagnostic = BooleanDiagnostic ();
+	std::vector<ExactOperand> operands = { ExactOperand (aShape), ExactOperand (bShape) };
+	Modeler::ContentHash hash = GetExactOperationHash (operation, operands);
+
+	std::shared_ptr<const ExactMesh> resultExactMesh = nullptr;
+	if (!GetCachedExactResult (hash, operation, operands, resultExactMesh)) {
+		if (!operands[0].Validate (0, diagnostic) || !operands[1].Validate (1, diagnostic)) {
+			return nullptr;
+		}
+		std::shared_ptr<ExactMesh> aExactMesh = operands[0].CreateExactMesh (NormalDirection::Original);
+		std::shared_ptr<ExactMesh> bExactMesh = operands[1].CreateExactMesh (operation == BooleanOperation::Difference ? NormalDirection::Reversed : NormalDirection::Original);
+		std::shared_ptr<ExactMesh> calculatedExactMesh = CalculateExactMeshBooleanOperation (aExactMesh, bExactMesh, operation, progress);
+		if (Modeler::IsOperationCancelled (progress)) {
+			diagnostic = BooleanDiagnostic (BooleanDiagnostic::Status::Cancelled, 0, Modeler::MeshValidation ());
+			return nullptr;
+		}
+		if (calculatedExactMesh != nullptr) {
+			calculatedExactMesh->hash = hash;
+		}
+		resultExactMesh = calculatedExactMesh;
+		AddCachedExactResult (hash, operation, operands, resultExactMesh);
+	}
+	if (resultExactMesh == nullptr) {
+		diagnostic = BooleanDiagnostic (BooleanDiagnostic::Status::CalculationFailed, 0, Modeler::MeshValidation ());
+		return nullptr;
+	}
+	Modeler::SetOperationProgress (progress, 1.0);
+	return Modeler::ShapePtr (new ExactMeshShape (glm::dmat4 (1.0), resultExactMesh));
+}
+
+// Copies the vertices and the faces with their origin one by one. The source
+// mesh has no garbage, so its vertex indices are continuous.
+static bool AppendExactMesh (const ExactMesh& source, ExactMesh& result)
+{
+	std::vector<CGAL_Mesh::Vertex_index> vertexMap;
+	vertexMap.reserve (source.cgalMesh.number_of_vertices ());
+	for (CGAL_Mesh::Vertex_index vertIndex : source.cgalMesh.vertices ()) {
+		vertexMap.push_back (result.cgalMesh.add_vertex (source.cgalMesh.point (vertIndex)));
+	}
+	for (CGAL_Mesh::Face_index faceIndex : source.cgalMesh.faces ()) {
+		std::vector<CGAL_Mesh::Vertex_index> vertices;
+		for (auto halfEdgeIndex : halfedges_around_face (source.cgalMesh.halfedge (faceIndex), source.cgalMesh)) {
+			vertices.push_back (vertexMap[(size_t) target (halfEdgeIndex, source.cgalMesh)]);
+		}
+		CGAL_Mesh::Face_index newFaceIndex = result.cgalMesh.add_face (vertices);
+		if (newFaceIndex == CGAL_Mesh::null_face ()) {
+			return false;
+		}
+		result.propertyMap[newFaceIndex] = source.propertyMap[faceIndex];
+	}
+	return true;
+}
+
+// Separated operands have no surface contact, so their union is the
+// concatenation of their exact meshes, and no corefinement is needed.
+static std::shared_ptr<ExactMesh> ConcatenateExactMeshes (const std::vector<std::shared_ptr<ExactMesh>>& exactMeshes)
+{
+	CGAL::Protect_FPU_rounding<true> protect (CGAL_FE_UPWARD);
+	std::shared_ptr<ExactMesh> resultExactMesh (new ExactMesh ());
+	for (const std::shared_ptr<ExactMesh>& exactMesh : exactMeshes) {
+		if (exactMesh->cgalMesh.has_garbage ()) {
+			exactMesh->cgalMesh.collect_garbage ();
+		}
+		if (!AppendExactMesh (*exactMesh, *resultExactMesh)) {
+			return nullptr;
+		}
+		resultExactMesh->sourceMeshes.insert (resultExactMesh->sourceMeshes.end (), exactMesh->sourceMeshes.begin (), exactMesh->sourceMeshes.end ());
+	}
+	return resultExactMesh;
+}
+
+static Modeler::ShapePtr ConcatenateShapes (const std::vector<Modeler::ShapeConstPtr>& shapes, BooleanDiagnostic& diagnostic)
+{
+	std::vector<ExactOperand> operands;
+	for (const Modeler::ShapeConstPtr& shape : shapes) {
+		operands.push_back (ExactOperand (shape));
+	}
+	Modeler::ContentHash hash = GetExactOperationHash (BooleanOperation::Union, operands);
+
+	std::shared_ptr<const ExactMesh> resultExactMesh = nullptr;
+	if (!GetCachedExactResult (hash, BooleanOperation::Union, operands, resultExactMesh)) {
+		std::vector<std::shared_ptr<ExactMesh>> exactMeshes;
+		for (size_t i = 0; i < operands.size (); i++) {
+			if (!operands[i].Validate (i, diagnostic)) {
+				return nullptr;
+			}
+			exactMeshes.push_back (operands[i].CreateExactMesh (NormalDirection::Original));
+		}
+		std::shared_ptr<ExactMesh> concatenatedExactMesh = ConcatenateExactMeshes (exactMeshes);
+		if (concatenatedExactMesh != nullptr) {
+			concatenatedExactMesh->hash = hash;
+		}
+		resultExactMesh = concatenatedExactMesh;
+		AddCachedExactResult (hash, BooleanOperation::Union, operands, resultExactMesh);
+	}
+	if (resultExactMesh == nullptr) {
+		diagnostic = BooleanDiagnostic (BooleanDiagnostic::Status::CalculationFailed, 0, Modeler::MeshValidation ());
+		return nullptr;
+	}
+	return Modeler::ShapePtr (new ExactMeshShape (glm::dmat4 (1.0), resultExactMesh));
+}
+
+ExactMeshShape::ExactMeshShape (const glm::dmat4& transformation, const std::shared_ptr<const ExactMesh>& exactMesh) :
+	Modeler::Shape (transformation),
+	exactMesh (exactMesh)
+{
+}
+
+ExactMeshShape::~ExactMeshShape ()
+{
+}
+
+bool ExactMeshShape::Check () const
+{
+	return exactMesh != nullptr;
+}
+
+Modeler::ShapePtr ExactMeshShape::Clone () const
+{
+	return Modeler::ShapePtr (new ExactMeshShape (*this));
+}
+
+std::wstring ExactMeshShape::ToString () const
+{
+	return L"Exact Mesh";
+}
+
+Modeler::Mesh ExactMeshShape::GenerateMesh () const
+{
+	Modeler::Mesh result = exactMesh->GetMesh ();
+	result.AddTransformation (transformation);
+	return result;
+}
+
+const std::shared_ptr<const ExactMesh>& ExactMeshShape::GetExactMesh () const
+{
+	return exactMesh;
+}
+
+BooleanDiagnostic::BooleanDiagnostic () :
+	BooleanDiagnostic (Status::Success, 0, Modeler::MeshValidation ())
+{
+}
+
+BooleanDiagnostic::BooleanDiagnostic (Status status, size_t operand, const Modeler::MeshValidation& validation) :
+	status (status),
+	operand (operand),
+	validation (validation)
+{
+}
+
+std::wstring BooleanDiagnostic::ToString () const
+{
+	switch (status) {
+		case Status::Success:
+			return L"success";
+		case Status::InvalidOperand:
+			return L"invalid operand " + std::to_wstring (operand + 1) + L": " + validation.ToString ();
+		case Status::CalculationFailed:
+			return L"calculation failed";
+		case Status::Cancelled:
+			return L"cancelled";
+	}
+	return L"";
 }
 
 bool MeshDifference (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, Modeler::Mesh& resultMesh)
@@ -332,52 +1259,208 @@ bool MeshUnion (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, Modeler:
 
 bool MeshUnion (const std::vector<Modeler::Mesh>& meshes, Modeler::Mesh& resultMesh)
 {
+	BooleanDiagnostic diagnostic;
+	return MeshUnion (meshes, resultMesh, diagnostic);
+}
+
+bool MeshDifference (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, Modeler::Mesh& resultMesh, BooleanDiagnostic& diagnostic)
+{
+	return MeshBooleanOperation (aMesh, bMesh, BooleanOperation::Difference, resultMesh, diagnostic, nullptr);
+}
+
+bool MeshIntersection (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, Modeler::Mesh& resultMesh, BooleanDiagnostic& diagnostic)
+{
+	return MeshBooleanOperation (aMesh, bMesh, BooleanOperation::Intersection, resultMesh, diagnostic, nullptr);
+}
+
+bool MeshUnion (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, Modeler::Mesh& resultMesh, BooleanDiagnostic& diagnostic)
+{
+	return MeshBooleanOperation (aMesh, bMesh, BooleanOperation::Union, resultMesh, diagnostic, nullptr);
+}
+
+bool MeshUnion (const std::vector<Modeler::Mesh>& meshes, Modeler::Mesh& resultMesh, BooleanDiagnostic& diagnostic)
+{
+	return MeshUnion (meshes, resultMesh, diagnostic, nullptr);
+}
+
+bool MeshDifference (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, Modeler::Mesh& resultMesh, BooleanDiagnostic& diagnostic, Modeler::OperationProgress* progress)
+{
+	return MeshBooleanOperation (aMesh, bMesh, BooleanOperation::Difference, resultMesh, diagnostic, progress);
+}
+
+bool MeshIntersection (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, Modeler::Mesh& resultMesh, BooleanDiagnostic& diagnostic, Modeler::OperationProgress* progress)
+{
+	return MeshBooleanOperation (aMesh, bMesh, BooleanOperation::Intersection, resultMesh, diagnostic, progress);
+}
+
+bool MeshUnion (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, Modeler::Mesh& resultMesh, BooleanDiagnostic& diagnostic, Modeler::OperationProgress* progress)
+{
+	return MeshBooleanOperation (aMesh, bMesh, BooleanOperation::Union, resultMesh, diagnostic, progress);
+}
+
+bool MeshUnion (const std::vector<Modeler::Mesh>& meshes, Modeler::Mesh& resultMesh, BooleanDiagnostic& diagnostic, Modeler::OperationProgress* progress)
+{
+	diagnostic = BooleanDiagnostic ();
 	if (meshes.empty ()) {
 		return false;
 	}
-	resultMesh = meshes[0];
-	for (size_t i = 1; i < meshes.size (); i++) {
-		Modeler::Mesh aMesh = resultMesh;
-		const Modeler::Mesh& bMesh = meshes[i];
-		resultMesh.Clear ();
-		if (!MeshUnion (aMesh, bMesh, resultMesh)) {
+	if (meshes.size () == 1) {
+		resultMesh = meshes[0];
+		return true;
+	}
+
+	std::vector<const Modeler::Mesh*> operands;
+	for (const Modeler::Mesh& mesh : meshes) {
+		operands.push_back (&mesh);
+	}
+	Modeler::ContentHash hash = GetBooleanOperationHash (BooleanOperation::Union, operands);
+	if (GetCachedBooleanResult (hash, BooleanOperation::Union, operands, resultMesh, diagnostic)) {
+		return diagnostic.status == BooleanDiagnostic::Status::Success;
+	}
+
+	// intermediate results come from the exact calculation, so only the
+	// original operands are validated
+	for (size_t i = 0; i < meshes.size (); i++) {
+		if (!ValidateOperand (meshes[i], i, diagnostic)) {
+			return false;
+		}
+	}
+
+	size_t failedOperand = 0;
+	if (!CalculateMeshUnionTree (meshes, resultMesh, failedOperand, progress)) {
+		if (Modeler::IsOperationCancelled (progress)) {
+			diagnostic = BooleanDiagnostic (BooleanDiagnostic::Status::Cancelled, 0, Modeler::MeshValidation ());
 			resultMesh.Clear ();
 			return false;
 		}
+		diagnostic = BooleanDiagnostic (BooleanDiagnostic::Status::CalculationFailed, failedOperand, Modeler::MeshValidation ());
+		resultMesh.Clear ();
+		AddCachedBooleanResult (hash, BooleanOperation::Union, operands, false, resultMesh);
+		return false;
 	}
+	AddCachedBooleanResult (hash, BooleanOperation::Union, operands, true, resultMesh);
+	Modeler::SetOperationProgress (progress, 1.0);
 	return true;
 }
 
+void ClearBooleanResultCache ()
+{
+	GetBooleanResultCache ().Clear ();
+	GetExactMeshCache ().Clear ();
+}
+
 Modeler::ShapePtr ShapeDifference (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape)
 {
-	return ShapeBooleanOperation (aShape, bShape, BooleanOperation::Difference);
+	return ShapeDifference (aShape, bShape, nullptr);
 }
 
 Modeler::ShapePtr ShapeIntersection (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape)
 {
-	return ShapeBooleanOperation (aShape, bShape, BooleanOperation::Intersection);
+	return ShapeIntersection (aShape, bShape, nullptr);
 }
 
 Modeler::ShapePtr ShapeUnion (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape)
 {
-	return ShapeBooleanOperation (aShape, bShape, BooleanOperation::Union);
+	return ShapeUnion (aShape, bShape, nullptr);
 }
 
 Modeler::ShapePtr ShapeUnion (const std::vector<Modeler::ShapeConstPtr>& shapes)
 {
-	//if (shapes.empty ()) {
-	//	return nullptr;
-	//}
-	//if (shapes.size () == 1) {
-	//	return shapes[0]->Clone ();
-	//}
+	return ShapeUnion (shapes, nullptr);
+}
+
+Modeler::ShapePtr ShapeDifference (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape, Modeler::OperationProgress* progress)
+{
+	BooleanDiagnostic diagnostic;
+	return ShapeDifference (aShape, bShape, diagnostic, progress);
+}
+
+Modeler::ShapePtr ShapeIntersection (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape, Modeler::OperationProgress* progress)
+{
+	BooleanDiagnostic diagnostic;
+	return ShapeIntersection (aShape, bShape, diagnostic, progress);
+}
 
+Modeler::ShapePtr ShapeUnion (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape, Modeler::OperationProgress* progress)
+{
+	BooleanDiagnostic diagnostic;
+	return ShapeUnion (aShape, bShape, diagnostic, progress);
+}
+
+Modeler::ShapePtr ShapeUnion (const std::vector<Modeler::ShapeConstPtr>& shapes, Modeler::OperationProgress* progress)
+{
+	BooleanDiagnostic diagnostic;
+	return ShapeUnion (shapes, diagnostic, progress);
+}
+
+Modeler::ShapePtr ShapeDifference (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape, BooleanDiagnostic& diagnostic, Modeler::OperationProgress* progress)
+{
+	return ShapeBooleanOperation (aShape, bShape, BooleanOperation::Difference, diagnostic, progress);
+}
+
+Modeler::ShapePtr ShapeIntersection (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape, BooleanDiagnostic& diagnostic, Modeler::OperationProgress* progress)
+{
+	return ShapeBooleanOperation (aShape, bShape, BooleanOperation::Intersection, diagnostic, progress);
+}
+
+Modeler::ShapePtr ShapeUnion (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape, BooleanDiagnostic& diagnostic, Modeler::OperationProgress* progress)
+{
+	return ShapeBooleanOperation (aShape, bShape, BooleanOperation::Union, diagnostic, progress);
+}
+
+Modeler::ShapePtr ShapeUnion (const std::vector<Modeler::ShapeConstPtr>& shapes, BooleanDiagnostic& diagnostic, Modeler::OperationProgress* progress)
+{
+	diagnostic = BooleanDiagnostic ();
+	if (shapes.empty ()) {
+		return nullptr;
+	}
+
+	// meshes of exact operands are converted from their exact surface, which
+	// can fail, the failed operand is reported
 	std::vector<Modeler::Mesh> meshes;
-	for (const Modeler::ShapeConstPtr& shape : shapes) {
-		meshes.push_back (shape->GenerateMesh ());
+	for (size_t i = 0; i < shapes.size (); i++) {
+		try {
+			meshes.push_back (shapes[i]->GenerateMesh ());
+		} catch (const std::exception&) {
+			diagnostic = BooleanDiagnostic (BooleanDiagnostic::Status::CalculationFailed, i, Modeler::MeshValidation ());
+			return nullptr;
+		}
 	}
+
+	// exact operands are united one by one to keep the result exact, but only
+	// within clusters of touching operands, the clusters are separated by a
+	// gap, so their results are concatenated
+	bool hasExactOperand = std::any_of (shapes.begin (), shapes.end (), [] (const Modeler::ShapeConstPtr& shape) {
+		return std::dynamic_pointer_cast<const ExactMeshShape> (shape) != nullptr;
+	});
+	if (hasExactOperand) {
+		std::vector<Modeler::ShapeConstPtr> clusterShapes;
+		size_t calculatedUnionCount = 0;
+		for (const std::vector<size_t>& cluster : Modeler::GetMeshClusters (meshes)) {
+			Modeler::ShapePtr clusterShape = shapes[cluster[0]]->Clone ();
+			for (size_t i = 1; i < cluster.size (); i++) {
+				Modeler::OperationProgress stepProgress (progress, (double) calculatedUnionCount / (double) (shapes.size () - 1), (double) (calculatedUnionCount + 1) / (double) (shapes.size () - 1));
+				clusterShape = ShapeBooleanOperation (clusterShape, shapes[cluster[i]], BooleanOperation::Union, diagnostic, &stepProgress);
+				calculatedUnionCount++;
+				if (clusterShape == nullptr) {
+					// only original operands are validated, the first operand is an
+					// original operand only in the first step, a failed calculation is
+					// reported on the operand, which could not be united
+					bool isFirstOperandInvalid = (diagnostic.status == BooleanDiagnostic::Status::InvalidOperand && diagnostic.operand == 0);
+					diagnostic.operand = (isFirstOperandInvalid ? cluster[0] : cluster[i]);
+					return nullptr;
+				}
+			}
+			clusterShapes.push_back (clusterShape);
+		}
+		if (clusterShapes.size () == 1) {
+			return clusterShapes[0]->Clone ();
+		}
+		return ConcatenateShapes (clusterShapes, diagnostic);
+	}
+
 	Modeler::Mesh resultMesh;
-	if (!MeshUnion (meshes, resultMesh)) {
+	if (!MeshUnion (meshes, resultMesh, diagnostic, progress)) {
 		return nullptr;
 	}
 	return std::shared_ptr<Modeler::MeshShape> (new Modeler::MeshShape (glm::dmat4 (1.0), resultMesh));
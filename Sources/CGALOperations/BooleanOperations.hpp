@@ -3,22 +3,105 @@
 
 #include "Shape.hpp"
 #include "Mesh.hpp"
+#include "MeshValidation.hpp"
+#include "OperationProgress.hpp"
 
 #include <vector>
+#include <string>
+#include <memory>
 
 namespace CGALOperations
 {
 
+// Reason of a failed boolean operation. Operands are validated before the
+// exact calculation, so invalid operands are reported without running it.
+class BooleanDiagnostic
+{
+public:
+	enum class Status
+	{
+		Success,
+		InvalidOperand,
+		CalculationFailed,
+		Cancelled
+	};
+
+	BooleanDiagnostic ();
+	BooleanDiagnostic (Status status, size_t operand, const Modeler::MeshValidation& validation);
+
+	std::wstring				ToString () const;
+
+	Status						status;
+	size_t						operand;
+	Modeler::MeshValidation		validation;
+};
+
+class ExactMesh;
+
+// Result of an exact boolean operation on shapes. It keeps the exact surface
+// of the result with the origin of every face, so a following operation uses
+// it without rounding and conversion, and the mesh is generated only when it
+// is needed for rendering or export. Generating the mesh throws the exception
+// of the conversion if the exact surface can not be converted.
+class ExactMeshShape : public Modeler::Shape
+{
+public:
+	ExactMeshShape (const glm::dmat4& transformation, const std::shared_ptr<const ExactMesh>& exactMesh);
+	virtual ~ExactMeshShape ();
+
+	virtual bool						Check () const override;
+	virtual Modeler::ShapePtr			Clone () const override;
+	virtual std::wstring				ToString () const override;
+	virtual Modeler::Mesh				GenerateMesh () const override;
+
+	const std::shared_ptr<const ExactMesh>&	GetExactMesh () const;
+
+private:
+	std::shared_ptr<const ExactMesh>	exactMesh;
+};
+
 bool					MeshDifference (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, Modeler::Mesh& resultMesh);
 bool					MeshIntersection (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, Modeler::Mesh& resultMesh);
 bool					MeshUnion (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, Modeler::Mesh& resultMesh);
 bool					MeshUnion (const std::vector<Modeler::Mesh>& meshes, Modeler::Mesh& resultMesh);
 
+bool					MeshDifference (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, Modeler::Mesh& resultMesh, BooleanDiagnostic& diagnostic);
+bool					MeshIntersection (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, Modeler::Mesh& resultMesh, BooleanDiagnostic& diagnostic);
+bool					MeshUnion (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, Modeler::Mesh& resultMesh, BooleanDiagnostic& diagnostic);
+bool					MeshUnion (const std::vector<Modeler::Mesh>& meshes, Modeler::Mesh& resultMesh, BooleanDiagnostic& diagnostic);
+
+// The operations check the progress regularly, and stop with a cancelled
+// diagnostic when it is cancelled. The progress can be null.
+bool					MeshDifference (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, Modeler::Mesh& resultMesh, BooleanDiagnostic& diagnostic, Modeler::OperationProgress* progress);
+bool					MeshIntersection (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, Modeler::Mesh& resultMesh, BooleanDiagnostic& diagnostic, Modeler::OperationProgress* progress);
+bool					MeshUnion (const Modeler::Mesh& aMesh, const Modeler::Mesh& bMesh, Modeler::Mesh& resultMesh, BooleanDiagnostic& diagnostic, Modeler::OperationProgress* progress);
+bool					MeshUnion (const std::vector<Modeler::Mesh>& meshes, Modeler::Mesh& resultMesh, BooleanDiagnostic& diagnostic, Modeler::OperationProgress* progress);
+
+// Results of the operations are cached by the content hash of their operands
+// with a memory limit, and the operands are compared on every hit. The cache
+// can be cleared explicitly.
+void					ClearBooleanResultCache ();
+
+// Pairwise shape operations and unions with exact operands return an exact
+// mesh shape, unions of other shapes are calculated on their meshes.
 Modeler::ShapePtr		ShapeDifference (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape);
 Modeler::ShapePtr		ShapeIntersection (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape);
 Modeler::ShapePtr		ShapeUnion (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape);
 Modeler::ShapePtr		ShapeUnion (const std::vector<Modeler::ShapeConstPtr>& shapes);
 
+Modeler::ShapePtr		ShapeDifference (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape, Modeler::OperationProgress* progress);
+Modeler::ShapePtr		ShapeIntersection (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape, Modeler::OperationProgress* progress);
+Modeler::ShapePtr		ShapeUnion (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape, Modeler::OperationProgress* progress);
+Modeler::ShapePtr		ShapeUnion (const std::vector<Modeler::ShapeConstPtr>& shapes, Modeler::OperationProgress* progress);
+
+// The diagnostic tells the reason of a failed operation, the operand of a
+// failed union of many shapes is the index of the shape, which could not be
+// united with the others.
+Modeler::ShapePtr		ShapeDifference (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape, BooleanDiagnostic& diagnostic, Modeler::OperationProgress* progress);
+Modeler::ShapePtr		ShapeIntersection (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape, BooleanDiagnostic& diagnostic, Modeler::OperationProgress* progress);
+Modeler::ShapePtr		ShapeUnion (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape, BooleanDiagnostic& diagnostic, Modeler::OperationProgress* progress);
+Modeler::ShapePtr		ShapeUnion (const std::vector<Modeler::ShapeConstPtr>& shapes, BooleanDiagnostic& diagnostic, Modeler::OperationProgress* progress);
+
 }
 
 #endif
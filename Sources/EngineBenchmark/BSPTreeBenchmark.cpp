@@ -0,0 +1,116 @@
+#include "SimpleBenchmark.hpp"
+#include "BSPTree.hpp"
+
+#include <random>
+
+using namespace Geometry;
+
+namespace BSPTreeBenchmark
+{
+
+class ClipCounter : public BSPTriangleClipper
+{
+public:
+	ClipCounter () :
+		count (0)
+	{
+	}
+
+	virtual void FrontTrianglesFound (const TriangleCutList& triangles) override
+	{
+		count += triangles.GetSize ();
+	}
+
+	virtual void BackTrianglesFound (const TriangleCutList& triangles) override
+	{
+		count += triangles.GetSize ();
+	}
+
+	virtual void PlaneTrianglesFound (const TriangleCutList& triangles) override
+	{
+		count += triangles.GetSize ();
+	}
+
+	size_t count;
+};
+
+static std::vector<Triangle> GenerateTriangleSoup (size_t count, double extent, double triangleSize)
+{
+	std::mt19937 generator (42);
+	std::uniform_real_distribution<double> positionDistribution (0.0, extent);
+	std::uniform_real_distribution<double> offsetDistribution (-triangleSize, triangleSize);
+
+	std::vector<Triangle> triangles;
+	for (size_t i = 0; i < count; i++) {
+		glm::dvec3 center (positionDistribution (generator), positionDistribution (generator), positionDistribution (generator));
+		glm::dvec3 v1 = center + glm::dvec3 (offsetDistribution (generator), offsetDistribution (generator), offsetDistribution (generator));
+		glm::dvec3 v2 = center + glm::dvec3 (offsetDistribution (generator), offsetDistribution (generator), offsetDistribution (generator));
+		glm::dvec3 v3 = center + glm::dvec3 (offsetDistribution (generator), offsetDistribution (generator), offsetDistribution (generator));
+		triangles.push_back (Triangle (v1, v2, v3));
+	}
+	return triangles;
+}
+
+static std::vector<Triangle> GenerateLayers (size_t count, size_t trianglesPerLayer)
+{
+	std::vector<Triangle> triangles;
+	for (size_t i = 0; i < count; i++) {
+		double x = (double) (i % trianglesPerLayer);
+		double z = (double) (i / trianglesPerLayer);
+		triangles.push_back (Triangle (glm::dvec3 (x, 0.0, z), glm::dvec3 (x + 1.0, 0.0, z), glm::dvec3 (x, 1.0, z)));
+	}
+	return triangles;
+}
+
+BENCHMARK (BSPTreeBuild)
+{
+	for (size_t triangleCount : { 10000, 100000 }) {
+		std::vector<Triangle> soup = GenerateTriangleSoup (triangleCount, 100.0, 0.2);
+		std::vector<Triangle> layers = GenerateLayers (triangleCount, 100);
+		Measure ("incremental, soup, " + std::to_string (triangleCount) + " triangles", [&] () {
+			BSPTree tree;
+			for (const Triangle& triangle : soup) {
+				tree.AddTriangle (triangle);
+			}
+		});
+		Measure ("balanced, soup, " + std::to_string (triangleCount) + " triangles", [&] () {
+			BalancedBSPTree tree (soup);
+		});
+		Measure ("incremental, layers, " + std::to_string (triangleCount) + " triangles", [&] () {
+			BSPTree tree;
+			for (const Triangle& triangle : layers) {
+				tree.AddTriangle (triangle);
+			}
+		});
+		Measure ("balanced, layers, " + std::to_string (triangleCount) + " triangles", [&] () {
+			BalancedBSPTree tree (layers);
+		});
+	}
+}
+
+BENCHMARK (BSPTreeClip)
+{
+	std::vector<Triangle> input = GenerateTriangleSoup (100000, 100.0, 0.2);
+	std::vector<Triangle> clipTriangles = GenerateTriangleSoup (10000, 100.0, 0.5);
+
+	BSPTree incrementalTree;
+	for (const Triangle& triangle : input) {
+		incrementalTree.AddTriangle (triangle);
+	}
+	BalancedBSPTree balancedTree (input);
+
+	Measure ("incremental", [&] () {
+		ClipCounter counter;
+		for (const Triangle& triangle : clipTriangles) {
+			incrementalTree.ClipTriangle (triangle, counter);
+		}
+	});
+	Measure ("balanced", [&] () {
+		ClipCounter counter;
+		for (const Triangle& triangle : clipTriangles) {
+			balancedTree.ClipTriangle (triangle, counter);
+		}
+	});
+}
+
+}
@@ -0,0 +1,28 @@
+#include "SimpleBenchmark.hpp"
+#include "MeshGenerators.hpp"
+#include "BSPBooleanOperations.hpp"
+#include "BooleanOperations.hpp"
+
+using namespace Modeler;
+
+namespace BooleanBenchmark
+{
+
+BENCHMARK (BooleanDifference)
+{
+	for (int segmentation : { 20, 50 }) {
+		Mesh box = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 2.0, 2.0, 2.0);
+		Mesh sphere = GenerateSphere (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (1.0, 1.0, 1.0)), 1.2, segmentation, true);
+		std::string caseSuffix = ", " + std::to_string (sphere.GetGeometry ().TriangleCount ()) + " triangles";
+		Measure ("bsp" + caseSuffix, [&] () {
+			Mesh result;
+			BSPOperations::MeshDifference (box, sphere, result);
+		});
+		Measure ("cgal" + caseSuffix, [&] () {
+			Mesh result;
+			CGALOperations::MeshDifference (box, sphere, result);
+		});
+	}
+}
+
+}
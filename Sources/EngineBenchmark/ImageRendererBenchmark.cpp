@@ -0,0 +1,36 @@
+#include "SimpleBenchmark.hpp"
+#include "MeshGenerators.hpp"
+#include "ImageRenderer.hpp"
+#include "ParallelTasks.hpp"
+
+using namespace Modeler;
+
+namespace ImageRendererBenchmark
+{
+
+BENCHMARK (ImageRender)
+{
+	Model model;
+	model.AddMesh (GenerateBox (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (-5.0, -5.0, -1.0)), 10.0, 10.0, 1.0));
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			glm::dmat4 transformation = glm::translate (glm::dmat4 (1.0), glm::dvec3 (i * 2.0 - 3.0, j * 2.0 - 3.0, 0.8));
+			model.AddMesh (GenerateSphere (DefaultMaterial, transformation, 0.8, 40, true));
+		}
+	}
+
+	Camera camera (glm::dvec3 (-8.0, -12.0, 6.0), glm::dvec3 (0.0, 0.0, 0.0), glm::dvec3 (0.0, 0.0, 1.0), 45.0, 0.1, 1000.0);
+	ImageRenderer renderer (model);
+	std::vector<unsigned char> pixels (512 * 512 * 4);
+
+	unsigned int hardwareThreadCount = GetHardwareThreadCount ();
+	for (unsigned int threadCount = 1; threadCount <= hardwareThreadCount; threadCount *= 2) {
+		ImageRenderSettings settings;
+		settings.threadCount = threadCount;
+		Measure ("512x512, " + std::to_string (threadCount) + " threads", [&] () {
+			renderer.RenderImage (camera, 512, 512, settings, pixels.data ());
+		});
+	}
+}
+
+}
@@ -0,0 +1,26 @@
+#include "SimpleBenchmark.hpp"
+#include "MeshGenerators.hpp"
+#include "Interference.hpp"
+
+using namespace Modeler;
+
+namespace InterferenceBenchmark
+{
+
+BENCHMARK (MeshInterference)
+{
+	for (int side : { 10, 30 }) {
+		Model model;
+		for (int i = 0; i < side; i++) {
+			for (int j = 0; j < side; j++) {
+				glm::dmat4 transformation = glm::translate (glm::dmat4 (1.0), glm::dvec3 (i * 1.5, j * 1.5, 0.0));
+				model.AddMesh (GenerateSphere (DefaultMaterial, transformation, 0.8, 30, true));
+			}
+		}
+		Measure (std::to_string (side * side) + " spheres", [&] () {
+			GetMeshInterferences (model);
+		});
+	}
+}
+
+}
@@ -0,0 +1,25 @@
+#include "SimpleBenchmark.hpp"
+#include "MeshGenerators.hpp"
+#include "LoopSubdivision.hpp"
+#include "ParallelTasks.hpp"
+
+using namespace Modeler;
+
+namespace LoopSubdivisionBenchmark
+{
+
+BENCHMARK (LoopSubdivision)
+{
+	Mesh sphere = GenerateSphere (DefaultMaterial, glm::dmat4 (1.0), 1.0, 160, true);
+	std::string caseSuffix = ", " + std::to_string (sphere.GetGeometry ().TriangleCount ()) + " triangles";
+
+	unsigned int hardwareThreadCount = GetHardwareThreadCount ();
+	for (unsigned int threadCount = 1; threadCount <= hardwareThreadCount; threadCount *= 2) {
+		Measure ("2 steps, " + std::to_string (threadCount) + " threads" + caseSuffix, [&] () {
+			Mesh result;
+			SubdivideMesh (sphere, 2, glm::pi<double> () / 6.0, threadCount, result, nullptr);
+		});
+	}
+}
+
+}
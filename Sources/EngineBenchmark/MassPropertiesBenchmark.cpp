@@ -0,0 +1,25 @@
+#include "SimpleBenchmark.hpp"
+#include "MeshGenerators.hpp"
+#include "MassProperties.hpp"
+#include "Model.hpp"
+
+using namespace Modeler;
+
+namespace MassPropertiesBenchmark
+{
+
+BENCHMARK (ModelMassProperties)
+{
+	Model model;
+	for (size_t i = 0; i < 16; i++) {
+		glm::dmat4 transformation = glm::translate (glm::dmat4 (1.0), glm::dvec3 ((double) i * 3.0, 0.0, 0.0));
+		model.AddMesh (GenerateSphere (DefaultMaterial, transformation, 1.0, 250, true));
+	}
+	std::string caseSuffix = ", " + std::to_string (model.GetInfo ().triangleCount) + " triangles";
+
+	Measure ("model mass properties" + caseSuffix, [&] () {
+		model.CalcMassProperties ();
+	});
+}
+
+}
@@ -0,0 +1,42 @@
+#include "SimpleBenchmark.hpp"
+#include "MeshGenerators.hpp"
+#include "MeshDistance.hpp"
+#include "ParallelTasks.hpp"
+
+#include <random>
+
+using namespace Modeler;
+
+namespace MeshDistanceBenchmark
+{
+
+BENCHMARK (MeshDistance)
+{
+	Mesh sphere = GenerateSphere (DefaultMaterial, glm::dmat4 (1.0), 1.0, 160, true);
+	std::string caseSuffix = ", " + std::to_string (sphere.GetGeometry ().TriangleCount ()) + " triangles";
+
+	// clearance checks query points near the surface, points around the center
+	// of a sphere are the worst case, because every triangle is equally far
+	std::mt19937 generator (42);
+	std::normal_distribution<double> directionDistribution (0.0, 1.0);
+	std::uniform_real_distribution<double> radiusDistribution (0.8, 1.2);
+	std::vector<glm::dvec3> points;
+	for (size_t i = 0; i < 1000000; i++) {
+		glm::dvec3 direction (directionDistribution (generator), directionDistribution (generator), directionDistribution (generator));
+		points.push_back (glm::normalize (direction) * radiusDistribution (generator));
+	}
+
+	std::unique_ptr<MeshDistanceQuery> query;
+	Measure ("build" + caseSuffix, [&] () {
+		query.reset (new MeshDistanceQuery (sphere));
+	});
+
+	unsigned int hardwareThreadCount = GetHardwareThreadCount ();
+	for (unsigned int threadCount = 1; threadCount <= hardwareThreadCount; threadCount *= 2) {
+		Measure ("1M signed distances, " + std::to_string (threadCount) + " threads" + caseSuffix, [&] () {
+			query->GetSignedDistances (points, threadCount);
+		});
+	}
+}
+
+}
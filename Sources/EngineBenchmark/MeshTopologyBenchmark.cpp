@@ -0,0 +1,39 @@
+#include "SimpleBenchmark.hpp"
+#include "MeshGenerators.hpp"
+#include "MeshTopology.hpp"
+#include "ParallelTasks.hpp"
+
+using namespace Modeler;
+
+namespace MeshTopologyBenchmark
+{
+
+BENCHMARK (MeshTopologyBuild)
+{
+	Mesh sphere = GenerateSphere (DefaultMaterial, glm::dmat4 (1.0), 1.0, 1000, false);
+	std::vector<unsigned int> triangleVertices;
+	sphere.GetGeometry ().EnumerateTriangles ([&] (const MeshTriangle& triangle) {
+		triangleVertices.push_back (triangle.v1);
+		triangleVertices.push_back (triangle.v2);
+		triangleVertices.push_back (triangle.v3);
+	});
+	std::string caseSuffix = ", " + std::to_string (triangleVertices.size () / 3) + " triangles";
+
+	Measure ("incremental" + caseSuffix, [&] () {
+		MeshTopology topology;
+		MeshTopologyBuilder builder (topology);
+		for (size_t i = 0; i < triangleVertices.size (); i += 3) {
+			builder.AddTriangle (triangleVertices[i], triangleVertices[i + 1], triangleVertices[i + 2]);
+		}
+	});
+
+	unsigned int hardwareThreadCount = GetHardwareThreadCount ();
+	for (unsigned int threadCount = 1; threadCount <= hardwareThreadCount; threadCount *= 2) {
+		Measure ("sorted, " + std::to_string (threadCount) + " threads" + caseSuffix, [&] () {
+			MeshTopology topology;
+			MeshTopologyBuilder::Build (topology, triangleVertices, threadCount);
+		});
+	}
+}
+
+}
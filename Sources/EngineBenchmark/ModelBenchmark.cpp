@@ -0,0 +1,39 @@
+#include "SimpleBenchmark.hpp"
+#include "Model.hpp"
+#include "MeshGenerators.hpp"
+
+#include <thread>
+
+using namespace Modeler;
+
+namespace ModelBenchmark
+{
+
+BENCHMARK (ConcurrentAddMeshScaling)
+{
+	const size_t meshCount = 1024;
+
+	std::vector<Mesh> meshes;
+	for (size_t i = 0; i < meshCount; i++) {
+		meshes.push_back (GenerateSphere (DefaultMaterial, glm::dmat4 (1.0), 1.0 + i * 0.001, 40, true));
+	}
+
+	for (size_t threadCount = 1; threadCount <= 32; threadCount *= 2) {
+		Measure (std::to_string (threadCount) + " threads", [&] () {
+			Model model;
+			std::vector<std::thread> threads;
+			for (size_t threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+				threads.push_back (std::thread ([&, threadIndex] () {
+					for (size_t i = threadIndex; i < meshCount; i += threadCount) {
+						model.AddMesh (meshes[i]);
+					}
+				}));
+			}
+			for (std::thread& thread : threads) {
+				thread.join ();
+			}
+		});
+	}
+}
+
+}
@@ -0,0 +1,27 @@
+#include "SimpleBenchmark.hpp"
+#include "MeshGenerators.hpp"
+#include "ModelSlicer.hpp"
+
+using namespace Modeler;
+
+namespace ModelSlicerBenchmark
+{
+
+BENCHMARK (ModelSlicing)
+{
+	Model model;
+	model.AddMesh (GenerateSphere (DefaultMaterial, glm::dmat4 (1.0), 1.0, 700, true));
+	std::string caseSuffix = ", " + std::to_string (model.GetInfo ().triangleCount) + " triangles";
+
+	for (int sliceCount : { 10, 1000 }) {
+		std::vector<double> offsets;
+		for (int i = 0; i < sliceCount; i++) {
+			offsets.push_back (-1.0 + (i + 0.5) * 2.0 / sliceCount);
+		}
+		Measure (std::to_string (sliceCount) + " slices" + caseSuffix, [&] () {
+			SliceModel (model, glm::dvec3 (0.0, 0.0, 1.0), offsets);
+		});
+	}
+}
+
+}
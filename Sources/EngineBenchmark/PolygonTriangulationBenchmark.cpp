@@ -0,0 +1,42 @@
+#include "SimpleBenchmark.hpp"
+#include "EarClippingTriangulator.hpp"
+#include "Triangulation.hpp"
+
+#include <cmath>
+
+using namespace Modeler;
+
+namespace PolygonTriangulationBenchmark
+{
+
+static std::vector<glm::dvec2> GetStarPolygon (size_t pointCount, double innerRadius, double outerRadius)
+{
+	std::vector<glm::dvec2> points;
+	for (size_t i = 0; i < pointCount; i++) {
+		double angle = 2.0 * glm::pi<double> () * (double) i / (double) pointCount;
+		double radius = (i % 2 == 0) ? outerRadius : innerRadius;
+		points.push_back (glm::dvec2 (radius * std::cos (angle), radius * std::sin (angle)));
+	}
+	return points;
+}
+
+BENCHMARK (PolygonTriangulation)
+{
+	// star polygons are concave at every second vertex, so they are hard for
+	// ear clipping, and they have no extra interior points for the cdt
+	for (size_t pointCount : { 1000, 10000 }) {
+		std::vector<glm::dvec2> points = GetStarPolygon (pointCount, 0.8, 1.0);
+		std::string caseSuffix = ", " + std::to_string (pointCount) + " vertices";
+		Measure ("ear clipping" + caseSuffix, [&] () {
+			EarClippingTriangulator triangulator;
+			std::vector<std::array<size_t, 3>> result;
+			triangulator.TriangulatePolygon (points, result);
+		});
+		Measure ("cdt" + caseSuffix, [&] () {
+			std::vector<std::array<size_t, 3>> result;
+			CGALOperations::TriangulatePolygon (points, result);
+		});
+	}
+}
+
+}
@@ -0,0 +1,124 @@
+#include "SimpleBenchmark.hpp"
+#include "Geometry.hpp"
+#include "RayIntersection.hpp"
+#include "FastRayIntersection.hpp"
+
+#include <random>
+#include <cmath>
+
+using namespace Geometry;
+
+namespace RayIntersectionBenchmark
+{
+
+static std::vector<std::array<glm::dvec3, 3>> GenerateTriangles (size_t count)
+{
+	std::mt19937 generator (42);
+	std::uniform_real_distribution<double> distribution (-1.0, 1.0);
+	std::vector<std::array<glm::dvec3, 3>> triangles;
+	for (size_t i = 0; i < count; i++) {
+		glm::dvec3 center (distribution (generator) * 10.0, distribution (generator) * 10.0, distribution (generator));
+		std::array<glm::dvec3, 3> triangle;
+		for (size_t j = 0; j < 3; j++) {
+			triangle[j] = center + glm::dvec3 (distribution (generator), distribution (generator), distribution (generator));
+		}
+		triangles.push_back (triangle);
+	}
+	return triangles;
+}
+
+static std::vector<Ray> GenerateCoherentRays (size_t count)
+{
+	std::vector<Ray> rays;
+	size_t side = (size_t) std::sqrt ((double) count);
+	glm::dvec3 origin (0.0, 0.0, 20.0);
+	for (size_t i = 0; i < count; i++) {
+		double x = ((double) (i % side) / side - 0.5) * 20.0;
+		double y = ((double) (i / side) / side - 0.5) * 20.0;
+		rays.push_back (Ray (origin, glm::dvec3 (x, y, 0.0) - origin));
+	}
+	return rays;
+}
+
+template <typename BlockType>
+static std::vector<BlockType> CreateBlocks (const std::vector<std::array<glm::dvec3, 3>>& triangles)
+{
+	std::vector<BlockType> blocks (1);
+	for (const std::array<glm::dvec3, 3>& triangle : triangles) {
+		if (blocks.back ().IsFull ()) {
+			blocks.push_back (BlockType ());
+		}
+		blocks.back ().Add (triangle[0], triangle[1], triangle[2]);
+	}
+	return blocks;
+}
+
+BENCHMARK (RayTriangleIntersection)
+{
+	std::vector<std::array<glm::dvec3, 3>> triangles = GenerateTriangles (1000);
+	std::vector<Ray> rays = GenerateCoherentRays (4096);
+	std::vector<TriangleBlock4> blocks4 = CreateBlocks<TriangleBlock4> (triangles);
+	std::vector<TriangleBlock8> blocks8 = CreateBlocks<TriangleBlock8> (triangles);
+
+	Measure ("scalar", [&] () {
+		for (const Ray& ray : rays) {
+			double distance = INF;
+			for (const std::array<glm::dvec3, 3>& triangle : triangles) {
+				RayIntersectionResult result = GetRayTriangleIntersection (ray, triangle[0], triangle[1], triangle[2]);
+				if (result.found && result.intersection.distance < distance) {
+					distance = result.intersection.distance;
+				}
+			}
+		}
+	});
+	Measure ("4-wide blocks", [&] () {
+		for (const Ray& ray : rays) {
+			PrecomputedRay precomputedRay (ray);
+			double distance = INF;
+			for (const TriangleBlock4& block : blocks4) {
+				GetRayTriangleBlockIntersection (precomputedRay, block, distance);
+			}
+		}
+	});
+	Measure ("8-wide blocks", [&] () {
+		for (const Ray& ray : rays) {
+			PrecomputedRay precomputedRay (ray);
+			double distance = INF;
+			for (const TriangleBlock8& block : blocks8) {
+				GetRayTriangleBlockIntersection (precomputedRay, block, distance);
+			}
+		}
+	});
+	Measure ("8-wide packets", [&] () {
+		for (size_t i = 0; i < rays.size (); i += RayPacket8::Size) {
+			RayPacket8 packet;
+			for (size_t j = i; j < rays.size () && !packet.IsFull (); j++) {
+				packet.Add (rays[j]);
+			}
+			RayPacketHits8 hits;
+			for (size_t j = 0; j < triangles.size (); j++) {
+				GetRayPacketTriangleIntersection (packet, triangles[j][0], triangles[j][1], triangles[j][2], j, hits);
+			}
+		}
+	});
+}
+
+BENCHMARK (RayBoundingBoxIntersection)
+{
+	std::vector<Ray> rays = GenerateCoherentRays (1 << 16);
+	BoundingBox box ({ -5.0, -5.0, -1.0 }, { 5.0, 5.0, 1.0 });
+
+	Measure ("scalar", [&] () {
+		for (const Ray& ray : rays) {
+			HasRayBoundingBoxIntersection (ray, box);
+		}
+	});
+	Measure ("slab", [&] () {
+		for (const Ray& ray : rays) {
+			double distance = 0.0;
+			GetRayBoundingBoxDistance (PrecomputedRay (ray), box, INF, distance);
+		}
+	});
+}
+
+}
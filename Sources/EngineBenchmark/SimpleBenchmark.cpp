@@ -0,0 +1,86 @@
+#include "SimpleBenchmark.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+
+namespace SimpleBenchmark
+{
+
+static const int RepeatCount = 3;
+
+class Suite
+{
+public:
+	void AddBenchmark (Benchmark* benchmark)
+	{
+		benchmarks.push_back (std::shared_ptr<Benchmark> (benchmark));
+	}
+
+	void Run (const std::string& filter)
+	{
+		for (const std::shared_ptr<Benchmark>& benchmark : benchmarks) {
+			if (!filter.empty () && benchmark->GetName ().find (filter) == std::string::npos) {
+				continue;
+			}
+			benchmark->Run ();
+		}
+	}
+
+	static Suite& Get ()
+	{
+		static Suite suite;
+		return suite;
+	}
+
+private:
+	std::vector<std::shared_ptr<Benchmark>> benchmarks;
+};
+
+Benchmark::Benchmark (const std::string& benchmarkName) :
+	benchmarkName (benchmarkName)
+{
+
+}
+
+Benchmark::~Benchmark ()
+{
+
+}
+
+void Benchmark::Run ()
+{
+	std::cout << "[ BENCHMARK ] " << benchmarkName << std::endl;
+	RunBenchmark ();
+}
+
+const std::string& Benchmark::GetName () const
+{
+	return benchmarkName;
+}
+
+double Benchmark::Measure (const std::string& caseName, const std::function<void ()>& func)
+{
+	double bestTime = 0.0;
+	for (int i = 0; i < RepeatCount; i++) {
+		std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now ();
+		func ();
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now ();
+		double time = std::chrono::duration<double, std::milli> (end - begin).count ();
+		bestTime = (i == 0 ? time : std::min (bestTime, time));
+	}
+	std::cout << "              " << std::left << std::setw (40) << caseName << std::right << std::fixed << std::setprecision (3) << std::setw (12) << bestTime << " ms" << std::endl;
+	return bestTime;
+}
+
+void RunBenchmarks (const std::string& filter)
+{
+	Suite::Get ().Run (filter);
+}
+
+void RegisterBenchmark (Benchmark* benchmark)
+{
+	Suite::Get ().AddBenchmark (benchmark);
+}
+
+}
@@ -0,0 +1,54 @@
+#ifndef SIMPLEBENCHMARK_HPP
+#define SIMPLEBENCHMARK_HPP
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+
+#define BENCHMARK(BENCHMARKNAME)										\
+namespace BENCHMARKNAME##BenchmarkNamespace {							\
+	class BENCHMARKNAME : public SimpleBenchmark::Benchmark {			\
+	public:																\
+		BENCHMARKNAME () :												\
+			SimpleBenchmark::Benchmark (#BENCHMARKNAME)					\
+		{																\
+		}																\
+		virtual void RunBenchmark () override;							\
+	};																	\
+	static class Register {												\
+		public:															\
+			Register ()													\
+			{															\
+				SimpleBenchmark::RegisterBenchmark (new BENCHMARKNAME ());	\
+			}															\
+	} BENCHMARKNAME##BenchmarkRegisterInstance;							\
+}																		\
+void BENCHMARKNAME##BenchmarkNamespace::BENCHMARKNAME::RunBenchmark ()
+
+namespace SimpleBenchmark
+{
+
+class Benchmark
+{
+public:
+	Benchmark (const std::string& benchmarkName);
+	virtual ~Benchmark ();
+
+	void				Run ();
+	const std::string&	GetName () const;
+
+protected:
+	double				Measure (const std::string& caseName, const std::function<void ()>& func);
+	virtual void		RunBenchmark () = 0;
+
+	std::string			benchmarkName;
+};
+
+void	RunBenchmarks (const std::string& filter);
+void	RegisterBenchmark (Benchmark* benchmark);
+
+}
+
+#endif
@@ -0,0 +1,11 @@
+#include "SimpleBenchmark.hpp"
+
+int main (int argc, char* argv[])
+{
+	std::string filter;
+	if (argc > 1) {
+		filter = argv[1];
+	}
+	SimpleBenchmark::RunBenchmarks (filter);
+	return 0;
+}
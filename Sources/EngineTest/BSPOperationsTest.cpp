@@ -0,0 +1,109 @@
+#include "SimpleTest.hpp"
+#include "MeshGenerators.hpp"
+#include "BSPBooleanOperations.hpp"
+#include "Geometry.hpp"
+
+#include <unordered_set>
+
+using namespace Modeler;
+using namespace BSPOperations;
+
+namespace BSPOperationsTest
+{
+
+static double CalculateVolume (const Mesh& mesh)
+{
+	const MeshGeometry& geometry = mesh.GetGeometry ();
+	const glm::dmat4& transformation = mesh.GetTransformation ();
+	double volume = 0.0;
+	geometry.EnumerateTriangles ([&] (const MeshTriangle& triangle) {
+		glm::dvec3 v1 = geometry.GetVertex (triangle.v1, transformation);
+		glm::dvec3 v2 = geometry.GetVertex (triangle.v2, transformation);
+		glm::dvec3 v3 = geometry.GetVertex (triangle.v3, transformation);
+		volume += glm::dot (v1, glm::cross (v2, v3)) / 6.0;
+	});
+	return volume;
+}
+
+TEST (BSPCubeBooleanTest)
+{
+	Mesh cube1 = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 1.0, 1.0, 1.0);
+	Mesh cube2 = GenerateBox (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (0.5, 0.5, 0.5)), 1.0, 1.0, 1.0);
+
+	Mesh difference;
+	ASSERT (MeshDifference (cube1, cube2, difference));
+	ASSERT (Geometry::IsEqual (CalculateVolume (difference), 0.875));
+	ASSERT (difference.GetGeometry ().NormalCount () == 6);
+	ASSERT (difference.GetGeometry ().VertexCount () < difference.GetGeometry ().TriangleCount ());
+
+	Mesh intersection;
+	ASSERT (MeshIntersection (cube1, cube2, intersection));
+	ASSERT (Geometry::IsEqual (CalculateVolume (intersection), 0.125));
+
+	Mesh unionResult;
+	ASSERT (MeshUnion (cube1, cube2, unionResult));
+	ASSERT (Geometry::IsEqual (CalculateVolume (unionResult), 1.875));
+}
+
+TEST (BSPCoplanarCubeBooleanTest)
+{
+	Mesh cube1 = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 1.0, 1.0, 1.0);
+	Mesh cube2 = GenerateBox (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (0.5, 0.0, 0.0)), 1.0, 1.0, 1.0);
+	Mesh cube3 = GenerateBox (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (1.0, 0.0, 0.0)), 1.0, 1.0, 1.0);
+
+	Mesh difference;
+	ASSERT (MeshDifference (cube1, cube2, difference));
+	ASSERT (Geometry::IsEqual (CalculateVolume (difference), 0.5));
+
+	Mesh intersection;
+	ASSERT (MeshIntersection (cube1, cube2, intersection));
+	ASSERT (Geometry::IsEqual (CalculateVolume (intersection), 0.5));
+
+	Mesh unionResult;
+	ASSERT (MeshUnion (cube1, cube2, unionResult));
+	ASSERT (Geometry::IsEqual (CalculateVolume (unionResult), 1.5));
+
+	Mesh touchingUnion;
+	ASSERT (MeshUnion (cube1, cube3, touchingUnion));
+	ASSERT (Geometry::IsEqual (CalculateVolume (touchingUnion), 2.0));
+	ASSERT (touchingUnion.GetGeometry ().TriangleCount () == 20);
+}
+
+TEST (BSPBooleanMaterialsTest)
+{
+	Mesh cube1 = GenerateBox (Material (glm::dvec3 (1.0, 0.0, 0.0)), glm::dmat4 (1.0), 1.0, 1.0, 1.0);
+	Mesh cube2 = GenerateBox (Material (glm::dvec3 (0.0, 1.0, 0.0)), glm::translate (glm::dmat4 (1.0), glm::dvec3 (0.5, 0.5, 0.5)), 1.0, 1.0, 1.0);
+	Mesh result;
+	ASSERT (MeshDifference (cube1, cube2, result));
+
+	std::unordered_set<MaterialId> foundMaterials;
+	const MeshGeometry& geometry = result.GetGeometry ();
+	const MeshMaterials& materials = result.GetMaterials ();
+	for (unsigned int i = 0; i < geometry.TriangleCount (); i++) {
+		foundMaterials.insert (materials.GetTriangleMaterial (i));
+	}
+	ASSERT (foundMaterials.size () == 2);
+	ASSERT (materials.TriangleRangeCount () == 2);
+	ASSERT (materials.IsGroupedByMaterial ());
+
+	for (unsigned int i = 0; i < geometry.TriangleCount (); i++) {
+		const MeshTriangle& triangle = geometry.GetTriangle (i);
+		glm::dvec3 v1 = geometry.GetVertex (triangle.v1);
+		glm::dvec3 v2 = geometry.GetVertex (triangle.v2);
+		glm::dvec3 v3 = geometry.GetVertex (triangle.v3);
+		glm::dvec3 faceNormal = glm::normalize (glm::cross (v2 - v1, v3 - v1));
+		ASSERT (glm::dot (faceNormal, geometry.GetNormal (triangle.n1)) > 0.0);
+	}
+}
+
+TEST (BSPSphereUnionTest)
+{
+	Mesh sphere1 = GenerateSphere (DefaultMaterial, glm::dmat4 (1.0), 1.0, 20, true);
+	Mesh sphere2 = GenerateSphere (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (3.0, 0.0, 0.0)), 1.0, 20, true);
+	Mesh result;
+	ASSERT (MeshUnion ({ sphere1, sphere2 }, result));
+	ASSERT (result.GetGeometry ().TriangleCount () == sphere1.GetGeometry ().TriangleCount () + sphere2.GetGeometry ().TriangleCount ());
+	ASSERT (Geometry::IsEqual (CalculateVolume (result), CalculateVolume (sphere1) + CalculateVolume (sphere2)));
+}
+
+}
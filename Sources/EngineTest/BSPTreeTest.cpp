@@ -20,19 +20,19 @@ public:
 	{
 	}
 
-	virtual void FrontTrianglesFound (const std::vector<Triangle>& triangles) override
+	virtual void FrontTrianglesFound (const TriangleCutList& triangles) override
 	{
-		frontCount += triangles.size ();
+		frontCount += triangles.GetSize ();
 	}
 
-	virtual void BackTrianglesFound (const std::vector<Triangle>& triangles) override
+	virtual void BackTrianglesFound (const TriangleCutList& triangles) override
 	{
-		backCount += triangles.size ();
+		backCount += triangles.GetSize ();
 	}
 
-	virtual void PlaneTrianglesFound (const std::vector<Triangle>& triangles) override
+	virtual void PlaneTrianglesFound (const TriangleCutList& triangles) override
 	{
-		planeCount += triangles.size ();
+		planeCount += triangles.GetSize ();
 	}
 
 	size_t frontCount;
@@ -40,6 +40,60 @@ public:
 	size_t planeCount;
 };
 
+class TriangleAreaCounter : public BSPTriangleClipper
+{
+public:
+	TriangleAreaCounter () :
+		frontArea (0.0),
+		backArea (0.0),
+		planeArea (0.0)
+	{
+	}
+
+	virtual void FrontTrianglesFound (const TriangleCutList& triangles) override
+	{
+		frontArea += GetArea (triangles);
+	}
+
+	virtual void BackTrianglesFound (const TriangleCutList& triangles) override
+	{
+		backArea += GetArea (triangles);
+	}
+
+	virtual void PlaneTrianglesFound (const TriangleCutList& triangles) override
+	{
+		planeArea += GetArea (triangles);
+	}
+
+	double frontArea;
+	double backArea;
+	double planeArea;
+
+private:
+	static double GetArea (const TriangleCutList& triangles)
+	{
+		double area = 0.0;
+		for (const Triangle& triangle : triangles) {
+			area += glm::length (glm::cross (triangle[1] - triangle[0], triangle[2] - triangle[0])) / 2.0;
+		}
+		return area;
+	}
+};
+
+static std::vector<Triangle> GetMeshTriangles (const Mesh& mesh)
+{
+	std::vector<Triangle> triangles;
+	const glm::dmat4& transformation = mesh.GetTransformation ();
+	mesh.GetGeometry ().EnumerateTriangles ([&] (const MeshTriangle& triangle) {
+		triangles.push_back (Triangle (
+			glm::dvec3 (transformation * glm::dvec4 (mesh.GetGeometry ().GetVertex (triangle.v1), 1.0)),
+			glm::dvec3 (transformation * glm::dvec4 (mesh.GetGeometry ().GetVertex (triangle.v2), 1.0)),
+			glm::dvec3 (transformation * glm::dvec4 (mesh.GetGeometry ().GetVertex (triangle.v3), 1.0))
+		));
+	});
+	return triangles;
+}
+
 TEST (BSPTreeClipTest)
 {
 	Mesh cube = GenerateBox (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (-0.5, -0.5, -0.5)), 1.0, 1.0, 1.0);
@@ -84,4 +138,88 @@ TEST (BSPTreeClipTest)
 	}
 }
 
+TEST (BSPTreePlaneTrianglesTest)
+{
+	BSPTree tree;
+	tree.AddTriangle (Triangle (glm::dvec3 (0.0, 0.0, 0.0), glm::dvec3 (1.0, 0.0, 0.0), glm::dvec3 (0.0, 1.0, 0.0)));
+	tree.AddTriangle (Triangle (glm::dvec3 (2.0, 0.0, 0.0), glm::dvec3 (3.0, 0.0, 0.0), glm::dvec3 (2.0, 1.0, 0.0)));
+	tree.AddTriangle (Triangle (glm::dvec3 (0.0, 0.0, 1.0), glm::dvec3 (1.0, 0.0, 1.0), glm::dvec3 (0.0, 1.0, 1.0)));
+
+	TriangleClipCounter counter;
+	tree.ClipTriangle (Triangle (glm::dvec3 (0.0, 0.0, 0.0), glm::dvec3 (0.0, 1.0, 0.0), glm::dvec3 (-1.0, 0.0, 0.0)), counter);
+	ASSERT (counter.frontCount == 0 && counter.backCount == 0 && counter.planeCount == 1);
+}
+
+TEST (BalancedBSPTreeClipTest)
+{
+	Mesh cube = GenerateBox (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (-0.5, -0.5, -0.5)), 1.0, 1.0, 1.0);
+	BalancedBSPTree tree (GetMeshTriangles (cube));
+	ASSERT (tree.NodeCount () == 6);
+	ASSERT (tree.PlaneTriangleCount () == 12);
+
+	{
+		Triangle triangle (glm::dvec3 (2.0, 0.0, 0.0), glm::dvec3 (4.0, 0.0, 0.0), glm::dvec3 (3.0, 1.0, 0.0));
+		TriangleClipCounter counter;
+		tree.ClipTriangle (triangle, counter);
+		ASSERT (counter.frontCount == 1 && counter.backCount == 0 && counter.planeCount == 0);
+	}
+
+	{
+		Triangle triangle (glm::dvec3 (0.0, 0.0, 0.0), glm::dvec3 (0.2, 0.0, 0.0), glm::dvec3 (0.1, 0.3, 0.0));
+		TriangleClipCounter counter;
+		tree.ClipTriangle (triangle, counter);
+		ASSERT (counter.frontCount == 0 && counter.backCount == 1 && counter.planeCount == 0);
+	}
+
+	{
+		Triangle triangle (glm::dvec3 (0.0, 0.0, 0.0), glm::dvec3 (2.0, 0.0, 0.0), glm::dvec3 (2.0, 1.0, 0.0));
+		TriangleAreaCounter counter;
+		tree.ClipTriangle (triangle, counter);
+		ASSERT (IsEqual (counter.frontArea, 0.9375));
+		ASSERT (IsEqual (counter.backArea, 0.0625));
+		ASSERT (IsEqual (counter.planeArea, 0.0));
+	}
+
+	{
+		Triangle triangle (glm::dvec3 (0.5, 0.0, 0.0), glm::dvec3 (0.5, -0.5, 0.0), glm::dvec3 (0.5, 0.5, 0.5));
+		TriangleClipCounter counter;
+		tree.ClipTriangle (triangle, counter);
+		ASSERT (counter.frontCount == 0 && counter.backCount == 0 && counter.planeCount == 1);
+	}
+}
+
+TEST (BalancedBSPTreeDepthTest)
+{
+	std::vector<Triangle> triangles;
+	for (int i = 0; i < 64; i++) {
+		double z = (double) i;
+		triangles.push_back (Triangle (glm::dvec3 (0.0, 0.0, z), glm::dvec3 (1.0, 0.0, z), glm::dvec3 (0.0, 1.0, z)));
+	}
+	BalancedBSPTree tree (triangles);
+	ASSERT (tree.NodeCount () == 64);
+	ASSERT (tree.Depth () <= 12);
+}
+
+TEST (BalancedBSPTreeDegenerateTest)
+{
+	Triangle degenerate (glm::dvec3 (0.0, 0.0, 0.0), glm::dvec3 (1.0, 0.0, 0.0), glm::dvec3 (2.0, 0.0, 0.0));
+	Triangle valid (glm::dvec3 (0.0, 0.0, 0.0), glm::dvec3 (1.0, 0.0, 0.0), glm::dvec3 (0.0, 1.0, 0.0));
+
+	BalancedBSPTree degenerateTree (std::vector<Triangle> (16, degenerate));
+	ASSERT (degenerateTree.NodeCount () == 0);
+
+	// the sampled candidates are all degenerate, the valid one is found later
+	std::vector<Triangle> triangles (16, degenerate);
+	triangles[3] = valid;
+	BalancedBSPTree tree (triangles);
+	ASSERT (tree.NodeCount () == 1);
+
+	BalancedBSPTree::ClipStack clipStack;
+	TriangleClipCounter counter;
+	Triangle above (glm::dvec3 (0.0, 0.0, 1.0), glm::dvec3 (1.0, 0.0, 1.0), glm::dvec3 (0.0, 1.0, 1.0));
+	tree.ClipTriangle (above, counter, BSPCoplanarSide::Plane, BSPCoplanarSide::Plane, clipStack);
+	tree.ClipTriangle (above, counter, BSPCoplanarSide::Plane, BSPCoplanarSide::Plane, clipStack);
+	ASSERT (counter.frontCount == 2 && counter.backCount == 0 && counter.planeCount == 0);
+}
+
 }
@@ -0,0 +1,130 @@
+#include "SimpleTest.hpp"
+#include "BooleanShape.hpp"
+#include "BasicShapes.hpp"
+#include "TestUtils.hpp"
+
+using namespace Modeler;
+
+namespace BooleanShapeTest
+{
+
+class TestBooleanShape : public BooleanShape
+{
+public:
+	TestBooleanShape (const glm::dmat4& transformation, Operation operation, const std::vector<ShapeConstPtr>& operands) :
+		BooleanShape (transformation, operation, operands)
+	{
+	}
+
+	virtual ShapePtr Clone () const override
+	{
+		return ShapePtr (new TestBooleanShape (*this));
+	}
+
+	virtual std::wstring ToString () const override
+	{
+		return L"Test Boolean";
+	}
+
+	virtual Mesh GenerateMesh () const override
+	{
+		return Mesh ();
+	}
+};
+
+static ShapeConstPtr CreateBox (const glm::dvec3& offset)
+{
+	return ShapeConstPtr (new BoxShape (DefaultMaterial, glm::translate (glm::dmat4 (1.0), offset), 1.0, 1.0, 1.0));
+}
+
+static ShapeConstPtr CreateBoolean (const glm::dmat4& transformation, BooleanShape::Operation operation, const std::vector<ShapeConstPtr>& operands)
+{
+	return ShapeConstPtr (new TestBooleanShape (transformation, operation, operands));
+}
+
+static glm::dvec3 GetOrigin (const ShapeConstPtr& shape)
+{
+	return glm::dvec3 (shape->GetTransformation () * glm::dvec4 (0.0, 0.0, 0.0, 1.0));
+}
+
+TEST (BooleanShapeDifferenceChainTest)
+{
+	ShapeConstPtr a = CreateBox (glm::dvec3 (0.0, 0.0, 0.0));
+	ShapeConstPtr b = CreateBox (glm::dvec3 (1.0, 0.0, 0.0));
+	ShapeConstPtr c = CreateBox (glm::dvec3 (2.0, 0.0, 0.0));
+	ShapeConstPtr d = CreateBox (glm::dvec3 (3.0, 0.0, 0.0));
+
+	// (A - B) - C -> A - (B + C)
+	ShapeConstPtr aMinusB = CreateBoolean (glm::dmat4 (1.0), BooleanShape::Operation::Difference, { a, b });
+	TestBooleanShape chain (glm::dmat4 (1.0), BooleanShape::Operation::Difference, { aMinusB, c });
+	std::vector<ShapeConstPtr> rewritten = chain.GetRewrittenOperands ();
+	ASSERT (rewritten.size () == 3);
+	ASSERT (rewritten[0] == a);
+	ASSERT (rewritten[1] == b);
+	ASSERT (rewritten[2] == c);
+
+	// ((A - B) - (C + D)) -> A - (B + C + D)
+	ShapeConstPtr cPlusD = CreateBoolean (glm::dmat4 (1.0), BooleanShape::Operation::Union, { c, d });
+	TestBooleanShape unionTool (glm::dmat4 (1.0), BooleanShape::Operation::Difference, { aMinusB, cPlusD });
+	rewritten = unionTool.GetRewrittenOperands ();
+	ASSERT (rewritten.size () == 4);
+	ASSERT (rewritten[0] == a);
+	ASSERT (rewritten[1] == b);
+	ASSERT (rewritten[2] == c);
+	ASSERT (rewritten[3] == d);
+}
+
+TEST (BooleanShapeNestedToolDifferenceTest)
+{
+	ShapeConstPtr a = CreateBox (glm::dvec3 (0.0, 0.0, 0.0));
+	ShapeConstPtr b = CreateBox (glm::dvec3 (1.0, 0.0, 0.0));
+	ShapeConstPtr c = CreateBox (glm::dvec3 (2.0, 0.0, 0.0));
+
+	// A - (B - C) is not A - B - C, the tool difference is kept intact
+	ShapeConstPtr bMinusC = CreateBoolean (glm::dmat4 (1.0), BooleanShape::Operation::Difference, { b, c });
+	TestBooleanShape difference (glm::dmat4 (1.0), BooleanShape::Operation::Difference, { a, bMinusC });
+	std::vector<ShapeConstPtr> rewritten = difference.GetRewrittenOperands ();
+	ASSERT (rewritten.size () == 2);
+	ASSERT (rewritten[0] == a);
+	ASSERT (rewritten[1] == bMinusC);
+
+	// the body of an intersection is not merged into a difference
+	ShapeConstPtr aAndB = CreateBoolean (glm::dmat4 (1.0), BooleanShape::Operation::Intersection, { a, b });
+	TestBooleanShape intersectionBody (glm::dmat4 (1.0), BooleanShape::Operation::Difference, { aAndB, c });
+	rewritten = intersectionBody.GetRewrittenOperands ();
+	ASSERT (rewritten.size () == 2);
+	ASSERT (rewritten[0] == aAndB);
+	ASSERT (rewritten[1] == c);
+}
+
+TEST (BooleanShapeTransformationTest)
+{
+	ShapeConstPtr a = CreateBox (glm::dvec3 (0.0, 0.0, 0.0));
+	ShapeConstPtr b = CreateBox (glm::dvec3 (1.0, 0.0, 0.0));
+	ShapeConstPtr c = CreateBox (glm::dvec3 (2.0, 0.0, 0.0));
+
+	// transformations of the nested operations are moved to the operands
+	ShapeConstPtr aMinusB = CreateBoolean (glm::translate (glm::dmat4 (1.0), glm::dvec3 (0.0, 5.0, 0.0)), BooleanShape::Operation::Difference, { a, b });
+	TestBooleanShape chain (glm::translate (glm::dmat4 (1.0), glm::dvec3 (0.0, 0.0, 10.0)), BooleanShape::Operation::Difference, { aMinusB, c });
+	std::vector<ShapeConstPtr> rewritten = chain.GetRewrittenOperands ();
+	ASSERT (rewritten.size () == 3);
+	ASSERT (IsEqualVec (GetOrigin (rewritten[0]), glm::dvec3 (0.0, 5.0, 10.0)));
+	ASSERT (IsEqualVec (GetOrigin (rewritten[1]), glm::dvec3 (1.0, 5.0, 10.0)));
+	ASSERT (IsEqualVec (GetOrigin (rewritten[2]), glm::dvec3 (2.0, 0.0, 10.0)));
+
+	// the original operands are not modified
+	ASSERT (IsEqualVec (GetOrigin (a), glm::dvec3 (0.0, 0.0, 0.0)));
+	ASSERT (IsEqualVec (GetOrigin (c), glm::dvec3 (2.0, 0.0, 0.0)));
+	ASSERT (IsEqualVec (GetOrigin (aMinusB), glm::dvec3 (0.0, 5.0, 0.0)));
+
+	// nested unions are merged with their transformation
+	ShapeConstPtr bPlusC = CreateBoolean (glm::translate (glm::dmat4 (1.0), glm::dvec3 (0.0, 5.0, 0.0)), BooleanShape::Operation::Union, { b, c });
+	TestBooleanShape unionShape (glm::translate (glm::dmat4 (1.0), glm::dvec3 (0.0, 0.0, 10.0)), BooleanShape::Operation::Union, { a, bPlusC });
+	rewritten = unionShape.GetRewrittenOperands ();
+	ASSERT (rewritten.size () == 3);
+	ASSERT (IsEqualVec (GetOrigin (rewritten[0]), glm::dvec3 (0.0, 0.0, 10.0)));
+	ASSERT (IsEqualVec (GetOrigin (rewritten[1]), glm::dvec3 (1.0, 5.0, 10.0)));
+	ASSERT (IsEqualVec (GetOrigin (rewritten[2]), glm::dvec3 (2.0, 5.0, 10.0)));
+}
+
+}
@@ -1,9 +1,13 @@
 #include "SimpleTest.hpp"
+#include "TestUtils.hpp"
 #include "MeshGenerators.hpp"
 #include "BooleanOperations.hpp"
 #include "Subdivision.hpp"
 #include "Triangulation.hpp"
 #include "Export.hpp"
+#include "MassProperties.hpp"
+#include "Geometry.hpp"
+#include "BasicShapes.hpp"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -71,6 +75,8 @@ TEST (CubeDifferenceTestWithMaterials)
 		foundMaterials.insert (materials.GetTriangleMaterial (i));
 	}
 	ASSERT (foundMaterials.size () == 2);
+	ASSERT (materials.TriangleRangeCount () == 2);
+	ASSERT (materials.IsGroupedByMaterial ());
 }
 
 TEST (CubeCylinderNonManifoldDifferenceTest)
@@ -82,6 +88,203 @@ TEST (CubeCylinderNonManifoldDifferenceTest)
 	ASSERT (opResult == false);
 }
 
+TEST (OpenOperandDifferenceTest)
+{
+	Mesh cube1 = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 1.0, 1.0, 1.0);
+	Mesh cube2 = GenerateBox (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (0.5, 0.5, 0.5)), 1.0, 1.0, 1.0);
+	Mesh openCube;
+	MaterialId material = openCube.AddMaterial (DefaultMaterial);
+	cube2.GetGeometry ().EnumerateVertices (cube2.GetTransformation (), [&] (const glm::dvec3& vertex) {
+		openCube.AddVertex (vertex);
+	});
+	for (unsigned int i = 1; i < cube2.GetGeometry ().TriangleCount (); i++) {
+		const MeshTriangle& triangle = cube2.GetGeometry ().GetTriangle (i);
+		openCube.AddTriangle (triangle.v1, triangle.v2, triangle.v3, material);
+	}
+
+	Mesh result;
+	BooleanDiagnostic diagnostic;
+	ASSERT (MeshDifference (cube1, cube2, result, diagnostic));
+	ASSERT (diagnostic.status == BooleanDiagnostic::Status::Success);
+
+	Mesh invalidResult;
+	ASSERT (!MeshDifference (cube1, openCube, invalidResult, diagnostic));
+	ASSERT (diagnostic.status == BooleanDiagnostic::Status::InvalidOperand);
+	ASSERT (diagnostic.operand == 1);
+	ASSERT (diagnostic.validation.defect == MeshDefect::OpenBoundary);
+	ASSERT (!MeshUnion ({ cube1, cube2, openCube }, invalidResult, diagnostic));
+	ASSERT (diagnostic.operand == 2);
+
+	ShapePtr cube1Shape (new MeshShape (glm::dmat4 (1.0), cube1));
+	ShapePtr openCubeShape (new MeshShape (glm::dmat4 (1.0), openCube));
+	ASSERT (ShapeDifference (cube1Shape, openCubeShape, diagnostic, nullptr) == nullptr);
+	ASSERT (diagnostic.status == BooleanDiagnostic::Status::InvalidOperand);
+	ASSERT (diagnostic.operand == 1);
+	ShapePtr exactShape = ShapeDifference (cube1Shape, ShapePtr (new MeshShape (glm::dmat4 (1.0), cube2)), diagnostic, nullptr);
+	ASSERT (exactShape != nullptr);
+	ASSERT (diagnostic.status == BooleanDiagnostic::Status::Success);
+	ASSERT (ShapeUnion ({ exactShape, cube1Shape, openCubeShape }, diagnostic, nullptr) == nullptr);
+	ASSERT (diagnostic.status == BooleanDiagnostic::Status::InvalidOperand);
+	ASSERT (diagnostic.operand == 2);
+}
+
+TEST (CachedDifferenceTest)
+{
+	ClearBooleanResultCache ();
+	Mesh cube1 = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 1.0, 1.0, 1.0);
+	Mesh cube2 = GenerateBox (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (0.5, 0.5, 0.5)), 1.0, 1.0, 1.0);
+	Mesh result1;
+	Mesh result2;
+	ASSERT (MeshDifference (cube1, cube2, result1));
+	ASSERT (MeshDifference (cube1, cube2, result2));
+	ASSERT (result1.GetGeometryPtr () == result2.GetGeometryPtr ());
+
+	Mesh movedCube2 = cube2;
+	movedCube2.AddTransformation (glm::translate (glm::dmat4 (1.0), glm::dvec3 (0.1, 0.0, 0.0)));
+	Mesh result3;
+	ASSERT (MeshDifference (cube1, movedCube2, result3));
+	ASSERT (result1.GetGeometryPtr () != result3.GetGeometryPtr ());
+
+	Mesh result4;
+	ASSERT (MeshIntersection (cube1, cube2, result4));
+	ASSERT (result1.GetGeometryPtr () != result4.GetGeometryPtr ());
+}
+
+TEST (CachedChecksumCollisionTest)
+{
+	ClearBooleanResultCache ();
+	// these boxes have the same checksum, but different volumes
+	Mesh box1 = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 102.76, 1.0, 1.0);
+	Mesh box2 = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 117.03, 1.0, 1.0);
+	Mesh cube = GenerateBox (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (-0.5, 0.25, 0.25)), 1.0, 0.5, 0.5);
+	Mesh result1;
+	Mesh result2;
+	ASSERT (MeshDifference (box1, cube, result1));
+	ASSERT (MeshDifference (box2, cube, result2));
+	ASSERT (result1.GetGeometryPtr () != result2.GetGeometryPtr ());
+	ASSERT (Geometry::IsEqual (CalcMeshMassProperties (result1.GetGeometry (), result1.GetTransformation ()).volume, 102.76 - 0.125));
+	ASSERT (Geometry::IsEqual (CalcMeshMassProperties (result2.GetGeometry (), result2.GetTransformation ()).volume, 117.03 - 0.125));
+}
+
+TEST (ManyCubesUnionTest)
+{
+	std::vector<Mesh> cubes;
+	for (double y : { 0.0, 10.0 }) {
+		for (int i = 0; i < 6; i++) {
+			cubes.push_back (GenerateBox (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (i * 0.5, y, 0.0)), 1.0, 1.0, 1.0));
+		}
+	}
+
+	Mesh result;
+	ASSERT (MeshUnion (cubes, result));
+	ASSERT (ValidateMesh (result).IsValid ());
+	MassProperties properties = CalcMeshMassProperties (result.GetGeometry (), result.GetTransformation ());
+	ASSERT (Geometry::IsEqual (properties.volume, 7.0));
+}
+
+TEST (SeparatedOperandsTest)
+{
+	Mesh cube1 = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 1.0, 1.0, 1.0);
+	Mesh cube2 = GenerateBox (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (5.0, 0.0, 0.0)), 1.0, 1.0, 1.0);
+	Mesh cube3 = GenerateBox (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (0.25, 0.25, 0.25)), 0.5, 0.5, 0.5);
+
+	Mesh result;
+	ASSERT (MeshDifference (cube1, cube2, result));
+	ASSERT (Geometry::IsEqual (CalcMeshMassProperties (result.GetGeometry (), result.GetTransformation ()).volume, 1.0));
+	ASSERT (MeshIntersection (cube1, cube2, result));
+	ASSERT (result.GetGeometry ().TriangleCount () == 0);
+	ASSERT (MeshUnion (cube1, cube2, result));
+	ASSERT (Geometry::IsEqual (CalcMeshMassProperties (result.GetGeometry (), result.GetTransformation ()).volume, 2.0));
+	ASSERT (MeshIntersection (cube1, cube3, result));
+	ASSERT (Geometry::IsEqual (CalcMeshMassProperties (result.GetGeometry (), result.GetTransformation ()).volume, 0.125));
+	ASSERT (MeshDifference (cube1, cube3, result));
+	ASSERT (Geometry::IsEqual (CalcMeshMassProperties (result.GetGeometry (), result.GetTransformation ()).volume, 0.875));
+}
+
+TEST (ExactShapeChainTest)
+{
+	ShapePtr box (new BoxShape (DefaultMaterial, glm::dmat4 (1.0), 2.0, 2.0, 2.0));
+	ShapePtr cube1 (new BoxShape (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (-0.5, -0.5, -0.5)), 1.0, 1.0, 1.0));
+	ShapePtr cube2 (new BoxShape (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (1.5, 1.5, 1.5)), 1.0, 1.0, 1.0));
+
+	ShapePtr difference1 = ShapeDifference (box, cube1);
+	ASSERT (std::dynamic_pointer_cast<ExactMeshShape> (difference1) != nullptr);
+	ShapePtr movedDifference1 = difference1->Transform (glm::translate (glm::dmat4 (1.0), glm::dvec3 (0.5, 0.5, 0.5)));
+	ShapePtr difference2 = ShapeDifference (movedDifference1, cube2->Transform (glm::translate (glm::dmat4 (1.0), glm::dvec3 (0.5, 0.5, 0.5))));
+	ASSERT (difference2 != nullptr);
+
+	Mesh result = difference2->GenerateMesh ();
+	ASSERT (ValidateMesh (result).IsValid ());
+	MassProperties properties = CalcMeshMassProperties (result.GetGeometry (), result.GetTransformation ());
+	ASSERT (Geometry::IsEqual (properties.volume, 8.0 - 2.0 * 0.125));
+	ASSERT (IsEqualVec (result.GetGeometry ().GetBoundingBox ().Transform (result.GetTransformation ()).GetMin (), glm::dvec3 (0.5, 0.5, 0.5)));
+
+	ShapePtr separatedDifference = ShapeDifference (difference2, cube1->Transform (glm::translate (glm::dmat4 (1.0), glm::dvec3 (10.0, 0.0, 0.0))));
+	Mesh separatedResult = separatedDifference->GenerateMesh ();
+	ASSERT (separatedResult.GetGeometry ().TriangleCount () == result.GetGeometry ().TriangleCount ());
+}
+
+TEST (ExactShapeChecksumCollisionTest)
+{
+	// these boxes have the same checksum, but different volumes
+	ShapePtr box1 (new BoxShape (DefaultMaterial, glm::dmat4 (1.0), 102.76, 1.0, 1.0));
+	ShapePtr box2 (new BoxShape (DefaultMaterial, glm::dmat4 (1.0), 117.03, 1.0, 1.0));
+	ShapePtr cube (new BoxShape (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (-0.5, 0.25, 0.25)), 1.0, 0.5, 0.5));
+
+	ShapePtr difference1 = ShapeDifference (box1, cube);
+	ShapePtr difference2 = ShapeDifference (box2, cube);
+	ASSERT (difference1 != nullptr && difference2 != nullptr);
+	Mesh result1 = difference1->GenerateMesh ();
+	Mesh result2 = difference2->GenerateMesh ();
+	ASSERT (Geometry::IsEqual (CalcMeshMassProperties (result1.GetGeometry (), result1.GetTransformation ()).volume, 102.76 - 0.125));
+	ASSERT (Geometry::IsEqual (CalcMeshMassProperties (result2.GetGeometry (), result2.GetTransformation ()).volume, 117.03 - 0.125));
+
+	ShapePtr difference3 = ShapeDifference (box1, cube);
+	ASSERT (std::dynamic_pointer_cast<ExactMeshShape> (difference3)->GetExactMesh () == std::dynamic_pointer_cast<ExactMeshShape> (difference1)->GetExactMesh ());
+	ShapePtr chained1 = ShapeDifference (difference1, cube->Transform (glm::translate (glm::dmat4 (1.0), glm::dvec3 (2.0, 0.0, 0.0))));
+	ShapePtr chained2 = ShapeDifference (difference2, cube->Transform (glm::translate (glm::dmat4 (1.0), glm::dvec3 (2.0, 0.0, 0.0))));
+	ASSERT (std::dynamic_pointer_cast<ExactMeshShape> (chained1)->GetExactMesh () != std::dynamic_pointer_cast<ExactMeshShape> (chained2)->GetExactMesh ());
+}
+
+TEST (ExactSeparatedUnionTest)
+{
+	ShapePtr box (new BoxShape (DefaultMaterial, glm::dmat4 (1.0), 2.0, 2.0, 2.0));
+	ShapePtr cube (new BoxShape (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (-0.5, -0.5, -0.5)), 1.0, 1.0, 1.0));
+	ShapePtr difference = ShapeDifference (box, cube);
+	ASSERT (difference != nullptr);
+
+	glm::dmat4 offset = glm::translate (glm::dmat4 (1.0), glm::dvec3 (10.0, 0.0, 0.0));
+	ShapePtr union1 = ShapeUnion ({ difference, difference->Transform (offset), cube->Transform (offset * offset) });
+	ASSERT (std::dynamic_pointer_cast<ExactMeshShape> (union1) != nullptr);
+	Mesh result = union1->GenerateMesh ();
+	ASSERT (ValidateMesh (result).IsValid ());
+	ASSERT (Geometry::IsEqual (CalcMeshMassProperties (result.GetGeometry (), result.GetTransformation ()).volume, 2.0 * 7.875 + 1.0));
+
+	ShapePtr union2 = ShapeUnion ({ difference, box->Transform (glm::translate (glm::dmat4 (1.0), glm::dvec3 (1.0, 0.0, 0.0))), difference->Transform (offset) });
+	ASSERT (union2 != nullptr);
+	Mesh result2 = union2->GenerateMesh ();
+	ASSERT (ValidateMesh (result2).IsValid ());
+	ASSERT (Geometry::IsEqual (CalcMeshMassProperties (result2.GetGeometry (), result2.GetTransformation ()).volume, 12.0 - 0.125 + 7.875));
+}
+
+TEST (ExactMirroredOperandTest)
+{
+	ShapePtr box (new BoxShape (DefaultMaterial, glm::dmat4 (1.0), 2.0, 2.0, 2.0));
+	ShapePtr cube (new BoxShape (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (-0.5, -0.5, -0.5)), 1.0, 1.0, 1.0));
+	ShapePtr bigBox (new BoxShape (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (-3.0, -3.0, -3.0)), 6.0, 6.0, 6.0));
+	ShapePtr difference = ShapeDifference (box, cube);
+	ASSERT (difference != nullptr);
+
+	// the mirrored exact operand is still oriented outwards
+	ShapePtr mirrored = difference->Transform (glm::scale (glm::dmat4 (1.0), glm::dvec3 (-1.0, 1.0, 1.0)));
+	ShapePtr intersection = ShapeIntersection (mirrored, bigBox);
+	ASSERT (std::dynamic_pointer_cast<ExactMeshShape> (intersection) != nullptr);
+	Mesh result = intersection->GenerateMesh ();
+	ASSERT (ValidateMesh (result).IsValid ());
+	ASSERT (Geometry::IsEqual (CalcMeshMassProperties (result.GetGeometry (), result.GetTransformation ()).volume, 7.875));
+	ASSERT (IsEqualVec (result.GetGeometry ().GetBoundingBox ().Transform (result.GetTransformation ()).GetMin (), glm::dvec3 (-2.0, 0.0, 0.0)));
+}
+
 TEST (CubeSubdivisionTest)
 {
 	Mesh cube = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 1.0, 1.0, 1.0);
@@ -90,6 +293,25 @@ TEST (CubeSubdivisionTest)
 	ASSERT (opResult == true);
 }
 
+TEST (CancelledOperationTest)
+{
+	ClearBooleanResultCache ();
+	Mesh cube1 = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 1.0, 1.0, 1.0);
+	Mesh cube2 = GenerateBox (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (0.5, 0.5, 0.5)), 1.0, 1.0, 1.0);
+
+	OperationProgress cancelledProgress;
+	cancelledProgress.Cancel ();
+	Mesh result;
+	BooleanDiagnostic diagnostic;
+	ASSERT (!MeshDifference (cube1, cube2, result, diagnostic, &cancelledProgress));
+	ASSERT (diagnostic.status == BooleanDiagnostic::Status::Cancelled);
+
+	OperationProgress progress;
+	ASSERT (MeshDifference (cube1, cube2, result, diagnostic, &progress));
+	ASSERT (diagnostic.status == BooleanDiagnostic::Status::Success);
+	ASSERT (progress.GetProgress () == 1.0);
+}
+
 TEST (TriangulationTest)
 {
 	{
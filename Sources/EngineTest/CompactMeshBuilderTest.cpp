@@ -0,0 +1,27 @@
+#include "SimpleTest.hpp"
+#include "CompactMeshBuilder.hpp"
+
+using namespace Modeler;
+
+namespace CompactMeshBuilderTest
+{
+
+TEST (CompactMeshBuilderTest)
+{
+	Mesh mesh;
+	CompactMeshBuilder builder (mesh);
+	ASSERT (builder.AddVertex (glm::dvec3 (0.0, 0.0, 0.0)) == 0);
+	ASSERT (builder.AddVertex (glm::dvec3 (1.0, 0.0, 0.0)) == 1);
+	ASSERT (builder.AddVertex (glm::dvec3 (1.0 + 1.0e-13, 0.0, 0.0)) == 1);
+	ASSERT (builder.AddVertex (glm::dvec3 (1.0 + 1.0e-6, 0.0, 0.0)) == 2);
+	ASSERT (builder.AddVertex (glm::dvec3 (0.0, 0.0, 0.0)) == 0);
+	ASSERT (mesh.GetGeometry ().VertexCount () == 3);
+
+	ASSERT (builder.AddNormal (glm::dvec3 (0.0, 0.0, 1.0)) == 0);
+	ASSERT (builder.AddNormal (glm::dvec3 (0.0, 0.0, -1.0)) == 1);
+	ASSERT (builder.AddNormal (glm::normalize (glm::dvec3 (1.0e-12, 0.0, 1.0))) == 0);
+	ASSERT (builder.AddNormal (glm::normalize (glm::dvec3 (1.0, 1.0, 1.0))) == 2);
+	ASSERT (mesh.GetGeometry ().NormalCount () == 3);
+}
+
+}
@@ -0,0 +1,174 @@
+#include "SimpleTest.hpp"
+#include "Geometry.hpp"
+#include "EarClippingTriangulator.hpp"
+#include "MeshGenerators.hpp"
+#include "MeshValidation.hpp"
+#include "MassProperties.hpp"
+
+#include <cmath>
+
+using namespace Geometry;
+using namespace Modeler;
+
+namespace EarClippingTriangulatorTest
+{
+
+static double GetTrianglesArea (const std::vector<glm::dvec2>& points, const std::vector<std::array<size_t, 3>>& triangles, bool& allCounterClockwise)
+{
+	double area = 0.0;
+	allCounterClockwise = true;
+	for (const std::array<size_t, 3>& triangle : triangles) {
+		const glm::dvec2& a = points[triangle[0]];
+		const glm::dvec2& b = points[triangle[1]];
+		const glm::dvec2& c = points[triangle[2]];
+		double triangleArea = ((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x)) / 2.0;
+		if (triangleArea < 0.0) {
+			allCounterClockwise = false;
+		}
+		area += triangleArea;
+	}
+	return area;
+}
+
+static std::vector<glm::dvec2> GetStarPolygon (size_t pointCount, double innerRadius, double outerRadius)
+{
+	std::vector<glm::dvec2> points;
+	for (size_t i = 0; i < pointCount; i++) {
+		double angle = 2.0 * glm::pi<double> () * (double) i / (double) pointCount;
+		double radius = (i % 2 == 0) ? outerRadius : innerRadius;
+		points.push_back (glm::dvec2 (radius * std::cos (angle), radius * std::sin (angle)));
+	}
+	return points;
+}
+
+TEST (EarClippingConcaveTest)
+{
+	std::vector<glm::dvec2> points = {
+		glm::dvec2 (0.0, 0.0),
+		glm::dvec2 (2.0, 0.0),
+		glm::dvec2 (2.0, 2.0),
+		glm::dvec2 (1.0, 2.0),
+		glm::dvec2 (1.0, 1.0),
+		glm::dvec2 (0.0, 1.0)
+	};
+
+	EarClippingTriangulator triangulator;
+	std::vector<std::array<size_t, 3>> triangles;
+	ASSERT (triangulator.TriangulatePolygon (points, triangles));
+	ASSERT (triangles.size () == 4);
+	bool allCounterClockwise = false;
+	ASSERT (IsEqual (GetTrianglesArea (points, triangles, allCounterClockwise), 3.0));
+	ASSERT (allCounterClockwise);
+
+	std::vector<glm::dvec2> reversedPoints (points.rbegin (), points.rend ());
+	std::vector<std::array<size_t, 3>> reversedTriangles;
+	ASSERT (triangulator.TriangulatePolygon (reversedPoints, reversedTriangles));
+	ASSERT (IsEqual (GetTrianglesArea (reversedPoints, reversedTriangles, allCounterClockwise), 3.0));
+	ASSERT (allCounterClockwise);
+}
+
+TEST (EarClippingLargePolygonTest)
+{
+	std::vector<glm::dvec2> points = GetStarPolygon (10000, 0.5, 1.0);
+	EarClippingTriangulator triangulator;
+	std::vector<std::array<size_t, 3>> triangles;
+	ASSERT (triangulator.TriangulatePolygon (points, triangles));
+	ASSERT (triangles.size () == points.size () - 2);
+	bool allCounterClockwise = false;
+	double area = GetTrianglesArea (points, triangles, allCounterClockwise);
+	ASSERT (allCounterClockwise);
+	ASSERT (IsEqual (area, 0.5 * points.size () * 0.5 * std::sin (2.0 * glm::pi<double> () / points.size ())));
+}
+
+TEST (EarClippingHolesTest)
+{
+	std::vector<glm::dvec2> contour = {
+		glm::dvec2 (0.0, 0.0),
+		glm::dvec2 (10.0, 0.0),
+		glm::dvec2 (10.0, 10.0),
+		glm::dvec2 (0.0, 10.0)
+	};
+	std::vector<std::vector<glm::dvec2>> holes = {
+		{ glm::dvec2 (1.0, 1.0), glm::dvec2 (3.0, 1.0), glm::dvec2 (3.0, 3.0), glm::dvec2 (1.0, 3.0) },
+		{ glm::dvec2 (5.0, 5.0), glm::dvec2 (5.0, 8.0), glm::dvec2 (8.0, 8.0), glm::dvec2 (8.0, 5.0) },
+		GetStarPolygon (200, 0.5, 1.0)
+	};
+	for (glm::dvec2& point : holes[2]) {
+		point += glm::dvec2 (2.0, 7.0);
+	}
+
+	std::vector<glm::dvec2> points (contour);
+	for (const std::vector<glm::dvec2>& hole : holes) {
+		points.insert (points.end (), hole.begin (), hole.end ());
+	}
+
+	EarClippingTriangulator triangulator;
+	std::vector<std::array<size_t, 3>> triangles;
+	ASSERT (triangulator.TriangulatePolygonWithHoles (contour, holes, triangles));
+	ASSERT (triangles.size () == points.size () + 2 * holes.size () - 2);
+	bool allCounterClockwise = false;
+	double starArea = 0.5 * 200.0 * 0.5 * std::sin (2.0 * glm::pi<double> () / 200.0);
+	ASSERT (IsEqual (GetTrianglesArea (points, triangles, allCounterClockwise), 100.0 - 4.0 - 9.0 - starArea));
+	ASSERT (allCounterClockwise);
+}
+
+TEST (EarClippingDegenerateTest)
+{
+	class FallbackTriangulator : public Triangulator
+	{
+	public:
+		FallbackTriangulator () :
+			callCount (0)
+		{
+		}
+
+		virtual bool TriangulatePolygon (const std::vector<glm::dvec2>&, std::vector<std::array<size_t, 3>>& result) override
+		{
+			callCount++;
+			result.push_back ({ 0, 1, 2 });
+			return true;
+		}
+
+		int callCount;
+	};
+
+	std::vector<glm::dvec2> selfIntersecting = {
+		glm::dvec2 (0.0, 0.0),
+		glm::dvec2 (1.0, 1.0),
+		glm::dvec2 (1.0, 0.0),
+		glm::dvec2 (0.0, 1.0)
+	};
+	std::vector<glm::dvec2> collinear = {
+		glm::dvec2 (0.0, 0.0),
+		glm::dvec2 (1.0, 0.0),
+		glm::dvec2 (2.0, 0.0)
+	};
+
+	std::vector<std::array<size_t, 3>> triangles;
+	EarClippingTriangulator triangulator;
+	ASSERT (!triangulator.TriangulatePolygon (selfIntersecting, triangles));
+	ASSERT (!triangulator.TriangulatePolygon (collinear, triangles));
+	ASSERT (!triangulator.TriangulatePolygon ({ glm::dvec2 (0.0, 0.0), glm::dvec2 (1.0, 0.0) }, triangles));
+	ASSERT (triangles.empty ());
+
+	std::shared_ptr<FallbackTriangulator> fallback (new FallbackTriangulator ());
+	EarClippingTriangulator triangulatorWithFallback (fallback);
+	ASSERT (triangulatorWithFallback.TriangulatePolygon (selfIntersecting, triangles));
+	ASSERT (fallback->callCount == 1);
+	ASSERT (triangles.size () == 1);
+	ASSERT (triangulatorWithFallback.TriangulatePolygon (GetStarPolygon (10, 0.5, 1.0), triangles));
+	ASSERT (fallback->callCount == 1);
+	ASSERT (triangles.size () == 9);
+}
+
+TEST (EarClippingPrismTest)
+{
+	std::vector<glm::dvec2> basePolygon = GetStarPolygon (100, 0.2, 1.0);
+	EarClippingTriangulator triangulator;
+	Mesh mesh = GeneratePrism (DefaultMaterial, glm::dmat4 (1.0), basePolygon, 2.0, triangulator);
+	ASSERT (ValidateMesh (mesh).IsValid ());
+	MassProperties properties = CalcMeshMassProperties (mesh.GetGeometry (), mesh.GetTransformation ());
+	ASSERT (IsEqual (properties.volume, 2.0 * 0.5 * 100.0 * 0.2 * std::sin (2.0 * glm::pi<double> () / 100.0)));
+}
+
+}
@@ -0,0 +1,179 @@
+#include "SimpleTest.hpp"
+#include "Geometry.hpp"
+#include "TestUtils.hpp"
+#include "RayIntersection.hpp"
+#include "FastRayIntersection.hpp"
+
+#include <random>
+
+using namespace Geometry;
+
+namespace FastRayIntersectionTest
+{
+
+static bool HasFastRayBoundingBoxIntersection (const Ray& ray, const BoundingBox& box)
+{
+	double distance = 0.0;
+	return GetRayBoundingBoxDistance (PrecomputedRay (ray), box, INF, distance);
+}
+
+static std::vector<Ray> GenerateRays (std::mt19937& generator, size_t count)
+{
+	std::uniform_real_distribution<double> distribution (-1.0, 1.0);
+	std::vector<Ray> rays;
+	for (size_t i = 0; i < count; i++) {
+		glm::dvec3 origin (distribution (generator) * 3.0, distribution (generator) * 3.0, 3.0);
+		glm::dvec3 target (distribution (generator), distribution (generator), 0.0);
+		rays.push_back (Ray (origin, target - origin));
+	}
+	return rays;
+}
+
+static double GetNearestScalarIntersection (const Ray& ray, const std::vector<Triangle>& triangles, size_t& nearest)
+{
+	double distance = INF;
+	nearest = (size_t) -1;
+	for (size_t i = 0; i < triangles.size (); i++) {
+		RayIntersectionResult result = GetRayTriangleIntersection (ray, triangles[i][0], triangles[i][1], triangles[i][2]);
+		if (result.found && result.intersection.distance < distance) {
+			distance = result.intersection.distance;
+			nearest = i;
+		}
+	}
+	return distance;
+}
+
+TEST (FastRayBoundingBoxTest)
+{
+	BoundingBox box ({ 1.0, 0.0, 0.0 }, { 2.0, 1.0, 1.0 });
+
+	ASSERT (!HasFastRayBoundingBoxIntersection (Ray ({ 0.0, 0.5, 0.5 }, { 0.0, 1.0, 0.0 }), box));
+	ASSERT (!HasFastRayBoundingBoxIntersection (Ray ({ 0.0, 0.5, 0.5 }, { 0.0, 0.0, 1.0 }), box));
+	ASSERT (!HasFastRayBoundingBoxIntersection (Ray ({ 0.0, 0.5, 0.5 }, { 1.0, 0.0, -1.0 }), box));
+	ASSERT (!HasFastRayBoundingBoxIntersection (Ray ({ 0.0, 0.5, 0.5 }, { -1.0, 0.0, 0.0 }), box));
+
+	ASSERT (HasFastRayBoundingBoxIntersection (Ray ({ 1.5, 0.5, 0.5 }, { 1.0, 0.0, 0.0 }), box));
+	ASSERT (HasFastRayBoundingBoxIntersection (Ray ({ 1.5, 0.5, 0.5 }, { 0.0, 0.0, -1.0 }), box));
+	ASSERT (HasFastRayBoundingBoxIntersection (Ray ({ 0.0, 0.0, 0.0 }, { 1.0, 0.0, 0.0 }), box));
+	ASSERT (HasFastRayBoundingBoxIntersection (Ray ({ 3.0, 1.0, 0.0 }, { -1.0, 0.0, 0.0 }), box));
+	ASSERT (HasFastRayBoundingBoxIntersection (Ray ({ 0.9, 0.5, 0.5 }, { 1.0, 1.0, 1.0 }), box));
+	ASSERT (HasFastRayBoundingBoxIntersection (Ray ({ 2.1, 0.5, 0.5 }, { -1.0, -1.0, -1.0 }), box));
+
+	double distance = 0.0;
+	ASSERT (GetRayBoundingBoxDistance (PrecomputedRay (Ray ({ 0.0, 0.5, 0.5 }, { 2.0, 0.0, 0.0 })), box, INF, distance));
+	ASSERT (IsEqual (distance, 1.0));
+	ASSERT (!GetRayBoundingBoxDistance (PrecomputedRay (Ray ({ 0.0, 0.5, 0.5 }, { 2.0, 0.0, 0.0 })), box, 0.5, distance));
+}
+
+TEST (FastRayTriangleBlockTest)
+{
+	std::mt19937 generator (42);
+	std::vector<Triangle> triangles = GenerateRandomTriangles (generator, 21, glm::dvec3 (0.0, 0.0, 0.0));
+	std::vector<Ray> rays = GenerateRays (generator, 1000);
+
+	std::vector<TriangleBlock4> blocks4 (1);
+	std::vector<TriangleBlock8> blocks8 (1);
+	for (const Triangle& triangle : triangles) {
+		if (blocks4.back ().IsFull ()) {
+			blocks4.push_back (TriangleBlock4 ());
+		}
+		if (blocks8.back ().IsFull ()) {
+			blocks8.push_back (TriangleBlock8 ());
+		}
+		blocks4.back ().Add (triangle[0], triangle[1], triangle[2]);
+		blocks8.back ().Add (triangle[0], triangle[1], triangle[2]);
+	}
+
+	size_t hitCount = 0;
+	for (const Ray& ray : rays) {
+		size_t scalarNearest = 0;
+		double scalarDistance = GetNearestScalarIntersection (ray, triangles, scalarNearest);
+
+		PrecomputedRay precomputedRay (ray);
+		double distance4 = INF;
+		size_t nearest4 = (size_t) -1;
+		for (size_t i = 0; i < blocks4.size (); i++) {
+			size_t index = GetRayTriangleBlockIntersection (precomputedRay, blocks4[i], distance4);
+			if (index != TriangleBlock4::Size) {
+				nearest4 = i * TriangleBlock4::Size + index;
+			}
+		}
+
+		double distance8 = INF;
+		size_t nearest8 = (size_t) -1;
+		for (size_t i = 0; i < blocks8.size (); i++) {
+			size_t index = GetRayTriangleBlockIntersection (precomputedRay, blocks8[i], distance8);
+			if (index != TriangleBlock8::Size) {
+				nearest8 = i * TriangleBlock8::Size + index;
+			}
+		}
+
+		ASSERT (nearest4 == scalarNearest);
+		ASSERT (nearest8 == scalarNearest);
+		if (scalarNearest != (size_t) -1) {
+			ASSERT (IsEqual (distance4, scalarDistance));
+			ASSERT (IsEqual (distance8, scalarDistance));
+			hitCount++;
+		}
+	}
+	ASSERT (hitCount > 0);
+}
+
+TEST (FastRayPacketTest)
+{
+	std::mt19937 generator (42);
+	std::vector<Triangle> triangles = GenerateRandomTriangles (generator, 20, glm::dvec3 (0.0, 0.0, 0.0));
+	std::vector<Ray> rays = GenerateRays (generator, 7);
+
+	RayPacket8 packet;
+	for (const Ray& ray : rays) {
+		packet.Add (ray);
+	}
+	ASSERT (packet.Count () == 7);
+
+	RayPacketHits8 hits;
+	BoundingBox box ({ -1.0, -1.0, -1.0 }, { 1.0, 1.0, 1.0 });
+	ASSERT (HasRayPacketBoundingBoxIntersection (packet, box, hits));
+	ASSERT (!HasRayPacketBoundingBoxIntersection (packet, BoundingBox ({ 10.0, 10.0, 10.0 }, { 11.0, 11.0, 11.0 }), hits));
+
+	for (size_t i = 0; i < triangles.size (); i++) {
+		GetRayPacketTriangleIntersection (packet, triangles[i][0], triangles[i][1], triangles[i][2], i, hits);
+	}
+	for (size_t i = 0; i < rays.size (); i++) {
+		size_t scalarNearest = 0;
+		double scalarDistance = GetNearestScalarIntersection (rays[i], triangles, scalarNearest);
+		if (scalarNearest == (size_t) -1) {
+			ASSERT (hits.ids[i] == RayPacketHits8::NoHit);
+		} else {
+			ASSERT (hits.ids[i] == scalarNearest);
+			ASSERT (IsEqual (hits.distances[i], scalarDistance));
+		}
+	}
+	ASSERT (hits.ids[7] == RayPacketHits8::NoHit);
+}
+
+TEST (FastRayCapacityTest)
+{
+	std::mt19937 generator (42);
+	std::vector<Triangle> triangles = GenerateRandomTriangles (generator, 5, glm::dvec3 (0.0, 0.0, 0.0));
+	std::vector<Ray> rays = GenerateRays (generator, 5);
+
+	TriangleBlock4 block;
+	for (size_t i = 0; i < 4; i++) {
+		ASSERT (block.Add (triangles[i][0], triangles[i][1], triangles[i][2]));
+	}
+	ASSERT (block.IsFull ());
+	ASSERT (!block.Add (triangles[4][0], triangles[4][1], triangles[4][2]));
+	ASSERT (block.Count () == 4);
+	ASSERT (IsEqual (block.v1x[3], triangles[3][0].x));
+
+	RayPacket4 packet;
+	for (size_t i = 0; i < 4; i++) {
+		ASSERT (packet.Add (rays[i]));
+	}
+	ASSERT (packet.IsFull ());
+	ASSERT (!packet.Add (rays[4]));
+	ASSERT (packet.Count () == 4);
+}
+
+}
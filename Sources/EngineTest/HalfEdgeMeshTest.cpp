@@ -0,0 +1,127 @@
+#include "SimpleTest.hpp"
+#include "HalfEdgeMesh.hpp"
+#include "MeshGenerators.hpp"
+
+using namespace Modeler;
+
+namespace HalfEdgeMeshTest
+{
+
+static bool IsConsistent (const HalfEdgeMesh& halfEdgeMesh)
+{
+	for (unsigned int halfEdge = 0; halfEdge < halfEdgeMesh.HalfEdgeCount (); halfEdge++) {
+		if (halfEdgeMesh.GetNext (halfEdgeMesh.GetPrev (halfEdge)) != halfEdge) {
+			return false;
+		}
+		if (halfEdgeMesh.GetTriangle (halfEdgeMesh.GetNext (halfEdge)) != halfEdgeMesh.GetTriangle (halfEdge)) {
+			return false;
+		}
+		unsigned int twin = halfEdgeMesh.GetTwin (halfEdge);
+		if (twin == NoHalfEdge) {
+			continue;
+		}
+		if (halfEdgeMesh.GetTwin (twin) != halfEdge) {
+			return false;
+		}
+		if (halfEdgeMesh.GetOrigin (twin) != halfEdgeMesh.GetTarget (halfEdge) || halfEdgeMesh.GetTarget (twin) != halfEdgeMesh.GetOrigin (halfEdge)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static unsigned int GetVertexHalfEdgeCount (const HalfEdgeMesh& halfEdgeMesh, unsigned int vertex)
+{
+	unsigned int count = 0;
+	halfEdgeMesh.EnumerateVertexHalfEdges (vertex, [&] (unsigned int halfEdge) {
+		if (halfEdgeMesh.GetOrigin (halfEdge) == vertex) {
+			count++;
+		}
+	});
+	return count;
+}
+
+TEST (HalfEdgeMeshEmptyTest)
+{
+	HalfEdgeMesh halfEdgeMesh;
+	ASSERT (halfEdgeMesh.Build (Mesh (), 0));
+	ASSERT (halfEdgeMesh.IsEmpty ());
+	ASSERT (halfEdgeMesh.IsClosed ());
+}
+
+TEST (HalfEdgeMeshOpenTest)
+{
+	Mesh mesh;
+	MaterialId material = mesh.AddMaterial (DefaultMaterial);
+	mesh.AddVertex (0.0, 0.0, 0.0);
+	mesh.AddVertex (1.0, 0.0, 0.0);
+	mesh.AddVertex (1.0, 1.0, 0.0);
+	mesh.AddVertex (0.0, 1.0, 0.0);
+	mesh.AddVertex (2.0, 2.0, 2.0);
+	mesh.AddTriangle (0, 1, 2, material);
+	mesh.AddTriangle (0, 2, 3, material);
+
+	HalfEdgeMesh halfEdgeMesh;
+	ASSERT (halfEdgeMesh.Build (mesh, 0));
+	ASSERT (!halfEdgeMesh.IsEmpty ());
+	ASSERT (!halfEdgeMesh.IsClosed ());
+	ASSERT (halfEdgeMesh.VertexCount () == 5);
+	ASSERT (halfEdgeMesh.TriangleCount () == 2);
+	ASSERT (halfEdgeMesh.HalfEdgeCount () == 6);
+	ASSERT (IsConsistent (halfEdgeMesh));
+
+	ASSERT (halfEdgeMesh.GetTwin (2) == 3);
+	ASSERT (halfEdgeMesh.GetTwin (3) == 2);
+	ASSERT (halfEdgeMesh.IsBoundaryHalfEdge (0));
+	ASSERT (!halfEdgeMesh.IsBoundaryHalfEdge (2));
+	ASSERT (halfEdgeMesh.GetOrigin (4) == 2);
+	ASSERT (halfEdgeMesh.GetTarget (4) == 3);
+
+	ASSERT (halfEdgeMesh.IsBoundaryVertex (0));
+	ASSERT (GetVertexHalfEdgeCount (halfEdgeMesh, 0) == 2);
+	ASSERT (GetVertexHalfEdgeCount (halfEdgeMesh, 1) == 1);
+	ASSERT (GetVertexHalfEdgeCount (halfEdgeMesh, 2) == 2);
+	ASSERT (halfEdgeMesh.GetVertexHalfEdge (4) == NoHalfEdge);
+	ASSERT (GetVertexHalfEdgeCount (halfEdgeMesh, 4) == 0);
+
+	ASSERT (halfEdgeMesh.GetMesh ().GetGeometryPtr () == mesh.GetGeometryPtr ());
+	ASSERT (halfEdgeMesh.GetMesh ().GetMaterialsPtr () == mesh.GetMaterialsPtr ());
+}
+
+TEST (HalfEdgeMeshNonManifoldTest)
+{
+	Mesh mesh;
+	MaterialId material = mesh.AddMaterial (DefaultMaterial);
+	mesh.AddVertex (0.0, 0.0, 0.0);
+	mesh.AddVertex (1.0, 0.0, 0.0);
+	mesh.AddVertex (1.0, 1.0, 0.0);
+	mesh.AddVertex (0.0, 1.0, 0.0);
+	mesh.AddTriangle (0, 1, 2, material);
+	mesh.AddTriangle (1, 2, 3, material);
+
+	HalfEdgeMesh halfEdgeMesh;
+	ASSERT (!halfEdgeMesh.Build (mesh, 0));
+	ASSERT (halfEdgeMesh.IsEmpty ());
+}
+
+TEST (HalfEdgeMeshClosedTest)
+{
+	Mesh sphere = GenerateSphere (DefaultMaterial, glm::dmat4 (1.0), 1.0, 100, false);
+	for (unsigned int threadCount : { 1, 3 }) {
+		HalfEdgeMesh halfEdgeMesh;
+		ASSERT (halfEdgeMesh.Build (sphere, threadCount));
+		ASSERT (halfEdgeMesh.IsClosed ());
+		ASSERT (IsConsistent (halfEdgeMesh));
+
+		std::vector<unsigned int> valences (halfEdgeMesh.VertexCount (), 0);
+		for (unsigned int halfEdge = 0; halfEdge < halfEdgeMesh.HalfEdgeCount (); halfEdge++) {
+			valences[halfEdgeMesh.GetOrigin (halfEdge)]++;
+		}
+		for (unsigned int vertex = 0; vertex < halfEdgeMesh.VertexCount (); vertex++) {
+			ASSERT (!halfEdgeMesh.IsBoundaryVertex (vertex));
+			ASSERT (GetVertexHalfEdgeCount (halfEdgeMesh, vertex) == valences[vertex]);
+		}
+	}
+}
+
+}
@@ -0,0 +1,149 @@
+#include "SimpleTest.hpp"
+#include "Geometry.hpp"
+#include "ImageRenderer.hpp"
+#include "ParallelTasks.hpp"
+#include "MeshGenerators.hpp"
+
+#include <atomic>
+#include <array>
+#include <stdexcept>
+
+using namespace Modeler;
+
+namespace ImageRendererTest
+{
+
+static const int ImageSize = 64;
+
+static std::vector<unsigned char> RenderImage (const ModelView& model, const Camera& camera, const ImageRenderSettings& settings)
+{
+	std::vector<unsigned char> pixels (ImageSize * ImageSize * 4, 0);
+	ImageRenderer renderer (model);
+	renderer.RenderImage (camera, ImageSize, ImageSize, settings, pixels.data ());
+	return pixels;
+}
+
+static std::array<unsigned char, 4> GetPixel (const std::vector<unsigned char>& pixels, int x, int y)
+{
+	size_t firstIndex = (y * ImageSize + x) * 4;
+	return { pixels[firstIndex], pixels[firstIndex + 1], pixels[firstIndex + 2], pixels[firstIndex + 3] };
+}
+
+static size_t SumPixels (const std::vector<unsigned char>& pixels)
+{
+	size_t sum = 0;
+	for (unsigned char value : pixels) {
+		sum += value;
+	}
+	return sum;
+}
+
+TEST (ParallelTasksTest)
+{
+	const size_t taskCount = 1000;
+	std::vector<std::atomic<int>> counters (taskCount);
+	for (std::atomic<int>& counter : counters) {
+		counter = 0;
+	}
+	RunParallelTasks (taskCount, 8, [&] (size_t taskIndex) {
+		counters[taskIndex]++;
+	});
+	for (const std::atomic<int>& counter : counters) {
+		ASSERT (counter == 1);
+	}
+
+	size_t runCount = 0;
+	RunParallelTasks (0, 0, [&] (size_t) {
+		runCount++;
+	});
+	ASSERT (runCount == 0);
+}
+
+TEST (ParallelTasksExceptionTest)
+{
+	for (unsigned int threadCount : { 1u, 4u }) {
+		std::atomic<size_t> finishedTasks (0);
+		bool caught = false;
+		try {
+			RunParallelTasks (1000, threadCount, [&] (size_t taskIndex) {
+				if (taskIndex == 10) {
+					throw std::runtime_error ("task failed");
+				}
+				finishedTasks++;
+			});
+		} catch (const std::runtime_error& ex) {
+			caught = std::string (ex.what ()) == "task failed";
+		}
+		ASSERT (caught);
+		ASSERT (finishedTasks < 1000);
+	}
+}
+
+TEST (ImageRendererEmptyModelTest)
+{
+	Model model;
+	Camera camera (glm::dvec3 (0.5, -5.0, 0.5), glm::dvec3 (0.5, 0.5, 0.5), glm::dvec3 (0.0, 0.0, 1.0), 45.0, 0.1, 100.0);
+	std::vector<unsigned char> pixels = RenderImage (model, camera, ImageRenderSettings ());
+	for (int y = 0; y < ImageSize; y++) {
+		for (int x = 0; x < ImageSize; x++) {
+			std::array<unsigned char, 4> pixel = GetPixel (pixels, x, y);
+			ASSERT (pixel[0] == 230 && pixel[1] == 230 && pixel[2] == 230 && pixel[3] == 0);
+		}
+	}
+}
+
+TEST (ImageRendererBoxTest)
+{
+	Model model;
+	model.AddMesh (GenerateBox (Material (glm::dvec3 (1.0, 0.0, 0.0)), glm::dmat4 (1.0), 1.0, 1.0, 1.0));
+	Camera camera (glm::dvec3 (0.5, -5.0, 0.5), glm::dvec3 (0.5, 0.5, 0.5), glm::dvec3 (0.0, 0.0, 1.0), 45.0, 0.1, 100.0);
+	std::vector<unsigned char> pixels = RenderImage (model, camera, ImageRenderSettings ());
+
+	std::array<unsigned char, 4> center = GetPixel (pixels, ImageSize / 2, ImageSize / 2);
+	ASSERT (center[0] == 255 && center[1] == 0 && center[2] == 0 && center[3] == 255);
+
+	std::array<unsigned char, 4> corner = GetPixel (pixels, 0, 0);
+	ASSERT (corner[0] == 230 && corner[1] == 230 && corner[2] == 230 && corner[3] == 0);
+}
+
+TEST (ImageRendererThreadCountTest)
+{
+	Model model;
+	model.AddMesh (GenerateBox (Material (glm::dvec3 (0.5, 0.5, 0.5)), glm::dmat4 (1.0), 1.0, 1.0, 1.0));
+	model.AddMesh (GenerateSphere (Material (glm::dvec3 (0.2, 0.4, 0.8)), glm::translate (glm::dmat4 (1.0), glm::dvec3 (1.0, 1.0, 1.0)), 0.5, 20, true));
+	Camera camera (glm::dvec3 (-2.0, -3.0, 2.5), glm::dvec3 (0.5, 0.5, 0.5), glm::dvec3 (0.0, 0.0, 1.0), 45.0, 0.1, 100.0);
+
+	ImageRenderSettings settings;
+	settings.tileSize = 7;
+	settings.threadCount = 1;
+	std::vector<unsigned char> singleThreadPixels = RenderImage (model, camera, settings);
+	settings.threadCount = 8;
+	std::vector<unsigned char> multiThreadPixels = RenderImage (model, camera, settings);
+	ASSERT (singleThreadPixels == multiThreadPixels);
+}
+
+TEST (ImageRendererAmbientOcclusionTest)
+{
+	Model model;
+	model.AddMesh (GenerateBox (Material (glm::dvec3 (0.5, 0.5, 0.5)), glm::translate (glm::dmat4 (1.0), glm::dvec3 (-5.0, -5.0, -1.0)), 10.0, 10.0, 1.0));
+	model.AddMesh (GenerateBox (Material (glm::dvec3 (0.5, 0.5, 0.5)), glm::dmat4 (1.0), 1.0, 1.0, 1.0));
+	Camera camera (glm::dvec3 (0.5, -3.0, 6.0), glm::dvec3 (0.5, 0.5, 0.0), glm::dvec3 (0.0, 0.0, 1.0), 45.0, 0.1, 100.0);
+
+	ImageRenderSettings settings;
+	settings.ambientOcclusionSamples = 0;
+	std::vector<unsigned char> plainPixels = RenderImage (model, camera, settings);
+	settings.ambientOcclusionSamples = 16;
+	std::vector<unsigned char> occludedPixels = RenderImage (model, camera, settings);
+
+	size_t darkerPixels = 0;
+	for (size_t i = 0; i < plainPixels.size (); i++) {
+		ASSERT (occludedPixels[i] <= plainPixels[i]);
+		if (occludedPixels[i] < plainPixels[i]) {
+			darkerPixels++;
+		}
+	}
+	ASSERT (darkerPixels > 0);
+	ASSERT (SumPixels (occludedPixels) < SumPixels (plainPixels));
+}
+
+}
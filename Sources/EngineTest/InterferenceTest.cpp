@@ -0,0 +1,79 @@
+#include "SimpleTest.hpp"
+#include "Geometry.hpp"
+#include "TriangleUtils.hpp"
+#include "Interference.hpp"
+#include "MeshGenerators.hpp"
+
+using namespace Geometry;
+using namespace Modeler;
+
+namespace InterferenceTest
+{
+
+static MeshId AddBox (Model& model, const glm::dvec3& position, double size)
+{
+	return model.AddMesh (GenerateBox (DefaultMaterial, glm::translate (glm::dmat4 (1.0), position), size, size, size));
+}
+
+TEST (TriangleTriangleIntersectionTest)
+{
+	Triangle triangle (glm::dvec3 (0.0, 0.0, 0.0), glm::dvec3 (1.0, 0.0, 0.0), glm::dvec3 (0.0, 1.0, 0.0));
+
+	ASSERT (HasTriangleTriangleIntersection (triangle, Triangle (glm::dvec3 (0.2, 0.2, -1.0), glm::dvec3 (0.2, 0.2, 1.0), glm::dvec3 (0.3, 0.5, 1.0))));
+	ASSERT (!HasTriangleTriangleIntersection (triangle, Triangle (glm::dvec3 (2.0, 2.0, -1.0), glm::dvec3 (2.0, 2.0, 1.0), glm::dvec3 (2.1, 2.5, 1.0))));
+	ASSERT (!HasTriangleTriangleIntersection (triangle, Triangle (glm::dvec3 (0.0, 0.0, 1.0), glm::dvec3 (1.0, 0.0, 1.0), glm::dvec3 (0.0, 1.0, 1.0))));
+	ASSERT (!HasTriangleTriangleIntersection (triangle, Triangle (glm::dvec3 (0.0, 0.0, 0.5), glm::dvec3 (1.0, 0.0, 0.5), glm::dvec3 (0.0, 1.0, 2.0))));
+	ASSERT (HasTriangleTriangleIntersection (triangle, Triangle (glm::dvec3 (1.0, 0.0, 0.0), glm::dvec3 (1.0, 0.0, 1.0), glm::dvec3 (1.0, 1.0, 1.0))));
+
+	ASSERT (HasTriangleTriangleIntersection (triangle, Triangle (glm::dvec3 (0.5, 0.0, 0.0), glm::dvec3 (1.5, 0.0, 0.0), glm::dvec3 (0.5, 1.0, 0.0))));
+	ASSERT (HasTriangleTriangleIntersection (triangle, Triangle (glm::dvec3 (0.1, 0.1, 0.0), glm::dvec3 (0.2, 0.1, 0.0), glm::dvec3 (0.1, 0.2, 0.0))));
+	ASSERT (HasTriangleTriangleIntersection (triangle, Triangle (glm::dvec3 (-1.0, -1.0, 0.0), glm::dvec3 (3.0, -1.0, 0.0), glm::dvec3 (-1.0, 3.0, 0.0))));
+	ASSERT (!HasTriangleTriangleIntersection (triangle, Triangle (glm::dvec3 (1.0, 1.0, 0.0), glm::dvec3 (2.0, 1.0, 0.0), glm::dvec3 (1.0, 2.0, 0.0))));
+}
+
+TEST (MeshInterferenceTest)
+{
+	Model model;
+	MeshId box1 = AddBox (model, glm::dvec3 (0.0, 0.0, 0.0), 1.0);
+	MeshId box2 = AddBox (model, glm::dvec3 (0.5, 0.5, 0.5), 1.0);
+	MeshId box3 = AddBox (model, glm::dvec3 (5.0, 0.0, 0.0), 1.0);
+	MeshId box4 = AddBox (model, glm::dvec3 (5.5, 0.0, 0.0), 0.2);
+	AddBox (model, glm::dvec3 (10.0, 0.0, 0.0), 1.0);
+
+	std::vector<MeshInterference> interferences = GetMeshInterferences (model);
+	ASSERT (interferences.size () == 2);
+	ASSERT (interferences[0].aMeshId == box1 && interferences[0].bMeshId == box2);
+	ASSERT (interferences[0].contactCount > 0);
+	ASSERT (interferences[1].aMeshId == box3 && interferences[1].bMeshId == box4);
+	ASSERT (interferences[1].contactCount > 0);
+}
+
+TEST (MeshInterferenceInsideTest)
+{
+	Model model;
+	MeshId outerBox = AddBox (model, glm::dvec3 (0.0, 0.0, 0.0), 3.0);
+	MeshId innerBox = AddBox (model, glm::dvec3 (1.0, 1.0, 1.0), 1.0);
+	MeshId outerSphere = model.AddMesh (GenerateSphere (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (10.0, 0.0, 0.0)), 1.0, 20, false));
+	AddBox (model, glm::dvec3 (10.7, 0.7, 0.7), 0.2);
+	MeshId innerBox2 = AddBox (model, glm::dvec3 (9.9, -0.1, -0.1), 0.2);
+
+	std::vector<MeshInterference> interferences = GetMeshInterferences (model);
+	ASSERT (interferences.size () == 2);
+	ASSERT (interferences[0].aMeshId == outerBox && interferences[0].bMeshId == innerBox);
+	ASSERT (interferences[0].contactCount == 0);
+	ASSERT (interferences[1].aMeshId == outerSphere && interferences[1].bMeshId == innerBox2);
+	ASSERT (interferences[1].contactCount == 0);
+}
+
+TEST (MeshInterferenceGridTest)
+{
+	Model model;
+	for (int i = 0; i < 10; i++) {
+		for (int j = 0; j < 10; j++) {
+			model.AddMesh (GenerateSphere (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (i * 1.5, j * 1.5, 0.0)), 0.8, 12, false));
+		}
+	}
+	ASSERT (GetMeshInterferences (model).size () == 2 * 10 * 9);
+}
+
+}
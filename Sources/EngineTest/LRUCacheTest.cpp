@@ -0,0 +1,61 @@
+#include "SimpleTest.hpp"
+#include "LRUCache.hpp"
+
+#include <string>
+
+using namespace Modeler;
+
+namespace LRUCacheTest
+{
+
+TEST (LRUCacheGetAddTest)
+{
+	LRUCache<int, std::string> cache (100, [] (const std::string& value) {
+		return value.length ();
+	});
+
+	std::string value;
+	ASSERT (!cache.Get (1, value));
+	cache.Add (1, "one");
+	cache.Add (2, "two");
+	ASSERT (cache.Count () == 2);
+	ASSERT (cache.Size () == 6);
+	ASSERT (cache.Get (1, value) && value == "one");
+	ASSERT (cache.Get (2, value) && value == "two");
+
+	cache.Add (1, "eins");
+	ASSERT (cache.Count () == 2);
+	ASSERT (cache.Size () == 7);
+	ASSERT (cache.Get (1, value) && value == "eins");
+
+	cache.Clear ();
+	ASSERT (cache.Count () == 0);
+	ASSERT (cache.Size () == 0);
+	ASSERT (!cache.Get (1, value));
+}
+
+TEST (LRUCacheEvictionTest)
+{
+	LRUCache<int, std::string> cache (10, [] (const std::string& value) {
+		return value.length ();
+	});
+
+	std::string value;
+	cache.Add (1, "aaaa");
+	cache.Add (2, "bbbb");
+	ASSERT (cache.Get (1, value));
+
+	// the least recently used value is dropped
+	cache.Add (3, "cccc");
+	ASSERT (cache.Count () == 2);
+	ASSERT (cache.Get (1, value));
+	ASSERT (!cache.Get (2, value));
+	ASSERT (cache.Get (3, value));
+
+	// values larger than the limit are not stored
+	cache.Add (4, "ddddddddddd");
+	ASSERT (!cache.Get (4, value));
+	ASSERT (cache.Count () == 2);
+}
+
+}
@@ -0,0 +1,156 @@
+#include "SimpleTest.hpp"
+#include "TestUtils.hpp"
+#include "Geometry.hpp"
+#include "LoopSubdivision.hpp"
+#include "MeshGenerators.hpp"
+#include "MeshValidation.hpp"
+#include "MassProperties.hpp"
+
+#include <cmath>
+
+using namespace Geometry;
+using namespace Modeler;
+
+namespace LoopSubdivisionTest
+{
+
+static bool IsAxisAligned (const glm::dvec3& vector)
+{
+	return IsEqual (std::fabs (vector.x) + std::fabs (vector.y) + std::fabs (vector.z), 1.0);
+}
+
+TEST (LoopSubdivisionSmoothTest)
+{
+	Mesh box = GenerateBox (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (1.0, 2.0, 3.0)), 1.0, 1.0, 1.0);
+	Mesh result;
+	ASSERT (SubdivideMesh (box, 1, glm::pi<double> (), 0, result, nullptr));
+	ASSERT (result.GetGeometry ().VertexCount () == 8 + 18);
+	ASSERT (result.GetGeometry ().TriangleCount () == 4 * 12);
+	ASSERT (ValidateMesh (result).IsValid ());
+	ASSERT (result.GetTransformation () == box.GetTransformation ());
+
+	MassProperties properties = CalcMeshMassProperties (result.GetGeometry (), result.GetTransformation ());
+	ASSERT (IsGreater (properties.volume, 0.0));
+	ASSERT (IsLower (properties.volume, 1.0));
+	ASSERT (IsEqualVec (properties.GetCentroid (), glm::dvec3 (1.5, 2.5, 3.5)));
+}
+
+TEST (LoopSubdivisionCreaseTest)
+{
+	Mesh box = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 1.0, 1.0, 1.0);
+	Mesh result;
+	ASSERT (SubdivideMesh (box, 2, glm::pi<double> () / 4.0, 0, result, nullptr));
+	ASSERT (result.GetGeometry ().TriangleCount () == 16 * 12);
+	ASSERT (ValidateMesh (result).IsValid ());
+
+	MassProperties properties = CalcMeshMassProperties (result.GetGeometry (), result.GetTransformation ());
+	ASSERT (IsEqual (properties.volume, 1.0));
+	ASSERT (IsEqual (properties.area, 6.0));
+	for (unsigned int i = 0; i < result.GetGeometry ().NormalCount (); i++) {
+		ASSERT (IsAxisAligned (result.GetGeometry ().GetNormal (i)));
+	}
+}
+
+TEST (LoopSubdivisionBoundaryTest)
+{
+	Mesh mesh;
+	MaterialId material1 = mesh.AddMaterial (Material (glm::dvec3 (1.0, 0.0, 0.0)));
+	MaterialId material2 = mesh.AddMaterial (Material (glm::dvec3 (0.0, 1.0, 0.0)));
+	mesh.AddVertex (0.0, 0.0, 0.0);
+	mesh.AddVertex (1.0, 0.0, 0.0);
+	mesh.AddVertex (1.0, 1.0, 0.0);
+	mesh.AddVertex (0.0, 1.0, 0.0);
+	mesh.AddTriangle (0, 1, 2, material1);
+	mesh.AddTriangle (0, 2, 3, material2);
+
+	Mesh result;
+	ASSERT (SubdivideMesh (mesh, 2, glm::pi<double> (), 0, result, nullptr));
+	const MeshGeometry& geometry = result.GetGeometry ();
+	ASSERT (geometry.TriangleCount () == 32);
+	for (unsigned int i = 0; i < geometry.VertexCount (); i++) {
+		ASSERT (IsEqual (geometry.GetVertex (i).z, 0.0));
+	}
+	ASSERT (IsGreaterOrEqual (geometry.GetBoundingBox ().GetMin ().x, 0.0));
+	ASSERT (IsLowerOrEqual (geometry.GetBoundingBox ().GetMax ().y, 1.0));
+
+	const MeshMaterials& materials = result.GetMaterials ();
+	ASSERT (materials.MaterialCount () == 2);
+	ASSERT (materials.TriangleRangeCount () == 2);
+	ASSERT (materials.GetTriangleMaterial (0) == material1);
+	ASSERT (materials.GetTriangleMaterial (15) == material1);
+	ASSERT (materials.GetTriangleMaterial (16) == material2);
+	ASSERT (materials.GetTriangleMaterial (31) == material2);
+	ASSERT (IsEqualVec (materials.GetMaterial (material2).GetColor (), glm::dvec3 (0.0, 1.0, 0.0)));
+}
+
+TEST (LoopSubdivisionThreadCountTest)
+{
+	Mesh sphere = GenerateSphere (DefaultMaterial, glm::dmat4 (1.0), 1.0, 20, true);
+	Mesh result1;
+	Mesh result3;
+	ASSERT (SubdivideMesh (sphere, 2, glm::pi<double> () / 6.0, 1, result1, nullptr));
+	ASSERT (SubdivideMesh (sphere, 2, glm::pi<double> () / 6.0, 3, result3, nullptr));
+	ASSERT (result1.GetGeometry ().CalcCheckSum () == result3.GetGeometry ().CalcCheckSum ());
+	ASSERT (ValidateMesh (result1).IsValid ());
+}
+
+TEST (LoopSubdivisionFailureTest)
+{
+	Mesh mesh;
+	MaterialId material = mesh.AddMaterial (DefaultMaterial);
+	mesh.AddVertex (0.0, 0.0, 0.0);
+	mesh.AddVertex (1.0, 0.0, 0.0);
+	mesh.AddVertex (1.0, 1.0, 0.0);
+	mesh.AddVertex (0.0, 1.0, 0.0);
+	mesh.AddTriangle (0, 1, 2, material);
+	mesh.AddTriangle (1, 2, 3, material);
+	Mesh result;
+	ASSERT (!SubdivideMesh (mesh, 1, glm::pi<double> (), 0, result, nullptr));
+
+	Mesh box = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 1.0, 1.0, 1.0);
+	OperationProgress progress;
+	progress.Cancel ();
+	ASSERT (!SubdivideMesh (box, 3, glm::pi<double> (), 0, result, &progress));
+}
+
+TEST (LoopSubdivisionCancelDuringOperationTest)
+{
+	// the application cancels the progress of the evaluation from the progress
+	// callback, the remaining steps must not run after that
+	Mesh box = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 1.0, 1.0, 1.0);
+	std::shared_ptr<OperationProgress> progress;
+	size_t reportCount = 0;
+	progress.reset (new OperationProgress ([&] (double) {
+		reportCount++;
+		progress->Cancel ();
+	}));
+
+	Mesh result;
+	ASSERT (!SubdivideMesh (box, 5, glm::pi<double> (), 0, result, progress.get ()));
+	ASSERT (progress->IsCancelled ());
+	ASSERT (reportCount == 1);
+	ASSERT (progress->GetProgress () < 1.0);
+	ASSERT (result.GetGeometry ().TriangleCount () == 0);
+}
+
+TEST (LoopSubdivisionStepProgressTest)
+{
+	// the first of two steps is one fifth of the work, and it reports its own
+	// progress before the step is finished
+	Mesh box = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 1.0, 1.0, 1.0);
+	std::vector<double> reportedProgress;
+	OperationProgress progress ([&] (double newProgress) {
+		reportedProgress.push_back (newProgress);
+	});
+
+	Mesh result;
+	ASSERT (SubdivideMesh (box, 2, glm::pi<double> (), 0, result, &progress));
+	ASSERT (reportedProgress.size () > 3);
+	ASSERT (reportedProgress[0] > 0.0 && reportedProgress[0] < 0.2);
+	for (size_t i = 1; i < reportedProgress.size (); i++) {
+		ASSERT (reportedProgress[i - 1] <= reportedProgress[i]);
+	}
+	ASSERT (reportedProgress.back () == 1.0);
+}
+
+}
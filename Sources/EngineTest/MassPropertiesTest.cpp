@@ -0,0 +1,116 @@
+#include "SimpleTest.hpp"
+#include "TestUtils.hpp"
+#include "Geometry.hpp"
+#include "MassProperties.hpp"
+#include "MeshGenerators.hpp"
+#include "Model.hpp"
+
+#include <thread>
+
+using namespace Geometry;
+using namespace Modeler;
+
+namespace MassPropertiesTest
+{
+
+static bool IsEqualMatrix (const glm::dmat3& a, const glm::dmat3& b)
+{
+	for (int i = 0; i < 3; i++) {
+		if (!IsEqualVec (a[i], b[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static glm::dmat3 GetBoxInertiaTensor (double x, double y, double z)
+{
+	double volume = x * y * z;
+	glm::dmat3 result (0.0);
+	result[0][0] = volume / 12.0 * (y * y + z * z);
+	result[1][1] = volume / 12.0 * (x * x + z * z);
+	result[2][2] = volume / 12.0 * (x * x + y * y);
+	return result;
+}
+
+TEST (MassPropertiesEmptyTest)
+{
+	MeshGeometry geometry;
+	MassProperties properties = CalcMeshMassProperties (geometry, glm::dmat4 (1.0));
+	ASSERT (IsEqual (properties.area, 0.0));
+	ASSERT (IsEqual (properties.volume, 0.0));
+	ASSERT (IsEqualVec (properties.GetCentroid (), glm::dvec3 (0.0, 0.0, 0.0)));
+}
+
+TEST (MassPropertiesBoxTest)
+{
+	Mesh box = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 1.0, 2.0, 3.0);
+	MassProperties properties = CalcMeshMassProperties (box.GetGeometry (), box.GetTransformation ());
+	ASSERT (IsEqual (properties.area, 22.0));
+	ASSERT (IsEqual (properties.volume, 6.0));
+	ASSERT (IsEqualVec (properties.GetCentroid (), glm::dvec3 (0.5, 1.0, 1.5)));
+	ASSERT (IsEqualMatrix (properties.GetInertiaTensor (), GetBoxInertiaTensor (1.0, 2.0, 3.0)));
+}
+
+TEST (MassPropertiesTransformedBoxTest)
+{
+	glm::dmat4 transformation = glm::translate (glm::dmat4 (1.0), glm::dvec3 (1000.0, -2000.0, 3000.0));
+	transformation = glm::rotate (transformation, glm::radians (90.0), glm::dvec3 (0.0, 0.0, 1.0));
+	Mesh box = GenerateBox (DefaultMaterial, transformation, 1.0, 2.0, 3.0);
+	MassProperties properties = CalcMeshMassProperties (box.GetGeometry (), box.GetTransformation ());
+	ASSERT (IsEqual (properties.area, 22.0));
+	ASSERT (IsEqual (properties.volume, 6.0));
+	ASSERT (IsEqualVec (properties.GetCentroid (), glm::dvec3 (999.0, -1999.5, 3001.5)));
+	ASSERT (IsEqualMatrix (properties.GetInertiaTensor (), GetBoxInertiaTensor (2.0, 1.0, 3.0)));
+}
+
+TEST (MassPropertiesSphereTest)
+{
+	Mesh sphere = GenerateSphere (DefaultMaterial, glm::dmat4 (1.0), 1.0, 100, true);
+	MassProperties properties = CalcMeshMassProperties (sphere.GetGeometry (), sphere.GetTransformation ());
+	ASSERT (std::fabs (properties.area - 4.0 * PI) < 0.01);
+	ASSERT (std::fabs (properties.volume - 4.0 / 3.0 * PI) < 0.01);
+	ASSERT (IsEqualVec (properties.GetCentroid (), glm::dvec3 (0.0, 0.0, 0.0)));
+}
+
+TEST (MassPropertiesModelTest)
+{
+	Model model;
+	model.AddMesh (GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 1.0, 1.0, 1.0));
+	model.AddMesh (GenerateBox (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (2.0, 0.0, 0.0)), 1.0, 1.0, 1.0));
+
+	MassProperties properties = model.CalcMassProperties ();
+	ASSERT (IsEqual (properties.area, 12.0));
+	ASSERT (IsEqual (properties.volume, 2.0));
+	ASSERT (IsEqualVec (properties.GetCentroid (), glm::dvec3 (1.5, 0.5, 0.5)));
+
+	glm::dmat3 expected = GetBoxInertiaTensor (1.0, 1.0, 1.0) * 2.0;
+	expected[1][1] += 2.0;
+	expected[2][2] += 2.0;
+	ASSERT (IsEqualMatrix (properties.GetInertiaTensor (), expected));
+}
+
+TEST (MassPropertiesConcurrentRemoveTest)
+{
+	Model model;
+	std::vector<MeshId> meshIds;
+	for (int i = 0; i < 200; i++) {
+		meshIds.push_back (model.AddMesh (GenerateBox (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (2.0 * i, 0.0, 0.0)), 1.0, 1.0, 1.0 + i)));
+	}
+
+	// every result is the volume of the meshes remaining at enumeration
+	std::thread remover ([&] () {
+		for (MeshId meshId : meshIds) {
+			model.RemoveMesh (meshId);
+		}
+	});
+	for (int i = 0; i < 20; i++) {
+		MassProperties properties = model.CalcMassProperties ();
+		ASSERT (properties.volume >= 0.0);
+		ASSERT (properties.volume <= 200.0 * 201.0 / 2.0 + 1.0);
+	}
+	remover.join ();
+	ASSERT (IsEqual (model.CalcMassProperties ().volume, 0.0));
+}
+
+}
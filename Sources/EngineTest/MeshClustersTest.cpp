@@ -0,0 +1,52 @@
+#include "SimpleTest.hpp"
+#include "TestUtils.hpp"
+#include "Geometry.hpp"
+#include "MeshClusters.hpp"
+#include "MeshGenerators.hpp"
+#include "MassProperties.hpp"
+
+using namespace Geometry;
+using namespace Modeler;
+
+namespace MeshClustersTest
+{
+
+TEST (MeshClustersTest)
+{
+	std::vector<Mesh> meshes = {
+		GenerateCube (glm::dvec3 (0.0, 0.0, 0.0), 1.0),
+		GenerateCube (glm::dvec3 (5.0, 0.0, 0.0), 1.0),
+		GenerateCube (glm::dvec3 (1.5, 0.0, 0.0), 1.0),
+		GenerateCube (glm::dvec3 (0.5, 0.0, 0.0), 1.0),
+		GenerateCube (glm::dvec3 (1.0, 0.0, 0.0), 1.0),
+		GenerateCube (glm::dvec3 (5.0, 1.0, 0.0), 1.0),
+		Mesh ()
+	};
+
+	std::vector<std::vector<size_t>> clusters = GetMeshClusters (meshes);
+	ASSERT (clusters.size () == 3);
+	ASSERT (clusters[0] == std::vector<size_t> ({ 0, 3, 4, 2 }));
+	ASSERT (clusters[1] == std::vector<size_t> ({ 1, 5 }));
+	ASSERT (clusters[2] == std::vector<size_t> ({ 6 }));
+	ASSERT (GetMeshClusters ({}).empty ());
+}
+
+TEST (MergeMeshesTest)
+{
+	Mesh redCube = GenerateBox (Material (glm::dvec3 (1.0, 0.0, 0.0)), glm::dmat4 (1.0), 1.0, 1.0, 1.0);
+	Mesh blueCube = GenerateBox (Material (glm::dvec3 (0.0, 0.0, 1.0)), glm::translate (glm::dmat4 (1.0), glm::dvec3 (3.0, 0.0, 0.0)), 1.0, 1.0, 1.0);
+	Mesh merged = MergeMeshes ({ redCube, blueCube });
+
+	const MeshGeometry& geometry = merged.GetGeometry ();
+	ASSERT (geometry.VertexCount () == 2 * redCube.GetGeometry ().VertexCount ());
+	ASSERT (geometry.TriangleCount () == 2 * redCube.GetGeometry ().TriangleCount ());
+	ASSERT (merged.GetMaterials ().MaterialCount () == 2);
+	ASSERT (merged.GetMaterials ().IsGroupedByMaterial ());
+	ASSERT (IsEqualVec (merged.GetMaterials ().GetMaterial (merged.GetMaterials ().GetTriangleMaterial (geometry.TriangleCount () - 1)).GetColor (), glm::dvec3 (0.0, 0.0, 1.0)));
+
+	MassProperties properties = CalcMeshMassProperties (geometry, merged.GetTransformation ());
+	ASSERT (IsEqual (properties.volume, 2.0));
+	ASSERT (IsEqualVec (properties.GetCentroid (), (redCube.GetGeometry ().GetBoundingBox ().GetCenter () + glm::dvec3 (1.5, 0.0, 0.0))));
+}
+
+}
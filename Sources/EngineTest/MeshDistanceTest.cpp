@@ -0,0 +1,124 @@
+#include "SimpleTest.hpp"
+#include "TestUtils.hpp"
+#include "Geometry.hpp"
+#include "TriangleUtils.hpp"
+#include "MeshDistance.hpp"
+#include "MeshGenerators.hpp"
+
+#include <random>
+
+using namespace Geometry;
+using namespace Modeler;
+
+namespace MeshDistanceTest
+{
+
+static std::vector<glm::dvec3> GenerateRandomPoints (size_t count, double size)
+{
+	std::mt19937 generator (42);
+	std::uniform_real_distribution<double> distribution (-size, size);
+	std::vector<glm::dvec3> points;
+	for (size_t i = 0; i < count; i++) {
+		points.push_back (glm::dvec3 (distribution (generator), distribution (generator), distribution (generator)));
+	}
+	return points;
+}
+
+static double GetBruteForceDistance (const Mesh& mesh, const glm::dvec3& point)
+{
+	const MeshGeometry& geometry = mesh.GetGeometry ();
+	double minDistance = INF;
+	geometry.EnumerateTriangles ([&] (const MeshTriangle& meshTriangle) {
+		Triangle triangle (
+			geometry.GetVertex (meshTriangle.v1, mesh.GetTransformation ()),
+			geometry.GetVertex (meshTriangle.v2, mesh.GetTransformation ()),
+			geometry.GetVertex (meshTriangle.v3, mesh.GetTransformation ())
+		);
+		minDistance = std::min (minDistance, glm::distance (point, GetTriangleClosestPoint (triangle, point).point));
+	});
+	return minDistance;
+}
+
+TEST (TriangleClosestPointTest)
+{
+	Triangle triangle (glm::dvec3 (0.0, 0.0, 0.0), glm::dvec3 (1.0, 0.0, 0.0), glm::dvec3 (0.0, 1.0, 0.0));
+
+	TriangleClosestPoint face = GetTriangleClosestPoint (triangle, glm::dvec3 (0.2, 0.2, 1.0));
+	ASSERT (face.feature == TriangleFeature::Face);
+	ASSERT (IsEqualVec (face.point, glm::dvec3 (0.2, 0.2, 0.0)));
+
+	TriangleClosestPoint edge1 = GetTriangleClosestPoint (triangle, glm::dvec3 (0.5, -1.0, 0.0));
+	ASSERT (edge1.feature == TriangleFeature::Edge1);
+	ASSERT (IsEqualVec (edge1.point, glm::dvec3 (0.5, 0.0, 0.0)));
+
+	TriangleClosestPoint edge2 = GetTriangleClosestPoint (triangle, glm::dvec3 (1.0, 1.0, 0.5));
+	ASSERT (edge2.feature == TriangleFeature::Edge2);
+	ASSERT (IsEqualVec (edge2.point, glm::dvec3 (0.5, 0.5, 0.0)));
+
+	TriangleClosestPoint edge3 = GetTriangleClosestPoint (triangle, glm::dvec3 (-1.0, 0.5, 0.0));
+	ASSERT (edge3.feature == TriangleFeature::Edge3);
+	ASSERT (IsEqualVec (edge3.point, glm::dvec3 (0.0, 0.5, 0.0)));
+
+	ASSERT (GetTriangleClosestPoint (triangle, glm::dvec3 (-1.0, -1.0, 1.0)).feature == TriangleFeature::Vertex1);
+	ASSERT (GetTriangleClosestPoint (triangle, glm::dvec3 (2.0, -1.0, 0.0)).feature == TriangleFeature::Vertex2);
+	ASSERT (GetTriangleClosestPoint (triangle, glm::dvec3 (-1.0, 2.0, 0.0)).feature == TriangleFeature::Vertex3);
+
+	Triangle degenerate (glm::dvec3 (0.0, 0.0, 0.0), glm::dvec3 (0.0, 0.0, 0.0), glm::dvec3 (0.0, 1.0, 0.0));
+	ASSERT (IsEqualVec (GetTriangleClosestPoint (degenerate, glm::dvec3 (1.0, 0.5, 0.0)).point, glm::dvec3 (0.0, 0.5, 0.0)));
+}
+
+TEST (MeshDistanceEmptyTest)
+{
+	MeshDistanceQuery query (EmptyMesh);
+	ASSERT (query.IsEmpty ());
+	ASSERT (!query.GetClosestPoint (glm::dvec3 (0.0, 0.0, 0.0)).IsValid ());
+	ASSERT (query.GetDistance (glm::dvec3 (0.0, 0.0, 0.0)) == INF);
+	ASSERT (query.GetSignedDistance (glm::dvec3 (0.0, 0.0, 0.0)) == INF);
+}
+
+TEST (MeshDistanceBoxTest)
+{
+	Mesh box = GenerateBox (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (1.0, 1.0, 1.0)), 1.0, 1.0, 1.0);
+	MeshDistanceQuery query (box);
+	ASSERT (!query.IsEmpty ());
+
+	MeshClosestPoint closestPoint = query.GetClosestPoint (glm::dvec3 (1.5, 1.5, 3.0));
+	ASSERT (closestPoint.IsValid ());
+	ASSERT (IsEqualVec (closestPoint.point, glm::dvec3 (1.5, 1.5, 2.0)));
+	ASSERT (IsEqual (closestPoint.distance, 1.0));
+
+	ASSERT (IsEqual (query.GetSignedDistance (glm::dvec3 (1.5, 1.5, 3.0)), 1.0));
+	ASSERT (IsEqual (query.GetSignedDistance (glm::dvec3 (1.5, 1.5, 1.5)), -0.5));
+	ASSERT (IsEqual (query.GetSignedDistance (glm::dvec3 (1.9, 1.9, 1.5)), -0.1));
+	ASSERT (IsEqual (query.GetSignedDistance (glm::dvec3 (3.0, 3.0, 1.5)), std::sqrt (2.0)));
+	ASSERT (IsEqual (query.GetSignedDistance (glm::dvec3 (3.0, 3.0, 3.0)), std::sqrt (3.0)));
+	ASSERT (IsEqual (query.GetSignedDistance (glm::dvec3 (0.0, 0.0, 0.0)), std::sqrt (3.0)));
+	ASSERT (IsEqual (query.GetDistance (glm::dvec3 (1.5, 1.5, 1.5)), 0.5));
+}
+
+TEST (MeshDistanceSphereTest)
+{
+	const double radius = 1.0;
+	Mesh sphere = GenerateSphere (DefaultMaterial, glm::dmat4 (1.0), radius, 30, true);
+	MeshDistanceQuery query (sphere);
+
+	std::vector<glm::dvec3> points = GenerateRandomPoints (500, 2.0);
+	std::vector<MeshClosestPoint> closestPoints = query.GetClosestPoints (points, 4);
+	std::vector<double> distances = query.GetDistances (points, 4);
+	std::vector<double> signedDistances = query.GetSignedDistances (points, 4);
+	ASSERT (closestPoints.size () == points.size ());
+	for (size_t i = 0; i < points.size (); i++) {
+		const glm::dvec3& point = points[i];
+		double distance = GetBruteForceDistance (sphere, point);
+		ASSERT (IsEqual (closestPoints[i].distance, distance));
+		ASSERT (IsEqual (glm::distance (closestPoints[i].point, point), distance));
+		ASSERT (distances[i] == closestPoints[i].distance);
+		ASSERT (IsEqual (std::fabs (signedDistances[i]), distance));
+		ASSERT (signedDistances[i] == query.GetSignedDistance (point));
+		if (IsGreater (distance, 0.01)) {
+			ASSERT ((signedDistances[i] < 0.0) == (glm::length (point) < radius));
+		}
+	}
+}
+
+}
@@ -0,0 +1,105 @@
+#include "SimpleTest.hpp"
+#include "TestUtils.hpp"
+#include "Geometry.hpp"
+#include "MeshOverlap.hpp"
+#include "MeshClusters.hpp"
+#include "MeshGenerators.hpp"
+
+using namespace Geometry;
+using namespace Modeler;
+
+namespace MeshOverlapTest
+{
+
+static unsigned int TriangleCount (const Mesh& mesh)
+{
+	return mesh.GetGeometry ().TriangleCount ();
+}
+
+TEST (SeparatedMeshOverlapTest)
+{
+	Mesh cube1 = GenerateCube (glm::dvec3 (0.0, 0.0, 0.0), 1.0);
+	Mesh cube2 = GenerateCube (glm::dvec3 (2.0, 0.0, 0.0), 1.0);
+	MeshOverlapPartition aPartition;
+	MeshOverlapPartition bPartition;
+	PartitionMeshOverlap (cube1, cube2, aPartition, bPartition);
+	ASSERT (aPartition.outside.GetGeometryPtr () == cube1.GetGeometryPtr ());
+	ASSERT (TriangleCount (aPartition.inside) == 0);
+	ASSERT (TriangleCount (aPartition.touching) == 0);
+	ASSERT (bPartition.outside.GetGeometryPtr () == cube2.GetGeometryPtr ());
+}
+
+TEST (ContainedMeshOverlapTest)
+{
+	Mesh bigCube = GenerateCube (glm::dvec3 (0.0, 0.0, 0.0), 3.0);
+	Mesh smallCube = GenerateCube (glm::dvec3 (1.0, 1.0, 1.0), 1.0);
+	MeshOverlapPartition aPartition;
+	MeshOverlapPartition bPartition;
+	PartitionMeshOverlap (bigCube, smallCube, aPartition, bPartition);
+	ASSERT (TriangleCount (aPartition.outside) == TriangleCount (bigCube));
+	ASSERT (TriangleCount (bPartition.inside) == TriangleCount (smallCube));
+	ASSERT (TriangleCount (bPartition.outside) == 0);
+	ASSERT (TriangleCount (aPartition.touching) == 0);
+	ASSERT (TriangleCount (bPartition.touching) == 0);
+}
+
+TEST (TouchingMeshOverlapTest)
+{
+	Mesh cube1 = GenerateCube (glm::dvec3 (0.0, 0.0, 0.0), 1.0);
+	Mesh cube2 = GenerateCube (glm::dvec3 (1.0, 0.0, 0.0), 1.0);
+	Mesh cube3 = GenerateCube (glm::dvec3 (0.5, 0.5, 0.5), 1.0);
+	MeshOverlapPartition aPartition;
+	MeshOverlapPartition bPartition;
+	PartitionMeshOverlap (cube1, cube2, aPartition, bPartition);
+	ASSERT (TriangleCount (aPartition.touching) == TriangleCount (cube1));
+	ASSERT (TriangleCount (bPartition.touching) == TriangleCount (cube2));
+	PartitionMeshOverlap (cube1, cube3, aPartition, bPartition);
+	ASSERT (TriangleCount (aPartition.touching) == TriangleCount (cube1));
+	ASSERT (TriangleCount (aPartition.outside) == 0);
+}
+
+TEST (NearContactMeshOverlapTest)
+{
+	Mesh cube1 = GenerateCube (glm::dvec3 (0.0, 0.0, 0.0), 1.0);
+	Mesh nearCube = GenerateCube (glm::dvec3 (1.0 + 1.0e-7, 0.0, 0.0), 1.0);
+	Mesh farCube = GenerateCube (glm::dvec3 (1.01, 0.0, 0.0), 1.0);
+	MeshOverlapPartition aPartition;
+	MeshOverlapPartition bPartition;
+	PartitionMeshOverlap (cube1, nearCube, aPartition, bPartition);
+	ASSERT (TriangleCount (aPartition.touching) == TriangleCount (cube1));
+	ASSERT (TriangleCount (bPartition.touching) == TriangleCount (nearCube));
+	PartitionMeshOverlap (cube1, farCube, aPartition, bPartition);
+	ASSERT (TriangleCount (aPartition.outside) == TriangleCount (cube1));
+	ASSERT (TriangleCount (bPartition.outside) == TriangleCount (farCube));
+
+	// a cube nearly touching the inner side of a face is not classified as inside
+	Mesh bigCube = GenerateCube (glm::dvec3 (0.0, 0.0, 0.0), 3.0);
+	Mesh innerCube = GenerateCube (glm::dvec3 (1.0, 1.0, 2.0 - 1.0e-7), 1.0);
+	PartitionMeshOverlap (bigCube, innerCube, aPartition, bPartition);
+	ASSERT (TriangleCount (bPartition.touching) == TriangleCount (innerCube));
+	ASSERT (TriangleCount (bPartition.inside) == 0);
+}
+
+TEST (ComponentsMeshOverlapTest)
+{
+	Mesh plate = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 10.0, 10.0, 1.0);
+	Mesh drills = MergeMeshes ({
+		GenerateCube (glm::dvec3 (1.0, 1.0, -0.5), 1.0),
+		GenerateCube (glm::dvec3 (4.0, 4.0, 0.25), 0.5),
+		GenerateCube (glm::dvec3 (20.0, 1.0, 0.0), 1.0),
+		GenerateCube (glm::dvec3 (1.0, 1.0, 5.0), 1.0)
+	});
+	unsigned int cubeTriangleCount = TriangleCount (GenerateCube (glm::dvec3 (0.0, 0.0, 0.0), 1.0));
+
+	MeshOverlapPartition aPartition;
+	MeshOverlapPartition bPartition;
+	PartitionMeshOverlap (plate, drills, aPartition, bPartition);
+	ASSERT (aPartition.touching.GetGeometryPtr () == plate.GetGeometryPtr ());
+	ASSERT (TriangleCount (bPartition.touching) == cubeTriangleCount);
+	ASSERT (TriangleCount (bPartition.inside) == cubeTriangleCount);
+	ASSERT (TriangleCount (bPartition.outside) == 2 * cubeTriangleCount);
+	ASSERT (IsEqualVec (bPartition.inside.GetGeometry ().GetBoundingBox ().GetMin (), glm::dvec3 (4.0, 4.0, 0.25)));
+	ASSERT (bPartition.outside.GetGeometry ().VertexCount () == 2 * GenerateCube (glm::dvec3 (0.0, 0.0, 0.0), 1.0).GetGeometry ().VertexCount ());
+}
+
+}
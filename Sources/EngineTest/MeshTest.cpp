@@ -0,0 +1,168 @@
+#include "SimpleTest.hpp"
+#include "Geometry.hpp"
+#include "Mesh.hpp"
+#include "Model.hpp"
+#include "BasicShapes.hpp"
+#include "MeshGenerators.hpp"
+#include "TestUtils.hpp"
+
+using namespace Geometry;
+using namespace Modeler;
+
+namespace MeshTest
+{
+
+TEST (MeshCopyOnWriteTest)
+{
+	Mesh mesh1 = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 1.0, 1.0, 1.0);
+	Mesh mesh2 = mesh1;
+	ASSERT (mesh1.GetGeometryPtr () == mesh2.GetGeometryPtr ());
+	ASSERT (mesh1.GetMaterialsPtr () == mesh2.GetMaterialsPtr ());
+
+	mesh2.AddTransformation (glm::translate (glm::dmat4 (1.0), glm::dvec3 (1.0, 0.0, 0.0)));
+	ASSERT (mesh1.GetGeometryPtr () == mesh2.GetGeometryPtr ());
+
+	mesh2.AddVertex (2.0, 2.0, 2.0);
+	ASSERT (mesh1.GetGeometryPtr () != mesh2.GetGeometryPtr ());
+	ASSERT (mesh1.GetMaterialsPtr () == mesh2.GetMaterialsPtr ());
+	ASSERT (mesh1.GetGeometry ().VertexCount () == 8);
+	ASSERT (mesh2.GetGeometry ().VertexCount () == 9);
+
+	mesh2.AddTriangle (0, 1, 8, 0);
+	ASSERT (mesh1.GetMaterialsPtr () != mesh2.GetMaterialsPtr ());
+	ASSERT (mesh1.GetGeometry ().TriangleCount () == 12);
+	ASSERT (mesh2.GetGeometry ().TriangleCount () == 13);
+
+	const MeshGeometry* geometry = &mesh2.GetGeometry ();
+	mesh2.AddVertex (3.0, 3.0, 3.0);
+	ASSERT (&mesh2.GetGeometry () == geometry);
+}
+
+TEST (MeshShapeSharedDataTest)
+{
+	Mesh mesh = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 1.0, 1.0, 1.0);
+	MeshShape shape (glm::dmat4 (1.0), mesh);
+
+	ShapePtr cloned = shape.Clone ();
+	ShapePtr transformed = shape.Transform (glm::translate (glm::dmat4 (1.0), glm::dvec3 (1.0, 0.0, 0.0)));
+
+	Mesh clonedMesh = cloned->GenerateMesh ();
+	Mesh transformedMesh = transformed->GenerateMesh ();
+	ASSERT (clonedMesh.GetGeometryPtr () == mesh.GetGeometryPtr ());
+	ASSERT (transformedMesh.GetGeometryPtr () == mesh.GetGeometryPtr ());
+	ASSERT (transformedMesh.GetMaterialsPtr () == mesh.GetMaterialsPtr ());
+	ASSERT (IsEqualVec (transformedMesh.GetGeometry ().GetVertex (0, transformedMesh.GetTransformation ()), glm::dvec3 (1.0, 0.0, 0.0)));
+	ASSERT (IsEqualVec (clonedMesh.GetGeometry ().GetVertex (0, clonedMesh.GetTransformation ()), glm::dvec3 (0.0, 0.0, 0.0)));
+}
+
+TEST (MeshTriangleRangesTest)
+{
+	Mesh mesh;
+	MaterialId material1 = mesh.AddMaterial (Material (glm::dvec3 (1.0, 0.0, 0.0)));
+	MaterialId material2 = mesh.AddMaterial (Material (glm::dvec3 (0.0, 1.0, 0.0)));
+	mesh.AddVertex (0.0, 0.0, 0.0);
+	mesh.AddVertex (1.0, 0.0, 0.0);
+	mesh.AddVertex (1.0, 1.0, 0.0);
+	mesh.AddTriangle (0, 1, 2, material2);
+	mesh.AddTriangle (0, 1, 2, material1);
+	mesh.AddTriangle (0, 1, 2, material1);
+	mesh.AddTriangle (0, 2, 1, material2);
+
+	const MeshMaterials& materials = mesh.GetMaterials ();
+	ASSERT (materials.TriangleRangeCount () == 3);
+	ASSERT (!materials.IsGroupedByMaterial ());
+	ASSERT (materials.GetTriangleMaterial (0) == material2);
+	ASSERT (materials.GetTriangleMaterial (1) == material1);
+	ASSERT (materials.GetTriangleMaterial (2) == material1);
+	ASSERT (materials.GetTriangleMaterial (3) == material2);
+
+	Mesh groupedMesh = mesh;
+	groupedMesh.GroupTrianglesByMaterial ();
+	const MeshGeometry& groupedGeometry = groupedMesh.GetGeometry ();
+	const MeshMaterials& groupedMaterials = groupedMesh.GetMaterials ();
+	ASSERT (groupedMaterials.IsGroupedByMaterial ());
+	ASSERT (groupedMaterials.TriangleRangeCount () == 2);
+	ASSERT (groupedMaterials.GetTriangleRange (0).material == material1);
+	ASSERT (groupedMaterials.GetTriangleRange (0).first == 0);
+	ASSERT (groupedMaterials.GetTriangleRange (0).count == 2);
+	ASSERT (groupedMaterials.GetTriangleRange (1).material == material2);
+	ASSERT (groupedMaterials.GetTriangleRange (1).first == 2);
+	ASSERT (groupedMaterials.GetTriangleRange (1).count == 2);
+	ASSERT (groupedGeometry.TriangleCount () == 4);
+	ASSERT (groupedGeometry.GetTriangle (2).v2 == 1);
+	ASSERT (groupedGeometry.GetTriangle (3).v2 == 2);
+	ASSERT (mesh.GetMaterials ().TriangleRangeCount () == 3);
+
+	Model model;
+	MeshId meshId = model.AddMesh (mesh);
+	MeshRefConstPtr meshRef = model.GetMesh (meshId);
+	ASSERT (meshRef->GetGeometryPtr () == mesh.GetGeometryPtr ());
+	ASSERT (model.GetMeshMaterials (*meshRef).GetTriangleMaterial (0) == material2);
+
+	Mesh emptyMesh;
+	bool thrown = false;
+	try {
+		emptyMesh.GetMaterials ().GetTriangleMaterial (0);
+	} catch (const std::out_of_range&) {
+		thrown = true;
+	}
+	ASSERT (thrown);
+}
+
+TEST (MemoryUsageTest)
+{
+	Mesh mesh = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 1.0, 1.0, 1.0);
+	const MeshGeometry& geometry = mesh.GetGeometry ();
+	const MeshMaterials& materials = mesh.GetMaterials ();
+	ASSERT (geometry.CalcMemoryUsage () >= 8 * sizeof (glm::dvec3) + 6 * sizeof (glm::dvec3) + 12 * sizeof (MeshTriangle));
+	ASSERT (materials.CalcMemoryUsage () >= sizeof (Material) + sizeof (TriangleMaterialRange));
+	ASSERT (mesh.CalcMemoryUsage () > geometry.CalcMemoryUsage () + materials.CalcMemoryUsage ());
+
+	MeshShape shape (glm::dmat4 (1.0), mesh);
+	ASSERT (shape.CalcMemoryUsage () >= mesh.CalcMemoryUsage ());
+
+	Model model;
+	model.AddMesh (mesh);
+	model.AddMesh (mesh);
+	ModelInfo modelInfo = model.GetInfo ();
+	ASSERT (modelInfo.geometryMemoryUsage == geometry.CalcMemoryUsage ());
+	ASSERT (modelInfo.materialsMemoryUsage == materials.CalcMemoryUsage ());
+	ASSERT (model.CalcMemoryUsage () > modelInfo.geometryMemoryUsage + modelInfo.materialsMemoryUsage);
+}
+
+TEST (MeshContentHashTest)
+{
+	// these boxes have the same checksum
+	Mesh box1 = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 102.76, 1.0, 1.0);
+	Mesh box2 = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 117.03, 1.0, 1.0);
+	ASSERT (box1.GetGeometry ().CalcCheckSum () == box2.GetGeometry ().CalcCheckSum ());
+	ASSERT (box1.CalcContentHash () != box2.CalcContentHash ());
+	ASSERT (!box1.IsIdentical (box2));
+
+	Mesh box3 = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 102.76, 1.0, 1.0);
+	ASSERT (box1.GetGeometryPtr () != box3.GetGeometryPtr ());
+	ASSERT (box1.CalcContentHash () == box3.CalcContentHash ());
+	ASSERT (box1.IsIdentical (box3));
+
+	Mesh movedBox = box1;
+	movedBox.AddTransformation (glm::translate (glm::dmat4 (1.0), glm::dvec3 (1.0, 0.0, 0.0)));
+	ASSERT (box1.CalcContentHash () != movedBox.CalcContentHash ());
+	ASSERT (!box1.IsIdentical (movedBox));
+
+	Mesh redBox = GenerateBox (Material (glm::dvec3 (1.0, 0.0, 0.0)), glm::dmat4 (1.0), 102.76, 1.0, 1.0);
+	ASSERT (box1.CalcContentHash () != redBox.CalcContentHash ());
+	ASSERT (!box1.IsIdentical (redBox));
+}
+
+TEST (TrackingAllocatorTest)
+{
+	size_t trackedBefore = GetTrackedMemory (MemorySubsystem::Render);
+	{
+		std::vector<int, TrackingAllocator<int, MemorySubsystem::Render>> vec (100, 0);
+		ASSERT (GetTrackedMemory (MemorySubsystem::Render) == trackedBefore + 100 * sizeof (int));
+	}
+	ASSERT (GetTrackedMemory (MemorySubsystem::Render) == trackedBefore);
+	ASSERT (FormatMemorySize (1536) == L"1.50 KB");
+}
+
+}
@@ -1,11 +1,62 @@
 #include "SimpleTest.hpp"
 #include "MeshTopology.hpp"
+#include "MeshGenerators.hpp"
 
 using namespace Modeler;
 
 namespace MeshTopologyTest
 {
 
+static std::vector<unsigned int> GetTriangleVertices (const MeshGeometry& geometry)
+{
+	std::vector<unsigned int> triangleVertices;
+	geometry.EnumerateTriangles ([&] (const MeshTriangle& triangle) {
+		triangleVertices.push_back (triangle.v1);
+		triangleVertices.push_back (triangle.v2);
+		triangleVertices.push_back (triangle.v3);
+	});
+	return triangleVertices;
+}
+
+static bool IsEqualTriangleEdge (const MeshTopology::TriangleEdge& a, const MeshTopology::TriangleEdge& b)
+{
+	return a.edge == b.edge && a.reversed == b.reversed;
+}
+
+static bool IsEqualTopology (const MeshTopology& a, const MeshTopology& b)
+{
+	if (a.IsValid () != b.IsValid () || a.GetTriangles ().size () != b.GetTriangles ().size () || a.GetEdges ().size () != b.GetEdges ().size ()) {
+		return false;
+	}
+	for (size_t i = 0; i < a.GetTriangles ().size (); i++) {
+		const MeshTopology::Triangle& aTriangle = a.GetTriangles ()[i];
+		const MeshTopology::Triangle& bTriangle = b.GetTriangles ()[i];
+		if (!IsEqualTriangleEdge (aTriangle.edge1, bTriangle.edge1) || !IsEqualTriangleEdge (aTriangle.edge2, bTriangle.edge2) || !IsEqualTriangleEdge (aTriangle.edge3, bTriangle.edge3)) {
+			return false;
+		}
+	}
+	for (size_t i = 0; i < a.GetEdges ().size (); i++) {
+		const MeshTopology::Edge& aEdge = a.GetEdges ()[i];
+		const MeshTopology::Edge& bEdge = b.GetEdges ()[i];
+		if (aEdge.beg != bEdge.beg || aEdge.end != bEdge.end || aEdge.triangle1 != bEdge.triangle1 || aEdge.triangle2 != bEdge.triangle2) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static MeshTopologyBuilder::Result BuildIncrementally (MeshTopology& topology, const std::vector<unsigned int>& triangleVertices)
+{
+	MeshTopologyBuilder builder (topology);
+	for (size_t i = 0; i < triangleVertices.size (); i += 3) {
+		MeshTopologyBuilder::Result result = builder.AddTriangle (triangleVertices[i], triangleVertices[i + 1], triangleVertices[i + 2]);
+		if (result != MeshTopologyBuilder::Result::NoError) {
+			return result;
+		}
+	}
+	return MeshTopologyBuilder::Result::NoError;
+}
+
 TEST (MeshTopologyTest_OneTriangle)
 {
 	MeshTopology topology;
@@ -100,4 +151,54 @@ TEST (MeshTopologyTest_TetrahedronTest)
 	ASSERT (topology.IsValid ());
 }
 
+TEST (MeshTopologyTest_BuildTwoTriangles)
+{
+	std::vector<unsigned int> triangleVertices = { 0, 1, 2, 1, 3, 2 };
+	MeshTopology reference;
+	ASSERT (BuildIncrementally (reference, triangleVertices) == MeshTopologyBuilder::Result::NoError);
+
+	MeshTopology topology;
+	ASSERT (MeshTopologyBuilder::Build (topology, triangleVertices, 0) == MeshTopologyBuilder::Result::NoError);
+	ASSERT (topology.GetEdges ().size () == 5);
+	ASSERT (!topology.IsClosed ());
+	ASSERT (IsEqualTopology (topology, reference));
+}
+
+TEST (MeshTopologyTest_BuildNonManifold)
+{
+	MeshTopology topology;
+	ASSERT (MeshTopologyBuilder::Build (topology, { 0, 1, 2, 1, 2, 3 }, 0) == MeshTopologyBuilder::Result::NonManifoldEdgeFound);
+	ASSERT (topology.IsEmpty ());
+	ASSERT (!topology.IsValid ());
+
+	ASSERT (MeshTopologyBuilder::Build (topology, { 0, 1, 2, 1, 3, 2, 4, 2, 1 }, 0) == MeshTopologyBuilder::Result::NonManifoldEdgeFound);
+	ASSERT (topology.IsEmpty ());
+	ASSERT (!topology.IsValid ());
+
+	ASSERT (MeshTopologyBuilder::Build (topology, { 0, 1, 2 }, 0) == MeshTopologyBuilder::Result::NoError);
+	ASSERT (topology.IsValid ());
+}
+
+TEST (MeshTopologyTest_BuildInvalidInput)
+{
+	MeshTopology topology;
+	ASSERT (MeshTopologyBuilder::Build (topology, { 0, 1 }, 0) == MeshTopologyBuilder::Result::InvalidTopology);
+	ASSERT (!topology.IsValid ());
+}
+
+TEST (MeshTopologyTest_BuildSphere)
+{
+	Mesh sphere = GenerateSphere (DefaultMaterial, glm::dmat4 (1.0), 1.0, 160, false);
+	std::vector<unsigned int> triangleVertices = GetTriangleVertices (sphere.GetGeometry ());
+	MeshTopology reference;
+	ASSERT (BuildIncrementally (reference, triangleVertices) == MeshTopologyBuilder::Result::NoError);
+
+	for (unsigned int threadCount : { 1, 3 }) {
+		MeshTopology topology;
+		ASSERT (MeshTopologyBuilder::Build (topology, triangleVertices, threadCount) == MeshTopologyBuilder::Result::NoError);
+		ASSERT (topology.IsClosed ());
+		ASSERT (IsEqualTopology (topology, reference));
+	}
+}
+
 }
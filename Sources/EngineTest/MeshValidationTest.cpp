@@ -0,0 +1,132 @@
+#include "SimpleTest.hpp"
+#include "MeshValidation.hpp"
+#include "MeshGenerators.hpp"
+#include "MeshTopology.hpp"
+
+using namespace Modeler;
+
+namespace MeshValidationTest
+{
+
+static Mesh CopyTriangles (const Mesh& mesh, const std::function<void (Mesh&, MaterialId, unsigned int, const MeshTriangle&)>& triangleAdder)
+{
+	Mesh result;
+	MaterialId material = result.AddMaterial (DefaultMaterial);
+	const MeshGeometry& geometry = mesh.GetGeometry ();
+	geometry.EnumerateVertices (glm::dmat4 (1.0), [&] (const glm::dvec3& vertex) {
+		result.AddVertex (vertex);
+	});
+	for (unsigned int i = 0; i < geometry.TriangleCount (); i++) {
+		triangleAdder (result, material, i, geometry.GetTriangle (i));
+	}
+	return result;
+}
+
+static void AddTetrahedron (Mesh& mesh, MaterialId material, const glm::dvec3& offset)
+{
+	unsigned int v1 = mesh.AddVertex (offset + glm::dvec3 (0.0, 0.0, 0.0));
+	unsigned int v2 = mesh.AddVertex (offset + glm::dvec3 (1.0, 0.0, 0.0));
+	unsigned int v3 = mesh.AddVertex (offset + glm::dvec3 (0.0, 1.0, 0.0));
+	unsigned int v4 = mesh.AddVertex (offset + glm::dvec3 (0.0, 0.0, 1.0));
+	mesh.AddTriangle (v1, v3, v2, material);
+	mesh.AddTriangle (v1, v2, v4, material);
+	mesh.AddTriangle (v2, v3, v4, material);
+	mesh.AddTriangle (v3, v1, v4, material);
+}
+
+TEST (MeshValidationValidTest)
+{
+	ASSERT (ValidateMesh (Mesh ()).IsValid ());
+	ASSERT (ValidateMesh (GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 1.0, 2.0, 3.0)).IsValid ());
+	ASSERT (ValidateMesh (GenerateBoxShell (DefaultMaterial, glm::dmat4 (1.0), 1.0, 2.0, 3.0, 0.1)).IsValid ());
+	ASSERT (ValidateMesh (GenerateCylinder (DefaultMaterial, glm::dmat4 (1.0), 1.0, 2.0, 20, true)).IsValid ());
+	ASSERT (ValidateMesh (GenerateCone (DefaultMaterial, glm::dmat4 (1.0), 0.5, 1.0, 2.0, 20, true)).IsValid ());
+	ASSERT (ValidateMesh (GenerateSphere (DefaultMaterial, glm::dmat4 (1.0), 1.0, 20, true)).IsValid ());
+	ASSERT (ValidateMesh (GenerateTorus (DefaultMaterial, glm::dmat4 (1.0), 2.0, 0.5, 20, 10, true)).IsValid ());
+}
+
+TEST (MeshValidationDefectsTest)
+{
+	Mesh box = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 1.0, 1.0, 1.0);
+
+	Mesh open = CopyTriangles (box, [] (Mesh& mesh, MaterialId material, unsigned int index, const MeshTriangle& triangle) {
+		if (index != 3) {
+			mesh.AddTriangle (triangle.v1, triangle.v2, triangle.v3, material);
+		}
+	});
+	ASSERT (ValidateMesh (open).defect == MeshDefect::OpenBoundary);
+
+	Mesh flipped = CopyTriangles (box, [] (Mesh& mesh, MaterialId material, unsigned int index, const MeshTriangle& triangle) {
+		if (index == 3) {
+			mesh.AddTriangle (triangle.v1, triangle.v3, triangle.v2, material);
+		} else {
+			mesh.AddTriangle (triangle.v1, triangle.v2, triangle.v3, material);
+		}
+	});
+	ASSERT (ValidateMesh (flipped).defect == MeshDefect::InconsistentOrientation);
+
+	Mesh duplicated = CopyTriangles (box, [] (Mesh& mesh, MaterialId material, unsigned int index, const MeshTriangle& triangle) {
+		mesh.AddTriangle (triangle.v1, triangle.v2, triangle.v3, material);
+		if (index == 3) {
+			mesh.AddTriangle (triangle.v1, triangle.v3, triangle.v2, material);
+		}
+	});
+	MeshValidation duplicatedValidation = ValidateMesh (duplicated);
+	ASSERT (duplicatedValidation.defect == MeshDefect::NonManifoldEdge);
+	ASSERT (duplicatedValidation.triangle != NoTriangle);
+
+	Mesh degenerate = CopyTriangles (box, [] (Mesh& mesh, MaterialId material, unsigned int index, const MeshTriangle& triangle) {
+		mesh.AddTriangle (triangle.v1, triangle.v2, triangle.v3, material);
+		if (index == 3) {
+			mesh.AddTriangle (triangle.v1, triangle.v1, triangle.v2, material);
+		}
+	});
+	MeshValidation degenerateValidation = ValidateMesh (degenerate);
+	ASSERT (degenerateValidation.defect == MeshDefect::DegenerateTriangle);
+	ASSERT (degenerateValidation.triangle == 4);
+}
+
+TEST (MeshValidationNonManifoldVertexTest)
+{
+	Mesh mesh;
+	MaterialId material = mesh.AddMaterial (DefaultMaterial);
+	AddTetrahedron (mesh, material, glm::dvec3 (0.0, 0.0, 0.0));
+	ASSERT (ValidateMesh (mesh).IsValid ());
+
+	// two tetrahedra touching at a shared vertex
+	mesh.AddVertex (-1.0, 0.0, 0.0);
+	mesh.AddVertex (0.0, -1.0, 0.0);
+	mesh.AddVertex (0.0, 0.0, -1.0);
+	mesh.AddTriangle (0, 4, 5, material);
+	mesh.AddTriangle (0, 6, 4, material);
+	mesh.AddTriangle (0, 5, 6, material);
+	mesh.AddTriangle (4, 6, 5, material);
+	ASSERT (ValidateMesh (mesh).defect == MeshDefect::NonManifoldVertex);
+}
+
+TEST (MeshValidationCacheTest)
+{
+	Mesh box = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 1.0, 1.0, 1.0);
+	ASSERT (ValidateMeshCached (box).IsValid ());
+	ASSERT (ValidateMeshCached (box).IsValid ());
+
+	Mesh open = CopyTriangles (box, [] (Mesh& mesh, MaterialId material, unsigned int index, const MeshTriangle& triangle) {
+		if (index != 0) {
+			mesh.AddTriangle (triangle.v1, triangle.v2, triangle.v3, material);
+		}
+	});
+	ASSERT (ValidateMeshCached (open).defect == MeshDefect::OpenBoundary);
+	ASSERT (ValidateMeshCached (open).defect == MeshDefect::OpenBoundary);
+
+	// these boxes have the same checksum, but the second one is flat
+	Mesh validBox = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 635.31, 1.0, 1.0);
+	Mesh flatBox = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 638.01, 0.0, 1.0);
+	ASSERT (validBox.GetGeometry ().CalcCheckSum () == flatBox.GetGeometry ().CalcCheckSum ());
+	ASSERT (ValidateMeshCached (validBox).IsValid ());
+	ASSERT (ValidateMeshCached (flatBox).defect == MeshDefect::DegenerateTriangle);
+
+	Mesh sameBox = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 635.31, 1.0, 1.0);
+	ASSERT (ValidateMeshCached (sameBox).IsValid ());
+}
+
+}
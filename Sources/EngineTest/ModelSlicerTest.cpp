@@ -0,0 +1,85 @@
+#include "SimpleTest.hpp"
+#include "Geometry.hpp"
+#include "ModelSlicer.hpp"
+#include "MeshGenerators.hpp"
+
+using namespace Geometry;
+using namespace Modeler;
+
+namespace ModelSlicerTest
+{
+
+static double GetPolylineArea (const SlicePolyline& polyline)
+{
+	double area = 0.0;
+	for (size_t i = 0; i < polyline.vertices.size (); i++) {
+		const glm::dvec3& current = polyline.vertices[i];
+		const glm::dvec3& next = polyline.vertices[(i + 1) % polyline.vertices.size ()];
+		area += current.x * next.y - next.x * current.y;
+	}
+	return area * 0.5;
+}
+
+TEST (SliceBoxTest)
+{
+	Model model;
+	model.AddMesh (GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 1.0, 1.0, 1.0));
+
+	std::vector<ModelSlice> slices = SliceModel (model, glm::dvec3 (0.0, 0.0, 1.0), { 0.5, -1.0, 0.0, 1.0, 2.0 });
+	ASSERT (slices.size () == 5);
+	ASSERT (IsEqual (slices[0].offset, 0.5));
+	ASSERT (slices[0].polylines.size () == 1);
+	ASSERT (slices[0].polylines[0].isClosed);
+	ASSERT (IsEqual (GetPolylineArea (slices[0].polylines[0]), 1.0));
+	for (const glm::dvec3& vertex : slices[0].polylines[0].vertices) {
+		ASSERT (IsEqual (vertex.z, 0.5));
+	}
+
+	ASSERT (slices[1].polylines.empty ());
+	ASSERT (slices[2].polylines.empty ());
+	ASSERT (slices[3].polylines.size () == 1);
+	ASSERT (slices[3].polylines[0].isClosed);
+	ASSERT (IsEqual (GetPolylineArea (slices[3].polylines[0]), 1.0));
+	ASSERT (slices[4].polylines.empty ());
+}
+
+TEST (SliceMultipleMeshesTest)
+{
+	Model model;
+	model.AddMesh (GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 1.0, 1.0, 1.0));
+	model.AddMesh (GenerateBox (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (2.0, 0.0, 0.0)), 2.0, 2.0, 2.0));
+	model.AddMesh (GenerateBoxShell (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (10.0, 0.0, 0.0)), 4.0, 4.0, 1.0, 1.0));
+
+	std::vector<ModelSlice> slices = SliceModel (model, glm::dvec3 (0.0, 0.0, 2.0), { 0.5 });
+	ASSERT (slices.size () == 1);
+	ASSERT (slices[0].polylines.size () == 4);
+	double area = 0.0;
+	for (const SlicePolyline& polyline : slices[0].polylines) {
+		ASSERT (polyline.isClosed);
+		area += GetPolylineArea (polyline);
+	}
+	ASSERT (IsEqual (area, 1.0 + 4.0 + 16.0 - 4.0));
+}
+
+TEST (SliceSphereTest)
+{
+	Model model;
+	model.AddMesh (GenerateSphere (DefaultMaterial, glm::dmat4 (1.0), 1.0, 40, true));
+
+	std::vector<double> offsets;
+	for (int i = 0; i < 100; i++) {
+		offsets.push_back (-0.95 + i * 0.019);
+	}
+	std::vector<ModelSlice> slices = SliceModel (model, glm::dvec3 (0.0, 0.0, 1.0), offsets);
+	ASSERT (slices.size () == offsets.size ());
+	for (const ModelSlice& slice : slices) {
+		ASSERT (slice.polylines.size () == 1);
+		ASSERT (slice.polylines[0].isClosed);
+		double circleArea = PI * (1.0 - slice.offset * slice.offset);
+		double area = GetPolylineArea (slice.polylines[0]);
+		ASSERT (area > 0.0 && area < circleArea);
+		ASSERT (area > circleArea * 0.95);
+	}
+}
+
+}
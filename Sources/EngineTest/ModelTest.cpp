@@ -4,6 +4,9 @@
 #include "MeshGenerators.hpp"
 #include "TestUtils.hpp"
 
+#include <thread>
+#include <atomic>
+
 using namespace Geometry;
 using namespace Modeler;
 
@@ -104,4 +107,186 @@ TEST (BoundingShapeTest)
 	ASSERT (IsEqual (boundingSphere.GetRadius (), sqrt (1.0 * 1.0 + 1.0 * 1.0 + 3.0 * 3.0) / 2.0));
 }
 
+TEST (ConcurrentAddRemoveMeshTest)
+{
+	const int threadCount = 8;
+	const int meshesPerThread = 200;
+
+	std::vector<Mesh> meshes;
+	for (int i = 0; i < 4; i++) {
+		meshes.push_back (GenerateBox (Material (glm::dvec3 (i * 0.25, 0.0, 0.0)), glm::dmat4 (1.0), 1.0, 1.0, 1.0 + i));
+	}
+
+	Model model;
+	std::vector<std::vector<MeshId>> addedMeshIds (threadCount);
+	std::vector<std::thread> threads;
+	for (int threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+		threads.push_back (std::thread ([&, threadIndex] () {
+			std::vector<MeshId>& threadMeshIds = addedMeshIds[threadIndex];
+			for (int i = 0; i < meshesPerThread; i++) {
+				const Mesh& mesh = meshes[(threadIndex + i) % meshes.size ()];
+				threadMeshIds.push_back (model.AddMesh (mesh));
+				if (i % 2 == 1) {
+					model.RemoveMesh (threadMeshIds[i - 1]);
+				}
+				model.GetSnapshot ()->GetBoundingBox ();
+			}
+		}));
+	}
+	for (std::thread& thread : threads) {
+		thread.join ();
+	}
+
+	std::unordered_set<MeshId> remainingMeshIds;
+	for (const std::vector<MeshId>& threadMeshIds : addedMeshIds) {
+		ASSERT (threadMeshIds.size () == (size_t) meshesPerThread);
+		for (size_t i = 1; i < threadMeshIds.size (); i += 2) {
+			remainingMeshIds.insert (threadMeshIds[i]);
+		}
+	}
+
+	ModelInfo modelInfo = model.GetInfo ();
+	ASSERT (modelInfo.meshGeometryCount == 4);
+	ASSERT (modelInfo.meshMaterialsCount == 4);
+	ASSERT (modelInfo.meshCount == (unsigned int) (threadCount * meshesPerThread / 2));
+	ASSERT (modelInfo.triangleCount == modelInfo.meshCount * 12);
+
+	MeshId lastMeshId = -1;
+	size_t enumeratedMeshCount = 0;
+	model.EnumerateMeshes ([&] (MeshId meshId, const MeshRef&) {
+		ASSERT (meshId > lastMeshId);
+		ASSERT (remainingMeshIds.find (meshId) != remainingMeshIds.end ());
+		lastMeshId = meshId;
+		enumeratedMeshCount++;
+	});
+	ASSERT (enumeratedMeshCount == remainingMeshIds.size ());
+
+	for (MeshId meshId : remainingMeshIds) {
+		model.RemoveMesh (meshId);
+	}
+	modelInfo = model.GetInfo ();
+	ASSERT (modelInfo.meshGeometryCount == 0);
+	ASSERT (modelInfo.meshMaterialsCount == 0);
+	ASSERT (modelInfo.meshCount == 0);
+}
+
+TEST (ConcurrentClearTest)
+{
+	const int threadCount = 4;
+	const int meshesPerThread = 200;
+
+	Mesh mesh = GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 1.0, 1.0, 1.0);
+	Model model;
+	MeshId clearedMeshId = model.AddMesh (mesh);
+	model.Clear ();
+
+	std::atomic<int> removedCount (0);
+	std::vector<std::thread> threads;
+	for (int threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+		threads.push_back (std::thread ([&] () {
+			for (int i = 0; i < meshesPerThread; i++) {
+				MeshId meshId = model.AddMesh (mesh);
+				ASSERT (meshId > clearedMeshId);
+				try {
+					model.RemoveMesh (meshId);
+					removedCount++;
+				} catch (const std::out_of_range&) {
+					// removed by the parallel clear
+				}
+			}
+		}));
+	}
+	for (int i = 0; i < 20; i++) {
+		model.Clear ();
+	}
+	for (std::thread& thread : threads) {
+		thread.join ();
+	}
+
+	ASSERT (removedCount <= threadCount * meshesPerThread);
+	ASSERT (model.GetInfo ().meshCount == 0);
+
+	MeshId meshId = model.AddMesh (mesh);
+	ASSERT (model.GetInfo ().meshGeometryCount == 1);
+	model.RemoveMesh (meshId);
+	ASSERT (model.GetInfo ().meshCount == 0);
+}
+
+TEST (MeshRefLifetimeTest)
+{
+	Model model;
+	MeshId meshId = model.AddMesh (GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 1.0, 1.0, 1.0));
+	MeshRefConstPtr meshRef = model.GetMesh (meshId);
+
+	UserDataConstPtr userData (new UserData ());
+	model.SetMeshUserData (meshId, "key", userData);
+	ASSERT (meshRef->GetUserData ("key") == nullptr);
+	ASSERT (model.GetMesh (meshId)->GetUserData ("key") == userData);
+
+	model.RemoveMesh (meshId);
+	ASSERT (meshRef->GetGeometry ().TriangleCount () == 12);
+	ASSERT (model.GetInfo ().meshCount == 0);
+}
+
+TEST (SharedMeshDataTest)
+{
+	Model model;
+	MeshId meshId = model.AddMesh (GenerateBox (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (2.0, 0.0, 0.0)), 1.0, 1.0, 1.0));
+	MeshRefConstPtr meshRef = model.GetMesh (meshId);
+	ASSERT (model.GetMeshGeometryPtr (*meshRef) == meshRef->GetGeometryPtr ());
+	ASSERT (model.GetMeshMaterialsPtr (*meshRef) == meshRef->GetMaterialsPtr ());
+
+	Model otherModel;
+	Mesh sharedMesh (model.GetMeshGeometryPtr (*meshRef), model.GetMeshMaterialsPtr (*meshRef), meshRef->GetTransformation ());
+	MeshRefConstPtr otherMeshRef = otherModel.GetMesh (otherModel.AddMesh (sharedMesh));
+	ASSERT (otherMeshRef->GetGeometryPtr () == meshRef->GetGeometryPtr ());
+	ASSERT (otherMeshRef->GetMaterialsPtr () == meshRef->GetMaterialsPtr ());
+	ASSERT (otherMeshRef->GetTransformation () == meshRef->GetTransformation ());
+}
+
+TEST (ModelSnapshotTest)
+{
+	Model model;
+	MeshId meshId1 = model.AddMesh (GenerateBox (DefaultMaterial, glm::dmat4 (1.0), 1.0, 1.0, 1.0));
+	MeshId meshId2 = model.AddMesh (GenerateBox (DefaultMaterial, glm::translate (glm::dmat4 (1.0), glm::dvec3 (2.0, 0.0, 0.0)), 1.0, 1.0, 1.0));
+
+	ModelSnapshotConstPtr snapshot1 = model.GetSnapshot ();
+	ASSERT (model.GetSnapshot () == snapshot1);
+	ASSERT (snapshot1->GetVersion () == model.GetVersion ());
+
+	model.RemoveMesh (meshId1);
+	MeshId meshId3 = model.AddMesh (GenerateBox (Material (glm::dvec3 (1.0, 0.0, 0.0)), glm::dmat4 (1.0), 1.0, 1.0, 3.0));
+	model.SetMeshUserData (meshId2, "key", nullptr);
+
+	ModelSnapshotConstPtr snapshot2 = model.GetSnapshot ();
+	ASSERT (snapshot2 != snapshot1);
+	ASSERT (snapshot2->GetVersion () > snapshot1->GetVersion ());
+
+	ASSERT (snapshot1->ContainsMesh (meshId1));
+	ASSERT (snapshot1->ContainsMesh (meshId2));
+	ASSERT (!snapshot1->ContainsMesh (meshId3));
+	ASSERT (!snapshot2->ContainsMesh (meshId1));
+	ASSERT (snapshot2->ContainsMesh (meshId2));
+	ASSERT (snapshot2->ContainsMesh (meshId3));
+
+	ModelInfo snapshotInfo1 = snapshot1->GetInfo ();
+	ASSERT (snapshotInfo1.meshCount == 2);
+	ASSERT (snapshotInfo1.meshGeometryCount == 1);
+	ASSERT (snapshotInfo1.meshMaterialsCount == 1);
+
+	ModelInfo snapshotInfo2 = snapshot2->GetInfo ();
+	ASSERT (snapshotInfo2.meshCount == 2);
+	ASSERT (snapshotInfo2.meshGeometryCount == 2);
+	ASSERT (snapshotInfo2.meshMaterialsCount == 2);
+
+	model.Clear ();
+	ASSERT (model.GetInfo ().meshCount == 0);
+
+	BoundingBox boundingBox = snapshot1->GetBoundingBox ();
+	ASSERT (IsEqualVec (boundingBox.GetMin (), glm::dvec3 (0.0, 0.0, 0.0)));
+	ASSERT (IsEqualVec (boundingBox.GetMax (), glm::dvec3 (3.0, 1.0, 1.0)));
+	MeshRefConstPtr meshRef = snapshot1->GetMesh (meshId1);
+	ASSERT (snapshot1->GetMeshGeometry (*meshRef).TriangleCount () == 12);
+}
+
 }
@@ -0,0 +1,80 @@
+#include "SimpleTest.hpp"
+#include "OperationProgress.hpp"
+#include "ParallelTasks.hpp"
+
+#include <atomic>
+
+using namespace Modeler;
+
+namespace OperationProgressTest
+{
+
+TEST (OperationProgressTest)
+{
+	double reportedProgress = -1.0;
+	OperationProgress progress ([&] (double newProgress) {
+		reportedProgress = newProgress;
+	});
+	ASSERT (!progress.IsCancelled ());
+	ASSERT (progress.GetProgress () == 0.0);
+	progress.SetProgress (0.25);
+	ASSERT (progress.GetProgress () == 0.25);
+	ASSERT (reportedProgress == 0.25);
+	progress.SetProgress (2.0);
+	ASSERT (progress.GetProgress () == 1.0);
+	progress.Cancel ();
+	ASSERT (progress.IsCancelled ());
+}
+
+TEST (OperationProgressChildTest)
+{
+	OperationProgress progress;
+	OperationProgress child (&progress, 0.5, 1.0);
+	child.SetProgress (0.5);
+	ASSERT (child.GetProgress () == 0.5);
+	ASSERT (progress.GetProgress () == 0.75);
+	ASSERT (!child.IsCancelled ());
+	progress.Cancel ();
+	ASSERT (child.IsCancelled ());
+	ASSERT (IsOperationCancelled (&child));
+	ASSERT (!IsOperationCancelled (nullptr));
+	SetOperationProgress (nullptr, 0.5);
+}
+
+TEST (OperationProgressCancelCheckTest)
+{
+	bool escapePressed = false;
+	size_t checkCount = 0;
+	OperationProgress progress (nullptr, [&] () {
+		checkCount++;
+		return escapePressed;
+	});
+	OperationProgress child (&progress, 0.0, 0.5);
+	ASSERT (!child.IsCancelled ());
+	ASSERT (checkCount == 1);
+	escapePressed = true;
+	ASSERT (child.IsCancelled ());
+	escapePressed = false;
+	ASSERT (progress.IsCancelled ());
+	ASSERT (child.IsCancelled ());
+	ASSERT (checkCount == 2);
+}
+
+TEST (OperationProgressCancelTest)
+{
+	OperationProgress progress;
+	std::atomic<size_t> finishedTasks (0);
+	RunParallelTasks (1000, 4, [&] (size_t taskIndex) {
+		if (progress.IsCancelled ()) {
+			return;
+		}
+		if (taskIndex == 10) {
+			progress.Cancel ();
+		}
+		finishedTasks++;
+	});
+	ASSERT (progress.IsCancelled ());
+	ASSERT (finishedTasks < 1000);
+}
+
+}
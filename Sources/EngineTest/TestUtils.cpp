@@ -1,5 +1,6 @@
 #include "TestUtils.hpp"
 #include "Geometry.hpp"
+#include "MeshGenerators.hpp"
 
 ModelWriterForTest::ModelWriterForTest () :
 	result ()
@@ -36,3 +37,23 @@ bool CheckString (const std::wstring& expected, const std::wstring& result)
 		return false;
 	}
 }
+
+Modeler::Mesh GenerateCube (const glm::dvec3& offset, double size)
+{
+	return Modeler::GenerateBox (Modeler::DefaultMaterial, glm::translate (glm::dmat4 (1.0), offset), size, size, size);
+}
+
+std::vector<Geometry::Triangle> GenerateRandomTriangles (std::mt19937& generator, size_t count, const glm::dvec3& spread)
+{
+	std::uniform_real_distribution<double> distribution (-1.0, 1.0);
+	std::vector<Geometry::Triangle> triangles;
+	for (size_t i = 0; i < count; i++) {
+		glm::dvec3 center (distribution (generator) * spread.x, distribution (generator) * spread.y, distribution (generator) * spread.z);
+		triangles.push_back (Geometry::Triangle (
+			center + glm::dvec3 (distribution (generator), distribution (generator), distribution (generator)),
+			center + glm::dvec3 (distribution (generator), distribution (generator), distribution (generator)),
+			center + glm::dvec3 (distribution (generator), distribution (generator), distribution (generator))
+		));
+	}
+	return triangles;
+}
@@ -3,6 +3,11 @@
 
 #include "SimpleTest.hpp"
 #include "Export.hpp"
+#include "Mesh.hpp"
+#include "Triangle.hpp"
+
+#include <vector>
+#include <random>
 
 class ModelWriterForTest : public Modeler::ModelWriter
 {
@@ -19,4 +24,7 @@ public:
 bool IsEqualVec (const glm::dvec3& a, const glm::dvec3& b);
 bool CheckString (const std::wstring& expected, const std::wstring& result);
 
+Modeler::Mesh GenerateCube (const glm::dvec3& offset, double size);
+std::vector<Geometry::Triangle> GenerateRandomTriangles (std::mt19937& generator, size_t count, const glm::dvec3& spread);
+
 #endif
@@ -0,0 +1,72 @@
+#include "SimpleTest.hpp"
+#include "Geometry.hpp"
+#include "TestUtils.hpp"
+#include "RayIntersection.hpp"
+#include "TriangleBVH.hpp"
+
+#include <random>
+
+using namespace Geometry;
+
+namespace TriangleBVHTest
+{
+
+static size_t GetNearestScalarIntersection (const Ray& ray, const std::vector<Triangle>& triangles, double& distance)
+{
+	size_t nearest = TriangleBVH::NoTriangle;
+	distance = INF;
+	for (size_t i = 0; i < triangles.size (); i++) {
+		RayIntersectionResult result = GetRayTriangleIntersection (ray, triangles[i][0], triangles[i][1], triangles[i][2]);
+		if (result.found && result.intersection.distance < distance) {
+			distance = result.intersection.distance;
+			nearest = i;
+		}
+	}
+	return nearest;
+}
+
+TEST (TriangleBVHEmptyTest)
+{
+	TriangleBVH bvh ({});
+	ASSERT (bvh.IsEmpty ());
+	ASSERT (!bvh.GetBoundingBox ().IsValid ());
+
+	PrecomputedRay ray (Ray (glm::dvec3 (0.0, 0.0, 0.0), glm::dvec3 (1.0, 0.0, 0.0)));
+	double distance = 0.0;
+	ASSERT (bvh.GetNearestIntersection (ray, INF, distance) == TriangleBVH::NoTriangle);
+	ASSERT (!bvh.HasIntersection (ray, INF));
+}
+
+TEST (TriangleBVHIntersectionTest)
+{
+	std::mt19937 generator (42);
+	std::vector<Triangle> triangles = GenerateRandomTriangles (generator, 500, glm::dvec3 (5.0, 5.0, 1.0));
+	TriangleBVH bvh (triangles);
+	ASSERT (!bvh.IsEmpty ());
+	ASSERT (bvh.TriangleCount () == triangles.size ());
+
+	std::uniform_real_distribution<double> distribution (-1.0, 1.0);
+	size_t hitCount = 0;
+	for (size_t i = 0; i < 1000; i++) {
+		glm::dvec3 origin (distribution (generator) * 6.0, distribution (generator) * 6.0, 5.0);
+		glm::dvec3 target (distribution (generator) * 5.0, distribution (generator) * 5.0, 0.0);
+		Ray ray (origin, target - origin);
+
+		double scalarDistance = 0.0;
+		size_t scalarNearest = GetNearestScalarIntersection (ray, triangles, scalarDistance);
+
+		PrecomputedRay precomputedRay (ray);
+		double distance = 0.0;
+		size_t nearest = bvh.GetNearestIntersection (precomputedRay, INF, distance);
+		ASSERT (nearest == scalarNearest);
+		ASSERT (bvh.HasIntersection (precomputedRay, INF) == (scalarNearest != TriangleBVH::NoTriangle));
+		if (scalarNearest != TriangleBVH::NoTriangle) {
+			ASSERT (IsEqual (distance, scalarDistance));
+			ASSERT (bvh.GetNearestIntersection (precomputedRay, scalarDistance * 0.5, distance) == TriangleBVH::NoTriangle);
+			hitCount++;
+		}
+	}
+	ASSERT (hitCount > 0);
+}
+
+}
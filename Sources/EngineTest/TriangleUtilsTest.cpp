@@ -22,9 +22,9 @@ TEST (CutTriangleWithPlane_TriangleNotCrossingPlane)
 	TrianglePlaneCutResult result1 = CutTriangleWithPlane (plane, t1);
 	TrianglePlaneCutResult result2 = CutTriangleWithPlane (plane, t2);
 	TrianglePlaneCutResult result3 = CutTriangleWithPlane (plane, t3);
-	ASSERT (result1.frontTriangles.size () == 0 && result1.backTriangles.size () == 1 && result1.planeTriangles.size () == 0);
-	ASSERT (result2.frontTriangles.size () == 1 && result2.backTriangles.size () == 0 && result2.planeTriangles.size () == 0);
-	ASSERT (result3.frontTriangles.size () == 0 && result3.backTriangles.size () == 0 && result3.planeTriangles.size () == 1);
+	ASSERT (result1.frontTriangles.GetSize () == 0 && result1.backTriangles.GetSize () == 1 && result1.planeTriangles.GetSize () == 0);
+	ASSERT (result2.frontTriangles.GetSize () == 1 && result2.backTriangles.GetSize () == 0 && result2.planeTriangles.GetSize () == 0);
+	ASSERT (result3.frontTriangles.GetSize () == 0 && result3.backTriangles.GetSize () == 0 && result3.planeTriangles.GetSize () == 1);
 }
 
 TEST (CutTriangleWithPlane_TriangleOnPlaneWithOneVertex)
@@ -34,8 +34,8 @@ TEST (CutTriangleWithPlane_TriangleOnPlaneWithOneVertex)
 	Triangle t2 (glm::dvec3 (0.0, 0.0, 2.0), glm::dvec3 (4.0, 0.0, 2.0), glm::dvec3 (0.0, 0.0, 1.0));
 	TrianglePlaneCutResult result1 = CutTriangleWithPlane (plane, t1);
 	TrianglePlaneCutResult result2 = CutTriangleWithPlane (plane, t2);
-	ASSERT (result1.frontTriangles.size () == 0 && result1.backTriangles.size () == 1 && result1.planeTriangles.size () == 0);
-	ASSERT (result2.frontTriangles.size () == 1 && result2.backTriangles.size () == 0 && result2.planeTriangles.size () == 0);
+	ASSERT (result1.frontTriangles.GetSize () == 0 && result1.backTriangles.GetSize () == 1 && result1.planeTriangles.GetSize () == 0);
+	ASSERT (result2.frontTriangles.GetSize () == 1 && result2.backTriangles.GetSize () == 0 && result2.planeTriangles.GetSize () == 0);
 }
 
 TEST (CutTriangleWithPlane_TriangleOnPlaneWithTwoVertices)
@@ -45,8 +45,8 @@ TEST (CutTriangleWithPlane_TriangleOnPlaneWithTwoVertices)
 	Triangle t2 (glm::dvec3 (0.0, 0.0, 2.0), glm::dvec3 (4.0, 0.0, 1.0), glm::dvec3 (0.0, 0.0, 1.0));
 	TrianglePlaneCutResult result1 = CutTriangleWithPlane (plane, t1);
 	TrianglePlaneCutResult result2 = CutTriangleWithPlane (plane, t2);
-	ASSERT (result1.frontTriangles.size () == 0 && result1.backTriangles.size () == 1 && result1.planeTriangles.size () == 0);
-	ASSERT (result2.frontTriangles.size () == 1 && result2.backTriangles.size () == 0 && result2.planeTriangles.size () == 0);
+	ASSERT (result1.frontTriangles.GetSize () == 0 && result1.backTriangles.GetSize () == 1 && result1.planeTriangles.GetSize () == 0);
+	ASSERT (result2.frontTriangles.GetSize () == 1 && result2.backTriangles.GetSize () == 0 && result2.planeTriangles.GetSize () == 0);
 }
 
 TEST (CutTriangleWithPlane_OnVertexCut)
@@ -54,7 +54,7 @@ TEST (CutTriangleWithPlane_OnVertexCut)
 	Plane plane = Plane::FromPointAndDirection (glm::dvec3 (0.0, 0.0, 0.0), glm::dvec3 (0.0, 1.0, 0.0));
 	Triangle triangle (glm::dvec3 (-1.0, 0.0, 0.0), glm::dvec3 (1.0, -1.0, 0.0), glm::dvec3 (1.0, 1.0, 0.0));
 	TrianglePlaneCutResult result = CutTriangleWithPlane (plane, triangle);
-	ASSERT (result.frontTriangles.size () == 1 && result.backTriangles.size () == 1);
+	ASSERT (result.frontTriangles.GetSize () == 1 && result.backTriangles.GetSize () == 1);
 	ASSERT (IsEqualTriangle (result.backTriangles[0], Triangle (glm::dvec3 (-1.0, 0.0, 0.0), glm::dvec3 (1.0, -1.0, 0.0), glm::dvec3 (1.0, 0.0, 0.0))));
 	ASSERT (IsEqualTriangle (result.frontTriangles[0], Triangle (glm::dvec3 (-1.0, 0.0, 0.0), glm::dvec3 (1.0, 0.0, 0.0), glm::dvec3 (1.0, 1.0, 0.0))));
 }
@@ -64,7 +64,7 @@ TEST (CutTriangleWithPlane_OnVertexCut2)
 	Plane plane = Plane::FromPointAndDirection (glm::dvec3 (0.0, 0.0, 0.0), glm::dvec3 (0.0, -1.0, 0.0));
 	Triangle triangle (glm::dvec3 (-1.0, 0.0, 0.0), glm::dvec3 (1.0, -1.0, 0.0), glm::dvec3 (1.0, 1.0, 0.0));
 	TrianglePlaneCutResult result = CutTriangleWithPlane (plane, triangle);
-	ASSERT (result.frontTriangles.size () == 1 && result.backTriangles.size () == 1);
+	ASSERT (result.frontTriangles.GetSize () == 1 && result.backTriangles.GetSize () == 1);
 	ASSERT (IsEqualTriangle (result.frontTriangles[0], Triangle (glm::dvec3 (-1.0, 0.0, 0.0), glm::dvec3 (1.0, -1.0, 0.0), glm::dvec3 (1.0, 0.0, 0.0))));
 	ASSERT (IsEqualTriangle (result.backTriangles[0], Triangle (glm::dvec3 (-1.0, 0.0, 0.0), glm::dvec3 (1.0, 0.0, 0.0), glm::dvec3 (1.0, 1.0, 0.0))));
 }
@@ -74,7 +74,7 @@ TEST (CutTriangleWithPlane_GeneralCut)
 	Plane plane = Plane::FromPointAndDirection (glm::dvec3 (0.0, 0.0, 0.0), glm::dvec3 (-1.0, 0.0, 0.0));
 	Triangle triangle (glm::dvec3 (-1.0, 0.0, 0.0), glm::dvec3 (1.0, -1.0, 0.0), glm::dvec3 (1.0, 1.0, 0.0));
 	TrianglePlaneCutResult result = CutTriangleWithPlane (plane, triangle);
-	ASSERT (result.frontTriangles.size () == 1 && result.backTriangles.size () == 2);
+	ASSERT (result.frontTriangles.GetSize () == 1 && result.backTriangles.GetSize () == 2);
 	ASSERT (IsEqualTriangle (result.frontTriangles[0], Triangle (glm::dvec3 (-1.0, 0.0, 0.0), glm::dvec3 (0.0, -0.5, 0.0), glm::dvec3 (0.0, 0.5, 0.0))));
 	ASSERT (IsEqualTriangle (result.backTriangles[0], Triangle (glm::dvec3 (1.0, -1.0, 0.0), glm::dvec3 (0.0, 0.5, 0.0), glm::dvec3 (0.0, -0.5, 0.0))));
 	ASSERT (IsEqualTriangle (result.backTriangles[1], Triangle (glm::dvec3 (1.0, 1.0, 0.0), glm::dvec3 (0.0, 0.5, 0.0), glm::dvec3 (1.0, -1.0, 0.0))));
@@ -85,7 +85,7 @@ TEST (CutTriangleWithPlane_GeneralCut2)
 	Plane plane = Plane::FromPointAndDirection (glm::dvec3 (0.0, 0.0, 0.0), glm::dvec3 (-1.0, 0.0, 0.0));
 	Triangle triangle (glm::dvec3 (1.0, -1.0, 0.0), glm::dvec3 (1.0, 1.0, 0.0), glm::dvec3 (-1.0, 0.0, 0.0));
 	TrianglePlaneCutResult result = CutTriangleWithPlane (plane, triangle);
-	ASSERT (result.frontTriangles.size () == 1 && result.backTriangles.size () == 2);
+	ASSERT (result.frontTriangles.GetSize () == 1 && result.backTriangles.GetSize () == 2);
 	ASSERT (IsEqualTriangle (result.frontTriangles[0], Triangle (glm::dvec3 (-1.0, 0.0, 0.0), glm::dvec3 (0.0, -0.5, 0.0), glm::dvec3 (0.0, 0.5, 0.0))));
 	ASSERT (IsEqualTriangle (result.backTriangles[0], Triangle (glm::dvec3 (1.0, -1.0, 0.0), glm::dvec3 (0.0, 0.5, 0.0), glm::dvec3 (0.0, -0.5, 0.0))));
 	ASSERT (IsEqualTriangle (result.backTriangles[1], Triangle (glm::dvec3 (1.0, 1.0, 0.0), glm::dvec3 (0.0, 0.5, 0.0), glm::dvec3 (1.0, -1.0, 0.0))));
@@ -96,7 +96,7 @@ TEST (CutTriangleWithPlane_GeneralCut3)
 	Plane plane = Plane::FromPointAndDirection (glm::dvec3 (0.5, -0.5, 0.5), glm::dvec3 (1.0, 0.0, 0.0));
 	Triangle triangle (glm::dvec3 (0.0, 0.0, 0.0), glm::dvec3 (2.0, 0.0, 0.0), glm::dvec3 (2.0, 1.0, 0.0));
 	TrianglePlaneCutResult result = CutTriangleWithPlane (plane, triangle);
-	ASSERT (result.frontTriangles.size () == 2 && result.backTriangles.size () == 1);
+	ASSERT (result.frontTriangles.GetSize () == 2 && result.backTriangles.GetSize () == 1);
 }
 
 TEST (BarycentricInterpolationTest)
@@ -129,4 +129,29 @@ TEST (PolygonOrientationTest)
 	ASSERT (GetPolygonOrientation2D (polygon2) == Orientation::Clockwise);
 }
 
+TEST (TriangleTriangleDistanceTest)
+{
+	Triangle triangle (glm::dvec3 (0.0, 0.0, 0.0), glm::dvec3 (1.0, 0.0, 0.0), glm::dvec3 (0.0, 1.0, 0.0));
+
+	// intersecting and touching triangles
+	ASSERT (GetTriangleTriangleDistance (triangle, Triangle (glm::dvec3 (0.2, 0.2, -1.0), glm::dvec3 (0.2, 0.2, 1.0), glm::dvec3 (0.3, 0.3, 1.0))) == 0.0);
+	ASSERT (GetTriangleTriangleDistance (triangle, Triangle (glm::dvec3 (1.0, 0.0, 0.0), glm::dvec3 (2.0, 0.0, 0.0), glm::dvec3 (2.0, 1.0, 0.0))) == 0.0);
+
+	// vertex above the face
+	ASSERT (IsEqual (GetTriangleTriangleDistance (triangle, Triangle (glm::dvec3 (0.2, 0.2, 0.5), glm::dvec3 (0.2, 0.2, 1.0), glm::dvec3 (0.3, 0.3, 1.0))), 0.5));
+
+	// crossing edges without close vertices
+	Triangle crossing (glm::dvec3 (0.2, -1.0, 0.3), glm::dvec3 (0.2, 1.0, 0.3), glm::dvec3 (0.2, 0.0, 2.0));
+	ASSERT (IsEqual (GetTriangleTriangleDistance (triangle, crossing), 0.3));
+
+	// near contact in the same plane
+	Triangle nearby (glm::dvec3 (1.0 + 1.0e-7, 0.0, 0.0), glm::dvec3 (2.0, 0.0, 0.0), glm::dvec3 (2.0, 1.0, 0.0));
+	double distance = GetTriangleTriangleDistance (triangle, nearby);
+	ASSERT (distance < 1.0e-6);
+
+	// degenerate triangle is measured as a segment
+	Triangle segment (glm::dvec3 (2.0, 0.0, 0.0), glm::dvec3 (3.0, 0.0, 0.0), glm::dvec3 (3.0, 0.0, 0.0));
+	ASSERT (IsEqual (GetTriangleTriangleDistance (triangle, segment), 1.0));
+}
+
 }
@@ -1,5 +1,10 @@
 #include "BSPTree.hpp"
 #include "TriangleUtils.hpp"
+#include "PlaneUtils.hpp"
+#include "Geometry.hpp"
+
+#include <limits>
+#include <algorithm>
 
 namespace Geometry
 {
@@ -18,7 +23,7 @@ BSPTreeNode::BSPTreeNode (const Triangle& triangle) :
 	planeTriangles.push_back (triangle);
 }
 
-BSPTreeNode::BSPTreeNode (const std::vector<Triangle>& triangles) :
+BSPTreeNode::BSPTreeNode (const TriangleCutList& triangles) :
 	plane (GetTrianglePlane (triangles[0]))
 {
 	for (const Triangle& triangle : triangles) {
@@ -29,7 +34,7 @@ BSPTreeNode::BSPTreeNode (const std::vector<Triangle>& triangles) :
 void BSPTreeNode::AddTriangle (const Triangle& triangle)
 {
 	TrianglePlaneCutResult cutResult = CutTriangleWithPlane (plane, triangle);
-	if (!cutResult.frontTriangles.empty ()) {
+	if (!cutResult.frontTriangles.IsEmpty ()) {
 		if (frontNode == nullptr) {
 			frontNode.reset (new BSPTreeNode (cutResult.frontTriangles));
 		} else {
@@ -38,7 +43,7 @@ void BSPTreeNode::AddTriangle (const Triangle& triangle)
 			}
 		}
 	}
-	if (!cutResult.backTriangles.empty ()) {
+	if (!cutResult.backTriangles.IsEmpty ()) {
 		if (backNode == nullptr) {
 			backNode.reset (new BSPTreeNode (cutResult.backTriangles));
 		} else {
@@ -47,15 +52,15 @@ void BSPTreeNode::AddTriangle (const Triangle& triangle)
 			}
 		}
 	}
-	if (!cutResult.planeTriangles.empty ()) {
-		planeTriangles.push_back (triangle);
+	for (const Triangle& planeTriangle : cutResult.planeTriangles) {
+		planeTriangles.push_back (planeTriangle);
 	}
 }
 
 void BSPTreeNode::ClipTriangle (const Triangle& triangle, BSPTriangleClipper& clipper) const
 {
 	TrianglePlaneCutResult cutResult = CutTriangleWithPlane (plane, triangle);
-	if (!cutResult.frontTriangles.empty ()) {
+	if (!cutResult.frontTriangles.IsEmpty ()) {
 		if (frontNode == nullptr) {
 			clipper.FrontTrianglesFound (cutResult.frontTriangles);
 		} else {
@@ -64,7 +69,7 @@ void BSPTreeNode::ClipTriangle (const Triangle& triangle, BSPTriangleClipper& cl
 			}
 		}
 	}
-	if (!cutResult.backTriangles.empty ()) {
+	if (!cutResult.backTriangles.IsEmpty ()) {
 		if (backNode == nullptr) {
 			clipper.BackTrianglesFound (cutResult.backTriangles);
 		} else {
@@ -73,7 +78,7 @@ void BSPTreeNode::ClipTriangle (const Triangle& triangle, BSPTriangleClipper& cl
 			}
 		}
 	}
-	if (!cutResult.planeTriangles.empty ()) {
+	if (!cutResult.planeTriangles.IsEmpty ()) {
 		clipper.PlaneTrianglesFound (cutResult.planeTriangles);
 	}
 }
@@ -99,4 +104,255 @@ void BSPTree::ClipTriangle (const Triangle& triangle, BSPTriangleClipper& clippe
 	rootNode->ClipTriangle (triangle, clipper);
 }
 
+static const size_t SplitCandidateCount = 8;
+static const size_t CostSampleCount = 256;
+static const size_t SplitCostWeight = 4;
+
+static bool IsDegenerateTriangle (const Triangle& triangle)
+{
+	return IsEqual (glm::length (glm::cross (triangle[1] - triangle[0], triangle[2] - triangle[0])), 0.0);
+}
+
+BalancedBSPTree::Node::Node (const Plane& plane) :
+	plane (plane),
+	firstPlaneTriangle (0),
+	planeTriangleCount (0),
+	frontNode (InvalidNode),
+	backNode (InvalidNode)
+{
+}
+
+BalancedBSPTree::BalancedBSPTree ()
+{
+}
+
+BalancedBSPTree::BalancedBSPTree (const std::vector<Triangle>& triangles)
+{
+	Build (triangles);
+}
+
+void BalancedBSPTree::Build (const std::vector<Triangle>& triangles)
+{
+	class BuildTask
+	{
+	public:
+		BuildTask (size_t parentNode, bool isFront, std::vector<Triangle>&& triangles) :
+			parentNode (parentNode),
+			isFront (isFront),
+			triangles (std::move (triangles))
+		{
+		}
+
+		size_t					parentNode;
+		bool					isFront;
+		std::vector<Triangle>	triangles;
+	};
+
+	nodes.clear ();
+	planeTriangles.clear ();
+	if (triangles.empty ()) {
+		return;
+	}
+
+	nodes.reserve (triangles.size ());
+	planeTriangles.reserve (triangles.size ());
+
+	std::vector<BuildTask> tasks;
+	tasks.push_back (BuildTask (InvalidNode, false, std::vector<Triangle> (triangles)));
+	while (!tasks.empty ()) {
+		BuildTask task = std::move (tasks.back ());
+		tasks.pop_back ();
+
+		size_t splittingTriangle = SelectSplittingTriangle (task.triangles);
+		if (splittingTriangle == NoTriangle) {
+			continue;
+		}
+		Plane plane = GetTrianglePlane (task.triangles[splittingTriangle]);
+
+		size_t nodeIndex = nodes.size ();
+		nodes.push_back (Node (plane));
+		if (task.parentNode != InvalidNode) {
+			if (task.isFront) {
+				nodes[task.parentNode].frontNode = nodeIndex;
+			} else {
+				nodes[task.parentNode].backNode = nodeIndex;
+			}
+		}
+
+		size_t firstPlaneTriangle = planeTriangles.size ();
+		planeTriangles.push_back (task.triangles[splittingTriangle]);
+
+		std::vector<Triangle> frontTriangles;
+		std::vector<Triangle> backTriangles;
+		for (size_t i = 0; i < task.triangles.size (); i++) {
+			if (i == splittingTriangle) {
+				continue;
+			}
+			TrianglePlaneCutResult cutResult = CutTriangleWithPlane (plane, task.triangles[i]);
+			frontTriangles.insert (frontTriangles.end (), cutResult.frontTriangles.begin (), cutResult.frontTriangles.end ());
+			backTriangles.insert (backTriangles.end (), cutResult.backTriangles.begin (), cutResult.backTriangles.end ());
+			planeTriangles.insert (planeTriangles.end (), cutResult.planeTriangles.begin (), cutResult.planeTriangles.end ());
+		}
+
+		Node& node = nodes[nodeIndex];
+		node.firstPlaneTriangle = firstPlaneTriangle;
+		node.planeTriangleCount = planeTriangles.size () - firstPlaneTriangle;
+
+		task.triangles.clear ();
+		task.triangles.shrink_to_fit ();
+		if (!backTriangles.empty ()) {
+			tasks.push_back (BuildTask (nodeIndex, false, std::move (backTriangles)));
+		}
+		if (!frontTriangles.empty ()) {
+			tasks.push_back (BuildTask (nodeIndex, true, std::move (frontTriangles)));
+		}
+	}
+}
+
+void BalancedBSPTree::ClipTriangle (const Triangle& triangle, BSPTriangleClipper& clipper) const
+{
+	ClipTriangle (triangle, clipper, BSPCoplanarSide::Plane, BSPCoplanarSide::Plane);
+}
+
+void BalancedBSPTree::ClipTriangle (const Triangle& triangle, BSPTriangleClipper& clipper, BSPCoplanarSide sameDirectionSide, BSPCoplanarSide oppositeDirectionSide) const
+{
+	ClipStack stack;
+	ClipTriangle (triangle, clipper, sameDirectionSide, oppositeDirectionSide, stack);
+}
+
+void BalancedBSPTree::ClipTriangle (const Triangle& triangle, BSPTriangleClipper& clipper, BSPCoplanarSide sameDirectionSide, BSPCoplanarSide oppositeDirectionSide, ClipStack& stack) const
+{
+	if (nodes.empty ()) {
+		return;
+	}
+
+	stack.clear ();
+	stack.push_back ({ 0, triangle });
+	while (!stack.empty ()) {
+		std::pair<size_t, Triangle> current = stack.back ();
+		stack.pop_back ();
+
+		const Node& node = nodes[current.first];
+		TrianglePlaneCutResult cutResult = CutTriangleWithPlane (node.plane, current.second);
+		if (!cutResult.planeTriangles.IsEmpty ()) {
+			glm::dvec3 planeNormal (node.plane.a, node.plane.b, node.plane.c);
+			bool sameDirection = glm::dot (CalculateTriangleNormal (current.second), planeNormal) > 0.0;
+			BSPCoplanarSide coplanarSide = sameDirection ? sameDirectionSide : oppositeDirectionSide;
+			if (coplanarSide == BSPCoplanarSide::Front) {
+				cutResult.frontTriangles = cutResult.planeTriangles;
+				cutResult.planeTriangles = TriangleCutList ();
+			} else if (coplanarSide == BSPCoplanarSide::Back) {
+				cutResult.backTriangles = cutResult.planeTriangles;
+				cutResult.planeTriangles = TriangleCutList ();
+			}
+		}
+		if (!cutResult.frontTriangles.IsEmpty ()) {
+			if (node.frontNode == InvalidNode) {
+				clipper.FrontTrianglesFound (cutResult.frontTriangles);
+			} else {
+				for (const Triangle& cutTriangle : cutResult.frontTriangles) {
+					stack.push_back ({ node.frontNode, cutTriangle });
+				}
+			}
+		}
+		if (!cutResult.backTriangles.IsEmpty ()) {
+			if (node.backNode == InvalidNode) {
+				clipper.BackTrianglesFound (cutResult.backTriangles);
+			} else {
+				for (const Triangle& cutTriangle : cutResult.backTriangles) {
+					stack.push_back ({ node.backNode, cutTriangle });
+				}
+			}
+		}
+		if (!cutResult.planeTriangles.IsEmpty ()) {
+			clipper.PlaneTrianglesFound (cutResult.planeTriangles);
+		}
+	}
+}
+
+size_t BalancedBSPTree::NodeCount () const
+{
+	return nodes.size ();
+}
+
+size_t BalancedBSPTree::PlaneTriangleCount () const
+{
+	return planeTriangles.size ();
+}
+
+size_t BalancedBSPTree::Depth () const
+{
+	if (nodes.empty ()) {
+		return 0;
+	}
+
+	size_t maxDepth = 0;
+	std::vector<std::pair<size_t, size_t>> stack;
+	stack.push_back ({ 0, 1 });
+	while (!stack.empty ()) {
+		std::pair<size_t, size_t> current = stack.back ();
+		stack.pop_back ();
+		maxDepth = std::max (maxDepth, current.second);
+		const Node& node = nodes[current.first];
+		if (node.frontNode != InvalidNode) {
+			stack.push_back ({ node.frontNode, current.second + 1 });
+		}
+		if (node.backNode != InvalidNode) {
+			stack.push_back ({ node.backNode, current.second + 1 });
+		}
+	}
+	return maxDepth;
+}
+
+size_t BalancedBSPTree::SelectSplittingTriangle (const std::vector<Triangle>& triangles) const
+{
+	size_t candidateStep = std::max (triangles.size () / SplitCandidateCount, (size_t) 1);
+	size_t sampleStep = std::max (triangles.size () / CostSampleCount, (size_t) 1);
+
+	size_t bestTriangle = NoTriangle;
+	size_t bestCost = std::numeric_limits<size_t>::max ();
+	for (size_t candidate = 0; candidate < triangles.size (); candidate += candidateStep) {
+		if (IsDegenerateTriangle (triangles[candidate])) {
+			continue;
+		}
+		Plane plane = GetTrianglePlane (triangles[candidate]);
+		glm::dvec3 planeNormal (plane.a, plane.b, plane.c);
+		size_t frontCount = 0;
+		size_t backCount = 0;
+		size_t splitCount = 0;
+		for (size_t i = 0; i < triangles.size (); i += sampleStep) {
+			bool hasFront = false;
+			bool hasBack = false;
+			for (size_t j = 0; j < 3; j++) {
+				double distance = glm::dot (triangles[i][j], planeNormal) + plane.d;
+				hasFront = hasFront || IsGreater (distance, 0.0);
+				hasBack = hasBack || IsLower (distance, 0.0);
+			}
+			if (hasFront && hasBack) {
+				splitCount++;
+			} else if (hasFront) {
+				frontCount++;
+			} else if (hasBack) {
+				backCount++;
+			}
+		}
+		size_t imbalance = frontCount > backCount ? frontCount - backCount : backCount - frontCount;
+		size_t cost = splitCount * SplitCostWeight + imbalance;
+		if (cost < bestCost) {
+			bestTriangle = candidate;
+			bestCost = cost;
+		}
+	}
+
+	// every sampled candidate is degenerate, so any valid plane is taken
+	if (bestTriangle == NoTriangle) {
+		for (size_t i = 0; i < triangles.size (); i++) {
+			if (!IsDegenerateTriangle (triangles[i])) {
+				return i;
+			}
+		}
+	}
+	return bestTriangle;
+}
+
 }
@@ -3,6 +3,7 @@
 
 #include "Triangle.hpp"
 #include "Plane.hpp"
+#include "TriangleUtils.hpp"
 
 #include <vector>
 #include <memory>
@@ -16,16 +17,23 @@ public:
 	BSPTriangleClipper ();
 	virtual ~BSPTriangleClipper ();
 
-	virtual void	FrontTrianglesFound (const std::vector<Triangle>& triangles) = 0;
-	virtual void	BackTrianglesFound (const std::vector<Triangle>& triangles) = 0;
-	virtual void	PlaneTrianglesFound (const std::vector<Triangle>& triangles) = 0;
+	virtual void	FrontTrianglesFound (const TriangleCutList& triangles) = 0;
+	virtual void	BackTrianglesFound (const TriangleCutList& triangles) = 0;
+	virtual void	PlaneTrianglesFound (const TriangleCutList& triangles) = 0;
+};
+
+enum class BSPCoplanarSide
+{
+	Plane,
+	Front,
+	Back
 };
 
 class BSPTreeNode
 {
 public:
 	BSPTreeNode (const Triangle& triangle);
-	BSPTreeNode (const std::vector<Triangle>& triangles);
+	BSPTreeNode (const TriangleCutList& triangles);
 
 	void	AddTriangle (const Triangle& triangle);
 	void	ClipTriangle (const Triangle& triangle, BSPTriangleClipper& clipper) const;
@@ -49,6 +57,51 @@ private:
 	std::unique_ptr<BSPTreeNode>	rootNode;
 };
 
+// Built from all triangles at once. Splitting planes are chosen by a cost
+// heuristic that penalizes split triangles and unbalanced subtrees, and nodes
+// are stored in a contiguous array linked by indices. Degenerate triangles
+// have no plane, so they never split, and a group of only degenerate
+// triangles becomes an empty leaf. Callers clipping many triangles can pass
+// the same clip stack to every call, so its memory is reused.
+class BalancedBSPTree
+{
+public:
+	static const size_t InvalidNode = (size_t) -1;
+	static const size_t NoTriangle = (size_t) -1;
+
+	using ClipStack = std::vector<std::pair<size_t, Triangle>>;
+
+	BalancedBSPTree ();
+	BalancedBSPTree (const std::vector<Triangle>& triangles);
+
+	void	Build (const std::vector<Triangle>& triangles);
+	void	ClipTriangle (const Triangle& triangle, BSPTriangleClipper& clipper) const;
+	void	ClipTriangle (const Triangle& triangle, BSPTriangleClipper& clipper, BSPCoplanarSide sameDirectionSide, BSPCoplanarSide oppositeDirectionSide) const;
+	void	ClipTriangle (const Triangle& triangle, BSPTriangleClipper& clipper, BSPCoplanarSide sameDirectionSide, BSPCoplanarSide oppositeDirectionSide, ClipStack& stack) const;
+
+	size_t	NodeCount () const;
+	size_t	PlaneTriangleCount () const;
+	size_t	Depth () const;
+
+private:
+	class Node
+	{
+	public:
+		Node (const Plane& plane);
+
+		Plane	plane;
+		size_t	firstPlaneTriangle;
+		size_t	planeTriangleCount;
+		size_t	frontNode;
+		size_t	backNode;
+	};
+
+	size_t	SelectSplittingTriangle (const std::vector<Triangle>& triangles) const;
+
+	std::vector<Node>		nodes;
+	std::vector<Triangle>	planeTriangles;
+};
+
 }
 
 #endif
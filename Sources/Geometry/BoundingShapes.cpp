@@ -110,4 +110,17 @@ double BoundingSphere::GetRadius () const
 	return radius;
 }
 
+bool HasBoundingBoxOverlap (const BoundingBox& a, const BoundingBox& b)
+{
+	if (!a.IsValid () || !b.IsValid ()) {
+		return false;
+	}
+	for (int i = 0; i < 3; i++) {
+		if (IsGreater (a.GetMin ()[i], b.GetMax ()[i]) || IsGreater (b.GetMin ()[i], a.GetMax ()[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
 }
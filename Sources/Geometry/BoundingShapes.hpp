@@ -47,6 +47,8 @@ private:
 	double		radius;
 };
 
+bool HasBoundingBoxOverlap (const BoundingBox& a, const BoundingBox& b);
+
 extern const BoundingBox InvalidBoundingBox;
 extern const BoundingSphere InvalidBoundingSphere;
 
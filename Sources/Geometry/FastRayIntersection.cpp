@@ -0,0 +1,163 @@
+#include "FastRayIntersection.hpp"
+#include "Geometry.hpp"
+
+#include <algorithm>
+
+namespace Geometry
+{
+
+template <size_t Width>
+static size_t GetNearestBlockIntersection (const PrecomputedRay& ray, const TriangleBlock<Width>& block, double& distance)
+{
+	const double ox = ray.origin.x;
+	const double oy = ray.origin.y;
+	const double oz = ray.origin.z;
+	const double dx = ray.direction.x;
+	const double dy = ray.direction.y;
+	const double dz = ray.direction.z;
+
+	std::array<double, Width> distances;
+	for (size_t i = 0; i < Width; i++) {
+		double px = dy * block.e2z[i] - dz * block.e2y[i];
+		double py = dz * block.e2x[i] - dx * block.e2z[i];
+		double pz = dx * block.e2y[i] - dy * block.e2x[i];
+		double determinant = block.e1x[i] * px + block.e1y[i] * py + block.e1z[i] * pz;
+		double invDeterminant = 1.0 / determinant;
+
+		double tx = ox - block.v1x[i];
+		double ty = oy - block.v1y[i];
+		double tz = oz - block.v1z[i];
+		double u = (tx * px + ty * py + tz * pz) * invDeterminant;
+
+		double qx = ty * block.e1z[i] - tz * block.e1y[i];
+		double qy = tz * block.e1x[i] - tx * block.e1z[i];
+		double qz = tx * block.e1y[i] - ty * block.e1x[i];
+		double v = (dx * qx + dy * qy + dz * qz) * invDeterminant;
+		double t = (block.e2x[i] * qx + block.e2y[i] * qy + block.e2z[i] * qz) * invDeterminant;
+
+		bool valid = i < block.Count () && determinant > EPS && u >= -EPS && u <= 1.0 + EPS && v >= -EPS && u + v <= 1.0 + EPS && t > EPS;
+		distances[i] = valid ? t : INF;
+	}
+
+	size_t nearest = Width;
+	for (size_t i = 0; i < Width; i++) {
+		if (distances[i] < distance) {
+			distance = distances[i];
+			nearest = i;
+		}
+	}
+	return nearest;
+}
+
+template <size_t Width>
+static bool HasPacketBoundingBoxIntersection (const RayPacket<Width>& packet, const BoundingBox& boundingBox, const RayPacketHits<Width>& hits)
+{
+	const glm::dvec3 boxMin = boundingBox.GetMin () - glm::dvec3 (EPS);
+	const glm::dvec3 boxMax = boundingBox.GetMax () + glm::dvec3 (EPS);
+
+	bool hasHit = false;
+	for (size_t i = 0; i < Width; i++) {
+		double tx1 = (boxMin.x - packet.ox[i]) * packet.ix[i];
+		double tx2 = (boxMax.x - packet.ox[i]) * packet.ix[i];
+		double ty1 = (boxMin.y - packet.oy[i]) * packet.iy[i];
+		double ty2 = (boxMax.y - packet.oy[i]) * packet.iy[i];
+		double tz1 = (boxMin.z - packet.oz[i]) * packet.iz[i];
+		double tz2 = (boxMax.z - packet.oz[i]) * packet.iz[i];
+		double tMin = std::max (std::max (std::min (tx1, tx2), std::min (ty1, ty2)), std::max (std::min (tz1, tz2), 0.0));
+		double tMax = std::min (std::min (std::max (tx1, tx2), std::max (ty1, ty2)), std::min (std::max (tz1, tz2), hits.distances[i]));
+		bool laneHit = i < packet.Count () && tMin <= tMax;
+		hasHit = hasHit || laneHit;
+	}
+	return hasHit;
+}
+
+template <size_t Width>
+static void GetPacketTriangleIntersection (const RayPacket<Width>& packet, const glm::dvec3& v1, const glm::dvec3& v2, const glm::dvec3& v3, size_t id, RayPacketHits<Width>& hits)
+{
+	const glm::dvec3 e1 = v2 - v1;
+	const glm::dvec3 e2 = v3 - v1;
+	for (size_t i = 0; i < Width; i++) {
+		double px = packet.dy[i] * e2.z - packet.dz[i] * e2.y;
+		double py = packet.dz[i] * e2.x - packet.dx[i] * e2.z;
+		double pz = packet.dx[i] * e2.y - packet.dy[i] * e2.x;
+		double determinant = e1.x * px + e1.y * py + e1.z * pz;
+		double invDeterminant = 1.0 / determinant;
+
+		double tx = packet.ox[i] - v1.x;
+		double ty = packet.oy[i] - v1.y;
+		double tz = packet.oz[i] - v1.z;
+		double u = (tx * px + ty * py + tz * pz) * invDeterminant;
+
+		double qx = ty * e1.z - tz * e1.y;
+		double qy = tz * e1.x - tx * e1.z;
+		double qz = tx * e1.y - ty * e1.x;
+		double v = (packet.dx[i] * qx + packet.dy[i] * qy + packet.dz[i] * qz) * invDeterminant;
+		double t = (e2.x * qx + e2.y * qy + e2.z * qz) * invDeterminant;
+
+		bool valid = i < packet.Count () && determinant > EPS && u >= -EPS && u <= 1.0 + EPS && v >= -EPS && u + v <= 1.0 + EPS && t > EPS && t < hits.distances[i];
+		hits.distances[i] = valid ? t : hits.distances[i];
+		hits.ids[i] = valid ? id : hits.ids[i];
+	}
+}
+
+PrecomputedRay::PrecomputedRay (const Ray& ray) :
+	origin (ray.GetOrigin ()),
+	direction (glm::normalize (ray.GetDirection ())),
+	invDirection (1.0 / direction.x, 1.0 / direction.y, 1.0 / direction.z),
+	sign ({ invDirection.x < 0.0 ? 1 : 0, invDirection.y < 0.0 ? 1 : 0, invDirection.z < 0.0 ? 1 : 0 })
+{
+}
+
+bool GetRayBoundingBoxDistance (const PrecomputedRay& ray, const BoundingBox& boundingBox, double maxDistance, double& distance)
+{
+	// the box is extended with the tolerance, so rays going exactly along
+	// a face of the box don't produce nan values and count as intersecting
+	const std::array<glm::dvec3, 2> bounds = {
+		boundingBox.GetMin () - glm::dvec3 (EPS),
+		boundingBox.GetMax () + glm::dvec3 (EPS)
+	};
+
+	double tMin = (bounds[ray.sign[0]].x - ray.origin.x) * ray.invDirection.x;
+	double tMax = (bounds[1 - ray.sign[0]].x - ray.origin.x) * ray.invDirection.x;
+	double tyMin = (bounds[ray.sign[1]].y - ray.origin.y) * ray.invDirection.y;
+	double tyMax = (bounds[1 - ray.sign[1]].y - ray.origin.y) * ray.invDirection.y;
+	double tzMin = (bounds[ray.sign[2]].z - ray.origin.z) * ray.invDirection.z;
+	double tzMax = (bounds[1 - ray.sign[2]].z - ray.origin.z) * ray.invDirection.z;
+
+	tMin = std::max (std::max (tMin, tyMin), std::max (tzMin, 0.0));
+	tMax = std::min (std::min (tMax, tyMax), std::min (tzMax, maxDistance));
+	distance = tMin;
+	return tMin <= tMax;
+}
+
+size_t GetRayTriangleBlockIntersection (const PrecomputedRay& ray, const TriangleBlock4& block, double& distance)
+{
+	return GetNearestBlockIntersection (ray, block, distance);
+}
+
+size_t GetRayTriangleBlockIntersection (const PrecomputedRay& ray, const TriangleBlock8& block, double& distance)
+{
+	return GetNearestBlockIntersection (ray, block, distance);
+}
+
+bool HasRayPacketBoundingBoxIntersection (const RayPacket4& packet, const BoundingBox& boundingBox, const RayPacketHits4& hits)
+{
+	return HasPacketBoundingBoxIntersection (packet, boundingBox, hits);
+}
+
+bool HasRayPacketBoundingBoxIntersection (const RayPacket8& packet, const BoundingBox& boundingBox, const RayPacketHits8& hits)
+{
+	return HasPacketBoundingBoxIntersection (packet, boundingBox, hits);
+}
+
+void GetRayPacketTriangleIntersection (const RayPacket4& packet, const glm::dvec3& v1, const glm::dvec3& v2, const glm::dvec3& v3, size_t id, RayPacketHits4& hits)
+{
+	GetPacketTriangleIntersection (packet, v1, v2, v3, id, hits);
+}
+
+void GetRayPacketTriangleIntersection (const RayPacket8& packet, const glm::dvec3& v1, const glm::dvec3& v2, const glm::dvec3& v3, size_t id, RayPacketHits8& hits)
+{
+	GetPacketTriangleIntersection (packet, v1, v2, v3, id, hits);
+}
+
+}
@@ -0,0 +1,218 @@
+#ifndef GEOMETRY_FASTRAYINTERSECTION_HPP
+#define GEOMETRY_FASTRAYINTERSECTION_HPP
+
+#include "IncludeGLM.hpp"
+#include "Ray.hpp"
+#include "BoundingShapes.hpp"
+
+#include <array>
+#include <limits>
+
+// Intersection kernels for tracing many rays against many triangles. Rays are
+// normalized once, triangles are stored in fixed width structure of arrays
+// blocks, and the inner loops have no early exits, so the compiler can turn
+// them into vector instructions. The results match the scalar functions in
+// RayIntersection.hpp: back faces are culled and distances are measured
+// along the normalized ray direction. Adding to a full block or packet
+// returns false and leaves it unchanged.
+
+namespace Geometry
+{
+
+class PrecomputedRay
+{
+public:
+	PrecomputedRay (const Ray& ray);
+
+	glm::dvec3			origin;
+	glm::dvec3			direction;
+	glm::dvec3			invDirection;
+	std::array<int, 3>	sign;
+};
+
+template <size_t Width>
+class TriangleBlock
+{
+public:
+	static const size_t Size = Width;
+
+	TriangleBlock ();
+
+	bool	IsEmpty () const;
+	bool	IsFull () const;
+	size_t	Count () const;
+	bool	Add (const glm::dvec3& v1, const glm::dvec3& v2, const glm::dvec3& v3);
+
+	std::array<double, Width>	v1x, v1y, v1z;
+	std::array<double, Width>	e1x, e1y, e1z;
+	std::array<double, Width>	e2x, e2y, e2z;
+
+private:
+	size_t						count;
+};
+
+using TriangleBlock4 = TriangleBlock<4>;
+using TriangleBlock8 = TriangleBlock<8>;
+
+template <size_t Width>
+class RayPacket
+{
+public:
+	static const size_t Size = Width;
+
+	RayPacket ();
+
+	bool	IsFull () const;
+	size_t	Count () const;
+	bool	Add (const Ray& ray);
+
+	std::array<double, Width>	ox, oy, oz;
+	std::array<double, Width>	dx, dy, dz;
+	std::array<double, Width>	ix, iy, iz;
+
+private:
+	size_t						count;
+};
+
+using RayPacket4 = RayPacket<4>;
+using RayPacket8 = RayPacket<8>;
+
+template <size_t Width>
+class RayPacketHits
+{
+public:
+	static const size_t NoHit = (size_t) -1;
+
+	RayPacketHits ();
+
+	std::array<double, Width>	distances;
+	std::array<size_t, Width>	ids;
+};
+
+using RayPacketHits4 = RayPacketHits<4>;
+using RayPacketHits8 = RayPacketHits<8>;
+
+bool	GetRayBoundingBoxDistance (const PrecomputedRay& ray, const BoundingBox& boundingBox, double maxDistance, double& distance);
+
+// Returns the index of the nearest triangle of the block hit closer than
+// distance, and updates distance. Returns the size of the block if none.
+size_t	GetRayTriangleBlockIntersection (const PrecomputedRay& ray, const TriangleBlock4& block, double& distance);
+size_t	GetRayTriangleBlockIntersection (const PrecomputedRay& ray, const TriangleBlock8& block, double& distance);
+
+bool	HasRayPacketBoundingBoxIntersection (const RayPacket4& packet, const BoundingBox& boundingBox, const RayPacketHits4& hits);
+bool	HasRayPacketBoundingBoxIntersection (const RayPacket8& packet, const BoundingBox& boundingBox, const RayPacketHits8& hits);
+
+void	GetRayPacketTriangleIntersection (const RayPacket4& packet, const glm::dvec3& v1, const glm::dvec3& v2, const glm::dvec3& v3, size_t id, RayPacketHits4& hits);
+void	GetRayPacketTriangleIntersection (const RayPacket8& packet, const glm::dvec3& v1, const glm::dvec3& v2, const glm::dvec3& v3, size_t id, RayPacketHits8& hits);
+
+template <size_t Width>
+TriangleBlock<Width>::TriangleBlock () :
+	count (0)
+{
+	v1x.fill (0.0);
+	v1y.fill (0.0);
+	v1z.fill (0.0);
+	e1x.fill (0.0);
+	e1y.fill (0.0);
+	e1z.fill (0.0);
+	e2x.fill (0.0);
+	e2y.fill (0.0);
+	e2z.fill (0.0);
+}
+
+template <size_t Width>
+bool TriangleBlock<Width>::IsEmpty () const
+{
+	return count == 0;
+}
+
+template <size_t Width>
+bool TriangleBlock<Width>::IsFull () const
+{
+	return count == Width;
+}
+
+template <size_t Width>
+size_t TriangleBlock<Width>::Count () const
+{
+	return count;
+}
+
+template <size_t Width>
+bool TriangleBlock<Width>::Add (const glm::dvec3& v1, const glm::dvec3& v2, const glm::dvec3& v3)
+{
+	if (IsFull ()) {
+		return false;
+	}
+	glm::dvec3 e1 = v2 - v1;
+	glm::dvec3 e2 = v3 - v1;
+	v1x[count] = v1.x;
+	v1y[count] = v1.y;
+	v1z[count] = v1.z;
+	e1x[count] = e1.x;
+	e1y[count] = e1.y;
+	e1z[count] = e1.z;
+	e2x[count] = e2.x;
+	e2y[count] = e2.y;
+	e2z[count] = e2.z;
+	count++;
+	return true;
+}
+
+template <size_t Width>
+RayPacket<Width>::RayPacket () :
+	count (0)
+{
+	ox.fill (0.0);
+	oy.fill (0.0);
+	oz.fill (0.0);
+	dx.fill (0.0);
+	dy.fill (0.0);
+	dz.fill (0.0);
+	ix.fill (0.0);
+	iy.fill (0.0);
+	iz.fill (0.0);
+}
+
+template <size_t Width>
+bool RayPacket<Width>::IsFull () const
+{
+	return count == Width;
+}
+
+template <size_t Width>
+size_t RayPacket<Width>::Count () const
+{
+	return count;
+}
+
+template <size_t Width>
+bool RayPacket<Width>::Add (const Ray& ray)
+{
+	if (IsFull ()) {
+		return false;
+	}
+	PrecomputedRay precomputed (ray);
+	ox[count] = precomputed.origin.x;
+	oy[count] = precomputed.origin.y;
+	oz[count] = precomputed.origin.z;
+	dx[count] = precomputed.direction.x;
+	dy[count] = precomputed.direction.y;
+	dz[count] = precomputed.direction.z;
+	ix[count] = precomputed.invDirection.x;
+	iy[count] = precomputed.invDirection.y;
+	iz[count] = precomputed.invDirection.z;
+	count++;
+	return true;
+}
+
+template <size_t Width>
+RayPacketHits<Width>::RayPacketHits ()
+{
+	distances.fill (std::numeric_limits<double>::max ());
+	ids.fill (NoHit);
+}
+
+}
+
+#endif
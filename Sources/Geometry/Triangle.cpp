@@ -3,6 +3,10 @@
 namespace Geometry
 {
 
+Triangle::Triangle ()
+{
+}
+
 Triangle::Triangle (const glm::dvec3& v1, const glm::dvec3& v2, const glm::dvec3& v3) :
 	vertices ({ v1, v2, v3 })
 {
@@ -11,6 +11,7 @@ namespace Geometry
 class Triangle
 {
 public:
+	Triangle ();
 	Triangle (const glm::dvec3& v1, const glm::dvec3& v2, const glm::dvec3& v3);
 
 	const glm::dvec3& operator[] (size_t index) const;
@@ -0,0 +1,322 @@
+#include "TriangleBVH.hpp"
+#include "Geometry.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace Geometry
+{
+
+static const size_t NoBlock = (size_t) -1;
+static const size_t MaxStackSize = 128;
+
+const size_t TriangleBVH::NoTriangle;
+
+static double GetBoundingBoxDiagonal (const BoundingBox& boundingBox)
+{
+	return glm::distance (boundingBox.GetMin (), boundingBox.GetMax ());
+}
+
+static double GetSquaredBoundingBoxDistance (const BoundingBox& boundingBox, const glm::dvec3& point)
+{
+	glm::dvec3 difference = point - glm::clamp (point, boundingBox.GetMin (), boundingBox.GetMax ());
+	return glm::dot (difference, difference);
+}
+
+static double GetSquaredAxisDistance (double vertex, double edge1, double edge2, double coordinate)
+{
+	double min = vertex + std::min (std::min (edge1, edge2), 0.0);
+	double max = vertex + std::max (std::max (edge1, edge2), 0.0);
+	double distance = std::max (std::max (min - coordinate, coordinate - max), 0.0);
+	return distance * distance;
+}
+
+static double GetSquaredTriangleBoundingBoxDistance (const TriangleBlock8& block, size_t index, const glm::dvec3& point)
+{
+	return	GetSquaredAxisDistance (block.v1x[index], block.e1x[index], block.e2x[index], point.x) +
+			GetSquaredAxisDistance (block.v1y[index], block.e1y[index], block.e2y[index], point.y) +
+			GetSquaredAxisDistance (block.v1z[index], block.e1z[index], block.e2z[index], point.z);
+}
+
+TriangleBVH::Node::Node () :
+	boundingBox (),
+	firstChild (0),
+	block (NoBlock)
+{
+}
+
+bool TriangleBVH::Node::IsLeaf () const
+{
+	return block != NoBlock;
+}
+
+TriangleBVH::TriangleBVH (const std::vector<Triangle>& triangles) :
+	triangles (triangles),
+	nodes (),
+	blocks (),
+	blockTriangles ()
+{
+	if (triangles.empty ()) {
+		return;
+	}
+
+	std::vector<size_t> order (triangles.size ());
+	std::vector<glm::dvec3> centers (triangles.size ());
+	for (size_t i = 0; i < triangles.size (); i++) {
+		order[i] = i;
+		centers[i] = (triangles[i][0] + triangles[i][1] + triangles[i][2]) / 3.0;
+	}
+
+	nodes.push_back (Node ());
+	BuildNode (0, order, 0, order.size (), centers);
+}
+
+bool TriangleBVH::IsEmpty () const
+{
+	return nodes.empty ();
+}
+
+size_t TriangleBVH::TriangleCount () const
+{
+	return triangles.size ();
+}
+
+const Triangle& TriangleBVH::GetTriangle (size_t index) const
+{
+	return triangles[index];
+}
+
+const BoundingBox& TriangleBVH::GetBoundingBox () const
+{
+	if (nodes.empty ()) {
+		return InvalidBoundingBox;
+	}
+	return nodes[0].boundingBox;
+}
+
+size_t TriangleBVH::GetNearestIntersection (const PrecomputedRay& ray, double maxDistance, double& distance) const
+{
+	size_t nearest = NoTriangle;
+	distance = maxDistance;
+	if (nodes.empty ()) {
+		return nearest;
+	}
+
+	double rootDistance = 0.0;
+	if (!GetRayBoundingBoxDistance (ray, nodes[0].boundingBox, distance, rootDistance)) {
+		return nearest;
+	}
+
+	std::array<size_t, MaxStackSize> stack;
+	size_t stackSize = 0;
+	stack[stackSize++] = 0;
+	while (stackSize > 0) {
+		const Node& node = nodes[stack[--stackSize]];
+		if (node.IsLeaf ()) {
+			size_t index = GetRayTriangleBlockIntersection (ray, blocks[node.block], distance);
+			if (index != TriangleBlock8::Size) {
+				nearest = blockTriangles[node.block * TriangleBlock8::Size + index];
+			}
+			continue;
+		}
+
+		// the nearer child is pushed last, so it is processed first
+		double firstDistance = 0.0;
+		double secondDistance = 0.0;
+		bool firstHit = GetRayBoundingBoxDistance (ray, nodes[node.firstChild].boundingBox, distance, firstDistance);
+		bool secondHit = GetRayBoundingBoxDistance (ray, nodes[node.firstChild + 1].boundingBox, distance, secondDistance);
+		if (firstHit && secondHit) {
+			if (firstDistance < secondDistance) {
+				stack[stackSize++] = node.firstChild + 1;
+				stack[stackSize++] = node.firstChild;
+			} else {
+				stack[stackSize++] = node.firstChild;
+				stack[stackSize++] = node.firstChild + 1;
+			}
+		} else if (firstHit) {
+			stack[stackSize++] = node.firstChild;
+		} else if (secondHit) {
+			stack[stackSize++] = node.firstChild + 1;
+		}
+	}
+
+	return nearest;
+}
+
+bool TriangleBVH::HasIntersection (const PrecomputedRay& ray, double maxDistance) const
+{
+	if (nodes.empty ()) {
+		return false;
+	}
+
+	std::array<size_t, MaxStackSize> stack;
+	size_t stackSize = 0;
+	stack[stackSize++] = 0;
+	while (stackSize > 0) {
+		const Node& node = nodes[stack[--stackSize]];
+		double boxDistance = 0.0;
+		if (!GetRayBoundingBoxDistance (ray, node.boundingBox, maxDistance, boxDistance)) {
+			continue;
+		}
+		if (node.IsLeaf ()) {
+			double distance = maxDistance;
+			if (GetRayTriangleBlockIntersection (ray, blocks[node.block], distance) != TriangleBlock8::Size) {
+				return true;
+			}
+			continue;
+		}
+		stack[stackSize++] = node.firstChild;
+		stack[stackSize++] = node.firstChild + 1;
+	}
+
+	return false;
+}
+
+size_t TriangleBVH::GetClosestTriangle (const glm::dvec3& point, double maxDistance, TriangleClosestPoint& closestPoint, double& distance) const
+{
+	size_t closest = NoTriangle;
+	distance = maxDistance;
+	if (nodes.empty ()) {
+		return closest;
+	}
+
+	// distances are compared squared, the root is taken only for the result
+	double closestSquaredDistance = maxDistance * maxDistance;
+	std::array<std::pair<size_t, double>, MaxStackSize> stack;
+	size_t stackSize = 0;
+	stack[stackSize++] = { 0, GetSquaredBoundingBoxDistance (nodes[0].boundingBox, point) };
+	while (stackSize > 0) {
+		std::pair<size_t, double> entry = stack[--stackSize];
+		if (entry.second > closestSquaredDistance) {
+			continue;
+		}
+
+		const Node& node = nodes[entry.first];
+		if (node.IsLeaf ()) {
+			// the bounding box of a triangle is a cheap lower bound of its
+			// distance, most of the triangles of a leaf are skipped by it
+			const TriangleBlock8& block = blocks[node.block];
+			for (size_t i = 0; i < block.Count (); i++) {
+				if (GetSquaredTriangleBoundingBoxDistance (block, i, point) >= closestSquaredDistance) {
+					continue;
+				}
+				glm::dvec3 v1 (block.v1x[i], block.v1y[i], block.v1z[i]);
+				glm::dvec3 e1 (block.e1x[i], block.e1y[i], block.e1z[i]);
+				glm::dvec3 e2 (block.e2x[i], block.e2y[i], block.e2z[i]);
+				TriangleClosestPoint triangleClosestPoint = GetTriangleClosestPoint (v1, v1 + e1, v1 + e2, point);
+				glm::dvec3 difference = point - triangleClosestPoint.point;
+				double squaredDistance = glm::dot (difference, difference);
+				if (squaredDistance < closestSquaredDistance) {
+					closestSquaredDistance = squaredDistance;
+					closestPoint = triangleClosestPoint;
+					closest = blockTriangles[node.block * TriangleBlock8::Size + i];
+				}
+			}
+			continue;
+		}
+
+		// the nearer child is pushed last, so it is processed first
+		double firstDistance = GetSquaredBoundingBoxDistance (nodes[node.firstChild].boundingBox, point);
+		double secondDistance = GetSquaredBoundingBoxDistance (nodes[node.firstChild + 1].boundingBox, point);
+		size_t firstChild = node.firstChild;
+		if (firstDistance < secondDistance) {
+			stack[stackSize++] = { firstChild + 1, secondDistance };
+			stack[stackSize++] = { firstChild, firstDistance };
+		} else {
+			stack[stackSize++] = { firstChild, firstDistance };
+			stack[stackSize++] = { firstChild + 1, secondDistance };
+		}
+	}
+
+	if (closest != NoTriangle) {
+		distance = std::sqrt (closestSquaredDistance);
+	}
+	return closest;
+}
+
+void TriangleBVH::EnumerateCandidatePairs (const TriangleBVH& other, const std::function<void (size_t, size_t)>& processor) const
+{
+	if (nodes.empty () || other.nodes.empty ()) {
+		return;
+	}
+
+	std::vector<std::pair<size_t, size_t>> stack;
+	stack.push_back ({ 0, 0 });
+	while (!stack.empty ()) {
+		std::pair<size_t, size_t> nodePair = stack.back ();
+		stack.pop_back ();
+
+		const Node& node = nodes[nodePair.first];
+		const Node& otherNode = other.nodes[nodePair.second];
+		if (!HasBoundingBoxOverlap (node.boundingBox, otherNode.boundingBox)) {
+			continue;
+		}
+
+		if (node.IsLeaf () && otherNode.IsLeaf ()) {
+			const TriangleBlock8& block = blocks[node.block];
+			const TriangleBlock8& otherBlock = other.blocks[otherNode.block];
+			for (size_t i = 0; i < block.Count (); i++) {
+				size_t triangle = blockTriangles[node.block * TriangleBlock8::Size + i];
+				for (size_t j = 0; j < otherBlock.Count (); j++) {
+					processor (triangle, other.blockTriangles[otherNode.block * TriangleBlock8::Size + j]);
+				}
+			}
+		} else if (otherNode.IsLeaf () || (!node.IsLeaf () && GetBoundingBoxDiagonal (node.boundingBox) >= GetBoundingBoxDiagonal (otherNode.boundingBox))) {
+			stack.push_back ({ node.firstChild, nodePair.second });
+			stack.push_back ({ node.firstChild + 1, nodePair.second });
+		} else {
+			stack.push_back ({ nodePair.first, otherNode.firstChild });
+			stack.push_back ({ nodePair.first, otherNode.firstChild + 1 });
+		}
+	}
+}
+
+void TriangleBVH::BuildNode (size_t nodeIndex, std::vector<size_t>& order, size_t first, size_t count, const std::vector<glm::dvec3>& centers)
+{
+	BoundingBox boundingBox;
+	BoundingBox centerBoundingBox;
+	for (size_t i = first; i < first + count; i++) {
+		const Triangle& triangle = triangles[order[i]];
+		boundingBox.AddPoint (triangle[0]);
+		boundingBox.AddPoint (triangle[1]);
+		boundingBox.AddPoint (triangle[2]);
+		centerBoundingBox.AddPoint (centers[order[i]]);
+	}
+	nodes[nodeIndex].boundingBox = boundingBox;
+
+	if (count <= TriangleBlock8::Size) {
+		TriangleBlock8 block;
+		for (size_t i = first; i < first + count; i++) {
+			const Triangle& triangle = triangles[order[i]];
+			block.Add (triangle[0], triangle[1], triangle[2]);
+			blockTriangles.push_back (order[i]);
+		}
+		blockTriangles.resize (blockTriangles.size () + TriangleBlock8::Size - count, NoTriangle);
+		nodes[nodeIndex].block = blocks.size ();
+		blocks.push_back (block);
+		return;
+	}
+
+	glm::dvec3 size = centerBoundingBox.GetMax () - centerBoundingBox.GetMin ();
+	int axis = 0;
+	if (size.y > size.x && size.y >= size.z) {
+		axis = 1;
+	} else if (size.z > size.x && size.z > size.y) {
+		axis = 2;
+	}
+
+	size_t half = count / 2;
+	std::nth_element (order.begin () + first, order.begin () + first + half, order.begin () + first + count, [&] (size_t a, size_t b) {
+		return centers[a][axis] < centers[b][axis];
+	});
+
+	size_t firstChild = nodes.size ();
+	nodes[nodeIndex].firstChild = firstChild;
+	nodes.push_back (Node ());
+	nodes.push_back (Node ());
+	BuildNode (firstChild, order, first, half, centers);
+	BuildNode (firstChild + 1, order, first + half, count - half, centers);
+}
+
+}
@@ -0,0 +1,69 @@
+#ifndef GEOMETRY_TRIANGLEBVH_HPP
+#define GEOMETRY_TRIANGLEBVH_HPP
+
+#include "Triangle.hpp"
+#include "TriangleUtils.hpp"
+#include "BoundingShapes.hpp"
+#include "FastRayIntersection.hpp"
+
+#include <vector>
+#include <functional>
+
+namespace Geometry
+{
+
+// Bounding volume hierarchy over a triangle soup. Nodes are split at the
+// median of the triangle centers along the longest axis, and every leaf is
+// stored as one triangle block, so leaves are tested with the blocked kernel.
+// The tree is immutable after construction, so it can be queried from many
+// threads at the same time.
+class TriangleBVH
+{
+public:
+	static const size_t NoTriangle = (size_t) -1;
+
+	TriangleBVH (const std::vector<Triangle>& triangles);
+
+	bool					IsEmpty () const;
+	size_t					TriangleCount () const;
+	const Triangle&			GetTriangle (size_t index) const;
+	const BoundingBox&		GetBoundingBox () const;
+
+	// Returns the index of the nearest triangle hit closer than maxDistance,
+	// or NoTriangle if none. The distance is measured along the normalized ray.
+	size_t					GetNearestIntersection (const PrecomputedRay& ray, double maxDistance, double& distance) const;
+	bool					HasIntersection (const PrecomputedRay& ray, double maxDistance) const;
+
+	// Returns the index of the triangle closest to the point within maxDistance,
+	// or NoTriangle if none. Nearer subtrees are visited first, and subtrees
+	// farther than the closest triangle found so far are skipped.
+	size_t					GetClosestTriangle (const glm::dvec3& point, double maxDistance, TriangleClosestPoint& closestPoint, double& distance) const;
+
+	// Enumerates the triangle pairs of the two trees in overlapping leaves.
+	// The pairs are only candidates, they have to be checked one by one.
+	void					EnumerateCandidatePairs (const TriangleBVH& other, const std::function<void (size_t, size_t)>& processor) const;
+
+private:
+	class Node
+	{
+	public:
+		Node ();
+
+		bool			IsLeaf () const;
+
+		BoundingBox		boundingBox;
+		size_t			firstChild;
+		size_t			block;
+	};
+
+	void					BuildNode (size_t nodeIndex, std::vector<size_t>& order, size_t first, size_t count, const std::vector<glm::dvec3>& centers);
+
+	std::vector<Triangle>		triangles;
+	std::vector<Node>			nodes;
+	std::vector<TriangleBlock8>	blocks;
+	std::vector<size_t>			blockTriangles;
+};
+
+}
+
+#endif
@@ -4,10 +4,61 @@
 #include "Geometry.hpp"
 
 #include <array>
+#include <algorithm>
+#include <stdexcept>
 
 namespace Geometry
 {
 
+TriangleCutList::TriangleCutList () :
+	count (0)
+{
+}
+
+size_t TriangleCutList::GetSize () const
+{
+	return count;
+}
+
+bool TriangleCutList::IsEmpty () const
+{
+	return count == 0;
+}
+
+void TriangleCutList::Add (const Triangle& triangle)
+{
+	if (count >= MaxTriangleCount) {
+		throw std::logic_error ("too many triangles in cut list");
+	}
+	triangles[count++] = triangle;
+}
+
+const Triangle& TriangleCutList::operator[] (size_t index) const
+{
+	return triangles[index];
+}
+
+const Triangle* TriangleCutList::begin () const
+{
+	return triangles.data ();
+}
+
+const Triangle* TriangleCutList::end () const
+{
+	return triangles.data () + count;
+}
+
+TriangleClosestPoint::TriangleClosestPoint () :
+	TriangleClosestPoint (glm::dvec3 (0.0, 0.0, 0.0), TriangleFeature::Face)
+{
+}
+
+TriangleClosestPoint::TriangleClosestPoint (const glm::dvec3& point, TriangleFeature feature) :
+	point (point),
+	feature (feature)
+{
+}
+
 TrianglePlaneCutResult::TrianglePlaneCutResult ()
 {
 }
@@ -52,13 +103,13 @@ TrianglePlaneCutResult CutTriangleWithPlane (const Plane& plane, const Triangle&
 	}
 
 	if (hasFront && !hasBack) {
-		result.frontTriangles.push_back (triangle);
+		result.frontTriangles.Add (triangle);
 		return result;
 	} else if (!hasFront && hasBack) {
-		result.backTriangles.push_back (triangle);
+		result.backTriangles.Add (triangle);
 		return result;
 	} else if (hasOn && !hasFront && !hasBack) {
-		result.planeTriangles.push_back (triangle);
+		result.planeTriangles.Add (triangle);
 		return result;
 	}
 
@@ -74,11 +125,11 @@ TrianglePlaneCutResult CutTriangleWithPlane (const Plane& plane, const Triangle&
 		size_t next = cutVertex < 2 ? cutVertex + 1 : 0;
 		LinePlaneIntersectionResult intersection = GetLinePlaneIntersection (plane, Line::FromTwoPoints (triangle[prev], triangle[next]));
 		if (vertexPos[next] == PointPlanePosition::FrontOfPlane) {
-			result.frontTriangles.push_back (Triangle (triangle[cutVertex], triangle[next], intersection.position));
-			result.backTriangles.push_back (Triangle (triangle[cutVertex], intersection.position, triangle[prev]));
+			result.frontTriangles.Add (Triangle (triangle[cutVertex], triangle[next], intersection.position));
+			result.backTriangles.Add (Triangle (triangle[cutVertex], intersection.position, triangle[prev]));
 		} else if (vertexPos[next] == PointPlanePosition::BackOfPlane) {
-			result.backTriangles.push_back (Triangle (triangle[cutVertex], triangle[next], intersection.position));
-			result.frontTriangles.push_back (Triangle (triangle[cutVertex], intersection.position, triangle[prev]));
+			result.backTriangles.Add (Triangle (triangle[cutVertex], triangle[next], intersection.position));
+			result.frontTriangles.Add (Triangle (triangle[cutVertex], intersection.position, triangle[prev]));
 		} else {
 			throw std::logic_error ("failed to cut triangle");
 		}
@@ -98,13 +149,13 @@ TrianglePlaneCutResult CutTriangleWithPlane (const Plane& plane, const Triangle&
 		LinePlaneIntersectionResult prevIntersection = GetLinePlaneIntersection (plane, Line::FromTwoPoints (triangle[cutVertex], triangle[prev]));
 		LinePlaneIntersectionResult nextIntersection = GetLinePlaneIntersection (plane, Line::FromTwoPoints (triangle[cutVertex], triangle[next]));
 		if (vertexPos[cutVertex] == PointPlanePosition::FrontOfPlane) {
-			result.frontTriangles.push_back (Triangle (triangle[cutVertex], nextIntersection.position, prevIntersection.position));
-			result.backTriangles.push_back (Triangle (triangle[next], prevIntersection.position, nextIntersection.position));
-			result.backTriangles.push_back (Triangle (triangle[prev], prevIntersection.position, triangle[next]));
+			result.frontTriangles.Add (Triangle (triangle[cutVertex], nextIntersection.position, prevIntersection.position));
+			result.backTriangles.Add (Triangle (triangle[next], prevIntersection.position, nextIntersection.position));
+			result.backTriangles.Add (Triangle (triangle[prev], prevIntersection.position, triangle[next]));
 		} else if (vertexPos[cutVertex] == PointPlanePosition::BackOfPlane) {
-			result.backTriangles.push_back (Triangle (triangle[cutVertex], nextIntersection.position, prevIntersection.position));
-			result.frontTriangles.push_back (Triangle (triangle[next], prevIntersection.position, nextIntersection.position));
-			result.frontTriangles.push_back (Triangle (triangle[prev], prevIntersection.position, triangle[next]));
+			result.backTriangles.Add (Triangle (triangle[cutVertex], nextIntersection.position, prevIntersection.position));
+			result.frontTriangles.Add (Triangle (triangle[next], prevIntersection.position, nextIntersection.position));
+			result.frontTriangles.Add (Triangle (triangle[prev], prevIntersection.position, triangle[next]));
 		} else {
 			throw std::logic_error ("failed to cut triangle");
 		}
@@ -113,6 +164,252 @@ TrianglePlaneCutResult CutTriangleWithPlane (const Plane& plane, const Triangle&
 	return result;
 }
 
+static void GetPlaneDistances (const Triangle& triangle, const glm::dvec3& normal, const glm::dvec3& planePoint, std::array<double, 3>& distances)
+{
+	for (size_t i = 0; i < 3; i++) {
+		distances[i] = glm::dot (normal, triangle[i] - planePoint);
+		if (IsZero (distances[i])) {
+			distances[i] = 0.0;
+		}
+	}
+}
+
+static bool IsOnOneSide (const std::array<double, 3>& distances)
+{
+	return (distances[0] > 0.0 && distances[1] > 0.0 && distances[2] > 0.0) || (distances[0] < 0.0 && distances[1] < 0.0 && distances[2] < 0.0);
+}
+
+static void GetPlaneCutInterval (const Triangle& triangle, const std::array<double, 3>& distances, const glm::dvec3& direction, double& min, double& max)
+{
+	min = INF;
+	max = -INF;
+	auto AddPoint = [&] (const glm::dvec3& point) {
+		double param = glm::dot (direction, point);
+		min = std::min (min, param);
+		max = std::max (max, param);
+	};
+	for (size_t i = 0; i < 3; i++) {
+		size_t j = (i + 1) % 3;
+		if (distances[i] == 0.0) {
+			AddPoint (triangle[i]);
+		}
+		if ((distances[i] > 0.0 && distances[j] < 0.0) || (distances[i] < 0.0 && distances[j] > 0.0)) {
+			double ratio = distances[i] / (distances[i] - distances[j]);
+			AddPoint (triangle[i] + (triangle[j] - triangle[i]) * ratio);
+		}
+	}
+}
+
+static double GetSignedArea2D (const glm::dvec2& a, const glm::dvec2& b, const glm::dvec2& c)
+{
+	return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+static bool HasSegmentSegmentIntersection2D (const glm::dvec2& a1, const glm::dvec2& a2, const glm::dvec2& b1, const glm::dvec2& b2)
+{
+	double d1 = GetSignedArea2D (b1, b2, a1);
+	double d2 = GetSignedArea2D (b1, b2, a2);
+	double d3 = GetSignedArea2D (a1, a2, b1);
+	double d4 = GetSignedArea2D (a1, a2, b2);
+	if (((IsPositive (d1) && IsPositive (-d2)) || (IsPositive (-d1) && IsPositive (d2))) &&
+		((IsPositive (d3) && IsPositive (-d4)) || (IsPositive (-d3) && IsPositive (d4))))
+	{
+		return true;
+	}
+	auto IsOnSegment = [] (const glm::dvec2& s1, const glm::dvec2& s2, const glm::dvec2& p, double area) {
+		return IsZero (area) &&
+			IsGreaterOrEqual (p.x, std::min (s1.x, s2.x)) && IsLowerOrEqual (p.x, std::max (s1.x, s2.x)) &&
+			IsGreaterOrEqual (p.y, std::min (s1.y, s2.y)) && IsLowerOrEqual (p.y, std::max (s1.y, s2.y));
+	};
+	return IsOnSegment (b1, b2, a1, d1) || IsOnSegment (b1, b2, a2, d2) || IsOnSegment (a1, a2, b1, d3) || IsOnSegment (a1, a2, b2, d4);
+}
+
+static bool IsPointInTriangle2D (const std::array<glm::dvec2, 3>& triangle, const glm::dvec2& point)
+{
+	double d1 = GetSignedArea2D (triangle[0], triangle[1], point);
+	double d2 = GetSignedArea2D (triangle[1], triangle[2], point);
+	double d3 = GetSignedArea2D (triangle[2], triangle[0], point);
+	bool hasNegative = IsPositive (-d1) || IsPositive (-d2) || IsPositive (-d3);
+	bool hasPositive = IsPositive (d1) || IsPositive (d2) || IsPositive (d3);
+	return !(hasNegative && hasPositive);
+}
+
+static bool HasCoplanarTriangleTriangleIntersection (const Triangle& a, const Triangle& b, const glm::dvec3& normal)
+{
+	// project to the coordinate plane where the triangles are the largest
+	glm::dvec3 absNormal = glm::abs (normal);
+	int xAxis = 1;
+	int yAxis = 2;
+	if (absNormal.y > absNormal.x && absNormal.y >= absNormal.z) {
+		xAxis = 0;
+		yAxis = 2;
+	} else if (absNormal.z > absNormal.x && absNormal.z > absNormal.y) {
+		xAxis = 0;
+		yAxis = 1;
+	}
+
+	std::array<glm::dvec2, 3> a2D;
+	std::array<glm::dvec2, 3> b2D;
+	for (size_t i = 0; i < 3; i++) {
+		a2D[i] = glm::dvec2 (a[i][xAxis], a[i][yAxis]);
+		b2D[i] = glm::dvec2 (b[i][xAxis], b[i][yAxis]);
+	}
+
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 3; j++) {
+			if (HasSegmentSegmentIntersection2D (a2D[i], a2D[(i + 1) % 3], b2D[j], b2D[(j + 1) % 3])) {
+				return true;
+			}
+		}
+	}
+	return IsPointInTriangle2D (b2D, a2D[0]) || IsPointInTriangle2D (a2D, b2D[0]);
+}
+
+bool HasTriangleTriangleIntersection (const Triangle& a, const Triangle& b)
+{
+	glm::dvec3 aNormal = glm::cross (a[1] - a[0], a[2] - a[0]);
+	glm::dvec3 bNormal = glm::cross (b[1] - b[0], b[2] - b[0]);
+	if (IsZero (glm::length (aNormal)) || IsZero (glm::length (bNormal))) {
+		return false;
+	}
+	aNormal = glm::normalize (aNormal);
+	bNormal = glm::normalize (bNormal);
+
+	std::array<double, 3> aDistances;
+	GetPlaneDistances (a, bNormal, b[0], aDistances);
+	if (IsOnOneSide (aDistances)) {
+		return false;
+	}
+
+	std::array<double, 3> bDistances;
+	GetPlaneDistances (b, aNormal, a[0], bDistances);
+	if (IsOnOneSide (bDistances)) {
+		return false;
+	}
+
+	glm::dvec3 direction = glm::cross (aNormal, bNormal);
+	if (IsZero (glm::length (direction))) {
+		return HasCoplanarTriangleTriangleIntersection (a, b, aNormal);
+	}
+
+	// both triangles cut the line where the planes meet, they intersect if the cuts overlap
+	double aMin, aMax, bMin, bMax;
+	GetPlaneCutInterval (a, aDistances, direction, aMin, aMax);
+	GetPlaneCutInterval (b, bDistances, direction, bMin, bMax);
+	return IsLowerOrEqual (aMin, bMax) && IsLowerOrEqual (bMin, aMax);
+}
+
+TriangleClosestPoint GetTriangleClosestPoint (const Triangle& triangle, const glm::dvec3& point)
+{
+	return GetTriangleClosestPoint (triangle[0], triangle[1], triangle[2], point);
+}
+
+TriangleClosestPoint GetTriangleClosestPoint (const glm::dvec3& a, const glm::dvec3& b, const glm::dvec3& c, const glm::dvec3& point)
+{
+	glm::dvec3 ab = b - a;
+	glm::dvec3 ac = c - a;
+
+	glm::dvec3 ap = point - a;
+	double d1 = glm::dot (ab, ap);
+	double d2 = glm::dot (ac, ap);
+	if (d1 <= 0.0 && d2 <= 0.0) {
+		return TriangleClosestPoint (a, TriangleFeature::Vertex1);
+	}
+
+	glm::dvec3 bp = point - b;
+	double d3 = glm::dot (ab, bp);
+	double d4 = glm::dot (ac, bp);
+	if (d3 >= 0.0 && d4 <= d3) {
+		return TriangleClosestPoint (b, TriangleFeature::Vertex2);
+	}
+
+	double vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0 && d1 - d3 > 0.0) {
+		return TriangleClosestPoint (a + ab * (d1 / (d1 - d3)), TriangleFeature::Edge1);
+	}
+
+	glm::dvec3 cp = point - c;
+	double d5 = glm::dot (ab, cp);
+	double d6 = glm::dot (ac, cp);
+	if (d6 >= 0.0 && d5 <= d6) {
+		return TriangleClosestPoint (c, TriangleFeature::Vertex3);
+	}
+
+	double vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0 && d2 - d6 > 0.0) {
+		return TriangleClosestPoint (a + ac * (d2 / (d2 - d6)), TriangleFeature::Edge3);
+	}
+
+	double va = d3 * d6 - d5 * d4;
+	if (va <= 0.0 && d4 - d3 >= 0.0 && d5 - d6 >= 0.0 && (d4 - d3) + (d5 - d6) > 0.0) {
+		return TriangleClosestPoint (b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6))), TriangleFeature::Edge2);
+	}
+
+	double denom = va + vb + vc;
+	if (denom <= 0.0) {
+		return TriangleClosestPoint (a, TriangleFeature::Vertex1);
+	}
+	double v = vb / denom;
+	double w = vc / denom;
+	return TriangleClosestPoint (a + ab * v + ac * w, TriangleFeature::Face);
+}
+
+// Closest points of two segments by clamping the parameters of the closest
+// points of the infinite lines. Zero length segments are handled as points.
+static double GetSegmentSegmentDistance (const glm::dvec3& a1, const glm::dvec3& a2, const glm::dvec3& b1, const glm::dvec3& b2)
+{
+	glm::dvec3 aDirection = a2 - a1;
+	glm::dvec3 bDirection = b2 - b1;
+	glm::dvec3 offset = a1 - b1;
+	double aLengthSquare = glm::dot (aDirection, aDirection);
+	double bLengthSquare = glm::dot (bDirection, bDirection);
+	double bOffset = glm::dot (bDirection, offset);
+
+	double aParam = 0.0;
+	double bParam = 0.0;
+	if (aLengthSquare == 0.0 && bLengthSquare == 0.0) {
+		return glm::length (offset);
+	} else if (aLengthSquare == 0.0) {
+		bParam = glm::clamp (bOffset / bLengthSquare, 0.0, 1.0);
+	} else {
+		double aOffset = glm::dot (aDirection, offset);
+		if (bLengthSquare == 0.0) {
+			aParam = glm::clamp (-aOffset / aLengthSquare, 0.0, 1.0);
+		} else {
+			double directionDot = glm::dot (aDirection, bDirection);
+			double denominator = aLengthSquare * bLengthSquare - directionDot * directionDot;
+			if (denominator > 0.0) {
+				aParam = glm::clamp ((directionDot * bOffset - aOffset * bLengthSquare) / denominator, 0.0, 1.0);
+			}
+			bParam = (directionDot * aParam + bOffset) / bLengthSquare;
+			if (bParam < 0.0) {
+				bParam = 0.0;
+				aParam = glm::clamp (-aOffset / aLengthSquare, 0.0, 1.0);
+			} else if (bParam > 1.0) {
+				bParam = 1.0;
+				aParam = glm::clamp ((directionDot - aOffset) / aLengthSquare, 0.0, 1.0);
+			}
+		}
+	}
+	return glm::distance (a1 + aDirection * aParam, b1 + bDirection * bParam);
+}
+
+double GetTriangleTriangleDistance (const Triangle& a, const Triangle& b)
+{
+	if (HasTriangleTriangleIntersection (a, b)) {
+		return 0.0;
+	}
+	double distance = INF;
+	for (size_t i = 0; i < 3; i++) {
+		distance = std::min (distance, glm::distance (a[i], GetTriangleClosestPoint (b, a[i]).point));
+		distance = std::min (distance, glm::distance (b[i], GetTriangleClosestPoint (a, b[i]).point));
+		for (size_t j = 0; j < 3; j++) {
+			distance = std::min (distance, GetSegmentSegmentDistance (a[i], a[(i + 1) % 3], b[j], b[(j + 1) % 3]));
+		}
+	}
+	return distance;
+}
+
 double CalculateTriangleArea (double a, double b, double c)
 {
 	double s = (a + b + c) / 2.0;
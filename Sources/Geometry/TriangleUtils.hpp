@@ -6,6 +6,7 @@
 #include "Triangle.hpp"
 
 #include <vector>
+#include <array>
 
 namespace Geometry
 {
@@ -17,14 +18,59 @@ enum class Orientation
 	Invalid
 };
 
+// Cutting a triangle with a plane results in at most two triangles on each side,
+// so the result is stored inline without any heap allocation.
+class TriangleCutList
+{
+public:
+	static const size_t MaxTriangleCount = 2;
+
+	TriangleCutList ();
+
+	size_t					GetSize () const;
+	bool					IsEmpty () const;
+	void					Add (const Triangle& triangle);
+
+	const Triangle&			operator[] (size_t index) const;
+	const Triangle*			begin () const;
+	const Triangle*			end () const;
+
+private:
+	std::array<Triangle, MaxTriangleCount>	triangles;
+	size_t									count;
+};
+
+// The part of the triangle containing the closest point. Edges are numbered
+// by their first vertex, so Edge1 goes from the first to the second vertex.
+enum class TriangleFeature
+{
+	Face,
+	Edge1,
+	Edge2,
+	Edge3,
+	Vertex1,
+	Vertex2,
+	Vertex3
+};
+
+class TriangleClosestPoint
+{
+public:
+	TriangleClosestPoint ();
+	TriangleClosestPoint (const glm::dvec3& point, TriangleFeature feature);
+
+	glm::dvec3		point;
+	TriangleFeature	feature;
+};
+
 class TrianglePlaneCutResult
 {
 public:
 	TrianglePlaneCutResult ();
 
-	std::vector<Triangle> frontTriangles;
-	std::vector<Triangle> backTriangles;
-	std::vector<Triangle> planeTriangles;
+	TriangleCutList frontTriangles;
+	TriangleCutList backTriangles;
+	TriangleCutList planeTriangles;
 };
 
 glm::dvec3						CalculateTriangleNormal (const Triangle& triangle);
@@ -32,6 +78,20 @@ glm::dvec3						CalculateTriangleNormal (const glm::dvec3& v1, const glm::dvec3&
 Plane							GetTrianglePlane (const Triangle& triangle);
 TrianglePlaneCutResult			CutTriangleWithPlane (const Plane& plane, const Triangle& triangle);
 
+// Touching triangles are reported as intersecting.
+bool							HasTriangleTriangleIntersection (const Triangle& a, const Triangle& b);
+
+// Finds the closest point by the Voronoi regions of the vertices and edges,
+// so no square root is needed. Zero length edges are skipped, so degenerate
+// triangles return a point of a valid edge or a vertex.
+TriangleClosestPoint			GetTriangleClosestPoint (const Triangle& triangle, const glm::dvec3& point);
+TriangleClosestPoint			GetTriangleClosestPoint (const glm::dvec3& v1, const glm::dvec3& v2, const glm::dvec3& v3, const glm::dvec3& point);
+
+// Returns zero for intersecting triangles, otherwise the closest points lie
+// on a vertex of one triangle, or on an edge of both, so the minimum of these
+// distances is returned. Degenerate triangles are measured as segments.
+double							GetTriangleTriangleDistance (const Triangle& a, const Triangle& b);
+
 double							CalculateTriangleArea (double a, double b, double c);
 glm::dvec3						BarycentricInterpolation (const glm::dvec3& v1, const glm::dvec3& v2, const glm::dvec3& v3, const glm::dvec3& val1, const glm::dvec3& val2, const glm::dvec3& val3, const glm::dvec3& position);
 
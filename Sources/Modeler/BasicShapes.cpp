@@ -411,4 +411,9 @@ Mesh MeshShape::GenerateMesh () const
 	return result;
 }
 
+size_t MeshShape::CalcMemoryUsage () const
+{
+	return sizeof (MeshShape) - sizeof (Mesh) + mesh.CalcMemoryUsage ();
+}
+
 }
@@ -208,6 +208,8 @@ public:
 	virtual std::wstring	ToString () const override;
 	virtual Mesh			GenerateMesh () const override;
 
+	size_t					CalcMemoryUsage () const;
+
 private:
 	Mesh	mesh;
 };
@@ -0,0 +1,106 @@
+#include "BooleanShape.hpp"
+
+namespace Modeler
+{
+
+static std::shared_ptr<const BooleanShape> GetBooleanShape (const ShapeConstPtr& shape, BooleanShape::Operation operation)
+{
+	std::shared_ptr<const BooleanShape> booleanShape = std::dynamic_pointer_cast<const BooleanShape> (shape);
+	if (booleanShape == nullptr || booleanShape->GetOperation () != operation) {
+		return nullptr;
+	}
+	return booleanShape;
+}
+
+// Operands of nested unions are collected to one list, so they are united in
+// one operation. Unions with one operand come from nodes with one input shape,
+// they are replaced by their operand.
+static void CollectUnionOperands (const ShapeConstPtr& shape, std::vector<ShapeConstPtr>& operands)
+{
+	std::shared_ptr<const BooleanShape> unionShape = GetBooleanShape (shape, BooleanShape::Operation::Union);
+	if (unionShape == nullptr) {
+		operands.push_back (shape);
+		return;
+	}
+	for (const ShapeConstPtr& operand : unionShape->GetTransformedOperands ()) {
+		CollectUnionOperands (operand, operands);
+	}
+}
+
+// Only the body of a difference is followed, so the tools are usually
+// separated, and their union is a concatenation without exact calculation.
+static void CollectDifferenceOperands (const ShapeConstPtr& shape, ShapeConstPtr& body, std::vector<ShapeConstPtr>& tools)
+{
+	std::vector<ShapeConstPtr> unionOperands;
+	CollectUnionOperands (shape, unionOperands);
+	std::shared_ptr<const BooleanShape> differenceShape = nullptr;
+	if (unionOperands.size () == 1) {
+		differenceShape = GetBooleanShape (unionOperands[0], BooleanShape::Operation::Difference);
+	}
+	if (differenceShape == nullptr) {
+		body = shape;
+		return;
+	}
+	std::vector<ShapeConstPtr> operands = differenceShape->GetTransformedOperands ();
+	CollectDifferenceOperands (operands[0], body, tools);
+	CollectUnionOperands (operands[1], tools);
+}
+
+BooleanShape::BooleanShape (const glm::dmat4& transformation, Operation operation, const std::vector<ShapeConstPtr>& operands) :
+	Shape (transformation),
+	operation (operation),
+	operands (operands)
+{
+}
+
+BooleanShape::~BooleanShape ()
+{
+}
+
+bool BooleanShape::Check () const
+{
+	if (operation == Operation::Union) {
+		return !operands.empty ();
+	}
+	return operands.size () == 2;
+}
+
+BooleanShape::Operation BooleanShape::GetOperation () const
+{
+	return operation;
+}
+
+std::vector<ShapeConstPtr> BooleanShape::GetTransformedOperands () const
+{
+	if (transformation == glm::dmat4 (1.0)) {
+		return operands;
+	}
+	std::vector<ShapeConstPtr> transformedOperands;
+	for (const ShapeConstPtr& operand : operands) {
+		transformedOperands.push_back (operand->Transform (transformation));
+	}
+	return transformedOperands;
+}
+
+std::vector<ShapeConstPtr> BooleanShape::GetRewrittenOperands () const
+{
+	std::vector<ShapeConstPtr> transformedOperands = GetTransformedOperands ();
+	std::vector<ShapeConstPtr> rewrittenOperands;
+	if (operation == Operation::Difference) {
+		ShapeConstPtr body = nullptr;
+		std::vector<ShapeConstPtr> tools;
+		CollectDifferenceOperands (transformedOperands[0], body, tools);
+		CollectUnionOperands (transformedOperands[1], tools);
+		rewrittenOperands.push_back (body);
+		rewrittenOperands.insert (rewrittenOperands.end (), tools.begin (), tools.end ());
+	} else if (operation == Operation::Union) {
+		for (const ShapeConstPtr& operand : transformedOperands) {
+			CollectUnionOperands (operand, rewrittenOperands);
+		}
+	} else {
+		rewrittenOperands = transformedOperands;
+	}
+	return rewrittenOperands;
+}
+
+}
@@ -0,0 +1,47 @@
+#ifndef MODELER_BOOLEANSHAPE_HPP
+#define MODELER_BOOLEANSHAPE_HPP
+
+#include "Shape.hpp"
+
+#include <vector>
+
+namespace Modeler
+{
+
+// Shape of a boolean operation, which keeps its operands, so the operation can
+// be calculated later. The operand tree can be rewritten before calculation,
+// so nested operations are merged, and expensive operations run fewer times.
+// The rewrite is used only when the result of a deferred tree is calculated,
+// operations calculated immediately are not rewritten.
+class BooleanShape : public Shape
+{
+public:
+	enum class Operation
+	{
+		Difference,
+		Intersection,
+		Union
+	};
+
+	BooleanShape (const glm::dmat4& transformation, Operation operation, const std::vector<ShapeConstPtr>& operands);
+	virtual ~BooleanShape ();
+
+	virtual bool				Check () const override;
+
+	Operation					GetOperation () const;
+	std::vector<ShapeConstPtr>	GetTransformedOperands () const;
+
+	// The transformation is moved to the operands, nested unions are merged,
+	// and a chain of differences (A - B) - C is rewritten to A - (B + C). The
+	// first operand of a difference is the body, the others are the tools
+	// subtracted from it. Differences in the tools are kept intact.
+	std::vector<ShapeConstPtr>	GetRewrittenOperands () const;
+
+protected:
+	Operation					operation;
+	std::vector<ShapeConstPtr>	operands;
+};
+
+}
+
+#endif
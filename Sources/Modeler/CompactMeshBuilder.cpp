@@ -0,0 +1,56 @@
+#include "CompactMeshBuilder.hpp"
+
+#include <cmath>
+
+namespace Modeler
+{
+
+// vertices closer than the geometric tolerance can still be ends of different
+// short edges, so only values differing in rounding errors are merged
+static const double VertexGridSize = 1.0e-9;
+static const double NormalGridSize = 1.0e-7;
+
+size_t CompactMeshBuilder::GridPositionHash::operator() (const GridPosition& position) const
+{
+	uint64_t hash = 14695981039346656037ULL;
+	for (int64_t coordinate : position) {
+		hash = (hash ^ (uint64_t) coordinate) * 1099511628211ULL;
+	}
+	return (size_t) hash;
+}
+
+CompactMeshBuilder::CompactMeshBuilder (Mesh& mesh) :
+	mesh (mesh),
+	vertexMap (),
+	normalMap ()
+{
+}
+
+unsigned int CompactMeshBuilder::AddVertex (const glm::dvec3& vertex)
+{
+	auto inserted = vertexMap.insert ({ GetGridPosition (vertex, VertexGridSize), 0 });
+	if (inserted.second) {
+		inserted.first->second = mesh.AddVertex (vertex);
+	}
+	return inserted.first->second;
+}
+
+unsigned int CompactMeshBuilder::AddNormal (const glm::dvec3& normal)
+{
+	auto inserted = normalMap.insert ({ GetGridPosition (normal, NormalGridSize), 0 });
+	if (inserted.second) {
+		inserted.first->second = mesh.AddNormal (normal);
+	}
+	return inserted.first->second;
+}
+
+CompactMeshBuilder::GridPosition CompactMeshBuilder::GetGridPosition (const glm::dvec3& value, double gridSize)
+{
+	return GridPosition ({
+		(int64_t) std::llround (value.x / gridSize),
+		(int64_t) std::llround (value.y / gridSize),
+		(int64_t) std::llround (value.z / gridSize)
+	});
+}
+
+}
@@ -0,0 +1,45 @@
+#ifndef MODELER_COMPACTMESHBUILDER_HPP
+#define MODELER_COMPACTMESHBUILDER_HPP
+
+#include "Mesh.hpp"
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+
+namespace Modeler
+{
+
+// Adds vertices and normals to a mesh only once. Values are quantized to a
+// fine grid and looked up by their grid position, so values computed for the
+// same point of neighbouring triangles share one index, and the result is as
+// compact as a generated mesh.
+class CompactMeshBuilder
+{
+public:
+	CompactMeshBuilder (Mesh& mesh);
+
+	unsigned int	AddVertex (const glm::dvec3& vertex);
+	unsigned int	AddNormal (const glm::dvec3& normal);
+
+private:
+	using GridPosition = std::array<int64_t, 3>;
+
+	class GridPositionHash
+	{
+	public:
+		size_t operator() (const GridPosition& position) const;
+	};
+
+	using IndexMap = std::unordered_map<GridPosition, unsigned int, GridPositionHash>;
+
+	static GridPosition		GetGridPosition (const glm::dvec3& value, double gridSize);
+
+	Mesh&		mesh;
+	IndexMap	vertexMap;
+	IndexMap	normalMap;
+};
+
+}
+
+#endif
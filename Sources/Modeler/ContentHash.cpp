@@ -0,0 +1,107 @@
+#include "ContentHash.hpp"
+#include <memory.h>
+#include <cstddef>
+
+static_assert (sizeof (size_t) == 8, "");
+static_assert (sizeof (double) == 8, "");
+
+namespace Modeler
+{
+
+static const uint64_t Multiplier1 = 0x87c37b91114253d5ULL;
+static const uint64_t Multiplier2 = 0x4cf5ad432745937fULL;
+
+static uint64_t RotateLeft (uint64_t val, int bits)
+{
+	return (val << bits) | (val >> (64 - bits));
+}
+
+static uint64_t FinalMix (uint64_t val)
+{
+	val ^= val >> 33;
+	val *= 0xff51afd7ed558ccdULL;
+	val ^= val >> 33;
+	val *= 0xc4ceb9fe1a85ec53ULL;
+	val ^= val >> 33;
+	return val;
+}
+
+ContentHash::ContentHash () :
+	high (0),
+	low (0),
+	counter (0)
+{
+
+}
+
+ContentHash::~ContentHash ()
+{
+
+}
+
+void ContentHash::Add (int val)
+{
+	AddWord ((uint64_t) (int64_t) val);
+}
+
+void ContentHash::Add (unsigned int val)
+{
+	AddWord ((uint64_t) val);
+}
+
+void ContentHash::Add (size_t val)
+{
+	AddWord ((uint64_t) val);
+}
+
+void ContentHash::Add (int64_t val)
+{
+	AddWord ((uint64_t) val);
+}
+
+void ContentHash::Add (double val)
+{
+	uint64_t intVal = 0;
+	memcpy (&intVal, &val, sizeof (intVal));
+	AddWord (intVal);
+}
+
+void ContentHash::Add (const ContentHash& val)
+{
+	AddWord (val.high);
+	AddWord (val.low);
+	AddWord (val.counter);
+}
+
+bool ContentHash::operator== (const ContentHash& rhs) const
+{
+	return high == rhs.high && low == rhs.low && counter == rhs.counter;
+}
+
+bool ContentHash::operator!= (const ContentHash& rhs) const
+{
+	return !operator== (rhs);
+}
+
+size_t ContentHash::GenerateHashValue () const
+{
+	return (size_t) FinalMix (high ^ FinalMix (low + counter));
+}
+
+void ContentHash::AddWord (uint64_t val)
+{
+	// body of the 128-bit MurmurHash3 with the same word in both lanes
+	uint64_t k1 = RotateLeft (val * Multiplier1, 31) * Multiplier2;
+	high ^= k1;
+	high = RotateLeft (high, 27) + low;
+	high = high * 5 + 0x52dce729;
+
+	uint64_t k2 = RotateLeft (val * Multiplier2, 33) * Multiplier1;
+	low ^= k2;
+	low = RotateLeft (low, 31) + high;
+	low = low * 5 + 0x38495ab5;
+
+	counter++;
+}
+
+}
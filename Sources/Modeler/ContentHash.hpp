@@ -0,0 +1,53 @@
+#ifndef MODELER_CONTENTHASH_HPP
+#define MODELER_CONTENTHASH_HPP
+
+#include <stdint.h>
+#include <functional>
+
+namespace Modeler
+{
+
+// 128-bit hash of a sequence of values. Unlike Checksum it mixes every bit of
+// every value into both halves, so it can be used as a cache key for content,
+// but a cache still has to compare the content on a hit.
+class ContentHash
+{
+public:
+	ContentHash ();
+	~ContentHash ();
+
+	void	Add (int val);
+	void	Add (unsigned int val);
+	void	Add (size_t val);
+	void	Add (int64_t val);
+	void	Add (double val);
+	void	Add (const ContentHash& val);
+
+	bool	operator== (const ContentHash& rhs) const;
+	bool	operator!= (const ContentHash& rhs) const;
+
+	size_t	GenerateHashValue () const;
+
+private:
+	void	AddWord (uint64_t val);
+
+	uint64_t	high;
+	uint64_t	low;
+	uint64_t	counter;
+};
+
+}
+
+namespace std
+{
+	template <>
+	struct hash<Modeler::ContentHash>
+	{
+		size_t operator() (const Modeler::ContentHash& contentHash) const noexcept
+		{
+			return contentHash.GenerateHashValue ();
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,739 @@
+// The triangulation is a port of earcut (https://github.com/mapbox/earcut).
+//
+// ISC License
+//
+// Copyright (c) 2016, Mapbox
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted, provided that the above copyright notice
+// and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND ISC DISCLAIMS ALL WARRANTIES WITH REGARD TO
+// THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL ISC BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR
+// CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA
+// OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include "EarClippingTriangulator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <limits>
+
+namespace Modeler
+{
+
+// The rings of the polygon are stored in circular doubly linked lists. Nodes
+// are also linked in z-order for the ear lookup, and vertices duplicated by
+// hole bridges and splits keep the index of the original vertex.
+class PolygonNode
+{
+public:
+	PolygonNode (size_t index, const glm::dvec2& position) :
+		index (index),
+		x (position.x),
+		y (position.y),
+		prev (nullptr),
+		next (nullptr),
+		z (0),
+		prevZ (nullptr),
+		nextZ (nullptr)
+	{
+	}
+
+	size_t			index;
+	double			x;
+	double			y;
+	PolygonNode*	prev;
+	PolygonNode*	next;
+	uint32_t		z;
+	PolygonNode*	prevZ;
+	PolygonNode*	nextZ;
+};
+
+// Twice the signed area of the triangle, negative for counterclockwise turns.
+static double TurnArea (const PolygonNode* p, const PolygonNode* q, const PolygonNode* r)
+{
+	return (q->y - p->y) * (r->x - q->x) - (q->x - p->x) * (r->y - q->y);
+}
+
+static bool IsEqualPosition (const PolygonNode* a, const PolygonNode* b)
+{
+	return a->x == b->x && a->y == b->y;
+}
+
+static int GetSign (double value)
+{
+	return value > 0.0 ? 1 : (value < 0.0 ? -1 : 0);
+}
+
+static bool IsPointInTriangle (double ax, double ay, double bx, double by, double cx, double cy, double px, double py)
+{
+	return (cx - px) * (ay - py) >= (ax - px) * (cy - py) &&
+		(ax - px) * (by - py) >= (bx - px) * (ay - py) &&
+		(bx - px) * (cy - py) >= (cx - px) * (by - py);
+}
+
+// the first vertex is excluded, because it can be duplicated by a bridge
+static bool IsPointInTriangleExceptFirst (double ax, double ay, double bx, double by, double cx, double cy, double px, double py)
+{
+	return !(ax == px && ay == py) && IsPointInTriangle (ax, ay, bx, by, cx, cy, px, py);
+}
+
+static bool IsOnSegment (const PolygonNode* p, const PolygonNode* q, const PolygonNode* r)
+{
+	return q->x <= std::max (p->x, r->x) && q->x >= std::min (p->x, r->x) && q->y <= std::max (p->y, r->y) && q->y >= std::min (p->y, r->y);
+}
+
+static bool SegmentsIntersect (const PolygonNode* p1, const PolygonNode* q1, const PolygonNode* p2, const PolygonNode* q2)
+{
+	int o1 = GetSign (TurnArea (p1, q1, p2));
+	int o2 = GetSign (TurnArea (p1, q1, q2));
+	int o3 = GetSign (TurnArea (p2, q2, p1));
+	int o4 = GetSign (TurnArea (p2, q2, q1));
+	if (o1 != o2 && o3 != o4) {
+		return true;
+	}
+	if (o1 == 0 && IsOnSegment (p1, p2, q1)) {
+		return true;
+	}
+	if (o2 == 0 && IsOnSegment (p1, q2, q1)) {
+		return true;
+	}
+	if (o3 == 0 && IsOnSegment (p2, p1, q2)) {
+		return true;
+	}
+	if (o4 == 0 && IsOnSegment (p2, q1, q2)) {
+		return true;
+	}
+	return false;
+}
+
+static bool DiagonalIntersectsPolygon (const PolygonNode* a, const PolygonNode* b)
+{
+	const PolygonNode* p = a;
+	do {
+		if (p->index != a->index && p->next->index != a->index && p->index != b->index && p->next->index != b->index && SegmentsIntersect (p, p->next, a, b)) {
+			return true;
+		}
+		p = p->next;
+	} while (p != a);
+	return false;
+}
+
+static bool IsLocallyInside (const PolygonNode* a, const PolygonNode* b)
+{
+	if (TurnArea (a->prev, a, a->next) < 0.0) {
+		return TurnArea (a, b, a->next) >= 0.0 && TurnArea (a, a->prev, b) >= 0.0;
+	}
+	return TurnArea (a, b, a->prev) < 0.0 || TurnArea (a, a->next, b) < 0.0;
+}
+
+static bool IsMiddleInside (const PolygonNode* a, const PolygonNode* b)
+{
+	const PolygonNode* p = a;
+	bool inside = false;
+	double px = (a->x + b->x) / 2.0;
+	double py = (a->y + b->y) / 2.0;
+	do {
+		if (((p->y > py) != (p->next->y > py)) && p->next->y != p->y && (px < (p->next->x - p->x) * (py - p->y) / (p->next->y - p->y) + p->x)) {
+			inside = !inside;
+		}
+		p = p->next;
+	} while (p != a);
+	return inside;
+}
+
+static bool IsValidDiagonal (const PolygonNode* a, const PolygonNode* b)
+{
+	if (a->next->index == b->index || a->prev->index == b->index || DiagonalIntersectsPolygon (a, b)) {
+		return false;
+	}
+	if (IsLocallyInside (a, b) && IsLocallyInside (b, a) && IsMiddleInside (a, b) && (TurnArea (a->prev, a, b->prev) != 0.0 || TurnArea (a, b->prev, b) != 0.0)) {
+		return true;
+	}
+	return IsEqualPosition (a, b) && TurnArea (a->prev, a, a->next) > 0.0 && TurnArea (b->prev, b, b->next) > 0.0;
+}
+
+static bool SectorContainsSector (const PolygonNode* m, const PolygonNode* p)
+{
+	return TurnArea (m->prev, m, p->prev) < 0.0 && TurnArea (p->next, m, m->next) < 0.0;
+}
+
+static PolygonNode* GetLeftmostNode (PolygonNode* start)
+{
+	PolygonNode* p = start;
+	PolygonNode* leftmost = start;
+	do {
+		if (p->x < leftmost->x || (p->x == leftmost->x && p->y < leftmost->y)) {
+			leftmost = p;
+		}
+		p = p->next;
+	} while (p != start);
+	return leftmost;
+}
+
+static void RemoveNode (PolygonNode* p)
+{
+	p->next->prev = p->prev;
+	p->prev->next = p->next;
+	if (p->prevZ != nullptr) {
+		p->prevZ->nextZ = p->nextZ;
+	}
+	if (p->nextZ != nullptr) {
+		p->nextZ->prevZ = p->prevZ;
+	}
+}
+
+// Removes duplicated and collinear vertices between start and end.
+static PolygonNode* FilterPoints (PolygonNode* start, PolygonNode* end)
+{
+	if (start == nullptr) {
+		return start;
+	}
+	if (end == nullptr) {
+		end = start;
+	}
+
+	PolygonNode* p = start;
+	bool again = false;
+	do {
+		again = false;
+		if (IsEqualPosition (p, p->next) || TurnArea (p->prev, p, p->next) == 0.0) {
+			RemoveNode (p);
+			p = end = p->prev;
+			if (p == p->next) {
+				break;
+			}
+			again = true;
+		} else {
+			p = p->next;
+		}
+	} while (again || p != end);
+	return end;
+}
+
+// Simon Tatham's merge sort of the z-order list.
+static void SortByZOrder (PolygonNode* list)
+{
+	size_t inSize = 1;
+	size_t mergeCount = 0;
+	do {
+		PolygonNode* p = list;
+		PolygonNode* tail = nullptr;
+		list = nullptr;
+		mergeCount = 0;
+		while (p != nullptr) {
+			mergeCount++;
+			PolygonNode* q = p;
+			size_t pSize = 0;
+			for (size_t i = 0; i < inSize; i++) {
+				pSize++;
+				q = q->nextZ;
+				if (q == nullptr) {
+					break;
+				}
+			}
+			size_t qSize = inSize;
+			while (pSize > 0 || (qSize > 0 && q != nullptr)) {
+				PolygonNode* e = nullptr;
+				if (pSize != 0 && (qSize == 0 || q == nullptr || p->z <= q->z)) {
+					e = p;
+					p = p->nextZ;
+					pSize--;
+				} else {
+					e = q;
+					q = q->nextZ;
+					qSize--;
+				}
+				if (tail != nullptr) {
+					tail->nextZ = e;
+				} else {
+					list = e;
+				}
+				e->prevZ = tail;
+				tail = e;
+			}
+			p = q;
+		}
+		tail->nextZ = nullptr;
+		inSize *= 2;
+	} while (mergeCount > 1);
+}
+
+static double GetSignedArea (const std::vector<glm::dvec2>& points, size_t start, size_t end)
+{
+	double area = 0.0;
+	for (size_t i = start, j = end - 1; i < end; j = i++) {
+		area += (points[j].x - points[i].x) * (points[i].y + points[j].y);
+	}
+	return area / 2.0;
+}
+
+class EarClipper
+{
+public:
+	EarClipper (std::vector<std::array<size_t, 3>>& triangles) :
+		nodes (),
+		minX (0.0),
+		minY (0.0),
+		invSize (0.0),
+		triangles (triangles)
+	{
+	}
+
+	// The first ring is the contour, the rest are holes.
+	void Triangulate (const std::vector<glm::dvec2>& points, const std::vector<size_t>& ringStarts)
+	{
+		size_t contourEnd = ringStarts.size () > 1 ? ringStarts[1] : points.size ();
+		PolygonNode* outerNode = CreateRing (points, 0, contourEnd, true);
+		if (outerNode == nullptr || outerNode->next == outerNode->prev) {
+			return;
+		}
+
+		if (ringStarts.size () > 1) {
+			outerNode = EliminateHoles (points, ringStarts, outerNode);
+		}
+
+		// small polygons are faster to check without hashing
+		if (points.size () > 80) {
+			double maxX = -std::numeric_limits<double>::max ();
+			double maxY = -std::numeric_limits<double>::max ();
+			minX = std::numeric_limits<double>::max ();
+			minY = std::numeric_limits<double>::max ();
+			for (size_t i = 0; i < contourEnd; i++) {
+				minX = std::min (minX, points[i].x);
+				minY = std::min (minY, points[i].y);
+				maxX = std::max (maxX, points[i].x);
+				maxY = std::max (maxY, points[i].y);
+			}
+			invSize = std::max (maxX - minX, maxY - minY);
+			invSize = invSize != 0.0 ? 32767.0 / invSize : 0.0;
+		}
+
+		ClipEars (outerNode, 0);
+	}
+
+private:
+	PolygonNode* InsertNode (size_t index, const glm::dvec2& position, PolygonNode* last)
+	{
+		nodes.emplace_back (index, position);
+		PolygonNode* p = &nodes.back ();
+		if (last == nullptr) {
+			p->prev = p;
+			p->next = p;
+		} else {
+			p->next = last->next;
+			p->prev = last;
+			last->next->prev = p;
+			last->next = p;
+		}
+		return p;
+	}
+
+	// The contour is linked counterclockwise, and the holes clockwise.
+	PolygonNode* CreateRing (const std::vector<glm::dvec2>& points, size_t start, size_t end, bool counterClockwise)
+	{
+		PolygonNode* last = nullptr;
+		if (counterClockwise == (GetSignedArea (points, start, end) > 0.0)) {
+			for (size_t i = start; i < end; i++) {
+				last = InsertNode (i, points[i], last);
+			}
+		} else {
+			for (size_t i = end; i > start; i--) {
+				last = InsertNode (i - 1, points[i - 1], last);
+			}
+		}
+		if (last != nullptr && IsEqualPosition (last, last->next)) {
+			RemoveNode (last);
+			last = last->next;
+		}
+		return last;
+	}
+
+	// Connects a and b with a diagonal, and returns the node after b in the
+	// newly separated ring.
+	PolygonNode* SplitPolygon (PolygonNode* a, PolygonNode* b)
+	{
+		nodes.emplace_back (a->index, glm::dvec2 (a->x, a->y));
+		PolygonNode* a2 = &nodes.back ();
+		nodes.emplace_back (b->index, glm::dvec2 (b->x, b->y));
+		PolygonNode* b2 = &nodes.back ();
+		PolygonNode* an = a->next;
+		PolygonNode* bp = b->prev;
+
+		a->next = b;
+		b->prev = a;
+		a2->next = an;
+		an->prev = a2;
+		b2->next = a2;
+		a2->prev = b2;
+		bp->next = b2;
+		b2->prev = bp;
+		return b2;
+	}
+
+	PolygonNode* EliminateHoles (const std::vector<glm::dvec2>& points, const std::vector<size_t>& ringStarts, PolygonNode* outerNode)
+	{
+		std::vector<PolygonNode*> holeNodes;
+		for (size_t i = 1; i < ringStarts.size (); i++) {
+			size_t start = ringStarts[i];
+			size_t end = i < ringStarts.size () - 1 ? ringStarts[i + 1] : points.size ();
+			PolygonNode* list = CreateRing (points, start, end, false);
+			if (list == nullptr || list == list->next) {
+				continue;
+			}
+			holeNodes.push_back (GetLeftmostNode (list));
+		}
+
+		std::sort (holeNodes.begin (), holeNodes.end (), [] (const PolygonNode* a, const PolygonNode* b) {
+			if (a->x != b->x) {
+				return a->x < b->x;
+			}
+			if (a->y != b->y) {
+				return a->y < b->y;
+			}
+			double aAngle = std::atan2 (a->next->y - a->y, a->next->x - a->x);
+			double bAngle = std::atan2 (b->next->y - b->y, b->next->x - b->x);
+			return aAngle < bAngle;
+		});
+
+		for (PolygonNode* holeNode : holeNodes) {
+			PolygonNode* bridge = FindHoleBridge (holeNode, outerNode);
+			if (bridge == nullptr) {
+				continue;
+			}
+			PolygonNode* bridgeReverse = SplitPolygon (bridge, holeNode);
+			FilterPoints (bridgeReverse, bridgeReverse->next);
+			outerNode = FilterPoints (bridge, bridge->next);
+		}
+		return outerNode;
+	}
+
+	// Finds a contour vertex visible from the leftmost vertex of the hole.
+	PolygonNode* FindHoleBridge (PolygonNode* hole, PolygonNode* outerNode)
+	{
+		PolygonNode* p = outerNode;
+		double hx = hole->x;
+		double hy = hole->y;
+		double qx = -std::numeric_limits<double>::max ();
+		PolygonNode* m = nullptr;
+
+		if (IsEqualPosition (hole, p)) {
+			return p;
+		}
+
+		// the closest edge intersection on the left of the hole vertex
+		do {
+			if (IsEqualPosition (hole, p->next)) {
+				return p->next;
+			} else if (hy <= p->y && hy >= p->next->y && p->next->y != p->y) {
+				double x = p->x + (hy - p->y) * (p->next->x - p->x) / (p->next->y - p->y);
+				if (x <= hx && x > qx) {
+					qx = x;
+					m = p->x < p->next->x ? p : p->next;
+					if (x == hx) {
+						return m;
+					}
+				}
+			}
+			p = p->next;
+		} while (p != outerNode);
+
+		if (m == nullptr) {
+			return nullptr;
+		}
+
+		// reflex vertices inside the triangle of the hole vertex, the intersection
+		// and the edge endpoint can block the bridge, the one with the smallest
+		// angle is chosen then
+		PolygonNode* stop = m;
+		double mx = m->x;
+		double my = m->y;
+		double tanMin = std::numeric_limits<double>::max ();
+		p = m;
+		do {
+			if (hx >= p->x && p->x >= mx && hx != p->x && IsPointInTriangle (hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, p->x, p->y)) {
+				double tan = std::fabs (hy - p->y) / (hx - p->x);
+				if (IsLocallyInside (p, hole) && (tan < tanMin || (tan == tanMin && (p->x > m->x || (p->x == m->x && SectorContainsSector (m, p)))))) {
+					m = p;
+					tanMin = tan;
+				}
+			}
+			p = p->next;
+		} while (p != stop);
+
+		return m;
+	}
+
+	uint32_t GetZOrder (double x, double y) const
+	{
+		uint32_t ix = (uint32_t) ((x - minX) * invSize);
+		uint32_t iy = (uint32_t) ((y - minY) * invSize);
+		ix = (ix | (ix << 8)) & 0x00FF00FF;
+		ix = (ix | (ix << 4)) & 0x0F0F0F0F;
+		ix = (ix | (ix << 2)) & 0x33333333;
+		ix = (ix | (ix << 1)) & 0x55555555;
+		iy = (iy | (iy << 8)) & 0x00FF00FF;
+		iy = (iy | (iy << 4)) & 0x0F0F0F0F;
+		iy = (iy | (iy << 2)) & 0x33333333;
+		iy = (iy | (iy << 1)) & 0x55555555;
+		return ix | (iy << 1);
+	}
+
+	void IndexCurve (PolygonNode* start)
+	{
+		PolygonNode* p = start;
+		do {
+			if (p->z == 0) {
+				p->z = GetZOrder (p->x, p->y);
+			}
+			p->prevZ = p->prev;
+			p->nextZ = p->next;
+			p = p->next;
+		} while (p != start);
+		p->prevZ->nextZ = nullptr;
+		p->prevZ = nullptr;
+		SortByZOrder (p);
+	}
+
+	bool IsEar (const PolygonNode* ear) const
+	{
+		const PolygonNode* a = ear->prev;
+		const PolygonNode* b = ear;
+		const PolygonNode* c = ear->next;
+		if (TurnArea (a, b, c) >= 0.0) {
+			return false;
+		}
+
+		double x0 = std::min ({ a->x, b->x, c->x });
+		double y0 = std::min ({ a->y, b->y, c->y });
+		double x1 = std::max ({ a->x, b->x, c->x });
+		double y1 = std::max ({ a->y, b->y, c->y });
+		const PolygonNode* p = c->next;
+		while (p != a) {
+			if (p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1 && IsPointInTriangleExceptFirst (a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) && TurnArea (p->prev, p, p->next) >= 0.0) {
+				return false;
+			}
+			p = p->next;
+		}
+		return true;
+	}
+
+	bool IsEarHashed (const PolygonNode* ear) const
+	{
+		const PolygonNode* a = ear->prev;
+		const PolygonNode* b = ear;
+		const PolygonNode* c = ear->next;
+		if (TurnArea (a, b, c) >= 0.0) {
+			return false;
+		}
+
+		double x0 = std::min ({ a->x, b->x, c->x });
+		double y0 = std::min ({ a->y, b->y, c->y });
+		double x1 = std::max ({ a->x, b->x, c->x });
+		double y1 = std::max ({ a->y, b->y, c->y });
+		uint32_t minZ = GetZOrder (x0, y0);
+		uint32_t maxZ = GetZOrder (x1, y1);
+
+		auto blocksEar = [&] (const PolygonNode* p) {
+			return p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1 && p != a && p != c &&
+				IsPointInTriangleExceptFirst (a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) && TurnArea (p->prev, p, p->next) >= 0.0;
+		};
+
+		// the z-order list is walked in both directions from the ear
+		const PolygonNode* p = ear->prevZ;
+		const PolygonNode* n = ear->nextZ;
+		while (p != nullptr && p->z >= minZ && n != nullptr && n->z <= maxZ) {
+			if (blocksEar (p)) {
+				return false;
+			}
+			p = p->prevZ;
+			if (blocksEar (n)) {
+				return false;
+			}
+			n = n->nextZ;
+		}
+		while (p != nullptr && p->z >= minZ) {
+			if (blocksEar (p)) {
+				return false;
+			}
+			p = p->prevZ;
+		}
+		while (n != nullptr && n->z <= maxZ) {
+			if (blocksEar (n)) {
+				return false;
+			}
+			n = n->nextZ;
+		}
+		return true;
+	}
+
+	void AddTriangle (const PolygonNode* a, const PolygonNode* b, const PolygonNode* c)
+	{
+		triangles.push_back ({ a->index, b->index, c->index });
+	}
+
+	// If no ear is found, the first pass filters the points, the second one
+	// cuts off small self-intersections, and the last one splits the polygon.
+	void ClipEars (PolygonNode* ear, int pass)
+	{
+		if (ear == nullptr) {
+			return;
+		}
+		if (pass == 0 && invSize != 0.0) {
+			IndexCurve (ear);
+		}
+
+		PolygonNode* stop = ear;
+		while (ear->prev != ear->next) {
+			PolygonNode* prev = ear->prev;
+			PolygonNode* next = ear->next;
+			if (invSize != 0.0 ? IsEarHashed (ear) : IsEar (ear)) {
+				AddTriangle (prev, ear, next);
+				RemoveNode (ear);
+				ear = next->next;
+				stop = next->next;
+				continue;
+			}
+
+			ear = next;
+			if (ear == stop) {
+				if (pass == 0) {
+					ClipEars (FilterPoints (ear, nullptr), 1);
+				} else if (pass == 1) {
+					ear = CureLocalIntersections (FilterPoints (ear, nullptr));
+					ClipEars (ear, 2);
+				} else if (pass == 2) {
+					SplitAndClipEars (ear);
+				}
+				break;
+			}
+		}
+	}
+
+	PolygonNode* CureLocalIntersections (PolygonNode* start)
+	{
+		PolygonNode* p = start;
+		do {
+			PolygonNode* a = p->prev;
+			PolygonNode* b = p->next->next;
+			if (!IsEqualPosition (a, b) && SegmentsIntersect (a, p, p->next, b) && IsLocallyInside (a, b) && IsLocallyInside (b, a)) {
+				AddTriangle (a, p, b);
+				RemoveNode (p);
+				RemoveNode (p->next);
+				p = start = b;
+			}
+			p = p->next;
+		} while (p != start);
+		return FilterPoints (p, nullptr);
+	}
+
+	void SplitAndClipEars (PolygonNode* start)
+	{
+		PolygonNode* a = start;
+		do {
+			PolygonNode* b = a->next->next;
+			while (b != a->prev) {
+				if (a->index != b->index && IsValidDiagonal (a, b)) {
+					PolygonNode* c = SplitPolygon (a, b);
+					a = FilterPoints (a, a->next);
+					c = FilterPoints (c, c->next);
+					ClipEars (a, 0);
+					ClipEars (c, 0);
+					return;
+				}
+				b = b->next;
+			}
+			a = a->next;
+		} while (a != start);
+	}
+
+	std::deque<PolygonNode>					nodes;
+	double									minX;
+	double									minY;
+	double									invSize;
+	std::vector<std::array<size_t, 3>>&		triangles;
+};
+
+static bool TriangulateRings (const std::vector<glm::dvec2>& points, const std::vector<size_t>& ringStarts, std::vector<std::array<size_t, 3>>& result)
+{
+	size_t contourEnd = ringStarts.size () > 1 ? ringStarts[1] : points.size ();
+	if (contourEnd < 3) {
+		return false;
+	}
+
+	double contourArea = std::fabs (GetSignedArea (points, 0, contourEnd));
+	double holesArea = 0.0;
+	for (size_t i = 1; i < ringStarts.size (); i++) {
+		size_t end = i < ringStarts.size () - 1 ? ringStarts[i + 1] : points.size ();
+		if (end - ringStarts[i] >= 3) {
+			holesArea += std::fabs (GetSignedArea (points, ringStarts[i], end));
+		}
+	}
+	double tolerance = (contourArea + holesArea) * 1.0e-8;
+	double polygonArea = contourArea - holesArea;
+	if (polygonArea <= tolerance) {
+		return false;
+	}
+
+	size_t firstTriangle = result.size ();
+	EarClipper earClipper (result);
+	earClipper.Triangulate (points, ringStarts);
+
+	// missing and overlapping triangles change the covered area
+	double trianglesArea = 0.0;
+	for (size_t i = firstTriangle; i < result.size (); i++) {
+		const glm::dvec2& a = points[result[i][0]];
+		const glm::dvec2& b = points[result[i][1]];
+		const glm::dvec2& c = points[result[i][2]];
+		trianglesArea += std::fabs ((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x)) / 2.0;
+	}
+	return std::fabs (trianglesArea - polygonArea) <= tolerance;
+}
+
+EarClippingTriangulator::EarClippingTriangulator () :
+	EarClippingTriangulator (nullptr)
+{
+}
+
+EarClippingTriangulator::EarClippingTriangulator (const TriangulatorPtr& fallbackTriangulator) :
+	Triangulator (),
+	fallbackTriangulator (fallbackTriangulator)
+{
+}
+
+bool EarClippingTriangulator::TriangulatePolygon (const std::vector<glm::dvec2>& points, std::vector<std::array<size_t, 3>>& result)
+{
+	size_t originalSize = result.size ();
+	if (TriangulateRings (points, {}, result)) {
+		return true;
+	}
+	result.resize (originalSize);
+	if (fallbackTriangulator == nullptr) {
+		return false;
+	}
+	return fallbackTriangulator->TriangulatePolygon (points, result);
+}
+
+bool EarClippingTriangulator::TriangulatePolygonWithHoles (const std::vector<glm::dvec2>& contour, const std::vector<std::vector<glm::dvec2>>& holes, std::vector<std::array<size_t, 3>>& result)
+{
+	std::vector<glm::dvec2> points (contour);
+	std::vector<size_t> ringStarts = { 0 };
+	for (const std::vector<glm::dvec2>& hole : holes) {
+		ringStarts.push_back (points.size ());
+		points.insert (points.end (), hole.begin (), hole.end ());
+	}
+
+	size_t originalSize = result.size ();
+	if (!TriangulateRings (points, ringStarts, result)) {
+		result.resize (originalSize);
+		return false;
+	}
+	return true;
+}
+
+}
@@ -0,0 +1,35 @@
+#ifndef MODELER_EARCLIPPINGTRIANGULATOR_HPP
+#define MODELER_EARCLIPPINGTRIANGULATOR_HPP
+
+#include "PolygonalGenerators.hpp"
+
+namespace Modeler
+{
+
+// Ear clipping triangulation of simple polygons with holes. Ear candidates are
+// looked up on a z-order curve, so large polygons are triangulated in near
+// n log n time. The contour and the holes can have any orientation, and the
+// resulting triangles are always counterclockwise. Hole vertices are indexed
+// after the contour vertices in the order of the holes.
+//
+// The area of the result is checked against the area of the polygon, so
+// self-intersecting and other degenerate inputs are detected. For polygons
+// without holes these are passed to the fallback triangulator if there is one.
+// The nodes use only TriangulatePolygon, holes are not exposed in the user
+// interface yet.
+class EarClippingTriangulator : public Triangulator
+{
+public:
+	EarClippingTriangulator ();
+	EarClippingTriangulator (const TriangulatorPtr& fallbackTriangulator);
+
+	virtual bool	TriangulatePolygon (const std::vector<glm::dvec2>& points, std::vector<std::array<size_t, 3>>& result) override;
+	bool			TriangulatePolygonWithHoles (const std::vector<glm::dvec2>& contour, const std::vector<std::vector<glm::dvec2>>& holes, std::vector<std::array<size_t, 3>>& result);
+
+private:
+	TriangulatorPtr	fallbackTriangulator;
+};
+
+}
+
+#endif
@@ -56,7 +56,7 @@ private:
 	std::unordered_map<std::pair<MeshId, MaterialId>, size_t, PairHash>		materialMap;
 };
 
-static void GetMaterialMap (const Model& model, MaterialMap& materialMap)
+static void GetMaterialMap (const ModelView& model, MaterialMap& materialMap)
 {
 	model.EnumerateMeshes ([&] (MeshId meshId, const MeshRef& mesh) {
 		const MeshMaterials& materials = model.GetMeshMaterials (mesh);
@@ -66,7 +66,7 @@ static void GetMaterialMap (const Model& model, MaterialMap& materialMap)
 	});
 }
 
-void ExportModelToObj (const Model& model, const std::wstring& name, ModelWriter& writer)
+void ExportModelToObj (const ModelView& model, const std::wstring& name, ModelWriter& writer)
 {
 	MaterialMap materialMap;
 	GetMaterialMap (model, materialMap);
@@ -95,9 +95,10 @@ void ExportModelToObj (const Model& model, const std::wstring& name, ModelWriter
 		geometry.EnumerateNormals (transformation, [&] (const glm::dvec3& normal) {
 			writer.WriteLine (L"vn %g %g %g", normal.x, normal.y, normal.z);
 		});
-		EnumerateTrianglesByMaterial (geometry, materials, [&] (MaterialId materialId, const std::vector<unsigned int>& triangles) {
-			writer.WriteLine (L"usemtl Material" + std::to_wstring (materialMap.GetMaterial (meshId, materialId)));
-			for (unsigned int triangleId : triangles) {
+		for (unsigned int rangeIndex = 0; rangeIndex < materials.TriangleRangeCount (); rangeIndex++) {
+			const TriangleMaterialRange& range = materials.GetTriangleRange (rangeIndex);
+			writer.WriteLine (L"usemtl Material" + std::to_wstring (materialMap.GetMaterial (meshId, range.material)));
+			for (unsigned int triangleId = range.first; triangleId < range.first + range.count; triangleId++) {
 				const MeshTriangle& triangle = geometry.GetTriangle (triangleId);
 				writer.WriteLine (
 					L"f %d//%d %d//%d %d//%d",
@@ -106,14 +107,14 @@ void ExportModelToObj (const Model& model, const std::wstring& name, ModelWriter
 					vertexOffset + triangle.v3, normalOffset + triangle.n3
 				);
 			}
-		});
+		}
 		vertexOffset += geometry.VertexCount ();
 		normalOffset += geometry.NormalCount ();
 	});	
 	writer.CloseFile ();
 }
 
-void ExportModelToStl (const Model& model, const std::wstring& name, ModelWriter& writer)
+void ExportModelToStl (const ModelView& model, const std::wstring& name, ModelWriter& writer)
 {
 	writer.OpenFile (name + L".stl");
 	writer.WriteLine (L"solid " + name);
@@ -138,7 +139,7 @@ void ExportModelToStl (const Model& model, const std::wstring& name, ModelWriter
 	writer.CloseFile ();
 }
 
-void ExportModelToOff (const Model& model, const std::wstring& name, ModelWriter& writer)
+void ExportModelToOff (const ModelView& model, const std::wstring& name, ModelWriter& writer)
 {
 	unsigned int vertexCount = 0;
 	unsigned int triangleCount = 0;
@@ -176,7 +177,7 @@ void ExportModelToOff (const Model& model, const std::wstring& name, ModelWriter
 	writer.CloseFile ();
 }
 
-bool ExportModel (const Model& model, FormatId formatId, const std::wstring& name, ModelWriter& writer)
+bool ExportModel (const ModelView& model, FormatId formatId, const std::wstring& name, ModelWriter& writer)
 {
 	if (formatId == FormatId::Obj) {
 		ExportModelToObj (model, name, writer);
@@ -31,10 +31,10 @@ enum class FormatId
 	Off = 2
 };
 
-void ExportModelToObj (const Model& model, const std::wstring& name, ModelWriter& writer);
-void ExportModelToStl (const Model& model, const std::wstring& name, ModelWriter& writer);
-void ExportModelToOff (const Model& model, const std::wstring& name, ModelWriter& writer);
-bool ExportModel (const Model& model, FormatId formatId, const std::wstring& name, ModelWriter& writer);
+void ExportModelToObj (const ModelView& model, const std::wstring& name, ModelWriter& writer);
+void ExportModelToStl (const ModelView& model, const std::wstring& name, ModelWriter& writer);
+void ExportModelToOff (const ModelView& model, const std::wstring& name, ModelWriter& writer);
+bool ExportModel (const ModelView& model, FormatId formatId, const std::wstring& name, ModelWriter& writer);
 bool ExportMesh (const Mesh& mesh, FormatId formatId, const std::wstring& name, ModelWriter& writer);
 
 }
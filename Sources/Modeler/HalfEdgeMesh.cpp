@@ -0,0 +1,220 @@
+#include "HalfEdgeMesh.hpp"
+#include "MeshTopology.hpp"
+#include "ParallelTasks.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+namespace Modeler
+{
+
+const unsigned int NoHalfEdge = (unsigned int) -1;
+
+static const size_t TrianglesPerTask = 1 << 14;
+
+static void RunOnTriangleRanges (unsigned int triangleCount, unsigned int threadCount, const std::function<void (unsigned int, unsigned int)>& processor)
+{
+	size_t taskCount = (triangleCount + TrianglesPerTask - 1) / TrianglesPerTask;
+	RunParallelTasks (taskCount, threadCount, [&] (size_t taskIndex) {
+		size_t first = taskIndex * TrianglesPerTask;
+		size_t last = std::min (first + TrianglesPerTask, (size_t) triangleCount);
+		processor ((unsigned int) first, (unsigned int) last);
+	});
+}
+
+static const MeshTopology::TriangleEdge& GetTriangleEdge (const MeshTopology::Triangle& triangle, unsigned int index)
+{
+	if (index == 0) {
+		return triangle.edge1;
+	} else if (index == 1) {
+		return triangle.edge2;
+	}
+	return triangle.edge3;
+}
+
+HalfEdgeMesh::HalfEdgeMesh () :
+	mesh (),
+	origins (),
+	twins (),
+	vertexHalfEdges ()
+{
+}
+
+bool HalfEdgeMesh::Build (const Mesh& newMesh, unsigned int threadCount)
+{
+	Clear ();
+
+	const MeshGeometry& geometry = newMesh.GetGeometry ();
+	unsigned int triangleCount = geometry.TriangleCount ();
+	std::vector<unsigned int> triangleVertices (3 * (size_t) triangleCount);
+	RunOnTriangleRanges (triangleCount, threadCount, [&] (unsigned int first, unsigned int last) {
+		for (unsigned int i = first; i < last; i++) {
+			const MeshTriangle& triangle = geometry.GetTriangle (i);
+			triangleVertices[3 * i] = triangle.v1;
+			triangleVertices[3 * i + 1] = triangle.v2;
+			triangleVertices[3 * i + 2] = triangle.v3;
+		}
+	});
+
+	MeshTopology topology;
+	if (MeshTopologyBuilder::Build (topology, triangleVertices, threadCount) != MeshTopologyBuilder::Result::NoError) {
+		return false;
+	}
+
+	// the twin is the half-edge of the other triangle of the same edge
+	const std::vector<MeshTopology::Triangle>& topologyTriangles = topology.GetTriangles ();
+	const std::vector<MeshTopology::Edge>& topologyEdges = topology.GetEdges ();
+	twins.assign (triangleVertices.size (), NoHalfEdge);
+	RunOnTriangleRanges (triangleCount, threadCount, [&] (unsigned int first, unsigned int last) {
+		for (unsigned int i = first; i < last; i++) {
+			for (unsigned int j = 0; j < 3; j++) {
+				const MeshTopology::TriangleEdge& triangleEdge = GetTriangleEdge (topologyTriangles[i], j);
+				const MeshTopology::Edge& edge = topologyEdges[triangleEdge.edge];
+				unsigned int otherTriangle = triangleEdge.reversed ? edge.triangle1 : edge.triangle2;
+				if (otherTriangle == NoTriangle) {
+					continue;
+				}
+				for (unsigned int k = 0; k < 3; k++) {
+					const MeshTopology::TriangleEdge& otherEdge = GetTriangleEdge (topologyTriangles[otherTriangle], k);
+					if (otherEdge.edge == triangleEdge.edge && otherEdge.reversed != triangleEdge.reversed) {
+						twins[3 * i + j] = 3 * otherTriangle + k;
+						break;
+					}
+				}
+			}
+		}
+	});
+
+	// every vertex gets its outgoing half-edge with the smallest index, but the
+	// ones starting a boundary fan are preferred, so fans can be walked around
+	std::vector<std::atomic<uint64_t>> vertexKeys (geometry.VertexCount ());
+	for (std::atomic<uint64_t>& vertexKey : vertexKeys) {
+		vertexKey.store (UINT64_MAX, std::memory_order_relaxed);
+	}
+	origins.swap (triangleVertices);
+	RunOnTriangleRanges (triangleCount, threadCount, [&] (unsigned int first, unsigned int last) {
+		for (unsigned int halfEdge = 3 * first; halfEdge < 3 * last; halfEdge++) {
+			uint64_t isInner = twins[GetPrev (halfEdge)] != NoHalfEdge ? 1 : 0;
+			uint64_t key = isInner << 32 | halfEdge;
+			std::atomic<uint64_t>& vertexKey = vertexKeys[origins[halfEdge]];
+			uint64_t current = vertexKey.load (std::memory_order_relaxed);
+			while (key < current && !vertexKey.compare_exchange_weak (current, key, std::memory_order_relaxed)) {
+			}
+		}
+	});
+
+	vertexHalfEdges.resize (vertexKeys.size ());
+	for (size_t i = 0; i < vertexKeys.size (); i++) {
+		uint64_t key = vertexKeys[i].load (std::memory_order_relaxed);
+		vertexHalfEdges[i] = key == UINT64_MAX ? NoHalfEdge : (unsigned int) (key & 0xffffffff);
+	}
+
+	mesh = newMesh;
+	return true;
+}
+
+bool HalfEdgeMesh::IsEmpty () const
+{
+	return origins.empty ();
+}
+
+bool HalfEdgeMesh::IsClosed () const
+{
+	return std::find (twins.begin (), twins.end (), NoHalfEdge) == twins.end ();
+}
+
+const Mesh& HalfEdgeMesh::GetMesh () const
+{
+	return mesh;
+}
+
+unsigned int HalfEdgeMesh::VertexCount () const
+{
+	return (unsigned int) vertexHalfEdges.size ();
+}
+
+unsigned int HalfEdgeMesh::TriangleCount () const
+{
+	return (unsigned int) origins.size () / 3;
+}
+
+unsigned int HalfEdgeMesh::HalfEdgeCount () const
+{
+	return (unsigned int) origins.size ();
+}
+
+unsigned int HalfEdgeMesh::GetTwin (unsigned int halfEdge) const
+{
+	return twins[halfEdge];
+}
+
+unsigned int HalfEdgeMesh::GetNext (unsigned int halfEdge) const
+{
+	return halfEdge % 3 == 2 ? halfEdge - 2 : halfEdge + 1;
+}
+
+unsigned int HalfEdgeMesh::GetPrev (unsigned int halfEdge) const
+{
+	return halfEdge % 3 == 0 ? halfEdge + 2 : halfEdge - 1;
+}
+
+unsigned int HalfEdgeMesh::GetTriangle (unsigned int halfEdge) const
+{
+	return halfEdge / 3;
+}
+
+unsigned int HalfEdgeMesh::GetOrigin (unsigned int halfEdge) const
+{
+	return origins[halfEdge];
+}
+
+unsigned int HalfEdgeMesh::GetTarget (unsigned int halfEdge) const
+{
+	return origins[GetNext (halfEdge)];
+}
+
+bool HalfEdgeMesh::IsBoundaryHalfEdge (unsigned int halfEdge) const
+{
+	return twins[halfEdge] == NoHalfEdge;
+}
+
+unsigned int HalfEdgeMesh::GetVertexHalfEdge (unsigned int vertex) const
+{
+	return vertexHalfEdges[vertex];
+}
+
+bool HalfEdgeMesh::IsBoundaryVertex (unsigned int vertex) const
+{
+	unsigned int halfEdge = vertexHalfEdges[vertex];
+	return halfEdge == NoHalfEdge || twins[GetPrev (halfEdge)] == NoHalfEdge;
+}
+
+void HalfEdgeMesh::EnumerateVertexHalfEdges (unsigned int vertex, const std::function<void (unsigned int)>& processor) const
+{
+	unsigned int firstHalfEdge = vertexHalfEdges[vertex];
+	if (firstHalfEdge == NoHalfEdge) {
+		return;
+	}
+
+	// the next outgoing half-edge starts where the twin ends
+	unsigned int halfEdge = firstHalfEdge;
+	do {
+		processor (halfEdge);
+		unsigned int twin = twins[halfEdge];
+		if (twin == NoHalfEdge) {
+			break;
+		}
+		halfEdge = GetNext (twin);
+	} while (halfEdge != firstHalfEdge);
+}
+
+void HalfEdgeMesh::Clear ()
+{
+	mesh.Clear ();
+	origins.clear ();
+	twins.clear ();
+	vertexHalfEdges.clear ();
+}
+
+}
@@ -0,0 +1,64 @@
+#ifndef MODELER_HALFEDGEMESH_HPP
+#define MODELER_HALFEDGEMESH_HPP
+
+#include "Mesh.hpp"
+
+#include <vector>
+#include <functional>
+
+namespace Modeler
+{
+
+extern const unsigned int NoHalfEdge;
+
+// Index based half-edge structure over the triangles of a mesh. The three
+// half-edges of triangle t are 3t, 3t + 1 and 3t + 2, and half-edge 3t + k
+// starts at the k-th vertex of the triangle, so next, previous and triangle
+// queries are arithmetic, and only the twins and one outgoing half-edge per
+// vertex are stored. The mesh is kept as it is, so converting back to a mesh
+// shares every buffer with the original one.
+class HalfEdgeMesh
+{
+public:
+	HalfEdgeMesh ();
+
+	// Returns false for meshes with non-manifold edges, in this case the
+	// half-edge mesh stays empty. With a thread count of zero every hardware
+	// thread is used.
+	bool			Build (const Mesh& mesh, unsigned int threadCount);
+
+	bool			IsEmpty () const;
+	bool			IsClosed () const;
+	const Mesh&		GetMesh () const;
+
+	unsigned int	VertexCount () const;
+	unsigned int	TriangleCount () const;
+	unsigned int	HalfEdgeCount () const;
+
+	unsigned int	GetTwin (unsigned int halfEdge) const;
+	unsigned int	GetNext (unsigned int halfEdge) const;
+	unsigned int	GetPrev (unsigned int halfEdge) const;
+	unsigned int	GetTriangle (unsigned int halfEdge) const;
+	unsigned int	GetOrigin (unsigned int halfEdge) const;
+	unsigned int	GetTarget (unsigned int halfEdge) const;
+	bool			IsBoundaryHalfEdge (unsigned int halfEdge) const;
+
+	// The outgoing half-edge of a boundary vertex is the first one of its fan,
+	// so enumerating from it visits every outgoing half-edge of the vertex.
+	// Vertices without triangles have no outgoing half-edge.
+	unsigned int	GetVertexHalfEdge (unsigned int vertex) const;
+	bool			IsBoundaryVertex (unsigned int vertex) const;
+	void			EnumerateVertexHalfEdges (unsigned int vertex, const std::function<void (unsigned int)>& processor) const;
+
+	void			Clear ();
+
+private:
+	Mesh						mesh;
+	std::vector<unsigned int>	origins;
+	std::vector<unsigned int>	twins;
+	std::vector<unsigned int>	vertexHalfEdges;
+};
+
+}
+
+#endif
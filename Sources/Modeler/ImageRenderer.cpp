@@ -0,0 +1,181 @@
+#include "ImageRenderer.hpp"
+#include "RayTracing.hpp"
+#include "ParallelTasks.hpp"
+#include "TriangleUtils.hpp"
+#include "Geometry.hpp"
+
+#include <random>
+#include <cmath>
+#include <algorithm>
+
+namespace Modeler
+{
+
+static unsigned char ColorComponentToByte (double component)
+{
+	return (unsigned char) std::round (glm::clamp (component, 0.0, 1.0) * 255.0);
+}
+
+static glm::dvec3 GetPerpendicularDirection (const glm::dvec3& direction)
+{
+	if (std::fabs (direction.x) < 0.5) {
+		return glm::normalize (glm::cross (direction, glm::dvec3 (1.0, 0.0, 0.0)));
+	}
+	return glm::normalize (glm::cross (direction, glm::dvec3 (0.0, 1.0, 0.0)));
+}
+
+ImageRenderSettings::ImageRenderSettings () :
+	threadCount (0),
+	tileSize (32),
+	ambientOcclusionSamples (16),
+	ambientOcclusionRadius (0.2),
+	lightColor (0.7, 0.7, 0.7),
+	lightAmbientStrength (0.6),
+	lightSpecularStrength (0.1),
+	materialShininess (32.0),
+	backgroundColor (0.9, 0.9, 0.9, 0.0)
+{
+}
+
+ImageRenderer::TriangleData::TriangleData (const glm::dvec3& n1, const glm::dvec3& n2, const glm::dvec3& n3, const glm::dvec3& color) :
+	n1 (n1),
+	n2 (n2),
+	n3 (n3),
+	color (color)
+{
+}
+
+ImageRenderer::ImageRenderer (const ModelView& model) :
+	triangleData (),
+	bvh (CollectTriangles (model, triangleData)),
+	modelRadius (0.0)
+{
+	Geometry::BoundingSphere boundingSphere = model.GetBoundingSphere ();
+	if (boundingSphere.IsValid ()) {
+		modelRadius = boundingSphere.GetRadius ();
+	}
+}
+
+void ImageRenderer::RenderImage (const Camera& camera, int width, int height, const ImageRenderSettings& settings, unsigned char* pixels) const
+{
+	int tileSize = std::max (settings.tileSize, 1);
+	int horizontalTiles = (width + tileSize - 1) / tileSize;
+	int verticalTiles = (height + tileSize - 1) / tileSize;
+	size_t tileCount = (size_t) horizontalTiles * (size_t) verticalTiles;
+
+	// tiles write disjoint parts of the buffer, so they need no synchronization
+	RunParallelTasks (tileCount, settings.threadCount, [&] (size_t tileIndex) {
+		int tileX = (int) (tileIndex % horizontalTiles) * tileSize;
+		int tileY = (int) (tileIndex / horizontalTiles) * tileSize;
+		int tileEndX = std::min (tileX + tileSize, width);
+		int tileEndY = std::min (tileY + tileSize, height);
+		for (int y = tileY; y < tileEndY; y++) {
+			for (int x = tileX; x < tileEndX; x++) {
+				glm::dvec4 color = TracePixel (camera, width, height, x, y, settings);
+				size_t firstIndex = ((size_t) y * width + x) * 4;
+				pixels[firstIndex + 0] = ColorComponentToByte (color.r);
+				pixels[firstIndex + 1] = ColorComponentToByte (color.g);
+				pixels[firstIndex + 2] = ColorComponentToByte (color.b);
+				pixels[firstIndex + 3] = ColorComponentToByte (color.a);
+			}
+		}
+	});
+}
+
+glm::dvec4 ImageRenderer::TracePixel (const Camera& camera, int width, int height, int x, int y, const ImageRenderSettings& settings) const
+{
+	// screen positions go from top to bottom, rows go from bottom to top
+	glm::dvec2 screenSize (width, height);
+	glm::dvec2 screenPos (x + 0.5, height - y - 0.5);
+	Geometry::PrecomputedRay ray (GetScreenRay (camera, screenSize, screenPos));
+
+	double distance = 0.0;
+	size_t triangleIndex = bvh.GetNearestIntersection (ray, Geometry::INF, distance);
+	if (triangleIndex == Geometry::TriangleBVH::NoTriangle) {
+		return settings.backgroundColor;
+	}
+
+	const Geometry::Triangle& triangle = bvh.GetTriangle (triangleIndex);
+	const TriangleData& data = triangleData[triangleIndex];
+	glm::dvec3 position = ray.origin + ray.direction * distance;
+	glm::dvec3 normal = glm::normalize (Geometry::BarycentricInterpolation (triangle[0], triangle[1], triangle[2], data.n1, data.n2, data.n3, position));
+	glm::dvec3 faceNormal = glm::normalize (glm::cross (triangle[1] - triangle[0], triangle[2] - triangle[0]));
+
+	double ambientOcclusion = CalcAmbientOcclusion (position, faceNormal, x, y, settings);
+	glm::dvec3 ambient = settings.lightAmbientStrength * ambientOcclusion * settings.lightColor;
+
+	glm::dvec3 lightDirection = glm::normalize (camera.GetEye () - position);
+	double diffuseValue = std::max (glm::dot (normal, lightDirection), 0.0);
+	glm::dvec3 diffuse = diffuseValue * settings.lightColor;
+
+	glm::dvec3 viewDirection = -ray.direction;
+	glm::dvec3 reflectedDirection = glm::reflect (-lightDirection, normal);
+	double specularValue = std::pow (std::max (glm::dot (viewDirection, reflectedDirection), 0.0), settings.materialShininess);
+	glm::dvec3 specular = settings.lightSpecularStrength * specularValue * settings.lightColor;
+
+	glm::dvec3 result = (ambient + diffuse + specular) * data.color;
+	return glm::dvec4 (result, 1.0);
+}
+
+double ImageRenderer::CalcAmbientOcclusion (const glm::dvec3& position, const glm::dvec3& normal, int x, int y, const ImageRenderSettings& settings) const
+{
+	if (settings.ambientOcclusionSamples <= 0 || !Geometry::IsPositive (modelRadius)) {
+		return 1.0;
+	}
+
+	// the generator is seeded by the pixel, so the image does not depend
+	// on the number of threads or on the order of the tiles
+	std::minstd_rand generator ((unsigned int) (x * 73856093) ^ (unsigned int) (y * 19349663));
+	std::uniform_real_distribution<double> distribution (0.0, 1.0);
+
+	glm::dvec3 tangent = GetPerpendicularDirection (normal);
+	glm::dvec3 bitangent = glm::cross (normal, tangent);
+	double maxDistance = modelRadius * settings.ambientOcclusionRadius;
+
+	int occludedSamples = 0;
+	for (int i = 0; i < settings.ambientOcclusionSamples; i++) {
+		// cosine weighted direction on the hemisphere around the normal
+		double angle = 2.0 * PI * distribution (generator);
+		double radiusSquare = distribution (generator);
+		double radius = std::sqrt (radiusSquare);
+		glm::dvec3 direction =
+			tangent * (radius * std::cos (angle)) +
+			bitangent * (radius * std::sin (angle)) +
+			normal * std::sqrt (std::max (1.0 - radiusSquare, 0.0));
+		Geometry::PrecomputedRay sampleRay (Geometry::Ray (position, direction));
+		if (bvh.HasIntersection (sampleRay, maxDistance)) {
+			occludedSamples++;
+		}
+	}
+
+	return 1.0 - (double) occludedSamples / (double) settings.ambientOcclusionSamples;
+}
+
+std::vector<Geometry::Triangle> ImageRenderer::CollectTriangles (const ModelView& model, std::vector<TriangleData>& triangleData)
+{
+	std::vector<Geometry::Triangle> triangles;
+	model.EnumerateMeshes ([&] (MeshId, const MeshRef& meshRef) {
+		const MeshGeometry& geometry = model.GetMeshGeometry (meshRef);
+		const MeshMaterials& materials = model.GetMeshMaterials (meshRef);
+		const glm::dmat4& transformation = meshRef.GetTransformation ();
+		glm::dmat3 normalMatrix = glm::transpose (glm::inverse (glm::dmat3 (transformation)));
+		for (unsigned int triangleIndex = 0; triangleIndex < geometry.TriangleCount (); triangleIndex++) {
+			const MeshTriangle& triangle = geometry.GetTriangle (triangleIndex);
+			triangles.push_back (Geometry::Triangle (
+				geometry.GetVertex (triangle.v1, transformation),
+				geometry.GetVertex (triangle.v2, transformation),
+				geometry.GetVertex (triangle.v3, transformation)
+			));
+			const Material& material = materials.GetMaterial (materials.GetTriangleMaterial (triangleIndex));
+			triangleData.push_back (TriangleData (
+				glm::normalize (normalMatrix * geometry.GetNormal (triangle.n1)),
+				glm::normalize (normalMatrix * geometry.GetNormal (triangle.n2)),
+				glm::normalize (normalMatrix * geometry.GetNormal (triangle.n3)),
+				material.GetColor ()
+			));
+		}
+	});
+	return triangles;
+}
+
+}
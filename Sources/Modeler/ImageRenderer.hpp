@@ -0,0 +1,68 @@
+#ifndef MODELER_IMAGERENDERER_HPP
+#define MODELER_IMAGERENDERER_HPP
+
+#include "IncludeGLM.hpp"
+#include "Model.hpp"
+#include "Camera.hpp"
+#include "TriangleBVH.hpp"
+
+#include <vector>
+
+namespace Modeler
+{
+
+// The light settings are the same as the ones of the OpenGL renderer, so the
+// images look the same apart from the ambient occlusion.
+class ImageRenderSettings
+{
+public:
+	ImageRenderSettings ();
+
+	unsigned int	threadCount;
+	int				tileSize;
+	int				ambientOcclusionSamples;
+	double			ambientOcclusionRadius;
+	glm::dvec3		lightColor;
+	double			lightAmbientStrength;
+	double			lightSpecularStrength;
+	double			materialShininess;
+	glm::dvec4		backgroundColor;
+};
+
+// Ray traced renderer working without a graphics context. The model is
+// copied to a bounding volume hierarchy on construction, so the same
+// renderer can render many images of the model from different cameras.
+class ImageRenderer
+{
+public:
+	ImageRenderer (const ModelView& model);
+
+	// Renders to an RGBA buffer of width * height * 4 bytes. Rows are stored
+	// from bottom to top like the result of glReadPixels.
+	void	RenderImage (const Camera& camera, int width, int height, const ImageRenderSettings& settings, unsigned char* pixels) const;
+
+private:
+	class TriangleData
+	{
+	public:
+		TriangleData (const glm::dvec3& n1, const glm::dvec3& n2, const glm::dvec3& n3, const glm::dvec3& color);
+
+		glm::dvec3	n1;
+		glm::dvec3	n2;
+		glm::dvec3	n3;
+		glm::dvec3	color;
+	};
+
+	static std::vector<Geometry::Triangle>	CollectTriangles (const ModelView& model, std::vector<TriangleData>& triangleData);
+
+	glm::dvec4	TracePixel (const Camera& camera, int width, int height, int x, int y, const ImageRenderSettings& settings) const;
+	double		CalcAmbientOcclusion (const glm::dvec3& position, const glm::dvec3& normal, int x, int y, const ImageRenderSettings& settings) const;
+
+	std::vector<TriangleData>	triangleData;
+	Geometry::TriangleBVH		bvh;
+	double						modelRadius;
+};
+
+}
+
+#endif
@@ -0,0 +1,202 @@
+#include "Interference.hpp"
+#include "ParallelTasks.hpp"
+#include "MeshDistance.hpp"
+#include "TriangleBVH.hpp"
+#include "TriangleUtils.hpp"
+#include "Geometry.hpp"
+
+#include <algorithm>
+#include <memory>
+
+namespace Modeler
+{
+
+class InterferenceMesh
+{
+public:
+	InterferenceMesh (MeshId meshId, const MeshGeometryConstPtr& geometry, const glm::dmat4& transformation) :
+		meshId (meshId),
+		geometry (geometry),
+		transformation (transformation),
+		boundingBox (geometry->GetBoundingBox ().Transform (transformation)),
+		bvh (nullptr),
+		distanceQuery (nullptr)
+	{
+	}
+
+	glm::dvec3 GetSurfacePoint () const
+	{
+		return geometry->GetVertex (geometry->GetTriangle (0).v1, transformation);
+	}
+
+	MeshId										meshId;
+	MeshGeometryConstPtr						geometry;
+	glm::dmat4									transformation;
+	Geometry::BoundingBox						boundingBox;
+	std::unique_ptr<Geometry::TriangleBVH>		bvh;
+	std::unique_ptr<MeshDistanceQuery>			distanceQuery;
+};
+
+class ContainmentCheck
+{
+public:
+	ContainmentCheck (size_t pairIndex, size_t innerMesh, size_t outerMesh) :
+		pairIndex (pairIndex),
+		innerMesh (innerMesh),
+		outerMesh (outerMesh)
+	{
+	}
+
+	size_t	pairIndex;
+	size_t	innerMesh;
+	size_t	outerMesh;
+};
+
+static std::unique_ptr<Geometry::TriangleBVH> CreateTriangleBVH (const MeshGeometry& geometry, const glm::dmat4& transformation)
+{
+	std::vector<Geometry::Triangle> triangles;
+	triangles.reserve (geometry.TriangleCount ());
+	for (unsigned int i = 0; i < geometry.TriangleCount (); i++) {
+		const MeshTriangle& triangle = geometry.GetTriangle (i);
+		triangles.push_back (Geometry::Triangle (
+			geometry.GetVertex (triangle.v1, transformation),
+			geometry.GetVertex (triangle.v2, transformation),
+			geometry.GetVertex (triangle.v3, transformation)
+		));
+	}
+	return std::unique_ptr<Geometry::TriangleBVH> (new Geometry::TriangleBVH (triangles));
+}
+
+static std::vector<std::pair<size_t, size_t>> GetCandidatePairs (const std::vector<std::unique_ptr<InterferenceMesh>>& meshes)
+{
+	std::vector<size_t> order (meshes.size ());
+	for (size_t i = 0; i < meshes.size (); i++) {
+		order[i] = i;
+	}
+	std::sort (order.begin (), order.end (), [&] (size_t a, size_t b) {
+		return meshes[a]->boundingBox.GetMin ().x < meshes[b]->boundingBox.GetMin ().x;
+	});
+
+	// sweep along the x axis, only meshes with overlapping x ranges are compared
+	std::vector<std::pair<size_t, size_t>> pairs;
+	std::vector<size_t> active;
+	for (size_t index : order) {
+		const Geometry::BoundingBox& boundingBox = meshes[index]->boundingBox;
+		active.erase (std::remove_if (active.begin (), active.end (), [&] (size_t activeIndex) {
+			return Geometry::IsLower (meshes[activeIndex]->boundingBox.GetMax ().x, boundingBox.GetMin ().x);
+		}), active.end ());
+		for (size_t activeIndex : active) {
+			if (Geometry::HasBoundingBoxOverlap (meshes[activeIndex]->boundingBox, boundingBox)) {
+				pairs.push_back ({ std::min (activeIndex, index), std::max (activeIndex, index) });
+			}
+		}
+		active.push_back (index);
+	}
+	return pairs;
+}
+
+MeshInterference::MeshInterference (MeshId aMeshId, MeshId bMeshId, size_t contactCount) :
+	aMeshId (aMeshId),
+	bMeshId (bMeshId),
+	contactCount (contactCount)
+{
+}
+
+std::vector<MeshInterference> GetMeshInterferences (const ModelView& model)
+{
+	std::vector<std::unique_ptr<InterferenceMesh>> meshes;
+	model.EnumerateMeshes ([&] (MeshId meshId, const MeshRef& meshRef) {
+		if (meshRef.GetGeometry ().TriangleCount () == 0) {
+			return;
+		}
+		meshes.push_back (std::unique_ptr<InterferenceMesh> (new InterferenceMesh (meshId, meshRef.GetGeometryPtr (), meshRef.GetTransformation ())));
+	});
+
+	std::vector<std::pair<size_t, size_t>> candidatePairs = GetCandidatePairs (meshes);
+	if (candidatePairs.empty ()) {
+		return {};
+	}
+
+	// trees are built only for meshes taking part in a candidate pair
+	std::vector<size_t> usedMeshes;
+	std::vector<bool> isUsedMesh (meshes.size (), false);
+	for (const std::pair<size_t, size_t>& candidatePair : candidatePairs) {
+		for (size_t index : { candidatePair.first, candidatePair.second }) {
+			if (!isUsedMesh[index]) {
+				isUsedMesh[index] = true;
+				usedMeshes.push_back (index);
+			}
+		}
+	}
+	RunParallelTasks (usedMeshes.size (), 0, [&] (size_t taskIndex) {
+		InterferenceMesh& mesh = *meshes[usedMeshes[taskIndex]];
+		mesh.bvh = CreateTriangleBVH (*mesh.geometry, mesh.transformation);
+	});
+
+	std::vector<size_t> contactCounts (candidatePairs.size (), 0);
+	RunParallelTasks (candidatePairs.size (), 0, [&] (size_t taskIndex) {
+		const Geometry::TriangleBVH& aBVH = *meshes[candidatePairs[taskIndex].first]->bvh;
+		const Geometry::TriangleBVH& bBVH = *meshes[candidatePairs[taskIndex].second]->bvh;
+		size_t contactCount = 0;
+		aBVH.EnumerateCandidatePairs (bBVH, [&] (size_t aTriangle, size_t bTriangle) {
+			if (Geometry::HasTriangleTriangleIntersection (aBVH.GetTriangle (aTriangle), bBVH.GetTriangle (bTriangle))) {
+				contactCount++;
+			}
+		});
+		contactCounts[taskIndex] = contactCount;
+	});
+
+	// without surface contact one mesh is either completely inside the other
+	// one or outside of it, so checking a single vertex of it is enough
+	std::vector<ContainmentCheck> containmentChecks;
+	std::vector<size_t> outerMeshes;
+	for (size_t i = 0; i < candidatePairs.size (); i++) {
+		if (contactCounts[i] > 0) {
+			continue;
+		}
+		size_t aMesh = candidatePairs[i].first;
+		size_t bMesh = candidatePairs[i].second;
+		for (const std::pair<size_t, size_t>& innerOuter : { std::make_pair (aMesh, bMesh), std::make_pair (bMesh, aMesh) }) {
+			glm::dvec3 point = meshes[innerOuter.first]->GetSurfacePoint ();
+			if (!Geometry::HasBoundingBoxOverlap (Geometry::BoundingBox (point, point), meshes[innerOuter.second]->boundingBox)) {
+				continue;
+			}
+			containmentChecks.push_back (ContainmentCheck (i, innerOuter.first, innerOuter.second));
+			if (std::find (outerMeshes.begin (), outerMeshes.end (), innerOuter.second) == outerMeshes.end ()) {
+				outerMeshes.push_back (innerOuter.second);
+			}
+		}
+	}
+	RunParallelTasks (outerMeshes.size (), 0, [&] (size_t taskIndex) {
+		InterferenceMesh& mesh = *meshes[outerMeshes[taskIndex]];
+		mesh.distanceQuery.reset (new MeshDistanceQuery (*mesh.geometry, mesh.transformation));
+	});
+
+	std::vector<bool> isContainedPair (candidatePairs.size (), false);
+	for (const ContainmentCheck& check : containmentChecks) {
+		const InterferenceMesh& innerMesh = *meshes[check.innerMesh];
+		const InterferenceMesh& outerMesh = *meshes[check.outerMesh];
+		if (outerMesh.distanceQuery->GetSignedDistance (innerMesh.GetSurfacePoint ()) < 0.0) {
+			isContainedPair[check.pairIndex] = true;
+		}
+	}
+
+	std::vector<MeshInterference> interferences;
+	for (size_t i = 0; i < candidatePairs.size (); i++) {
+		if (contactCounts[i] == 0 && !isContainedPair[i]) {
+			continue;
+		}
+		MeshId aMeshId = meshes[candidatePairs[i].first]->meshId;
+		MeshId bMeshId = meshes[candidatePairs[i].second]->meshId;
+		interferences.push_back (MeshInterference (std::min (aMeshId, bMeshId), std::max (aMeshId, bMeshId), contactCounts[i]));
+	}
+	std::sort (interferences.begin (), interferences.end (), [] (const MeshInterference& a, const MeshInterference& b) {
+		if (a.aMeshId != b.aMeshId) {
+			return a.aMeshId < b.aMeshId;
+		}
+		return a.bMeshId < b.bMeshId;
+	});
+	return interferences;
+}
+
+}
@@ -0,0 +1,32 @@
+#ifndef MODELER_INTERFERENCE_HPP
+#define MODELER_INTERFERENCE_HPP
+
+#include "Model.hpp"
+
+#include <vector>
+
+namespace Modeler
+{
+
+class MeshInterference
+{
+public:
+	MeshInterference (MeshId aMeshId, MeshId bMeshId, size_t contactCount);
+
+	MeshId	aMeshId;
+	MeshId	bMeshId;
+	size_t	contactCount;
+};
+
+// Finds the meshes of the model with intersecting or touching surfaces, and
+// the meshes completely inside another one. The contact count is the number
+// of intersecting triangle pairs, it is zero for contained meshes. Candidate
+// pairs are collected by sweeping the bounding boxes of the meshes, every pair
+// is checked with triangle trees, and pairs without contact are checked with
+// the signed distance of a vertex of one mesh from the other. Pairs are
+// ordered by mesh id.
+std::vector<MeshInterference>	GetMeshInterferences (const ModelView& model);
+
+}
+
+#endif
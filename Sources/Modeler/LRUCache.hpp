@@ -0,0 +1,108 @@
+#ifndef MODELER_LRUCACHE_HPP
+#define MODELER_LRUCACHE_HPP
+
+#include <unordered_map>
+#include <list>
+#include <mutex>
+#include <functional>
+
+namespace Modeler
+{
+
+// Thread safe cache with a size limit. The size of a value is calculated by
+// the given function when it is added, and the least recently used values
+// are dropped when the total size exceeds the limit. A value larger than
+// the limit is not stored at all.
+template <typename KeyType, typename ValueType>
+class LRUCache
+{
+public:
+	using SizeFunction = std::function<size_t (const ValueType&)>;
+
+	LRUCache (size_t maxSize, const SizeFunction& sizeFunction) :
+		maxSize (maxSize),
+		sizeFunction (sizeFunction),
+		size (0)
+	{
+	}
+
+	LRUCache (const LRUCache& rhs) = delete;
+	LRUCache& operator= (const LRUCache& rhs) = delete;
+
+	bool Get (const KeyType& key, ValueType& value)
+	{
+		std::lock_guard<std::mutex> lock (mutex);
+		auto found = keyToEntry.find (key);
+		if (found == keyToEntry.end ()) {
+			return false;
+		}
+		entries.splice (entries.begin (), entries, found->second);
+		value = found->second->value;
+		return true;
+	}
+
+	void Add (const KeyType& key, const ValueType& value)
+	{
+		size_t valueSize = sizeFunction (value);
+		std::lock_guard<std::mutex> lock (mutex);
+		auto found = keyToEntry.find (key);
+		if (found != keyToEntry.end ()) {
+			size -= found->second->size;
+			entries.erase (found->second);
+			keyToEntry.erase (found);
+		}
+		if (valueSize > maxSize) {
+			return;
+		}
+		while (size + valueSize > maxSize) {
+			const Entry& last = entries.back ();
+			size -= last.size;
+			keyToEntry.erase (last.key);
+			entries.pop_back ();
+		}
+		entries.push_front (Entry { key, value, valueSize });
+		keyToEntry.insert ({ key, entries.begin () });
+		size += valueSize;
+	}
+
+	size_t Count () const
+	{
+		std::lock_guard<std::mutex> lock (mutex);
+		return entries.size ();
+	}
+
+	size_t Size () const
+	{
+		std::lock_guard<std::mutex> lock (mutex);
+		return size;
+	}
+
+	void Clear ()
+	{
+		std::lock_guard<std::mutex> lock (mutex);
+		entries.clear ();
+		keyToEntry.clear ();
+		size = 0;
+	}
+
+private:
+	struct Entry
+	{
+		KeyType		key;
+		ValueType	value;
+		size_t		size;
+	};
+
+	using EntryIterator = typename std::list<Entry>::iterator;
+
+	size_t										maxSize;
+	SizeFunction								sizeFunction;
+	size_t										size;
+	std::list<Entry>							entries;
+	std::unordered_map<KeyType, EntryIterator>	keyToEntry;
+	mutable std::mutex							mutex;
+};
+
+}
+
+#endif
@@ -0,0 +1,351 @@
+#include "LoopSubdivision.hpp"
+#include "HalfEdgeMesh.hpp"
+#include "ParallelTasks.hpp"
+#include "Geometry.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace Modeler
+{
+
+static const size_t ItemsPerTask = 1 << 14;
+
+static void RunOnRanges (size_t itemCount, unsigned int threadCount, const std::function<void (unsigned int, unsigned int)>& processor)
+{
+	size_t taskCount = (itemCount + ItemsPerTask - 1) / ItemsPerTask;
+	RunParallelTasks (taskCount, threadCount, [&] (size_t taskIndex) {
+		size_t first = taskIndex * ItemsPerTask;
+		size_t last = std::min (first + ItemsPerTask, itemCount);
+		processor ((unsigned int) first, (unsigned int) last);
+	});
+}
+
+static void AddMaterials (const MeshMaterials& materials, Mesh& mesh)
+{
+	materials.EnumerateMaterials ([&] (MaterialId, const Material& material) {
+		mesh.AddMaterial (material);
+	});
+}
+
+static std::vector<glm::dvec3> CalcTriangleNormals (const HalfEdgeMesh& halfEdgeMesh, unsigned int threadCount)
+{
+	const MeshGeometry& geometry = halfEdgeMesh.GetMesh ().GetGeometry ();
+	std::vector<glm::dvec3> triangleNormals (halfEdgeMesh.TriangleCount ());
+	RunOnRanges (triangleNormals.size (), threadCount, [&] (unsigned int first, unsigned int last) {
+		for (unsigned int i = first; i < last; i++) {
+			const MeshTriangle& triangle = geometry.GetTriangle (i);
+			const glm::dvec3& v1 = geometry.GetVertex (triangle.v1);
+			glm::dvec3 cross = glm::cross (geometry.GetVertex (triangle.v2) - v1, geometry.GetVertex (triangle.v3) - v1);
+			double length = glm::length (cross);
+			triangleNormals[i] = Geometry::IsPositive (length) ? cross / length : glm::dvec3 (0.0, 0.0, 0.0);
+		}
+	});
+	return triangleNormals;
+}
+
+static std::vector<char> GetSharpHalfEdges (const HalfEdgeMesh& halfEdgeMesh, double creaseAngle, unsigned int threadCount)
+{
+	std::vector<glm::dvec3> triangleNormals = CalcTriangleNormals (halfEdgeMesh, threadCount);
+	std::vector<char> sharpHalfEdges (halfEdgeMesh.HalfEdgeCount (), 0);
+	RunOnRanges (sharpHalfEdges.size (), threadCount, [&] (unsigned int first, unsigned int last) {
+		for (unsigned int halfEdge = first; halfEdge < last; halfEdge++) {
+			unsigned int twin = halfEdgeMesh.GetTwin (halfEdge);
+			if (twin == NoHalfEdge) {
+				sharpHalfEdges[halfEdge] = 1;
+				continue;
+			}
+			double cosAngle = glm::dot (triangleNormals[halfEdgeMesh.GetTriangle (halfEdge)], triangleNormals[halfEdgeMesh.GetTriangle (twin)]);
+			double angle = std::acos (std::min (std::max (cosAngle, -1.0), 1.0));
+			sharpHalfEdges[halfEdge] = Geometry::IsGreater (angle, creaseAngle) ? 1 : 0;
+		}
+	});
+	return sharpHalfEdges;
+}
+
+static double GetLoopWeight (unsigned int valence)
+{
+	double n = (double) valence;
+	double cosTerm = 3.0 / 8.0 + 1.0 / 4.0 * std::cos (2.0 * glm::pi<double> () / n);
+	return (5.0 / 8.0 - cosTerm * cosTerm) / n;
+}
+
+// The new position of an old vertex comes from its neighbours along the
+// smooth edges, along the two sharp edges of a crease, or stays in place at
+// corners. The fan of a boundary vertex ends with an incoming half-edge, so
+// its origin is an extra neighbour along a sharp edge.
+static glm::dvec3 CalcVertexPoint (const HalfEdgeMesh& halfEdgeMesh, const std::vector<char>& sharpHalfEdges, unsigned int vertex)
+{
+	const MeshGeometry& geometry = halfEdgeMesh.GetMesh ().GetGeometry ();
+	const glm::dvec3& position = geometry.GetVertex (vertex);
+	unsigned int firstHalfEdge = halfEdgeMesh.GetVertexHalfEdge (vertex);
+	if (firstHalfEdge == NoHalfEdge) {
+		return position;
+	}
+
+	glm::dvec3 neighbourSum (0.0, 0.0, 0.0);
+	glm::dvec3 sharpNeighbourSum (0.0, 0.0, 0.0);
+	unsigned int valence = 0;
+	unsigned int sharpCount = 0;
+	halfEdgeMesh.EnumerateVertexHalfEdges (vertex, [&] (unsigned int halfEdge) {
+		const glm::dvec3& neighbour = geometry.GetVertex (halfEdgeMesh.GetTarget (halfEdge));
+		neighbourSum += neighbour;
+		valence++;
+		if (sharpHalfEdges[halfEdge]) {
+			sharpNeighbourSum += neighbour;
+			sharpCount++;
+		}
+	});
+	if (halfEdgeMesh.IsBoundaryVertex (vertex)) {
+		const glm::dvec3& neighbour = geometry.GetVertex (halfEdgeMesh.GetOrigin (halfEdgeMesh.GetPrev (firstHalfEdge)));
+		neighbourSum += neighbour;
+		sharpNeighbourSum += neighbour;
+		valence++;
+		sharpCount++;
+	}
+
+	if (sharpCount == 2) {
+		return 0.75 * position + 0.125 * sharpNeighbourSum;
+	} else if (sharpCount > 2) {
+		return position;
+	}
+	double weight = GetLoopWeight (valence);
+	return (1.0 - valence * weight) * position + weight * neighbourSum;
+}
+
+static glm::dvec3 CalcEdgePoint (const HalfEdgeMesh& halfEdgeMesh, const std::vector<char>& sharpHalfEdges, unsigned int halfEdge)
+{
+	const MeshGeometry& geometry = halfEdgeMesh.GetMesh ().GetGeometry ();
+	glm::dvec3 endSum = geometry.GetVertex (halfEdgeMesh.GetOrigin (halfEdge)) + geometry.GetVertex (halfEdgeMesh.GetTarget (halfEdge));
+	if (sharpHalfEdges[halfEdge]) {
+		return 0.5 * endSum;
+	}
+	unsigned int twin = halfEdgeMesh.GetTwin (halfEdge);
+	glm::dvec3 oppositeSum = geometry.GetVertex (halfEdgeMesh.GetOrigin (halfEdgeMesh.GetPrev (halfEdge))) + geometry.GetVertex (halfEdgeMesh.GetOrigin (halfEdgeMesh.GetPrev (twin)));
+	return 0.375 * endSum + 0.125 * oppositeSum;
+}
+
+// Old vertices keep their index, the vertex of an edge is numbered by the
+// half-edge with the smaller index. Triangle t is split into triangles 4t to
+// 4t + 3, the first three are at the corners, and the last one is in the
+// middle, so the sharp half-edges of the new mesh come from the old ones.
+// The progress is reported after every pass, and the cancellation is checked
+// during the creation of the triangles too.
+static bool SubdivideLevel (const HalfEdgeMesh& halfEdgeMesh, const std::vector<char>& sharpHalfEdges, unsigned int threadCount, Mesh& resultMesh, std::vector<char>& resultSharpHalfEdges, OperationProgress* progress)
+{
+	const Mesh& mesh = halfEdgeMesh.GetMesh ();
+	unsigned int vertexCount = halfEdgeMesh.VertexCount ();
+	unsigned int halfEdgeCount = halfEdgeMesh.HalfEdgeCount ();
+
+	std::vector<unsigned int> edgeVertices (halfEdgeCount, 0);
+	unsigned int edgeCount = 0;
+	for (unsigned int halfEdge = 0; halfEdge < halfEdgeCount; halfEdge++) {
+		unsigned int twin = halfEdgeMesh.GetTwin (halfEdge);
+		if (twin == NoHalfEdge || halfEdge < twin) {
+			edgeVertices[halfEdge] = vertexCount + edgeCount++;
+		}
+	}
+
+	std::vector<glm::dvec3> positions (vertexCount + edgeCount);
+	RunOnRanges (halfEdgeCount, threadCount, [&] (unsigned int first, unsigned int last) {
+		for (unsigned int halfEdge = first; halfEdge < last; halfEdge++) {
+			unsigned int twin = halfEdgeMesh.GetTwin (halfEdge);
+			if (twin == NoHalfEdge || halfEdge < twin) {
+				positions[edgeVertices[halfEdge]] = CalcEdgePoint (halfEdgeMesh, sharpHalfEdges, halfEdge);
+			} else {
+				edgeVertices[halfEdge] = edgeVertices[twin];
+			}
+		}
+	});
+	if (IsOperationCancelled (progress)) {
+		return false;
+	}
+	SetOperationProgress (progress, 0.3);
+	RunOnRanges (vertexCount, threadCount, [&] (unsigned int first, unsigned int last) {
+		for (unsigned int vertex = first; vertex < last; vertex++) {
+			positions[vertex] = CalcVertexPoint (halfEdgeMesh, sharpHalfEdges, vertex);
+		}
+	});
+	if (IsOperationCancelled (progress)) {
+		return false;
+	}
+	SetOperationProgress (progress, 0.5);
+
+	// intermediate levels get one dummy normal, the normals are calculated
+	// only for the final mesh
+	resultMesh.Clear ();
+	AddMaterials (mesh.GetMaterials (), resultMesh);
+	for (const glm::dvec3& position : positions) {
+		resultMesh.AddVertex (position);
+	}
+	unsigned int normal = resultMesh.AddNormal (0.0, 0.0, 1.0);
+
+	const MeshMaterials& materials = mesh.GetMaterials ();
+	resultSharpHalfEdges.assign (4 * (size_t) halfEdgeCount, 0);
+	for (unsigned int rangeIndex = 0; rangeIndex < materials.TriangleRangeCount (); rangeIndex++) {
+		const TriangleMaterialRange& range = materials.GetTriangleRange (rangeIndex);
+		for (unsigned int triangle = range.first; triangle < range.first + range.count; triangle++) {
+			if (triangle % ItemsPerTask == 0 && IsOperationCancelled (progress)) {
+				return false;
+			}
+			unsigned int h0 = 3 * triangle;
+			unsigned int h1 = h0 + 1;
+			unsigned int h2 = h0 + 2;
+			unsigned int v0 = halfEdgeMesh.GetOrigin (h0);
+			unsigned int v1 = halfEdgeMesh.GetOrigin (h1);
+			unsigned int v2 = halfEdgeMesh.GetOrigin (h2);
+			unsigned int m0 = edgeVertices[h0];
+			unsigned int m1 = edgeVertices[h1];
+			unsigned int m2 = edgeVertices[h2];
+			resultMesh.AddTriangle (v0, m0, m2, normal, range.material);
+			resultMesh.AddTriangle (m0, v1, m1, normal, range.material);
+			resultMesh.AddTriangle (m2, m1, v2, normal, range.material);
+			resultMesh.AddTriangle (m0, m1, m2, normal, range.material);
+
+			size_t first = 12 * (size_t) triangle;
+			resultSharpHalfEdges[first + 0] = sharpHalfEdges[h0];
+			resultSharpHalfEdges[first + 2] = sharpHalfEdges[h2];
+			resultSharpHalfEdges[first + 3] = sharpHalfEdges[h0];
+			resultSharpHalfEdges[first + 4] = sharpHalfEdges[h1];
+			resultSharpHalfEdges[first + 7] = sharpHalfEdges[h1];
+			resultSharpHalfEdges[first + 8] = sharpHalfEdges[h2];
+		}
+	}
+	SetOperationProgress (progress, 0.7);
+	return true;
+}
+
+// Triangles around a vertex are grouped by the sharp edges between them, and
+// every group gets the angle weighted average normal of its triangles. Each
+// corner refers to the group by the first half-edge of it. Half-edges of fans
+// not reached from the vertex get the normal of their own triangle.
+static void CreateMeshWithNormals (const HalfEdgeMesh& halfEdgeMesh, const std::vector<char>& sharpHalfEdges, unsigned int threadCount, Mesh& resultMesh)
+{
+	const Mesh& mesh = halfEdgeMesh.GetMesh ();
+	const MeshGeometry& geometry = mesh.GetGeometry ();
+	unsigned int halfEdgeCount = halfEdgeMesh.HalfEdgeCount ();
+	std::vector<glm::dvec3> triangleNormals = CalcTriangleNormals (halfEdgeMesh, threadCount);
+
+	std::vector<unsigned int> groupHalfEdges (halfEdgeCount, NoHalfEdge);
+	std::vector<glm::dvec3> groupNormals (halfEdgeCount, glm::dvec3 (0.0, 0.0, 0.0));
+	RunOnRanges (halfEdgeMesh.VertexCount (), threadCount, [&] (unsigned int first, unsigned int last) {
+		std::vector<unsigned int> fan;
+		for (unsigned int vertex = first; vertex < last; vertex++) {
+			fan.clear ();
+			halfEdgeMesh.EnumerateVertexHalfEdges (vertex, [&] (unsigned int halfEdge) {
+				fan.push_back (halfEdge);
+			});
+			if (fan.empty ()) {
+				continue;
+			}
+
+			// the edge of a fan half-edge separates its triangle from the next one,
+			// a closed fan is started after a sharp edge to keep groups together
+			size_t fanSize = fan.size ();
+			size_t start = 0;
+			if (!halfEdgeMesh.IsBoundaryVertex (vertex)) {
+				for (size_t i = 0; i < fanSize; i++) {
+					if (sharpHalfEdges[fan[(i + fanSize - 1) % fanSize]]) {
+						start = i;
+						break;
+					}
+				}
+			}
+
+			const glm::dvec3& position = geometry.GetVertex (vertex);
+			unsigned int groupHalfEdge = fan[start];
+			for (size_t i = 0; i < fanSize; i++) {
+				size_t index = (start + i) % fanSize;
+				unsigned int halfEdge = fan[index];
+				if (i > 0 && sharpHalfEdges[fan[(index + fanSize - 1) % fanSize]]) {
+					groupHalfEdge = halfEdge;
+				}
+				glm::dvec3 nextEdge = geometry.GetVertex (halfEdgeMesh.GetTarget (halfEdge)) - position;
+				glm::dvec3 prevEdge = geometry.GetVertex (halfEdgeMesh.GetOrigin (halfEdgeMesh.GetPrev (halfEdge))) - position;
+				double angle = std::atan2 (glm::length (glm::cross (nextEdge, prevEdge)), glm::dot (nextEdge, prevEdge));
+				groupHalfEdges[halfEdge] = groupHalfEdge;
+				groupNormals[groupHalfEdge] += angle * triangleNormals[halfEdgeMesh.GetTriangle (halfEdge)];
+			}
+		}
+	});
+
+	resultMesh.Clear ();
+	resultMesh.SetTransformation (mesh.GetTransformation ());
+	AddMaterials (mesh.GetMaterials (), resultMesh);
+	geometry.EnumerateVertices (glm::dmat4 (1.0), [&] (const glm::dvec3& vertex) {
+		resultMesh.AddVertex (vertex);
+	});
+
+	std::vector<unsigned int> normalIndices (halfEdgeCount, 0);
+	for (unsigned int halfEdge = 0; halfEdge < halfEdgeCount; halfEdge++) {
+		if (groupHalfEdges[halfEdge] == NoHalfEdge) {
+			groupHalfEdges[halfEdge] = halfEdge;
+			groupNormals[halfEdge] = triangleNormals[halfEdgeMesh.GetTriangle (halfEdge)];
+		}
+		if (groupHalfEdges[halfEdge] == halfEdge) {
+			const glm::dvec3& groupNormal = groupNormals[halfEdge];
+			double length = glm::length (groupNormal);
+			normalIndices[halfEdge] = resultMesh.AddNormal (Geometry::IsPositive (length) ? groupNormal / length : triangleNormals[halfEdgeMesh.GetTriangle (halfEdge)]);
+		}
+	}
+
+	const MeshMaterials& materials = mesh.GetMaterials ();
+	for (unsigned int rangeIndex = 0; rangeIndex < materials.TriangleRangeCount (); rangeIndex++) {
+		const TriangleMaterialRange& range = materials.GetTriangleRange (rangeIndex);
+		for (unsigned int triangle = range.first; triangle < range.first + range.count; triangle++) {
+			unsigned int h0 = 3 * triangle;
+			resultMesh.AddTriangle (
+				halfEdgeMesh.GetOrigin (h0), halfEdgeMesh.GetOrigin (h0 + 1), halfEdgeMesh.GetOrigin (h0 + 2),
+				normalIndices[groupHalfEdges[h0]], normalIndices[groupHalfEdges[h0 + 1]], normalIndices[groupHalfEdges[h0 + 2]],
+				range.material
+			);
+		}
+	}
+}
+
+// Every step quadruples the number of triangles, so the progress of a step
+// is weighted by the number of triangles it creates. Each step reports into
+// its own range, and the cancellation is checked between its stages too.
+bool SubdivideMesh (const Mesh& mesh, unsigned int steps, double creaseAngle, unsigned int threadCount, Mesh& resultMesh, OperationProgress* progress)
+{
+	HalfEdgeMesh halfEdgeMesh;
+	if (!halfEdgeMesh.Build (mesh, threadCount)) {
+		return false;
+	}
+
+	std::vector<char> sharpHalfEdges = GetSharpHalfEdges (halfEdgeMesh, creaseAngle, threadCount);
+	double allWork = (std::pow (4.0, steps) - 1.0) / 3.0;
+	double doneWork = 0.0;
+	for (unsigned int step = 0; step < steps; step++) {
+		if (IsOperationCancelled (progress)) {
+			return false;
+		}
+		double stepWork = std::pow (4.0, step);
+		OperationProgress stepProgress (progress, doneWork / allWork, (doneWork + stepWork) / allWork);
+		Mesh levelMesh;
+		std::vector<char> levelSharpHalfEdges;
+		if (!SubdivideLevel (halfEdgeMesh, sharpHalfEdges, threadCount, levelMesh, levelSharpHalfEdges, progress != nullptr ? &stepProgress : nullptr)) {
+			return false;
+		}
+		if (IsOperationCancelled (progress)) {
+			return false;
+		}
+		levelMesh.SetTransformation (mesh.GetTransformation ());
+		if (!halfEdgeMesh.Build (levelMesh, threadCount)) {
+			return false;
+		}
+		sharpHalfEdges.swap (levelSharpHalfEdges);
+		doneWork += stepWork;
+		SetOperationProgress (progress, doneWork / allWork);
+	}
+
+	if (IsOperationCancelled (progress)) {
+		return false;
+	}
+	CreateMeshWithNormals (halfEdgeMesh, sharpHalfEdges, threadCount, resultMesh);
+	SetOperationProgress (progress, 1.0);
+	return true;
+}
+
+}
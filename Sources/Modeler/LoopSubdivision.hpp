@@ -0,0 +1,22 @@
+#ifndef MODELER_LOOPSUBDIVISION_HPP
+#define MODELER_LOOPSUBDIVISION_HPP
+
+#include "Mesh.hpp"
+#include "OperationProgress.hpp"
+
+namespace Modeler
+{
+
+// Loop subdivision of manifold, consistently oriented triangle meshes, other
+// meshes are not subdivided. Every step splits each triangle into four, and
+// the new triangles keep the material of the original one. Boundary edges and
+// edges with a dihedral angle above the crease angle (in radians) are sharp,
+// they are subdivided as curves, and vertices with more than two sharp edges
+// stay in place. The normals of the result are smooth except along the sharp
+// edges. With a thread count of zero every hardware thread is used, and the
+// progress can be null.
+bool	SubdivideMesh (const Mesh& mesh, unsigned int steps, double creaseAngle, unsigned int threadCount, Mesh& resultMesh, OperationProgress* progress);
+
+}
+
+#endif
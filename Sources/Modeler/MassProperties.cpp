@@ -0,0 +1,196 @@
+#include "MassProperties.hpp"
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace Modeler
+{
+
+// Triangles are copied to fixed size structure of arrays batches, and the
+// integrals are accumulated in independent lanes, so the inner loop has no
+// dependency between consecutive triangles and the compiler can vectorize it.
+static const size_t BatchSize = 64;
+static const size_t LaneCount = 4;
+
+class TriangleBatch
+{
+public:
+	TriangleBatch () :
+		count (0)
+	{
+		for (std::array<double, BatchSize>* coordinates : { &ax, &ay, &az, &bx, &by, &bz, &cx, &cy, &cz }) {
+			coordinates->fill (0.0);
+		}
+	}
+
+	void Add (const glm::dvec3& a, const glm::dvec3& b, const glm::dvec3& c)
+	{
+		ax[count] = a.x; ay[count] = a.y; az[count] = a.z;
+		bx[count] = b.x; by[count] = b.y; bz[count] = b.z;
+		cx[count] = c.x; cy[count] = c.y; cz[count] = c.z;
+		count++;
+	}
+
+	bool IsFull () const
+	{
+		return count == BatchSize;
+	}
+
+	std::array<double, BatchSize>	ax, ay, az;
+	std::array<double, BatchSize>	bx, by, bz;
+	std::array<double, BatchSize>	cx, cy, cz;
+	size_t							count;
+};
+
+class LaneAccumulator
+{
+public:
+	LaneAccumulator ()
+	{
+		for (std::array<double, LaneCount>* lanes : { &area, &volume, &mx, &my, &mz, &sxx, &syy, &szz, &sxy, &syz, &szx }) {
+			lanes->fill (0.0);
+		}
+	}
+
+	// Every triangle forms a tetrahedron with the origin, and the signed integrals
+	// of the tetrahedra sum up to the integrals of the enclosed volume. Padding
+	// triangles at the end of a batch are degenerate, so they add nothing.
+	void AddBatch (const TriangleBatch& batch)
+	{
+		for (size_t i = 0; i < BatchSize; i += LaneCount) {
+			for (size_t lane = 0; lane < LaneCount; lane++) {
+				size_t j = i + lane;
+				double e1x = batch.bx[j] - batch.ax[j];
+				double e1y = batch.by[j] - batch.ay[j];
+				double e1z = batch.bz[j] - batch.az[j];
+				double e2x = batch.cx[j] - batch.ax[j];
+				double e2y = batch.cy[j] - batch.ay[j];
+				double e2z = batch.cz[j] - batch.az[j];
+				double nx = e1y * e2z - e1z * e2y;
+				double ny = e1z * e2x - e1x * e2z;
+				double nz = e1x * e2y - e1y * e2x;
+				area[lane] += std::sqrt (nx * nx + ny * ny + nz * nz);
+
+				double det = batch.ax[j] * (batch.by[j] * batch.cz[j] - batch.bz[j] * batch.cy[j]) +
+							 batch.ay[j] * (batch.bz[j] * batch.cx[j] - batch.bx[j] * batch.cz[j]) +
+							 batch.az[j] * (batch.bx[j] * batch.cy[j] - batch.by[j] * batch.cx[j]);
+				double sx = batch.ax[j] + batch.bx[j] + batch.cx[j];
+				double sy = batch.ay[j] + batch.by[j] + batch.cy[j];
+				double sz = batch.az[j] + batch.bz[j] + batch.cz[j];
+				volume[lane] += det;
+				mx[lane] += det * sx;
+				my[lane] += det * sy;
+				mz[lane] += det * sz;
+				sxx[lane] += det * (batch.ax[j] * batch.ax[j] + batch.bx[j] * batch.bx[j] + batch.cx[j] * batch.cx[j] + sx * sx);
+				syy[lane] += det * (batch.ay[j] * batch.ay[j] + batch.by[j] * batch.by[j] + batch.cy[j] * batch.cy[j] + sy * sy);
+				szz[lane] += det * (batch.az[j] * batch.az[j] + batch.bz[j] * batch.bz[j] + batch.cz[j] * batch.cz[j] + sz * sz);
+				sxy[lane] += det * (batch.ax[j] * batch.ay[j] + batch.bx[j] * batch.by[j] + batch.cx[j] * batch.cy[j] + sx * sy);
+				syz[lane] += det * (batch.ay[j] * batch.az[j] + batch.by[j] * batch.bz[j] + batch.cy[j] * batch.cz[j] + sy * sz);
+				szx[lane] += det * (batch.az[j] * batch.ax[j] + batch.bz[j] * batch.bx[j] + batch.cz[j] * batch.cx[j] + sz * sx);
+			}
+		}
+	}
+
+	// The tetrahedron integrals are det / 6 for the volume, det / 24 for the
+	// first moment and det / 120 for the second moment.
+	MassProperties GetMassProperties () const
+	{
+		MassProperties result;
+		for (size_t lane = 0; lane < LaneCount; lane++) {
+			result.area += area[lane] / 2.0;
+			result.volume += volume[lane] / 6.0;
+			result.firstMoment += glm::dvec3 (mx[lane], my[lane], mz[lane]) / 24.0;
+			result.secondMoment += glm::dmat3 (
+				sxx[lane], sxy[lane], szx[lane],
+				sxy[lane], syy[lane], syz[lane],
+				szx[lane], syz[lane], szz[lane]
+			) / 120.0;
+		}
+		return result;
+	}
+
+	std::array<double, LaneCount>	area;
+	std::array<double, LaneCount>	volume;
+	std::array<double, LaneCount>	mx, my, mz;
+	std::array<double, LaneCount>	sxx, syy, szz, sxy, syz, szx;
+};
+
+MassProperties::MassProperties () :
+	area (0.0),
+	volume (0.0),
+	firstMoment (0.0),
+	secondMoment (0.0)
+{
+}
+
+MassProperties& MassProperties::operator+= (const MassProperties& rhs)
+{
+	area += rhs.area;
+	volume += rhs.volume;
+	firstMoment += rhs.firstMoment;
+	secondMoment += rhs.secondMoment;
+	return *this;
+}
+
+glm::dvec3 MassProperties::GetCentroid () const
+{
+	if (volume == 0.0) {
+		return glm::dvec3 (0.0);
+	}
+	return firstMoment / volume;
+}
+
+glm::dmat3 MassProperties::GetInertiaTensor () const
+{
+	glm::dvec3 centroid = GetCentroid ();
+	glm::dmat3 centralSecondMoment = secondMoment - volume * glm::outerProduct (centroid, centroid);
+	double trace = centralSecondMoment[0][0] + centralSecondMoment[1][1] + centralSecondMoment[2][2];
+	return glm::dmat3 (trace) - centralSecondMoment;
+}
+
+MassProperties CalcMeshMassProperties (const MeshGeometry& geometry, const glm::dmat4& transformation)
+{
+	const Geometry::BoundingBox& boundingBox = geometry.GetBoundingBox ();
+	if (!boundingBox.IsValid () || geometry.TriangleCount () == 0) {
+		return MassProperties ();
+	}
+
+	// the integrals are calculated around the center of the mesh, and moved to
+	// the origin at the end, so meshes far from the origin keep their precision
+	glm::dvec3 origin (transformation * glm::dvec4 (boundingBox.GetCenter (), 1.0));
+	std::vector<glm::dvec3> vertices;
+	vertices.reserve (geometry.VertexCount ());
+	geometry.EnumerateVertices (transformation, [&] (const glm::dvec3& vertex) {
+		vertices.push_back (vertex - origin);
+	});
+
+	TriangleBatch batch;
+	LaneAccumulator accumulator;
+	geometry.EnumerateTriangles ([&] (const MeshTriangle& triangle) {
+		batch.Add (vertices[triangle.v1], vertices[triangle.v2], vertices[triangle.v3]);
+		if (batch.IsFull ()) {
+			accumulator.AddBatch (batch);
+			batch.count = 0;
+		}
+	});
+	if (batch.count > 0) {
+		for (size_t i = batch.count; i < BatchSize; i++) {
+			batch.Add (glm::dvec3 (0.0), glm::dvec3 (0.0), glm::dvec3 (0.0));
+		}
+		accumulator.AddBatch (batch);
+	}
+
+	MassProperties local = accumulator.GetMassProperties ();
+	MassProperties result;
+	result.area = local.area;
+	result.volume = local.volume;
+	result.firstMoment = local.firstMoment + local.volume * origin;
+	result.secondMoment = local.secondMoment +
+		glm::outerProduct (local.firstMoment, origin) +
+		glm::outerProduct (origin, local.firstMoment) +
+		local.volume * glm::outerProduct (origin, origin);
+	return result;
+}
+
+}
@@ -0,0 +1,36 @@
+#ifndef MODELER_MASSPROPERTIES_HPP
+#define MODELER_MASSPROPERTIES_HPP
+
+#include "IncludeGLM.hpp"
+#include "Mesh.hpp"
+
+namespace Modeler
+{
+
+// Surface and volume integrals of closed, consistently oriented meshes with
+// unit density. The moments are stored relative to the world origin, so the
+// properties of separate meshes can be summed. The volume is negative for
+// meshes with inward facing triangles, and meaningless for open meshes.
+class MassProperties
+{
+public:
+	MassProperties ();
+
+	MassProperties&		operator+= (const MassProperties& rhs);
+
+	glm::dvec3			GetCentroid () const;
+
+	// Inertia tensor around the centroid.
+	glm::dmat3			GetInertiaTensor () const;
+
+	double				area;
+	double				volume;
+	glm::dvec3			firstMoment;
+	glm::dmat3			secondMoment;
+};
+
+MassProperties	CalcMeshMassProperties (const MeshGeometry& geometry, const glm::dmat4& transformation);
+
+}
+
+#endif
@@ -0,0 +1,62 @@
+#include "MemoryUsage.hpp"
+
+#include <atomic>
+#include <cstdio>
+
+namespace Modeler
+{
+
+static std::atomic<size_t> trackedMemory[MemorySubsystemCount];
+
+void AddTrackedMemory (MemorySubsystem subsystem, size_t size)
+{
+	trackedMemory[(int) subsystem] += size;
+}
+
+void RemoveTrackedMemory (MemorySubsystem subsystem, size_t size)
+{
+	trackedMemory[(int) subsystem] -= size;
+}
+
+size_t GetTrackedMemory (MemorySubsystem subsystem)
+{
+	return trackedMemory[(int) subsystem];
+}
+
+bool IsMemoryTrackingEnabled ()
+{
+#ifdef MODELER_MEMORY_TRACKING
+	return true;
+#else
+	return false;
+#endif
+}
+
+std::wstring GetMemorySubsystemName (MemorySubsystem subsystem)
+{
+	switch (subsystem) {
+		case MemorySubsystem::MeshGeometry:
+			return L"Mesh geometry";
+		case MemorySubsystem::MeshMaterials:
+			return L"Mesh materials";
+		case MemorySubsystem::Render:
+			return L"Render";
+	}
+	return L"";
+}
+
+std::wstring FormatMemorySize (size_t size)
+{
+	static const wchar_t* units[] = { L"B", L"KB", L"MB", L"GB" };
+	double value = (double) size;
+	int unitIndex = 0;
+	while (value >= 1024.0 && unitIndex < 3) {
+		value /= 1024.0;
+		unitIndex++;
+	}
+	wchar_t buffer[64];
+	std::swprintf (buffer, 64, L"%.2f %ls", value, units[unitIndex]);
+	return std::wstring (buffer);
+}
+
+}
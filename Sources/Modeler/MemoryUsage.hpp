@@ -0,0 +1,92 @@
+#ifndef MODELER_MEMORYUSAGE_HPP
+#define MODELER_MEMORYUSAGE_HPP
+
+#include <vector>
+#include <string>
+#include <memory>
+
+namespace Modeler
+{
+
+enum class MemorySubsystem
+{
+	MeshGeometry	= 0,
+	MeshMaterials	= 1,
+	Render			= 2
+};
+
+static const int MemorySubsystemCount = 3;
+
+void			AddTrackedMemory (MemorySubsystem subsystem, size_t size);
+void			RemoveTrackedMemory (MemorySubsystem subsystem, size_t size);
+size_t			GetTrackedMemory (MemorySubsystem subsystem);
+bool			IsMemoryTrackingEnabled ();
+
+std::wstring	GetMemorySubsystemName (MemorySubsystem subsystem);
+std::wstring	FormatMemorySize (size_t size);
+
+template <typename T, MemorySubsystem subsystem>
+class TrackingAllocator
+{
+public:
+	using value_type = T;
+
+	template <typename U>
+	struct rebind
+	{
+		using other = TrackingAllocator<U, subsystem>;
+	};
+
+	TrackingAllocator ()
+	{
+
+	}
+
+	template <typename U>
+	TrackingAllocator (const TrackingAllocator<U, subsystem>&)
+	{
+
+	}
+
+	T* allocate (size_t count)
+	{
+		AddTrackedMemory (subsystem, count * sizeof (T));
+		return static_cast<T*> (::operator new (count * sizeof (T)));
+	}
+
+	void deallocate (T* ptr, size_t count)
+	{
+		RemoveTrackedMemory (subsystem, count * sizeof (T));
+		::operator delete (ptr);
+	}
+};
+
+template <typename T, typename U, MemorySubsystem subsystem>
+bool operator== (const TrackingAllocator<T, subsystem>&, const TrackingAllocator<U, subsystem>&)
+{
+	return true;
+}
+
+template <typename T, typename U, MemorySubsystem subsystem>
+bool operator!= (const TrackingAllocator<T, subsystem>&, const TrackingAllocator<U, subsystem>&)
+{
+	return false;
+}
+
+#ifdef MODELER_MEMORY_TRACKING
+template <typename T, MemorySubsystem subsystem>
+using TrackedVector = std::vector<T, TrackingAllocator<T, subsystem>>;
+#else
+template <typename T, MemorySubsystem subsystem>
+using TrackedVector = std::vector<T>;
+#endif
+
+template <typename T, typename Allocator>
+size_t CalcVectorMemoryUsage (const std::vector<T, Allocator>& vec)
+{
+	return vec.capacity () * sizeof (T);
+}
+
+}
+
+#endif
@@ -4,6 +4,8 @@
 #include "TriangleUtils.hpp"
 
 #include <atomic>
+#include <algorithm>
+#include <stdexcept>
 
 namespace Modeler
 {
@@ -197,6 +199,51 @@ Checksum MeshGeometry::CalcCheckSum () const
 	return result;
 }
 
+ContentHash MeshGeometry::CalcContentHash () const
+{
+	ContentHash result;
+	result.Add (vertices.size ());
+	for (const glm::dvec3& vec : vertices) {
+		result.Add (vec.x);
+		result.Add (vec.y);
+		result.Add (vec.z);
+	}
+	result.Add (normals.size ());
+	for (const glm::dvec3& vec : normals) {
+		result.Add (vec.x);
+		result.Add (vec.y);
+		result.Add (vec.z);
+	}
+	result.Add (triangles.size ());
+	for (const MeshTriangle& tri : triangles) {
+		result.Add (tri.v1);
+		result.Add (tri.v2);
+		result.Add (tri.v3);
+		result.Add (tri.n1);
+		result.Add (tri.n2);
+		result.Add (tri.n3);
+	}
+	return result;
+}
+
+bool MeshGeometry::IsIdentical (const MeshGeometry& rhs) const
+{
+	if (vertices.size () != rhs.vertices.size () || normals.size () != rhs.normals.size () || triangles.size () != rhs.triangles.size ()) {
+		return false;
+	}
+	if (!std::equal (vertices.begin (), vertices.end (), rhs.vertices.begin ()) || !std::equal (normals.begin (), normals.end (), rhs.normals.begin ())) {
+		return false;
+	}
+	return std::equal (triangles.begin (), triangles.end (), rhs.triangles.begin (), [] (const MeshTriangle& a, const MeshTriangle& b) {
+		return a.v1 == b.v1 && a.v2 == b.v2 && a.v3 == b.v3 && a.n1 == b.n1 && a.n2 == b.n2 && a.n3 == b.n3;
+	});
+}
+
+size_t MeshGeometry::CalcMemoryUsage () const
+{
+	return sizeof (MeshGeometry) + CalcVectorMemoryUsage (vertices) + CalcVectorMemoryUsage (normals) + CalcVectorMemoryUsage (triangles);
+}
+
 void MeshGeometry::Clear()
 {
 	vertices.clear ();
@@ -204,6 +251,14 @@ void MeshGeometry::Clear()
 	triangles.clear ();
 }
 
+TriangleMaterialRange::TriangleMaterialRange (MaterialId material, unsigned int first, unsigned int count) :
+	material (material),
+	first (first),
+	count (count)
+{
+
+}
+
 MeshMaterials::MeshMaterials ()
 {
 
@@ -234,12 +289,51 @@ unsigned int MeshMaterials::MaterialCount () const
 
 void MeshMaterials::AddTriangleMaterial (MaterialId materialId)
 {
-	triangleMaterials.push_back (materialId);
+	if (!triangleRanges.empty () && triangleRanges.back ().material == materialId) {
+		triangleRanges.back ().count += 1;
+		return;
+	}
+	unsigned int first = 0;
+	if (!triangleRanges.empty ()) {
+		const TriangleMaterialRange& lastRange = triangleRanges.back ();
+		first = lastRange.first + lastRange.count;
+	}
+	triangleRanges.push_back (TriangleMaterialRange (materialId, first, 1));
 }
 
 MaterialId MeshMaterials::GetTriangleMaterial (unsigned int triangleIndex) const
 {
-	return triangleMaterials[triangleIndex];
+	auto found = std::upper_bound (triangleRanges.begin (), triangleRanges.end (), triangleIndex, [] (unsigned int index, const TriangleMaterialRange& range) {
+		return index < range.first;
+	});
+	if (found == triangleRanges.begin ()) {
+		throw std::out_of_range ("triangle has no material");
+	}
+	const TriangleMaterialRange& range = *(found - 1);
+	if (triangleIndex >= range.first + range.count) {
+		throw std::out_of_range ("triangle has no material");
+	}
+	return range.material;
+}
+
+unsigned int MeshMaterials::TriangleRangeCount () const
+{
+	return (unsigned int) triangleRanges.size ();
+}
+
+const TriangleMaterialRange& MeshMaterials::GetTriangleRange (unsigned int index) const
+{
+	return triangleRanges[index];
+}
+
+bool MeshMaterials::IsGroupedByMaterial () const
+{
+	for (size_t i = 1; i < triangleRanges.size (); i++) {
+		if (triangleRanges[i - 1].material >= triangleRanges[i].material) {
+			return false;
+		}
+	}
+	return true;
 }
 
 Checksum MeshMaterials::CalcCheckSum () const
@@ -248,75 +342,136 @@ Checksum MeshMaterials::CalcCheckSum () const
 	for (const Material& material : materials) {
 		result.Add (material.CalcCheckSum ());
 	}
-	for (MaterialId materialId : triangleMaterials) {
-		result.Add (materialId);
+	for (const TriangleMaterialRange& range : triangleRanges) {
+		result.Add (range.material);
+		result.Add (range.first);
+		result.Add (range.count);
+	}
+	return result;
+}
+
+ContentHash MeshMaterials::CalcContentHash () const
+{
+	ContentHash result;
+	result.Add (materials.size ());
+	for (const Material& material : materials) {
+		result.Add (material.GetColor ().x);
+		result.Add (material.GetColor ().y);
+		result.Add (material.GetColor ().z);
+	}
+	result.Add (triangleRanges.size ());
+	for (const TriangleMaterialRange& range : triangleRanges) {
+		result.Add (range.material);
+		result.Add (range.first);
+		result.Add (range.count);
 	}
 	return result;
 }
 
+bool MeshMaterials::IsIdentical (const MeshMaterials& rhs) const
+{
+	if (materials.size () != rhs.materials.size () || triangleRanges.size () != rhs.triangleRanges.size ()) {
+		return false;
+	}
+	bool equalMaterials = std::equal (materials.begin (), materials.end (), rhs.materials.begin (), [] (const Material& a, const Material& b) {
+		return a.GetColor () == b.GetColor ();
+	});
+	if (!equalMaterials) {
+		return false;
+	}
+	return std::equal (triangleRanges.begin (), triangleRanges.end (), rhs.triangleRanges.begin (), [] (const TriangleMaterialRange& a, const TriangleMaterialRange& b) {
+		return a.material == b.material && a.first == b.first && a.count == b.count;
+	});
+}
+
+size_t MeshMaterials::CalcMemoryUsage () const
+{
+	return sizeof (MeshMaterials) + CalcVectorMemoryUsage (materials) + CalcVectorMemoryUsage (triangleRanges);
+}
+
 void MeshMaterials::Clear()
 {
 	materials.clear ();
-	triangleMaterials.clear ();
+	triangleRanges.clear ();
 }
 
 Mesh::Mesh () :
-	geometry (),
-	materials (),
+	geometry (new MeshGeometry ()),
+	materials (new MeshMaterials ()),
 	transformation (1.0)
 {
 
 }
 
+Mesh::Mesh (const MeshGeometryConstPtr& geometry, const MeshMaterialsConstPtr& materials, const glm::dmat4& transformation) :
+	geometry (geometry),
+	materials (materials),
+	transformation (transformation)
+{
+	if (geometry == nullptr || materials == nullptr) {
+		throw std::logic_error ("invalid mesh data");
+	}
+}
+
 MaterialId Mesh::AddMaterial (const Material& material)
 {
-	return materials.AddMaterial (material);
+	return ModifyMaterials ().AddMaterial (material);
 }
 
 unsigned int Mesh::AddVertex (double x, double y, double z)
 {
-	return geometry.AddVertex (glm::dvec3 (x, y, z));
+	return ModifyGeometry ().AddVertex (glm::dvec3 (x, y, z));
 }
 
 unsigned int Mesh::AddVertex (const glm::dvec3& vertex)
 {
-	return geometry.AddVertex (vertex);
+	return ModifyGeometry ().AddVertex (vertex);
 }
 
 unsigned int Mesh::AddNormal (double x, double y, double z)
 {
-	return geometry.AddNormal (glm::dvec3 (x, y, z));
+	return ModifyGeometry ().AddNormal (glm::dvec3 (x, y, z));
 }
 
 unsigned int Mesh::AddNormal (const glm::dvec3& normal)
 {
-	return geometry.AddNormal (normal);
+	return ModifyGeometry ().AddNormal (normal);
 }
 
 unsigned int Mesh::AddTriangle (unsigned int v1, unsigned int v2, unsigned int v3, MaterialId mat)
 {
-	materials.AddTriangleMaterial (mat);
-	return geometry.AddTriangle (v1, v2, v3);
+	ModifyMaterials ().AddTriangleMaterial (mat);
+	return ModifyGeometry ().AddTriangle (v1, v2, v3);
 }
 
 unsigned int Mesh::AddTriangle (unsigned int v1, unsigned int v2, unsigned int v3, unsigned int normal, MaterialId mat)
 {
-	materials.AddTriangleMaterial (mat);
-	return geometry.AddTriangle (v1, v2, v3, normal);
+	ModifyMaterials ().AddTriangleMaterial (mat);
+	return ModifyGeometry ().AddTriangle (v1, v2, v3, normal);
 }
 
 unsigned int Mesh::AddTriangle (unsigned int v1, unsigned int v2, unsigned int v3, unsigned int n1, unsigned int n2, unsigned int n3, MaterialId mat)
 {
-	materials.AddTriangleMaterial (mat);
-	return geometry.AddTriangle (v1, v2, v3, n1, n2, n3);
+	ModifyMaterials ().AddTriangleMaterial (mat);
+	return ModifyGeometry ().AddTriangle (v1, v2, v3, n1, n2, n3);
 }
 
 const MeshGeometry& Mesh::GetGeometry () const
 {
-	return geometry;
+	return *geometry;
 }
 
 const MeshMaterials& Mesh::GetMaterials () const
+{
+	return *materials;
+}
+
+const MeshGeometryConstPtr& Mesh::GetGeometryPtr () const
+{
+	return geometry;
+}
+
+const MeshMaterialsConstPtr& Mesh::GetMaterialsPtr () const
 {
 	return materials;
 }
@@ -336,31 +491,95 @@ void Mesh::AddTransformation (const glm::dmat4& newTransformation)
 	transformation = newTransformation * transformation;
 }
 
+void Mesh::GroupTrianglesByMaterial ()
+{
+	if (materials->IsGroupedByMaterial ()) {
+		return;
+	}
+
+	std::vector<TriangleMaterialRange> ranges;
+	for (unsigned int i = 0; i < materials->TriangleRangeCount (); i++) {
+		ranges.push_back (materials->GetTriangleRange (i));
+	}
+	std::stable_sort (ranges.begin (), ranges.end (), [&] (const TriangleMaterialRange& a, const TriangleMaterialRange& b) {
+		return a.material < b.material;
+	});
+
+	std::shared_ptr<MeshGeometry> groupedGeometry (new MeshGeometry ());
+	std::shared_ptr<MeshMaterials> groupedMaterials (new MeshMaterials ());
+	geometry->EnumerateVertices (glm::dmat4 (1.0), [&] (const glm::dvec3& vertex) {
+		groupedGeometry->AddVertex (vertex);
+	});
+	geometry->EnumerateNormals (glm::dmat4 (1.0), [&] (const glm::dvec3& normal) {
+		groupedGeometry->AddNormal (normal);
+	});
+	materials->EnumerateMaterials ([&] (MaterialId, const Material& material) {
+		groupedMaterials->AddMaterial (material);
+	});
+	for (const TriangleMaterialRange& range : ranges) {
+		for (unsigned int i = range.first; i < range.first + range.count; i++) {
+			const MeshTriangle& triangle = geometry->GetTriangle (i);
+			groupedGeometry->AddTriangle (triangle.v1, triangle.v2, triangle.v3, triangle.n1, triangle.n2, triangle.n3);
+			groupedMaterials->AddTriangleMaterial (range.material);
+		}
+	}
+
+	geometry = groupedGeometry;
+	materials = groupedMaterials;
+}
+
+ContentHash Mesh::CalcContentHash () const
+{
+	ContentHash result;
+	result.Add (geometry->CalcContentHash ());
+	result.Add (materials->CalcContentHash ());
+	for (glm::length_t i = 0; i < 4; i++) {
+		for (glm::length_t j = 0; j < 4; j++) {
+			result.Add (transformation[i][j]);
+		}
+	}
+	return result;
+}
+
+bool Mesh::IsIdentical (const Mesh& rhs) const
+{
+	if (transformation != rhs.transformation) {
+		return false;
+	}
+	if (geometry != rhs.geometry && !geometry->IsIdentical (*rhs.geometry)) {
+		return false;
+	}
+	return materials == rhs.materials || materials->IsIdentical (*rhs.materials);
+}
+
+size_t Mesh::CalcMemoryUsage () const
+{
+	return sizeof (Mesh) + geometry->CalcMemoryUsage () + materials->CalcMemoryUsage ();
+}
+
 void Mesh::Clear ()
 {
-	geometry.Clear ();
-	materials.Clear ();
+	geometry.reset (new MeshGeometry ());
+	materials.reset (new MeshMaterials ());
 	transformation = glm::dmat4 (1.0);
 }
 
-const Mesh EmptyMesh;
-
-void EnumerateTrianglesByMaterial (const MeshGeometry& geometry, const MeshMaterials& materials, const std::function<void (MaterialId, const std::vector<unsigned int>&)>& processor)
+MeshGeometry& Mesh::ModifyGeometry ()
 {
-	std::vector<MaterialId> materialVector;
-	std::unordered_map<MaterialId, std::vector<unsigned int>> trianglesByMaterial;
-	for (MaterialId materialId = 0; materialId < (int) materials.MaterialCount (); materialId++) {
-		materialVector.push_back (materialId);
-		trianglesByMaterial.insert ({ materialId, std::vector<unsigned int> ()});
+	if (geometry.use_count () > 1) {
+		geometry.reset (new MeshGeometry (*geometry));
 	}
-	for (unsigned int i = 0; i < geometry.TriangleCount (); i++) {
-		MaterialId materialId = materials.GetTriangleMaterial (i);
-		trianglesByMaterial[materialId].push_back (i);
-	};
-	std::sort (materialVector.begin (), materialVector.end ());
-	for (MaterialId materialId : materialVector) {
-		processor (materialId, trianglesByMaterial[materialId]);
+	return const_cast<MeshGeometry&> (*geometry);
+}
+
+MeshMaterials& Mesh::ModifyMaterials ()
+{
+	if (materials.use_count () > 1) {
+		materials.reset (new MeshMaterials (*materials));
 	}
+	return const_cast<MeshMaterials&> (*materials);
 }
 
+const Mesh EmptyMesh;
+
 }
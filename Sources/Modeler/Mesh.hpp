@@ -2,8 +2,10 @@
 #define MODELER_MESH_HPP
 
 #include "Checksum.hpp"
+#include "ContentHash.hpp"
 #include "IncludeGLM.hpp"
 #include "BoundingShapes.hpp"
+#include "MemoryUsage.hpp"
 
 #include <vector>
 #include <unordered_set>
@@ -86,15 +88,32 @@ public:
 
 	const Geometry::BoundingBox&	GetBoundingBox () const;
 	Checksum						CalcCheckSum () const;
+	ContentHash						CalcContentHash () const;
+	bool							IsIdentical (const MeshGeometry& rhs) const;
+	size_t							CalcMemoryUsage () const;
 	void							Clear ();
 
 private:
-	std::vector<glm::dvec3>			vertices;
-	std::vector<glm::dvec3>			normals;
-	std::vector<MeshTriangle>		triangles;
-	Geometry::BoundingBox			bounds;
+	TrackedVector<glm::dvec3, MemorySubsystem::MeshGeometry>		vertices;
+	TrackedVector<glm::dvec3, MemorySubsystem::MeshGeometry>		normals;
+	TrackedVector<MeshTriangle, MemorySubsystem::MeshGeometry>		triangles;
+	Geometry::BoundingBox											bounds;
 };
 
+class TriangleMaterialRange
+{
+public:
+	TriangleMaterialRange (MaterialId material, unsigned int first, unsigned int count);
+
+	MaterialId		material;
+	unsigned int	first;
+	unsigned int	count;
+};
+
+// Triangle materials are stored as ranges of consecutive triangles with the same
+// material. Meshes grouped by material have only one range per material. The
+// triangle order is never changed implicitly, operations building meshes with
+// mixed materials group their result once.
 class MeshMaterials
 {
 public:
@@ -110,26 +129,37 @@ public:
 	void					EnumerateMaterials (const std::function<void (MaterialId, const Material&)>& processor) const;
 	unsigned int			MaterialCount () const;
 
-	void					AddTriangleMaterial (MaterialId materialId);
-	MaterialId				GetTriangleMaterial (unsigned int triangleIndex) const;
+	void							AddTriangleMaterial (MaterialId materialId);
+	MaterialId						GetTriangleMaterial (unsigned int triangleIndex) const;
 
-	Checksum				CalcCheckSum () const;
-	void					Clear ();
+	unsigned int					TriangleRangeCount () const;
+	const TriangleMaterialRange&	GetTriangleRange (unsigned int index) const;
+	bool							IsGroupedByMaterial () const;
+
+	Checksum						CalcCheckSum () const;
+	ContentHash						CalcContentHash () const;
+	bool							IsIdentical (const MeshMaterials& rhs) const;
+	size_t							CalcMemoryUsage () const;
+	void							Clear ();
 
 private:
-	std::vector<Material>		materials;
-	std::vector<MaterialId>		triangleMaterials;
+	TrackedVector<Material, MemorySubsystem::MeshMaterials>					materials;
+	TrackedVector<TriangleMaterialRange, MemorySubsystem::MeshMaterials>	triangleRanges;
 };
 
+typedef std::shared_ptr<const MeshGeometry> MeshGeometryConstPtr;
+typedef std::shared_ptr<const MeshMaterials> MeshMaterialsConstPtr;
+
+// Geometry and materials are immutable shared buffers, so copying a mesh
+// is cheap. The buffers are copied only when a shared mesh is modified.
 class Mesh
 {
 public:
 	Mesh ();
+	Mesh (const MeshGeometryConstPtr& geometry, const MeshMaterialsConstPtr& materials, const glm::dmat4& transformation);
 	Mesh (const Mesh& rhs) = default;
-	Mesh (Mesh&& rhs) = default;
 	
 	Mesh&					operator= (const Mesh& rhs) = default;
-	Mesh&					operator= (Mesh&& rhs) = default;
 
 	MaterialId				AddMaterial (const Material& material);
 
@@ -143,25 +173,36 @@ public:
 	unsigned int			AddTriangle (unsigned int v1, unsigned int v2, unsigned int v3, unsigned int normal, MaterialId mat);
 	unsigned int			AddTriangle (unsigned int v1, unsigned int v2, unsigned int v3, unsigned int n1, unsigned int n2, unsigned int n3, MaterialId mat);
 
-	const MeshGeometry&		GetGeometry () const;
-	const MeshMaterials&	GetMaterials () const;
+	const MeshGeometry&				GetGeometry () const;
+	const MeshMaterials&			GetMaterials () const;
+	const MeshGeometryConstPtr&		GetGeometryPtr () const;
+	const MeshMaterialsConstPtr&	GetMaterialsPtr () const;
 
 	const glm::dmat4&		GetTransformation () const;
 	void					SetTransformation (const glm::dmat4& newTransformation);
 	void					AddTransformation (const glm::dmat4& newTransformation);
 
+	void					GroupTrianglesByMaterial ();
+
+	// The content hash and the comparison cover the geometry, the materials
+	// and the transformation, shared buffers are not compared element-wise.
+	ContentHash				CalcContentHash () const;
+	bool					IsIdentical (const Mesh& rhs) const;
+
+	size_t					CalcMemoryUsage () const;
 	void					Clear ();
 
 private:
-	MeshGeometry			geometry;
-	MeshMaterials			materials;
+	MeshGeometry&			ModifyGeometry ();
+	MeshMaterials&			ModifyMaterials ();
+
+	MeshGeometryConstPtr	geometry;
+	MeshMaterialsConstPtr	materials;
 	glm::dmat4				transformation;
 };
 
 extern const Mesh EmptyMesh;
 
-void EnumerateTrianglesByMaterial (const MeshGeometry& geometry, const MeshMaterials& materials, const std::function<void (MaterialId, const std::vector<unsigned int>&)>& processor);
-
 }
 
 #endif
@@ -0,0 +1,149 @@
+#include "MeshClusters.hpp"
+#include "Geometry.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace Modeler
+{
+
+class MeshClusterSet
+{
+public:
+	MeshClusterSet (size_t count) :
+		parents (count)
+	{
+		std::iota (parents.begin (), parents.end (), 0);
+	}
+
+	size_t Find (size_t index)
+	{
+		while (parents[index] != index) {
+			parents[index] = parents[parents[index]];
+			index = parents[index];
+		}
+		return index;
+	}
+
+	void Join (size_t a, size_t b)
+	{
+		size_t aRoot = Find (a);
+		size_t bRoot = Find (b);
+		if (aRoot != bRoot) {
+			parents[std::max (aRoot, bRoot)] = std::min (aRoot, bRoot);
+		}
+	}
+
+private:
+	std::vector<size_t> parents;
+};
+
+static void SortClusterAlongLongestAxis (const std::vector<Geometry::BoundingBox>& boundingBoxes, std::vector<size_t>& cluster)
+{
+	Geometry::BoundingBox clusterBox;
+	for (size_t index : cluster) {
+		if (boundingBoxes[index].IsValid ()) {
+			clusterBox.AddPoint (boundingBoxes[index].GetMin ());
+			clusterBox.AddPoint (boundingBoxes[index].GetMax ());
+		}
+	}
+	if (!clusterBox.IsValid ()) {
+		return;
+	}
+
+	glm::dvec3 size = clusterBox.GetMax () - clusterBox.GetMin ();
+	glm::length_t axis = 0;
+	if (size.y > size[axis]) {
+		axis = 1;
+	}
+	if (size.z > size[axis]) {
+		axis = 2;
+	}
+	std::stable_sort (cluster.begin (), cluster.end (), [&] (size_t a, size_t b) {
+		return boundingBoxes[a].GetCenter ()[axis] < boundingBoxes[b].GetCenter ()[axis];
+	});
+}
+
+std::vector<std::vector<size_t>> GetMeshClusters (const std::vector<Mesh>& meshes)
+{
+	std::vector<Geometry::BoundingBox> boundingBoxes;
+	boundingBoxes.reserve (meshes.size ());
+	for (const Mesh& mesh : meshes) {
+		boundingBoxes.push_back (mesh.GetGeometry ().GetBoundingBox ().Transform (mesh.GetTransformation ()));
+	}
+
+	std::vector<size_t> order (meshes.size ());
+	std::iota (order.begin (), order.end (), 0);
+	std::sort (order.begin (), order.end (), [&] (size_t a, size_t b) {
+		return boundingBoxes[a].GetMin ().x < boundingBoxes[b].GetMin ().x;
+	});
+
+	// sweep along the x axis, only meshes with overlapping x ranges are compared
+	MeshClusterSet clusterSet (meshes.size ());
+	std::vector<size_t> active;
+	for (size_t index : order) {
+		const Geometry::BoundingBox& boundingBox = boundingBoxes[index];
+		if (!boundingBox.IsValid ()) {
+			continue;
+		}
+		active.erase (std::remove_if (active.begin (), active.end (), [&] (size_t activeIndex) {
+			return Geometry::IsLower (boundingBoxes[activeIndex].GetMax ().x, boundingBox.GetMin ().x);
+		}), active.end ());
+		for (size_t activeIndex : active) {
+			if (Geometry::HasBoundingBoxOverlap (boundingBoxes[activeIndex], boundingBox)) {
+				clusterSet.Join (activeIndex, index);
+			}
+		}
+		active.push_back (index);
+	}
+
+	// roots are the smallest indices of their clusters
+	std::vector<std::vector<size_t>> clusters;
+	std::vector<size_t> clusterIndices (meshes.size ());
+	for (size_t i = 0; i < meshes.size (); i++) {
+		size_t root = clusterSet.Find (i);
+		if (root == i) {
+			clusterIndices[i] = clusters.size ();
+			clusters.push_back ({});
+		}
+		clusters[clusterIndices[root]].push_back (i);
+	}
+	for (std::vector<size_t>& cluster : clusters) {
+		SortClusterAlongLongestAxis (boundingBoxes, cluster);
+	}
+	return clusters;
+}
+
+Mesh MergeMeshes (const std::vector<Mesh>& meshes)
+{
+	Mesh result;
+	for (const Mesh& mesh : meshes) {
+		const MeshGeometry& geometry = mesh.GetGeometry ();
+		const MeshMaterials& materials = mesh.GetMaterials ();
+		unsigned int vertexOffset = result.GetGeometry ().VertexCount ();
+		unsigned int normalOffset = result.GetGeometry ().NormalCount ();
+		MaterialId materialOffset = (MaterialId) result.GetMaterials ().MaterialCount ();
+
+		geometry.EnumerateVertices (mesh.GetTransformation (), [&] (const glm::dvec3& vertex) {
+			result.AddVertex (vertex);
+		});
+		geometry.EnumerateNormals (mesh.GetTransformation (), [&] (const glm::dvec3& normal) {
+			result.AddNormal (normal);
+		});
+		materials.EnumerateMaterials ([&] (MaterialId, const Material& material) {
+			result.AddMaterial (material);
+		});
+		for (unsigned int i = 0; i < geometry.TriangleCount (); i++) {
+			const MeshTriangle& triangle = geometry.GetTriangle (i);
+			result.AddTriangle (
+				vertexOffset + triangle.v1, vertexOffset + triangle.v2, vertexOffset + triangle.v3,
+				normalOffset + triangle.n1, normalOffset + triangle.n2, normalOffset + triangle.n3,
+				materialOffset + materials.GetTriangleMaterial (i)
+			);
+		}
+	}
+	result.GroupTrianglesByMaterial ();
+	return result;
+}
+
+}
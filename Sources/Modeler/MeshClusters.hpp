@@ -0,0 +1,24 @@
+#ifndef MODELER_MESHCLUSTERS_HPP
+#define MODELER_MESHCLUSTERS_HPP
+
+#include "Mesh.hpp"
+
+#include <vector>
+
+namespace Modeler
+{
+
+// Groups the meshes by their transformed bounding boxes. Meshes with touching
+// or overlapping boxes are in the same cluster, so meshes of different clusters
+// are separated by a gap. Clusters are ordered by their first mesh, and the
+// meshes of a cluster are ordered along its longest axis, so neighbouring meshes
+// in the list are close to each other.
+std::vector<std::vector<size_t>>	GetMeshClusters (const std::vector<Mesh>& meshes);
+
+// Concatenates the meshes to one mesh in world coordinates, the triangles are
+// grouped by material. The result is the union of separated closed meshes.
+Mesh								MergeMeshes (const std::vector<Mesh>& meshes);
+
+}
+
+#endif
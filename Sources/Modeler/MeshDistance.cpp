@@ -0,0 +1,277 @@
+#include "MeshDistance.hpp"
+#include "ParallelTasks.hpp"
+#include "MeshTopology.hpp"
+#include "Geometry.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+
+namespace Modeler
+{
+
+// points are processed in chunks, so the cost of scheduling is negligible
+static const size_t PointsPerTask = 256;
+
+static uint64_t GetEdgeKey (unsigned int v1, unsigned int v2)
+{
+	return ((uint64_t) std::min (v1, v2) << 32) | (uint64_t) std::max (v1, v2);
+}
+
+static uint64_t SpreadBits (uint64_t value)
+{
+	value &= 0x1fffff;
+	value = (value | value << 32) & 0x1f00000000ffff;
+	value = (value | value << 16) & 0x1f0000ff0000ff;
+	value = (value | value << 8) & 0x100f00f00f00f00f;
+	value = (value | value << 4) & 0x10c30c30c30c30c3;
+	value = (value | value << 2) & 0x1249249249249249;
+	return value;
+}
+
+static std::vector<size_t> GetSpatialOrder (const std::vector<glm::dvec3>& points)
+{
+	Geometry::BoundingBox boundingBox;
+	for (const glm::dvec3& point : points) {
+		boundingBox.AddPoint (point);
+	}
+
+	const double gridSize = (double) 0x1fffff;
+	glm::dvec3 size = boundingBox.GetMax () - boundingBox.GetMin ();
+	double maxSize = std::max (std::max (size.x, size.y), size.z);
+	double scale = Geometry::IsPositive (maxSize) ? gridSize / maxSize : 0.0;
+
+	std::vector<std::pair<uint64_t, size_t>> codes (points.size ());
+	for (size_t i = 0; i < points.size (); i++) {
+		glm::dvec3 gridPosition = (points[i] - boundingBox.GetMin ()) * scale;
+		uint64_t code = SpreadBits ((uint64_t) gridPosition.x) | SpreadBits ((uint64_t) gridPosition.y) << 1 | SpreadBits ((uint64_t) gridPosition.z) << 2;
+		codes[i] = { code, i };
+	}
+	std::sort (codes.begin (), codes.end ());
+
+	std::vector<size_t> order (points.size ());
+	for (size_t i = 0; i < codes.size (); i++) {
+		order[i] = codes[i].second;
+	}
+	return order;
+}
+
+MeshClosestPoint::MeshClosestPoint () :
+	MeshClosestPoint (glm::dvec3 (0.0, 0.0, 0.0), NoTriangle, Geometry::INF)
+{
+}
+
+MeshClosestPoint::MeshClosestPoint (const glm::dvec3& point, unsigned int triangle, double distance) :
+	point (point),
+	triangle (triangle),
+	distance (distance)
+{
+}
+
+bool MeshClosestPoint::IsValid () const
+{
+	return triangle != NoTriangle;
+}
+
+MeshDistanceQuery::TriangleData::TriangleData () :
+	vertices ({ 0, 0, 0 }),
+	normal (0.0, 0.0, 0.0),
+	edgeNormals ({ glm::dvec3 (0.0, 0.0, 0.0), glm::dvec3 (0.0, 0.0, 0.0), glm::dvec3 (0.0, 0.0, 0.0) })
+{
+}
+
+MeshDistanceQuery::MeshDistanceQuery (const Mesh& mesh) :
+	MeshDistanceQuery (mesh.GetGeometry (), mesh.GetTransformation ())
+{
+}
+
+MeshDistanceQuery::MeshDistanceQuery (const MeshGeometry& geometry, const glm::dmat4& transformation) :
+	bvh (CollectTriangles (geometry, transformation)),
+	triangleData (),
+	vertexNormals ()
+{
+	CalculatePseudonormals (geometry);
+}
+
+bool MeshDistanceQuery::IsEmpty () const
+{
+	return bvh.IsEmpty ();
+}
+
+MeshClosestPoint MeshDistanceQuery::GetClosestPoint (const glm::dvec3& point) const
+{
+	Geometry::TriangleClosestPoint closestPoint;
+	double distance = Geometry::INF;
+	size_t triangle = FindClosestTriangle (point, Geometry::TriangleBVH::NoTriangle, closestPoint, distance);
+	if (triangle == Geometry::TriangleBVH::NoTriangle) {
+		return MeshClosestPoint ();
+	}
+	return MeshClosestPoint (closestPoint.point, (unsigned int) triangle, distance);
+}
+
+double MeshDistanceQuery::GetDistance (const glm::dvec3& point) const
+{
+	return GetClosestPoint (point).distance;
+}
+
+double MeshDistanceQuery::GetSignedDistance (const glm::dvec3& point) const
+{
+	Geometry::TriangleClosestPoint closestPoint;
+	double distance = Geometry::INF;
+	size_t triangle = FindClosestTriangle (point, Geometry::TriangleBVH::NoTriangle, closestPoint, distance);
+	return CalcSignedDistance (point, triangle, closestPoint, distance);
+}
+
+std::vector<MeshClosestPoint> MeshDistanceQuery::GetClosestPoints (const std::vector<glm::dvec3>& points, unsigned int threadCount) const
+{
+	std::vector<MeshClosestPoint> result (points.size ());
+	RunBatchedQueries (points, threadCount, [&] (size_t index, size_t triangle, const Geometry::TriangleClosestPoint& closestPoint, double distance) {
+		if (triangle != Geometry::TriangleBVH::NoTriangle) {
+			result[index] = MeshClosestPoint (closestPoint.point, (unsigned int) triangle, distance);
+		}
+	});
+	return result;
+}
+
+std::vector<double> MeshDistanceQuery::GetDistances (const std::vector<glm::dvec3>& points, unsigned int threadCount) const
+{
+	std::vector<double> result (points.size ());
+	RunBatchedQueries (points, threadCount, [&] (size_t index, size_t, const Geometry::TriangleClosestPoint&, double distance) {
+		result[index] = distance;
+	});
+	return result;
+}
+
+std::vector<double> MeshDistanceQuery::GetSignedDistances (const std::vector<glm::dvec3>& points, unsigned int threadCount) const
+{
+	std::vector<double> result (points.size ());
+	RunBatchedQueries (points, threadCount, [&] (size_t index, size_t triangle, const Geometry::TriangleClosestPoint& closestPoint, double distance) {
+		result[index] = CalcSignedDistance (points[index], triangle, closestPoint, distance);
+	});
+	return result;
+}
+
+std::vector<Geometry::Triangle> MeshDistanceQuery::CollectTriangles (const MeshGeometry& geometry, const glm::dmat4& transformation)
+{
+	std::vector<glm::dvec3> vertices;
+	vertices.reserve (geometry.VertexCount ());
+	geometry.EnumerateVertices (transformation, [&] (const glm::dvec3& vertex) {
+		vertices.push_back (vertex);
+	});
+
+	std::vector<Geometry::Triangle> triangles;
+	triangles.reserve (geometry.TriangleCount ());
+	geometry.EnumerateTriangles ([&] (const MeshTriangle& triangle) {
+		triangles.push_back (Geometry::Triangle (vertices[triangle.v1], vertices[triangle.v2], vertices[triangle.v3]));
+	});
+	return triangles;
+}
+
+void MeshDistanceQuery::CalculatePseudonormals (const MeshGeometry& geometry)
+{
+	// edge normals are the sum of the two neighbouring face normals, vertex
+	// normals are the sum of the face normals weighted by the corner angles
+	triangleData.resize (geometry.TriangleCount ());
+	vertexNormals.assign (geometry.VertexCount (), glm::dvec3 (0.0, 0.0, 0.0));
+	std::unordered_map<uint64_t, glm::dvec3> edgeNormals;
+	edgeNormals.reserve (geometry.TriangleCount () * 3 / 2);
+	for (unsigned int i = 0; i < geometry.TriangleCount (); i++) {
+		const MeshTriangle& meshTriangle = geometry.GetTriangle (i);
+		const Geometry::Triangle& triangle = bvh.GetTriangle (i);
+		TriangleData& data = triangleData[i];
+		data.vertices = { meshTriangle.v1, meshTriangle.v2, meshTriangle.v3 };
+
+		glm::dvec3 cross = glm::cross (triangle[1] - triangle[0], triangle[2] - triangle[0]);
+		double length = glm::length (cross);
+		data.normal = Geometry::IsPositive (length) ? cross / length : glm::dvec3 (0.0, 0.0, 0.0);
+
+		for (size_t j = 0; j < 3; j++) {
+			glm::dvec3 nextEdge = triangle[(j + 1) % 3] - triangle[j];
+			glm::dvec3 prevEdge = triangle[(j + 2) % 3] - triangle[j];
+			double angle = std::atan2 (glm::length (glm::cross (nextEdge, prevEdge)), glm::dot (nextEdge, prevEdge));
+			vertexNormals[data.vertices[j]] += angle * data.normal;
+			edgeNormals[GetEdgeKey (data.vertices[j], data.vertices[(j + 1) % 3])] += data.normal;
+		}
+	}
+
+	for (TriangleData& data : triangleData) {
+		for (size_t j = 0; j < 3; j++) {
+			data.edgeNormals[j] = edgeNormals.at (GetEdgeKey (data.vertices[j], data.vertices[(j + 1) % 3]));
+		}
+	}
+}
+
+size_t MeshDistanceQuery::FindClosestTriangle (const glm::dvec3& point, size_t hintTriangle, Geometry::TriangleClosestPoint& closestPoint, double& distance) const
+{
+	if (hintTriangle == Geometry::TriangleBVH::NoTriangle) {
+		return bvh.GetClosestTriangle (point, Geometry::INF, closestPoint, distance);
+	}
+
+	// the distance of the hint triangle is an upper bound, so most of the tree
+	// is skipped, if no closer triangle is found the hint is the closest one
+	Geometry::TriangleClosestPoint hintClosestPoint = Geometry::GetTriangleClosestPoint (bvh.GetTriangle (hintTriangle), point);
+	double hintDistance = glm::distance (point, hintClosestPoint.point);
+	size_t triangle = bvh.GetClosestTriangle (point, hintDistance, closestPoint, distance);
+	if (triangle == Geometry::TriangleBVH::NoTriangle) {
+		closestPoint = hintClosestPoint;
+		distance = hintDistance;
+		return hintTriangle;
+	}
+	return triangle;
+}
+
+double MeshDistanceQuery::CalcSignedDistance (const glm::dvec3& point, size_t triangle, const Geometry::TriangleClosestPoint& closestPoint, double distance) const
+{
+	if (triangle == Geometry::TriangleBVH::NoTriangle) {
+		return Geometry::INF;
+	}
+	const glm::dvec3& pseudonormal = GetPseudonormal ((unsigned int) triangle, closestPoint.feature);
+	if (glm::dot (point - closestPoint.point, pseudonormal) < 0.0) {
+		return -distance;
+	}
+	return distance;
+}
+
+void MeshDistanceQuery::RunBatchedQueries (const std::vector<glm::dvec3>& points, unsigned int threadCount, const QueryProcessor& processor) const
+{
+	// points are processed along a space filling curve, so consecutive points
+	// are close to each other, and the result of the previous point is a hint
+	std::vector<size_t> order = GetSpatialOrder (points);
+	size_t taskCount = (points.size () + PointsPerTask - 1) / PointsPerTask;
+	RunParallelTasks (taskCount, threadCount, [&] (size_t taskIndex) {
+		size_t first = taskIndex * PointsPerTask;
+		size_t last = std::min (first + PointsPerTask, points.size ());
+		size_t hintTriangle = Geometry::TriangleBVH::NoTriangle;
+		for (size_t i = first; i < last; i++) {
+			Geometry::TriangleClosestPoint closestPoint;
+			double distance = Geometry::INF;
+			hintTriangle = FindClosestTriangle (points[order[i]], hintTriangle, closestPoint, distance);
+			processor (order[i], hintTriangle, closestPoint, distance);
+		}
+	});
+}
+
+const glm::dvec3& MeshDistanceQuery::GetPseudonormal (unsigned int triangle, Geometry::TriangleFeature feature) const
+{
+	const TriangleData& data = triangleData[triangle];
+	switch (feature) {
+		case Geometry::TriangleFeature::Face:
+			return data.normal;
+		case Geometry::TriangleFeature::Edge1:
+			return data.edgeNormals[0];
+		case Geometry::TriangleFeature::Edge2:
+			return data.edgeNormals[1];
+		case Geometry::TriangleFeature::Edge3:
+			return data.edgeNormals[2];
+		case Geometry::TriangleFeature::Vertex1:
+			return vertexNormals[data.vertices[0]];
+		case Geometry::TriangleFeature::Vertex2:
+			return vertexNormals[data.vertices[1]];
+		case Geometry::TriangleFeature::Vertex3:
+			return vertexNormals[data.vertices[2]];
+	}
+	return data.normal;
+}
+
+}
@@ -0,0 +1,82 @@
+#ifndef MODELER_MESHDISTANCE_HPP
+#define MODELER_MESHDISTANCE_HPP
+
+#include "IncludeGLM.hpp"
+#include "Mesh.hpp"
+#include "TriangleBVH.hpp"
+
+#include <vector>
+#include <array>
+#include <functional>
+
+namespace Modeler
+{
+
+class MeshClosestPoint
+{
+public:
+	MeshClosestPoint ();
+	MeshClosestPoint (const glm::dvec3& point, unsigned int triangle, double distance);
+
+	bool			IsValid () const;
+
+	glm::dvec3		point;
+	unsigned int	triangle;
+	double			distance;
+};
+
+// Distance queries from points to the surface of a mesh. The transformed
+// triangles are stored in a bounding volume hierarchy on construction, so
+// one query object can answer any number of queries, even from many threads.
+// The sign of the signed distance comes from the angle weighted pseudonormal
+// of the closest feature, it is negative inside closed and consistently
+// oriented meshes. Empty meshes are infinitely far from every point.
+class MeshDistanceQuery
+{
+public:
+	MeshDistanceQuery (const Mesh& mesh);
+	MeshDistanceQuery (const MeshGeometry& geometry, const glm::dmat4& transformation);
+
+	bool							IsEmpty () const;
+
+	MeshClosestPoint				GetClosestPoint (const glm::dvec3& point) const;
+	double							GetDistance (const glm::dvec3& point) const;
+	double							GetSignedDistance (const glm::dvec3& point) const;
+
+	// Batched queries, the points are processed in parallel in the order of
+	// a space filling curve, and the closest triangle of the previous point
+	// bounds the search of the next one. With a thread count of zero every
+	// hardware thread is used.
+	std::vector<MeshClosestPoint>	GetClosestPoints (const std::vector<glm::dvec3>& points, unsigned int threadCount) const;
+	std::vector<double>				GetDistances (const std::vector<glm::dvec3>& points, unsigned int threadCount) const;
+	std::vector<double>				GetSignedDistances (const std::vector<glm::dvec3>& points, unsigned int threadCount) const;
+
+private:
+	class TriangleData
+	{
+	public:
+		TriangleData ();
+
+		std::array<unsigned int, 3>	vertices;
+		glm::dvec3					normal;
+		std::array<glm::dvec3, 3>	edgeNormals;
+	};
+
+	typedef std::function<void (size_t, size_t, const Geometry::TriangleClosestPoint&, double)> QueryProcessor;
+
+	static std::vector<Geometry::Triangle>	CollectTriangles (const MeshGeometry& geometry, const glm::dmat4& transformation);
+
+	void					CalculatePseudonormals (const MeshGeometry& geometry);
+	size_t					FindClosestTriangle (const glm::dvec3& point, size_t hintTriangle, Geometry::TriangleClosestPoint& closestPoint, double& distance) const;
+	double					CalcSignedDistance (const glm::dvec3& point, size_t triangle, const Geometry::TriangleClosestPoint& closestPoint, double distance) const;
+	void					RunBatchedQueries (const std::vector<glm::dvec3>& points, unsigned int threadCount, const QueryProcessor& processor) const;
+	const glm::dvec3&		GetPseudonormal (unsigned int triangle, Geometry::TriangleFeature feature) const;
+
+	Geometry::TriangleBVH		bvh;
+	std::vector<TriangleData>	triangleData;
+	std::vector<glm::dvec3>		vertexNormals;
+};
+
+}
+
+#endif
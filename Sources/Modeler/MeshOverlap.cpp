@@ -0,0 +1,207 @@
+#include "MeshOverlap.hpp"
+#include "MeshDistance.hpp"
+#include "TriangleBVH.hpp"
+#include "TriangleUtils.hpp"
+#include "Geometry.hpp"
+
+#include <memory>
+#include <numeric>
+#include <cmath>
+
+namespace Modeler
+{
+
+// Surfaces closer than this margin are touching, it is the same tolerance as
+// the one of the bounding box overlap check, so every near pair is a candidate.
+// Rounding errors of the transformations are far below it, so a separated or
+// contained component is never in contact in exact arithmetic.
+static const double ContactMargin = Geometry::EPS;
+
+enum class ComponentRelation
+{
+	Outside,
+	Inside,
+	Touching
+};
+
+class OverlapMesh
+{
+public:
+	OverlapMesh (const Mesh& mesh) :
+		mesh (mesh),
+		vertices (),
+		boundingBox (mesh.GetGeometry ().GetBoundingBox ().Transform (mesh.GetTransformation ())),
+		triangleComponents (),
+		componentVertices (),
+		componentRelations ()
+	{
+		const MeshGeometry& geometry = mesh.GetGeometry ();
+		vertices.reserve (geometry.VertexCount ());
+		geometry.EnumerateVertices (mesh.GetTransformation (), [&] (const glm::dvec3& vertex) {
+			vertices.push_back (vertex);
+		});
+		CalculateComponents ();
+	}
+
+	std::unique_ptr<Geometry::TriangleBVH> CreateTriangleBVH () const
+	{
+		const MeshGeometry& geometry = mesh.GetGeometry ();
+		std::vector<Geometry::Triangle> triangles;
+		triangles.reserve (geometry.TriangleCount ());
+		geometry.EnumerateTriangles ([&] (const MeshTriangle& triangle) {
+			triangles.push_back (Geometry::Triangle (vertices[triangle.v1], vertices[triangle.v2], vertices[triangle.v3]));
+		});
+		return std::unique_ptr<Geometry::TriangleBVH> (new Geometry::TriangleBVH (triangles));
+	}
+
+	const Mesh&						mesh;
+	std::vector<glm::dvec3>			vertices;
+	Geometry::BoundingBox			boundingBox;
+	std::vector<size_t>				triangleComponents;
+	std::vector<unsigned int>		componentVertices;
+	std::vector<ComponentRelation>	componentRelations;
+
+private:
+	void CalculateComponents ()
+	{
+		const MeshGeometry& geometry = mesh.GetGeometry ();
+		std::vector<unsigned int> parents (geometry.VertexCount ());
+		std::iota (parents.begin (), parents.end (), 0);
+		auto findRoot = [&] (unsigned int vertex) {
+			while (parents[vertex] != vertex) {
+				parents[vertex] = parents[parents[vertex]];
+				vertex = parents[vertex];
+			}
+			return vertex;
+		};
+		geometry.EnumerateTriangles ([&] (const MeshTriangle& triangle) {
+			unsigned int root = findRoot (triangle.v1);
+			for (unsigned int vertex : { triangle.v2, triangle.v3 }) {
+				unsigned int otherRoot = findRoot (vertex);
+				if (otherRoot != root) {
+					parents[std::max (root, otherRoot)] = std::min (root, otherRoot);
+					root = std::min (root, otherRoot);
+				}
+			}
+		});
+
+		std::vector<size_t> rootComponents (geometry.VertexCount (), (size_t) -1);
+		triangleComponents.reserve (geometry.TriangleCount ());
+		geometry.EnumerateTriangles ([&] (const MeshTriangle& triangle) {
+			unsigned int root = findRoot (triangle.v1);
+			if (rootComponents[root] == (size_t) -1) {
+				rootComponents[root] = componentVertices.size ();
+				componentVertices.push_back (triangle.v1);
+			}
+			triangleComponents.push_back (rootComponents[root]);
+		});
+		componentRelations.assign (componentVertices.size (), ComponentRelation::Outside);
+	}
+};
+
+static void ClassifyContainedComponents (OverlapMesh& overlapMesh, const Mesh& otherMesh, const Geometry::BoundingBox& otherBoundingBox)
+{
+	std::unique_ptr<MeshDistanceQuery> distanceQuery;
+	for (size_t component = 0; component < overlapMesh.componentVertices.size (); component++) {
+		if (overlapMesh.componentRelations[component] == ComponentRelation::Touching) {
+			continue;
+		}
+		const glm::dvec3& vertex = overlapMesh.vertices[overlapMesh.componentVertices[component]];
+		if (!Geometry::HasBoundingBoxOverlap (Geometry::BoundingBox (vertex, vertex), otherBoundingBox)) {
+			continue;
+		}
+		if (distanceQuery == nullptr) {
+			distanceQuery.reset (new MeshDistanceQuery (otherMesh));
+		}
+		double signedDistance = distanceQuery->GetSignedDistance (vertex);
+		if (std::fabs (signedDistance) <= ContactMargin) {
+			overlapMesh.componentRelations[component] = ComponentRelation::Touching;
+		} else if (signedDistance < 0.0) {
+			overlapMesh.componentRelations[component] = ComponentRelation::Inside;
+		}
+	}
+}
+
+static Mesh CreateComponentsMesh (const OverlapMesh& overlapMesh, ComponentRelation relation)
+{
+	const MeshGeometry& geometry = overlapMesh.mesh.GetGeometry ();
+	const MeshMaterials& materials = overlapMesh.mesh.GetMaterials ();
+	Mesh result;
+	materials.EnumerateMaterials ([&] (MaterialId, const Material& material) {
+		result.AddMaterial (material);
+	});
+
+	// only the used vertices are copied, normals are copied as they are
+	std::vector<unsigned int> vertexMap (geometry.VertexCount (), (unsigned int) -1);
+	auto mapVertex = [&] (unsigned int vertex) {
+		if (vertexMap[vertex] == (unsigned int) -1) {
+			vertexMap[vertex] = result.AddVertex (overlapMesh.vertices[vertex]);
+		}
+		return vertexMap[vertex];
+	};
+	geometry.EnumerateNormals (overlapMesh.mesh.GetTransformation (), [&] (const glm::dvec3& normal) {
+		result.AddNormal (normal);
+	});
+	for (unsigned int i = 0; i < geometry.TriangleCount (); i++) {
+		if (overlapMesh.componentRelations[overlapMesh.triangleComponents[i]] != relation) {
+			continue;
+		}
+		const MeshTriangle& triangle = geometry.GetTriangle (i);
+		result.AddTriangle (mapVertex (triangle.v1), mapVertex (triangle.v2), mapVertex (triangle.v3), triangle.n1, triangle.n2, triangle.n3, materials.GetTriangleMaterial (i));
+	}
+	return result;
+}
+
+// If every component has the same relation, that part is the original mesh
+// with its local coordinates and transformation, otherwise the parts are new
+// meshes of the components in world coordinates.
+static void CreatePartition (const OverlapMesh& overlapMesh, MeshOverlapPartition& partition)
+{
+	partition = MeshOverlapPartition ();
+	bool hasRelation[3] = { false, false, false };
+	for (ComponentRelation relation : overlapMesh.componentRelations) {
+		hasRelation[(int) relation] = true;
+	}
+	int relationCount = (int) hasRelation[0] + (int) hasRelation[1] + (int) hasRelation[2];
+	for (ComponentRelation relation : { ComponentRelation::Outside, ComponentRelation::Inside, ComponentRelation::Touching }) {
+		if (!hasRelation[(int) relation]) {
+			continue;
+		}
+		Mesh& part = (relation == ComponentRelation::Outside ? partition.outside : (relation == ComponentRelation::Inside ? partition.inside : partition.touching));
+		part = (relationCount == 1 ? overlapMesh.mesh : CreateComponentsMesh (overlapMesh, relation));
+	}
+}
+
+MeshOverlapPartition::MeshOverlapPartition () :
+	outside (),
+	inside (),
+	touching ()
+{
+}
+
+void PartitionMeshOverlap (const Mesh& aMesh, const Mesh& bMesh, MeshOverlapPartition& aPartition, MeshOverlapPartition& bPartition)
+{
+	OverlapMesh aOverlapMesh (aMesh);
+	OverlapMesh bOverlapMesh (bMesh);
+	if (Geometry::HasBoundingBoxOverlap (aOverlapMesh.boundingBox, bOverlapMesh.boundingBox)) {
+		std::unique_ptr<Geometry::TriangleBVH> aBVH = aOverlapMesh.CreateTriangleBVH ();
+		std::unique_ptr<Geometry::TriangleBVH> bBVH = bOverlapMesh.CreateTriangleBVH ();
+		aBVH->EnumerateCandidatePairs (*bBVH, [&] (size_t aTriangle, size_t bTriangle) {
+			ComponentRelation& aRelation = aOverlapMesh.componentRelations[aOverlapMesh.triangleComponents[aTriangle]];
+			ComponentRelation& bRelation = bOverlapMesh.componentRelations[bOverlapMesh.triangleComponents[bTriangle]];
+			if (aRelation == ComponentRelation::Touching && bRelation == ComponentRelation::Touching) {
+				return;
+			}
+			if (Geometry::GetTriangleTriangleDistance (aBVH->GetTriangle (aTriangle), bBVH->GetTriangle (bTriangle)) <= ContactMargin) {
+				aRelation = ComponentRelation::Touching;
+				bRelation = ComponentRelation::Touching;
+			}
+		});
+		ClassifyContainedComponents (aOverlapMesh, bMesh, bOverlapMesh.boundingBox);
+		ClassifyContainedComponents (bOverlapMesh, aMesh, aOverlapMesh.boundingBox);
+	}
+	CreatePartition (aOverlapMesh, aPartition);
+	CreatePartition (bOverlapMesh, bPartition);
+}
+
+}
@@ -0,0 +1,36 @@
+#ifndef MODELER_MESHOVERLAP_HPP
+#define MODELER_MESHOVERLAP_HPP
+
+#include "Mesh.hpp"
+
+namespace Modeler
+{
+
+// Connected components of a mesh sorted by their relation to an other mesh.
+// Components with intersecting, touching or nearly touching surfaces are in
+// the touching mesh, the others are inside or outside of the other mesh. Every
+// part is empty, the original mesh with its own transformation if all of the
+// components are in that part, or a mesh of the components in world
+// coordinates.
+class MeshOverlapPartition
+{
+public:
+	MeshOverlapPartition ();
+
+	Mesh	outside;
+	Mesh	inside;
+	Mesh	touching;
+};
+
+// Partitions the components of both closed meshes against each other. Meshes
+// with separated bounding boxes are outside of each other without any further
+// check, otherwise surface contacts are found with triangle trees, and one
+// vertex of every component without contact decides if it is inside by the
+// sign of its distance from the other mesh. Contacts are detected with a small
+// margin, so near contacts are classified as touching, and are left to the
+// exact calculation instead of a decision based on rounded coordinates.
+void	PartitionMeshOverlap (const Mesh& aMesh, const Mesh& bMesh, MeshOverlapPartition& aPartition, MeshOverlapPartition& bPartition);
+
+}
+
+#endif
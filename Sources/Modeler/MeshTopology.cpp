@@ -1,10 +1,39 @@
 #include "MeshTopology.hpp"
+#include "ParallelTasks.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
 
 namespace Modeler
 {
 
 const unsigned int NoTriangle = (unsigned int) -1;
 
+struct HalfEdge
+{
+	unsigned int	maxVertex;
+	unsigned int	index;
+};
+
+// every pass of the build works on chunks of this size, so chunks can be
+// processed in parallel without any synchronization
+static const size_t ItemsPerChunk = 1 << 16;
+
+static size_t GetChunkCount (size_t itemCount)
+{
+	return (itemCount + ItemsPerChunk - 1) / ItemsPerChunk;
+}
+
+static void RunOnChunks (size_t itemCount, unsigned int threadCount, const std::function<void (size_t, size_t, size_t)>& processor)
+{
+	RunParallelTasks (GetChunkCount (itemCount), threadCount, [&] (size_t chunkIndex) {
+		size_t first = chunkIndex * ItemsPerChunk;
+		size_t last = std::min (first + ItemsPerChunk, itemCount);
+		processor (chunkIndex, first, last);
+	});
+}
+
 MeshTopology::MeshTopology () :
 	isValid (true)
 {
@@ -76,6 +105,146 @@ MeshTopologyBuilder::Result MeshTopologyBuilder::AddTriangle (unsigned int v1, u
 	return Result::NoError;
 }
 
+MeshTopologyBuilder::Result MeshTopologyBuilder::Build (MeshTopology& topology, const std::vector<unsigned int>& triangleVertices, unsigned int threadCount)
+{
+	topology.isValid = true;
+	topology.Clear ();
+	if (triangleVertices.size () % 3 != 0) {
+		topology.isValid = false;
+		return Result::InvalidTopology;
+	}
+
+	size_t halfEdgeCount = triangleVertices.size ();
+	auto GetHalfEdgeBeg = [&] (size_t halfEdge) {
+		return triangleVertices[halfEdge];
+	};
+	auto GetHalfEdgeEnd = [&] (size_t halfEdge) {
+		return triangleVertices[halfEdge % 3 == 2 ? halfEdge - 2 : halfEdge + 1];
+	};
+	auto GetHalfEdgeMin = [&] (size_t halfEdge) {
+		return std::min (GetHalfEdgeBeg (halfEdge), GetHalfEdgeEnd (halfEdge));
+	};
+	auto GetHalfEdgeMax = [&] (size_t halfEdge) {
+		return std::max (GetHalfEdgeBeg (halfEdge), GetHalfEdgeEnd (halfEdge));
+	};
+
+	unsigned int vertexCount = 0;
+	for (unsigned int vertex : triangleVertices) {
+		vertexCount = std::max (vertexCount, vertex + 1);
+	}
+
+	// the edge key is the smaller and the larger vertex index, the half-edges
+	// are sorted by the smaller vertex with a counting sort, so one pass puts
+	// them to buckets, and the small buckets are sorted by the larger vertex
+	std::vector<std::atomic<unsigned int>> bucketPositions (vertexCount + 1);
+	RunOnChunks (halfEdgeCount, threadCount, [&] (size_t, size_t first, size_t last) {
+		for (size_t i = first; i < last; i++) {
+			bucketPositions[GetHalfEdgeMin (i)].fetch_add (1, std::memory_order_relaxed);
+		}
+	});
+
+	std::vector<unsigned int> bucketOffsets (vertexCount + 1);
+	unsigned int offset = 0;
+	for (unsigned int vertex = 0; vertex <= vertexCount; vertex++) {
+		unsigned int count = bucketPositions[vertex].load (std::memory_order_relaxed);
+		bucketOffsets[vertex] = offset;
+		bucketPositions[vertex].store (offset, std::memory_order_relaxed);
+		offset += count;
+	}
+
+	std::vector<HalfEdge> halfEdges (halfEdgeCount);
+	RunOnChunks (halfEdgeCount, threadCount, [&] (size_t, size_t first, size_t last) {
+		for (size_t i = first; i < last; i++) {
+			unsigned int position = bucketPositions[GetHalfEdgeMin (i)].fetch_add (1, std::memory_order_relaxed);
+			halfEdges[position] = HalfEdge { GetHalfEdgeMax (i), (unsigned int) i };
+		}
+	});
+
+	// the buckets are fully sorted, so the first half-edge of every group is the
+	// first occurrence of the edge, it gives the direction and the order of the
+	// edge, the same as in case of adding the triangles one by one
+	std::vector<unsigned int> firstHalfEdges (halfEdgeCount);
+	std::vector<unsigned int> edgeIndices (halfEdgeCount, 0);
+	std::vector<char> chunkNonManifold (GetChunkCount (vertexCount), 0);
+	RunOnChunks (vertexCount, threadCount, [&] (size_t chunkIndex, size_t first, size_t last) {
+		for (size_t vertex = first; vertex < last; vertex++) {
+			HalfEdge* bucketBeg = halfEdges.data () + bucketOffsets[vertex];
+			HalfEdge* bucketEnd = halfEdges.data () + bucketOffsets[vertex + 1];
+			std::sort (bucketBeg, bucketEnd, [] (const HalfEdge& a, const HalfEdge& b) {
+				return a.maxVertex < b.maxVertex || (a.maxVertex == b.maxVertex && a.index < b.index);
+			});
+			HalfEdge* groupBeg = bucketBeg;
+			for (HalfEdge* it = bucketBeg; it != bucketEnd; ++it) {
+				if (it->maxVertex != groupBeg->maxVertex) {
+					groupBeg = it;
+				}
+				firstHalfEdges[it->index] = groupBeg->index;
+				if (it == groupBeg) {
+					edgeIndices[it->index] = 1;
+				} else if (it > groupBeg + 1 || GetHalfEdgeBeg (it->index) == GetHalfEdgeBeg (groupBeg->index)) {
+					chunkNonManifold[chunkIndex] = 1;
+				}
+			}
+		}
+	});
+	if (std::find (chunkNonManifold.begin (), chunkNonManifold.end (), 1) != chunkNonManifold.end ()) {
+		topology.isValid = false;
+		return Result::NonManifoldEdgeFound;
+	}
+
+	// edge indices are the exclusive prefix sum of the first occurrence flags
+	std::vector<unsigned int> chunkEdgeOffsets (GetChunkCount (halfEdgeCount), 0);
+	RunOnChunks (halfEdgeCount, threadCount, [&] (size_t chunkIndex, size_t first, size_t last) {
+		for (size_t i = first; i < last; i++) {
+			chunkEdgeOffsets[chunkIndex] += edgeIndices[i];
+		}
+	});
+	unsigned int edgeCount = 0;
+	for (unsigned int& chunkEdgeOffset : chunkEdgeOffsets) {
+		unsigned int chunkEdgeCount = chunkEdgeOffset;
+		chunkEdgeOffset = edgeCount;
+		edgeCount += chunkEdgeCount;
+	}
+	RunOnChunks (halfEdgeCount, threadCount, [&] (size_t chunkIndex, size_t first, size_t last) {
+		unsigned int edgeIndex = chunkEdgeOffsets[chunkIndex];
+		for (size_t i = first; i < last; i++) {
+			unsigned int isFirst = edgeIndices[i];
+			edgeIndices[i] = edgeIndex;
+			edgeIndex += isFirst;
+		}
+	});
+
+	// every half-edge writes its own triangle field of the edge, so there is
+	// no conflict between the two half-edges of an edge
+	topology.edges.resize (edgeCount, MeshTopology::Edge { 0, 0, NoTriangle, NoTriangle });
+	topology.triangles.resize (halfEdgeCount / 3);
+	RunOnChunks (halfEdgeCount, threadCount, [&] (size_t, size_t first, size_t last) {
+		for (size_t i = first; i < last; i++) {
+			unsigned int firstHalfEdge = firstHalfEdges[i];
+			unsigned int triangle = (unsigned int) (i / 3);
+			MeshTopology::Edge& edge = topology.edges[edgeIndices[firstHalfEdge]];
+			MeshTopology::TriangleEdge triEdge { edgeIndices[firstHalfEdge], i != firstHalfEdge };
+			if (triEdge.reversed) {
+				edge.triangle2 = triangle;
+			} else {
+				edge.beg = GetHalfEdgeBeg (i);
+				edge.end = GetHalfEdgeEnd (i);
+				edge.triangle1 = triangle;
+			}
+			MeshTopology::Triangle& topologyTriangle = topology.triangles[triangle];
+			if (i % 3 == 0) {
+				topologyTriangle.edge1 = triEdge;
+			} else if (i % 3 == 1) {
+				topologyTriangle.edge2 = triEdge;
+			} else {
+				topologyTriangle.edge3 = triEdge;
+			}
+		}
+	});
+
+	return Result::NoError;
+}
+
 MeshTopologyBuilder::Result MeshTopologyBuilder::AddTriangleEdges (MeshTopology::Triangle& triangle, unsigned int v1, unsigned int v2, unsigned int v3)
 {
 	unsigned int triangleIndex = (unsigned int) topology.triangles.size ();
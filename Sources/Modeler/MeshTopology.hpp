@@ -4,6 +4,7 @@
 #include <vector>
 #include <functional>
 #include <unordered_map>
+#include <cstdint>
 
 namespace Modeler
 {
@@ -67,6 +68,14 @@ public:
 
 	Result	AddTriangle (unsigned int v1, unsigned int v2, unsigned int v3);
 
+	// Builds the topology of all the triangles at once, the vertex indices of
+	// the triangles follow each other in the array. The half-edges are radix
+	// sorted by their edge key in parallel and paired up linearly, the result
+	// is the same as adding the triangles one by one. The previous content of
+	// the topology is replaced. With a thread count of zero every hardware
+	// thread is used.
+	static Result	Build (MeshTopology& topology, const std::vector<unsigned int>& triangleVertices, unsigned int threadCount);
+
 private:
 	struct EdgeKey
 	{
@@ -81,7 +90,9 @@ private:
 		template <class EdgeKey>
 		std::size_t operator() (const EdgeKey& key) const
 		{
-			return std::hash<unsigned int> {} (key.beg) + std::hash<unsigned int> {} (key.end);
+			uint64_t minVertex = key.beg < key.end ? key.beg : key.end;
+			uint64_t maxVertex = key.beg < key.end ? key.end : key.beg;
+			return std::hash<uint64_t> {} (minVertex << 32 | maxVertex);
 		}
 	};
 
@@ -0,0 +1,240 @@
+#include "MeshValidation.hpp"
+#include "MeshTopology.hpp"
+#include "HalfEdgeMesh.hpp"
+#include "ParallelTasks.hpp"
+#include "ContentHash.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace Modeler
+{
+
+static const size_t TrianglesPerTask = 1 << 14;
+static const size_t MaxCachedValidations = 4096;
+
+static bool IsDegenerateTriangle (const MeshGeometry& geometry, const MeshTriangle& triangle)
+{
+	if (triangle.v1 == triangle.v2 || triangle.v2 == triangle.v3 || triangle.v3 == triangle.v1) {
+		return true;
+	}
+
+	// the tolerance is relative to the edge lengths, so the check does not
+	// depend on the size of the mesh, only collinear vertices are rejected
+	const glm::dvec3& v1 = geometry.GetVertex (triangle.v1);
+	const glm::dvec3& v2 = geometry.GetVertex (triangle.v2);
+	const glm::dvec3& v3 = geometry.GetVertex (triangle.v3);
+	glm::dvec3 edge1 = v2 - v1;
+	glm::dvec3 edge2 = v3 - v1;
+	double crossLength = glm::length (glm::cross (edge1, edge2));
+	return crossLength <= 1.0e-12 * glm::length (edge1) * glm::length (edge2);
+}
+
+static unsigned int FindDegenerateTriangle (const MeshGeometry& geometry)
+{
+	std::atomic<unsigned int> degenerateTriangle (NoTriangle);
+	size_t taskCount = (geometry.TriangleCount () + TrianglesPerTask - 1) / TrianglesPerTask;
+	RunParallelTasks (taskCount, 0, [&] (size_t taskIndex) {
+		unsigned int first = (unsigned int) (taskIndex * TrianglesPerTask);
+		unsigned int last = (unsigned int) std::min (first + TrianglesPerTask, (size_t) geometry.TriangleCount ());
+		for (unsigned int i = first; i < last && i < degenerateTriangle.load (std::memory_order_relaxed); i++) {
+			if (IsDegenerateTriangle (geometry, geometry.GetTriangle (i))) {
+				unsigned int current = degenerateTriangle.load (std::memory_order_relaxed);
+				while (i < current && !degenerateTriangle.compare_exchange_weak (current, i, std::memory_order_relaxed)) {
+				}
+				break;
+			}
+		}
+	});
+	return degenerateTriangle.load ();
+}
+
+static MeshValidation ClassifyInvalidEdges (const MeshGeometry& geometry)
+{
+	// runs only for invalid meshes, the topology builder does not tell apart
+	// edges with more than two triangles from edges with wrong orientation
+	struct EdgeUsage
+	{
+		unsigned int	forward;
+		unsigned int	backward;
+		unsigned int	triangle;
+	};
+
+	std::unordered_map<uint64_t, EdgeUsage> edgeUsages;
+	for (unsigned int i = 0; i < geometry.TriangleCount (); i++) {
+		const MeshTriangle& triangle = geometry.GetTriangle (i);
+		unsigned int vertices[3] = { triangle.v1, triangle.v2, triangle.v3 };
+		for (unsigned int j = 0; j < 3; j++) {
+			unsigned int beg = vertices[j];
+			unsigned int end = vertices[(j + 1) % 3];
+			uint64_t key = (uint64_t) std::min (beg, end) << 32 | std::max (beg, end);
+			EdgeUsage& usage = edgeUsages.insert ({ key, EdgeUsage { 0, 0, i } }).first->second;
+			if (beg < end) {
+				usage.forward++;
+			} else {
+				usage.backward++;
+			}
+		}
+	}
+
+	MeshValidation result (MeshDefect::NonManifoldEdge, NoTriangle);
+	unsigned int orientationTriangle = NoTriangle;
+	for (const auto& it : edgeUsages) {
+		const EdgeUsage& usage = it.second;
+		if (usage.forward + usage.backward > 2) {
+			result.triangle = std::min (result.triangle, usage.triangle);
+		} else if (usage.forward == 2 || usage.backward == 2) {
+			orientationTriangle = std::min (orientationTriangle, usage.triangle);
+		}
+	}
+	if (result.triangle == NoTriangle) {
+		return MeshValidation (MeshDefect::InconsistentOrientation, orientationTriangle);
+	}
+	return result;
+}
+
+static unsigned int FindNonManifoldVertexTriangle (const HalfEdgeMesh& halfEdgeMesh)
+{
+	// the fan of a manifold vertex contains every half-edge starting there
+	std::vector<unsigned int> valences (halfEdgeMesh.VertexCount (), 0);
+	for (unsigned int halfEdge = 0; halfEdge < halfEdgeMesh.HalfEdgeCount (); halfEdge++) {
+		valences[halfEdgeMesh.GetOrigin (halfEdge)]++;
+	}
+	for (unsigned int vertex = 0; vertex < halfEdgeMesh.VertexCount (); vertex++) {
+		unsigned int fanSize = 0;
+		halfEdgeMesh.EnumerateVertexHalfEdges (vertex, [&] (unsigned int) {
+			fanSize++;
+		});
+		if (fanSize != valences[vertex]) {
+			return halfEdgeMesh.GetTriangle (halfEdgeMesh.GetVertexHalfEdge (vertex));
+		}
+	}
+	return NoTriangle;
+}
+
+// Validated geometries are not kept alive by the cache, a hit is accepted
+// only if the validated geometry still exists and it is identical.
+class CachedValidation
+{
+public:
+	std::weak_ptr<const MeshGeometry>	geometry;
+	MeshValidation						validation;
+};
+
+static bool IsCachedGeometry (const CachedValidation& cachedValidation, const MeshGeometryConstPtr& geometry)
+{
+	MeshGeometryConstPtr cachedGeometry = cachedValidation.geometry.lock ();
+	if (cachedGeometry == nullptr) {
+		return false;
+	}
+	return cachedGeometry == geometry || cachedGeometry->IsIdentical (*geometry);
+}
+
+MeshValidation::MeshValidation () :
+	MeshValidation (MeshDefect::None, NoTriangle)
+{
+}
+
+MeshValidation::MeshValidation (MeshDefect defect, unsigned int triangle) :
+	defect (defect),
+	triangle (triangle)
+{
+}
+
+bool MeshValidation::IsValid () const
+{
+	return defect == MeshDefect::None;
+}
+
+std::wstring MeshValidation::ToString () const
+{
+	std::wstring result;
+	switch (defect) {
+		case MeshDefect::None:
+			return L"valid mesh";
+		case MeshDefect::DegenerateTriangle:
+			result = L"degenerate triangle";
+			break;
+		case MeshDefect::NonManifoldEdge:
+			result = L"non-manifold edge";
+			break;
+		case MeshDefect::InconsistentOrientation:
+			result = L"inconsistent triangle orientation";
+			break;
+		case MeshDefect::OpenBoundary:
+			result = L"open boundary";
+			break;
+		case MeshDefect::NonManifoldVertex:
+			result = L"non-manifold vertex";
+			break;
+	}
+	if (triangle != NoTriangle) {
+		result += L" at triangle " + std::to_wstring (triangle);
+	}
+	return result;
+}
+
+MeshValidation ValidateMesh (const Mesh& mesh)
+{
+	const MeshGeometry& geometry = mesh.GetGeometry ();
+	unsigned int degenerateTriangle = FindDegenerateTriangle (geometry);
+	if (degenerateTriangle != NoTriangle) {
+		return MeshValidation (MeshDefect::DegenerateTriangle, degenerateTriangle);
+	}
+
+	HalfEdgeMesh halfEdgeMesh;
+	if (!halfEdgeMesh.Build (mesh, 0)) {
+		return ClassifyInvalidEdges (geometry);
+	}
+
+	for (unsigned int halfEdge = 0; halfEdge < halfEdgeMesh.HalfEdgeCount (); halfEdge++) {
+		if (halfEdgeMesh.IsBoundaryHalfEdge (halfEdge)) {
+			return MeshValidation (MeshDefect::OpenBoundary, halfEdgeMesh.GetTriangle (halfEdge));
+		}
+	}
+
+	unsigned int nonManifoldVertexTriangle = FindNonManifoldVertexTriangle (halfEdgeMesh);
+	if (nonManifoldVertexTriangle != NoTriangle) {
+		return MeshValidation (MeshDefect::NonManifoldVertex, nonManifoldVertexTriangle);
+	}
+
+	return MeshValidation ();
+}
+
+MeshValidation ValidateMeshCached (const Mesh& mesh)
+{
+	static std::mutex cacheMutex;
+	static std::unordered_map<ContentHash, CachedValidation> cache;
+
+	const MeshGeometryConstPtr& geometry = mesh.GetGeometryPtr ();
+	ContentHash key = geometry->CalcContentHash ();
+	CachedValidation cachedValidation;
+	bool found = false;
+	{
+		std::lock_guard<std::mutex> lock (cacheMutex);
+		auto foundValidation = cache.find (key);
+		if (foundValidation != cache.end ()) {
+			cachedValidation = foundValidation->second;
+			found = true;
+		}
+	}
+	if (found && IsCachedGeometry (cachedValidation, geometry)) {
+		return cachedValidation.validation;
+	}
+
+	MeshValidation validation = ValidateMesh (mesh);
+	{
+		std::lock_guard<std::mutex> lock (cacheMutex);
+		if (cache.size () >= MaxCachedValidations) {
+			cache.clear ();
+		}
+		cache[key] = CachedValidation { geometry, validation };
+	}
+	return validation;
+}
+
+}
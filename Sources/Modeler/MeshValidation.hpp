@@ -0,0 +1,46 @@
+#ifndef MODELER_MESHVALIDATION_HPP
+#define MODELER_MESHVALIDATION_HPP
+
+#include "Mesh.hpp"
+
+#include <string>
+
+namespace Modeler
+{
+
+enum class MeshDefect
+{
+	None,
+	DegenerateTriangle,
+	NonManifoldEdge,
+	InconsistentOrientation,
+	OpenBoundary,
+	NonManifoldVertex
+};
+
+class MeshValidation
+{
+public:
+	MeshValidation ();
+	MeshValidation (MeshDefect defect, unsigned int triangle);
+
+	bool			IsValid () const;
+	std::wstring	ToString () const;
+
+	MeshDefect		defect;
+	unsigned int	triangle;
+};
+
+// Checks whether the mesh is a closed, oriented 2-manifold without degenerate
+// triangles, so it bounds a volume. The first defect found is reported with
+// one of the affected triangles. Empty meshes are valid.
+MeshValidation		ValidateMesh (const Mesh& mesh);
+
+// The same as ValidateMesh, but the results are cached by the content hash of
+// the geometry, so every unique geometry is validated only once while it
+// exists. The geometry is compared with the validated one on every hit.
+MeshValidation		ValidateMeshCached (const Mesh& mesh);
+
+}
+
+#endif
@@ -1,16 +1,23 @@
 #include "Model.hpp"
+#include "ParallelTasks.hpp"
 
 #include "IncludeGLM.hpp"
 #include "TriangleUtils.hpp"
 
 #include <atomic>
+#include <algorithm>
+#include <unordered_set>
 
 namespace Modeler
 {
 
-MeshRef::MeshRef (MeshGeometryId geometryId, MeshMaterialsId& materialsId, const glm::dmat4& transformation) :
+MeshRef::MeshRef (	MeshGeometryId geometryId, const MeshGeometryConstPtr& geometry,
+					MeshMaterialsId materialsId, const MeshMaterialsConstPtr& materials,
+					const glm::dmat4& transformation) :
 	geometryId (geometryId),
+	geometry (geometry),
 	materialsId (materialsId),
+	materials (materials),
 	transformation (transformation)
 {
 }
@@ -25,108 +32,123 @@ MeshMaterialsId MeshRef::GetMaterialsId () const
 	return materialsId;
 }
 
-const glm::dmat4& MeshRef::GetTransformation () const
+const MeshGeometry& MeshRef::GetGeometry () const
 {
-	return transformation;
+	return *geometry;
 }
 
-void MeshRef::SetUserData (const std::string& key, const UserDataConstPtr& data)
+const MeshGeometryConstPtr& MeshRef::GetGeometryPtr () const
 {
-	userData.Set (key, data);
+	return geometry;
 }
 
-UserDataConstPtr MeshRef::GetUserData (const std::string & key) const
+const MeshMaterials& MeshRef::GetMaterials () const
 {
-	return userData.Get (key);
+	return *materials;
 }
 
-Model::Model () :
-	nextMeshId (0),
-	nextMaterialId (0)
+const MeshMaterialsConstPtr& MeshRef::GetMaterialsPtr () const
 {
-	Clear ();
+	return materials;
 }
 
-const MeshGeometry& Model::GetMeshGeometry (const MeshRef& meshRef) const
+const glm::dmat4& MeshRef::GetTransformation () const
 {
-	return geometries.GetData (meshRef.GetGeometryId ());
+	return transformation;
 }
 
-const MeshMaterials& Model::GetMeshMaterials (const MeshRef& meshRef) const
+void MeshRef::SetUserData (const std::string& key, const UserDataConstPtr& data)
 {
-	return materials.GetData (meshRef.GetMaterialsId ());
+	userData.Set (key, data);
 }
 
-const MeshRef& Model::GetMesh (MeshId meshId) const
+UserDataConstPtr MeshRef::GetUserData (const std::string & key) const
 {
-	return meshRefs.at (meshId);
+	return userData.Get (key);
 }
 
-void Model::EnumerateMeshes (const std::function<void (MeshId, const MeshRef&)>& processor) const
+ModelView::ModelView ()
 {
-	for (const auto& it : meshRefs) {
-		processor (it.first, it.second);
-	}
+
 }
 
-MeshId Model::AddMesh (const Mesh& mesh)
+ModelView::~ModelView ()
 {
-	const MeshGeometry& meshGeometry = mesh.GetGeometry ();
-	const MeshMaterials& meshMaterials = mesh.GetMaterials ();
-	const glm::dmat4& transformation = mesh.GetTransformation ();
 
-	MeshGeometryId meshGeometryId = geometries.AddReference (meshGeometry, meshGeometry.CalcCheckSum ());
-	MeshGeometryId meshMaterialsId = materials.AddReference (meshMaterials, meshMaterials.CalcCheckSum ());
+}
 
-	MeshRef meshRef (meshGeometryId, meshMaterialsId, transformation);
-	MeshId meshId = nextMeshId++;
-	meshRefs.insert ({ meshId, meshRef });
-	return meshId;
+const MeshGeometry& ModelView::GetMeshGeometry (const MeshRef& meshRef) const
+{
+	return meshRef.GetGeometry ();
 }
 
-void Model::SetMeshUserData (MeshId meshId, const std::string& key, const UserDataConstPtr& data)
+const MeshMaterials& ModelView::GetMeshMaterials (const MeshRef& meshRef) const
 {
-	MeshRef& meshRef = meshRefs.at (meshId);
-	meshRef.SetUserData (key, data);
+	return meshRef.GetMaterials ();
 }
 
-void Model::RemoveMesh (MeshId meshId)
+MeshGeometryConstPtr ModelView::GetMeshGeometryPtr (const MeshRef& meshRef) const
 {
-	const MeshRef& meshRef = meshRefs.at (meshId);
-	MeshGeometryId meshGeometryId = meshRef.GetGeometryId ();
-	MeshGeometryId meshMaterialsId = meshRef.GetMaterialsId ();
-	geometries.RemoveReference (meshGeometryId);
-	materials.RemoveReference (meshMaterialsId);
-	meshRefs.erase (meshId);
+	return meshRef.GetGeometryPtr ();
 }
 
-void Model::Clear ()
+MeshMaterialsConstPtr ModelView::GetMeshMaterialsPtr (const MeshRef& meshRef) const
 {
-	geometries.Clear ();
-	materials.Clear ();
-	meshRefs.clear ();
-	nextMeshId = 0;
-	nextMaterialId = 0;
+	return meshRef.GetMaterialsPtr ();
 }
 
-ModelInfo Model::GetInfo () const
+ModelInfo ModelView::GetInfo () const
 {
+	std::unordered_set<MeshGeometryId> geometryIds;
+	std::unordered_set<MeshMaterialsId> materialsIds;
 	ModelInfo modelInfo;
-	modelInfo.meshGeometryCount = (unsigned int) geometries.DataCount ();
-	modelInfo.meshMaterialsCount = (unsigned int) materials.DataCount ();
-	modelInfo.meshCount = (unsigned int) meshRefs.size ();
-	modelInfo.vertexCount = 0;
-	modelInfo.triangleCount = 0;
-	for (const auto& it : meshRefs) {
-		const MeshRef& meshRef = it.second;
-		const MeshGeometry& geometry = geometries.GetData (meshRef.GetGeometryId ());
+	EnumerateMeshes ([&] (MeshId, const MeshRef& meshRef) {
+		const MeshGeometry& geometry = meshRef.GetGeometry ();
+		if (geometryIds.insert (meshRef.GetGeometryId ()).second) {
+			modelInfo.geometryMemoryUsage += geometry.CalcMemoryUsage ();
+		}
+		if (materialsIds.insert (meshRef.GetMaterialsId ()).second) {
+			modelInfo.materialsMemoryUsage += meshRef.GetMaterials ().CalcMemoryUsage ();
+		}
+		modelInfo.meshCount += 1;
 		modelInfo.vertexCount += geometry.VertexCount ();
 		modelInfo.triangleCount += geometry.TriangleCount ();
-	}
+		modelInfo.meshMemoryUsage += sizeof (MeshRef);
+	});
+	modelInfo.meshGeometryCount = (unsigned int) geometryIds.size ();
+	modelInfo.meshMaterialsCount = (unsigned int) materialsIds.size ();
 	return modelInfo;
 }
 
-Geometry::BoundingBox Model::GetBoundingBox () const
+size_t ModelView::CalcMemoryUsage () const
+{
+	ModelInfo modelInfo = GetInfo ();
+	return modelInfo.geometryMemoryUsage + modelInfo.materialsMemoryUsage + modelInfo.meshMemoryUsage;
+}
+
+MassProperties ModelView::CalcMassProperties () const
+{
+	std::vector<MeshRefConstPtr> meshRefs;
+	EnumerateMeshRefs ([&] (MeshId, const MeshRefConstPtr& meshRef) {
+		meshRefs.push_back (meshRef);
+	});
+
+	// meshes are calculated in parallel, and summed in a fixed order, so
+	// the result does not depend on the number of threads
+	std::vector<MassProperties> meshProperties (meshRefs.size ());
+	RunParallelTasks (meshRefs.size (), 0, [&] (size_t taskIndex) {
+		const MeshRef& meshRef = *meshRefs[taskIndex];
+		meshProperties[taskIndex] = CalcMeshMassProperties (GetMeshGeometry (meshRef), meshRef.GetTransformation ());
+	});
+
+	MassProperties result;
+	for (const MassProperties& properties : meshProperties) {
+		result += properties;
+	}
+	return result;
+}
+
+Geometry::BoundingBox ModelView::GetBoundingBox () const
 {
 	Geometry::BoundingBox boundingBox;
 	EnumerateMeshes ([&] (MeshId, const MeshRef& meshRef) {
@@ -141,7 +163,7 @@ Geometry::BoundingBox Model::GetBoundingBox () const
 	return boundingBox;
 }
 
-Geometry::BoundingSphere Model::GetBoundingSphere () const
+Geometry::BoundingSphere ModelView::GetBoundingSphere () const
 {
 	Geometry::BoundingBox boundingBox = GetBoundingBox ();
 	if (!boundingBox.IsValid ()) {
@@ -153,4 +175,201 @@ Geometry::BoundingSphere Model::GetBoundingSphere () const
 	return Geometry::BoundingSphere (center, radius);
 }
 
+ModelSnapshot::ModelSnapshot (unsigned int version, std::vector<std::pair<MeshId, MeshRefConstPtr>>&& meshRefs) :
+	ModelView (),
+	version (version),
+	meshRefs (std::move (meshRefs))
+{
+
+}
+
+ModelSnapshot::~ModelSnapshot ()
+{
+
+}
+
+unsigned int ModelSnapshot::GetVersion () const
+{
+	return version;
+}
+
+bool ModelSnapshot::ContainsMesh (MeshId meshId) const
+{
+	auto found = std::lower_bound (meshRefs.begin (), meshRefs.end (), meshId, [] (const std::pair<MeshId, MeshRefConstPtr>& item, MeshId id) {
+		return item.first < id;
+	});
+	return found != meshRefs.end () && found->first == meshId;
+}
+
+MeshRefConstPtr ModelSnapshot::GetMesh (MeshId meshId) const
+{
+	auto found = std::lower_bound (meshRefs.begin (), meshRefs.end (), meshId, [] (const std::pair<MeshId, MeshRefConstPtr>& item, MeshId id) {
+		return item.first < id;
+	});
+	if (found == meshRefs.end () || found->first != meshId) {
+		throw std::out_of_range ("mesh not found");
+	}
+	return found->second;
+}
+
+void ModelSnapshot::EnumerateMeshes (const std::function<void (MeshId, const MeshRef&)>& processor) const
+{
+	for (const auto& it : meshRefs) {
+		processor (it.first, *it.second);
+	}
+}
+
+void ModelSnapshot::EnumerateMeshRefs (const std::function<void (MeshId, const MeshRefConstPtr&)>& processor) const
+{
+	for (const auto& it : meshRefs) {
+		processor (it.first, it.second);
+	}
+}
+
+Model::Model () :
+	ModelView (),
+	nextMeshId (0),
+	version (0)
+{
+	Clear ();
+}
+
+Model::~Model ()
+{
+
+}
+
+MeshRefConstPtr Model::GetMesh (MeshId meshId) const
+{
+	const MeshRefShard& shard = GetMeshRefShard (meshId);
+	std::lock_guard<std::mutex> lock (shard.mutex);
+	return shard.meshRefs.at (meshId);
+}
+
+void Model::EnumerateMeshes (const std::function<void (MeshId, const MeshRef&)>& processor) const
+{
+	unsigned int collectedVersion = 0;
+	std::vector<std::pair<MeshId, MeshRefConstPtr>> meshRefs = CollectMeshRefs (collectedVersion);
+	for (const auto& it : meshRefs) {
+		processor (it.first, *it.second);
+	}
+}
+
+void Model::EnumerateMeshRefs (const std::function<void (MeshId, const MeshRefConstPtr&)>& processor) const
+{
+	unsigned int collectedVersion = 0;
+	std::vector<std::pair<MeshId, MeshRefConstPtr>> meshRefs = CollectMeshRefs (collectedVersion);
+	for (const auto& it : meshRefs) {
+		processor (it.first, it.second);
+	}
+}
+
+MeshId Model::AddMesh (const Mesh& mesh)
+{
+	const MeshGeometryConstPtr& meshGeometry = mesh.GetGeometryPtr ();
+	const MeshMaterialsConstPtr& meshMaterials = mesh.GetMaterialsPtr ();
+	const glm::dmat4& transformation = mesh.GetTransformation ();
+	Checksum geometryCheckSum = meshGeometry->CalcCheckSum ();
+	Checksum materialsCheckSum = meshMaterials->CalcCheckSum ();
+
+	// the references are added under the shard lock, so a parallel clear
+	// removes either both the mesh and its references, or none of them
+	MeshId meshId = nextMeshId++;
+	MeshRefShard& shard = GetMeshRefShard (meshId);
+	std::lock_guard<std::mutex> lock (shard.mutex);
+	MeshGeometryId meshGeometryId = geometries.AddReference (meshGeometry, geometryCheckSum);
+	MeshMaterialsId meshMaterialsId = materials.AddReference (meshMaterials, materialsCheckSum);
+
+	MeshRefConstPtr meshRef (new MeshRef (
+		meshGeometryId, geometries.GetDataPtr (meshGeometryId),
+		meshMaterialsId, materials.GetDataPtr (meshMaterialsId),
+		transformation
+	));
+	shard.meshRefs.insert ({ meshId, meshRef });
+	version++;
+	return meshId;
+}
+
+void Model::SetMeshUserData (MeshId meshId, const std::string& key, const UserDataConstPtr& data)
+{
+	MeshRefShard& shard = GetMeshRefShard (meshId);
+	std::lock_guard<std::mutex> lock (shard.mutex);
+	MeshRefConstPtr& meshRef = shard.meshRefs.at (meshId);
+	std::shared_ptr<MeshRef> modifiedMeshRef (new MeshRef (*meshRef));
+	modifiedMeshRef->SetUserData (key, data);
+	meshRef = modifiedMeshRef;
+	version++;
+}
+
+void Model::RemoveMesh (MeshId meshId)
+{
+	MeshRefShard& shard = GetMeshRefShard (meshId);
+	std::lock_guard<std::mutex> lock (shard.mutex);
+	MeshRefConstPtr meshRef = shard.meshRefs.at (meshId);
+	shard.meshRefs.erase (meshId);
+	geometries.RemoveReference (meshRef->GetGeometryId ());
+	materials.RemoveReference (meshRef->GetMaterialsId ());
+	version++;
+}
+
+void Model::Clear ()
+{
+	std::vector<std::unique_lock<std::mutex>> locks;
+	for (MeshRefShard& shard : meshRefShards) {
+		locks.push_back (std::unique_lock<std::mutex> (shard.mutex));
+	}
+	for (MeshRefShard& shard : meshRefShards) {
+		shard.meshRefs.clear ();
+	}
+	geometries.Clear ();
+	materials.Clear ();
+	version++;
+}
+
+unsigned int Model::GetVersion () const
+{
+	return version;
+}
+
+ModelSnapshotConstPtr Model::GetSnapshot () const
+{
+	std::lock_guard<std::mutex> lock (snapshotMutex);
+	if (snapshot == nullptr || snapshot->GetVersion () != version) {
+		unsigned int collectedVersion = 0;
+		std::vector<std::pair<MeshId, MeshRefConstPtr>> meshRefs = CollectMeshRefs (collectedVersion);
+		snapshot.reset (new ModelSnapshot (collectedVersion, std::move (meshRefs)));
+	}
+	return snapshot;
+}
+
+Model::MeshRefShard& Model::GetMeshRefShard (MeshId meshId)
+{
+	return meshRefShards[(size_t) meshId % ShardCount];
+}
+
+const Model::MeshRefShard& Model::GetMeshRefShard (MeshId meshId) const
+{
+	return meshRefShards[(size_t) meshId % ShardCount];
+}
+
+std::vector<std::pair<MeshId, MeshRefConstPtr>> Model::CollectMeshRefs (unsigned int& collectedVersion) const
+{
+	std::vector<std::unique_lock<std::mutex>> locks;
+	for (const MeshRefShard& shard : meshRefShards) {
+		locks.push_back (std::unique_lock<std::mutex> (shard.mutex));
+	}
+	std::vector<std::pair<MeshId, MeshRefConstPtr>> meshRefs;
+	for (const MeshRefShard& shard : meshRefShards) {
+		for (const auto& it : shard.meshRefs) {
+			meshRefs.push_back ({ it.first, it.second });
+		}
+	}
+	collectedVersion = version;
+	locks.clear ();
+	std::sort (meshRefs.begin (), meshRefs.end (), [] (const std::pair<MeshId, MeshRefConstPtr>& a, const std::pair<MeshId, MeshRefConstPtr>& b) {
+		return a.first < b.first;
+	});
+	return meshRefs;
+}
+
 }
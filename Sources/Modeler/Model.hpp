@@ -4,6 +4,7 @@
 #include "Checksum.hpp"
 #include "IncludeGLM.hpp"
 #include "Mesh.hpp"
+#include "MassProperties.hpp"
 #include "UserData.hpp"
 #include "SharedData.hpp"
 #include "BoundingShapes.hpp"
@@ -11,6 +12,9 @@
 #include <vector>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
+#include <atomic>
+#include <array>
 
 namespace Modeler
 {
@@ -22,22 +26,32 @@ using MeshId = int;
 class MeshRef
 {
 public:
-	MeshRef (MeshGeometryId geometryId, MeshMaterialsId& materialsId, const glm::dmat4& transformation);
+	MeshRef (	MeshGeometryId geometryId, const MeshGeometryConstPtr& geometry,
+				MeshMaterialsId materialsId, const MeshMaterialsConstPtr& materials,
+				const glm::dmat4& transformation);
 
-	MeshGeometryId		GetGeometryId () const;
-	MeshMaterialsId		GetMaterialsId () const;
-	const glm::dmat4&	GetTransformation () const;
+	MeshGeometryId					GetGeometryId () const;
+	MeshMaterialsId					GetMaterialsId () const;
+	const MeshGeometry&				GetGeometry () const;
+	const MeshGeometryConstPtr&		GetGeometryPtr () const;
+	const MeshMaterials&			GetMaterials () const;
+	const MeshMaterialsConstPtr&	GetMaterialsPtr () const;
+	const glm::dmat4&				GetTransformation () const;
 
-	void				SetUserData (const std::string& key, const UserDataConstPtr& data);
-	UserDataConstPtr	GetUserData (const std::string& key) const;
+	void							SetUserData (const std::string& key, const UserDataConstPtr& data);
+	UserDataConstPtr				GetUserData (const std::string& key) const;
 
 private:
-	MeshGeometryId		geometryId;
-	MeshMaterialsId		materialsId;
-	glm::dmat4			transformation;
-	UserDataCollection	userData;
+	MeshGeometryId			geometryId;
+	MeshGeometryConstPtr	geometry;
+	MeshMaterialsId			materialsId;
+	MeshMaterialsConstPtr	materials;
+	glm::dmat4				transformation;
+	UserDataCollection		userData;
 };
 
+typedef std::shared_ptr<const MeshRef> MeshRefConstPtr;
+
 class ModelInfo
 {
 public:
@@ -46,40 +60,114 @@ public:
 	unsigned int meshCount = 0;
 	unsigned int vertexCount = 0;
 	unsigned int triangleCount = 0;
+	size_t geometryMemoryUsage = 0;
+	size_t materialsMemoryUsage = 0;
+	size_t meshMemoryUsage = 0;
+};
+
+class ModelView
+{
+public:
+	ModelView ();
+	virtual ~ModelView ();
+
+	const MeshGeometry&			GetMeshGeometry (const MeshRef& meshRef) const;
+	const MeshMaterials&		GetMeshMaterials (const MeshRef& meshRef) const;
+
+	// The shared data of the mesh, so a mesh of another model can refer to it
+	// without copying.
+	MeshGeometryConstPtr		GetMeshGeometryPtr (const MeshRef& meshRef) const;
+	MeshMaterialsConstPtr		GetMeshMaterialsPtr (const MeshRef& meshRef) const;
+
+	virtual MeshRefConstPtr		GetMesh (MeshId meshId) const = 0;
+	virtual void				EnumerateMeshes (const std::function<void (MeshId, const MeshRef&)>& processor) const = 0;
+
+	// The mesh references can be kept after the enumeration, they remain valid
+	// even if the meshes are removed from the model.
+	virtual void				EnumerateMeshRefs (const std::function<void (MeshId, const MeshRefConstPtr&)>& processor) const = 0;
+
+	ModelInfo					GetInfo () const;
+	size_t						CalcMemoryUsage () const;
+	MassProperties				CalcMassProperties () const;
+	Geometry::BoundingBox		GetBoundingBox () const;
+	Geometry::BoundingSphere	GetBoundingSphere () const;
+};
+
+// An immutable view of the model at a given version. Mesh references and
+// mesh data are shared with the model and with other snapshots, and they
+// are released when the last snapshot referring to them is destroyed.
+class ModelSnapshot : public ModelView
+{
+public:
+	ModelSnapshot (unsigned int version, std::vector<std::pair<MeshId, MeshRefConstPtr>>&& meshRefs);
+	virtual ~ModelSnapshot ();
+
+	unsigned int				GetVersion () const;
+	bool						ContainsMesh (MeshId meshId) const;
+
+	virtual MeshRefConstPtr		GetMesh (MeshId meshId) const override;
+	virtual void				EnumerateMeshes (const std::function<void (MeshId, const MeshRef&)>& processor) const override;
+	virtual void				EnumerateMeshRefs (const std::function<void (MeshId, const MeshRefConstPtr&)>& processor) const override;
+
+private:
+	unsigned int										version;
+	std::vector<std::pair<MeshId, MeshRefConstPtr>>		meshRefs;
 };
 
-class Model
+typedef std::shared_ptr<const ModelSnapshot> ModelSnapshotConstPtr;
+
+// Meshes can be added and removed from multiple threads at the same time.
+// Every mesh reference keeps its own geometry and materials alive, so the
+// references passed to EnumerateMeshes remain valid even if the mesh is
+// removed by another thread during the enumeration. Readers running parallel
+// with modifications should work on a snapshot of the model. Mesh ids are
+// never reused, not even after clearing the model.
+class Model : public ModelView
 {
 public:
 	Model ();
 	Model (const Model& rhs) = delete;
 	Model (Model&& rhs) = delete;
+	virtual ~Model ();
 	
 	Model&						operator= (const Model& rhs) = delete;
 	Model&						operator= (Model&& rhs) = delete;
 
-	const MeshGeometry&			GetMeshGeometry (const MeshRef& meshRef) const;
-	const MeshMaterials&		GetMeshMaterials (const MeshRef& meshRef) const;
-
-	const MeshRef&				GetMesh (MeshId meshId) const;
-	void						EnumerateMeshes (const std::function<void (MeshId, const MeshRef&)>& processor) const;
+	virtual MeshRefConstPtr		GetMesh (MeshId meshId) const override;
+	virtual void				EnumerateMeshes (const std::function<void (MeshId, const MeshRef&)>& processor) const override;
+	virtual void				EnumerateMeshRefs (const std::function<void (MeshId, const MeshRefConstPtr&)>& processor) const override;
 
 	MeshId						AddMesh (const Mesh& mesh);
 	void						SetMeshUserData (MeshId meshId, const std::string& key, const UserDataConstPtr& data);
 	void						RemoveMesh (MeshId meshId);
 	void						Clear ();
 
-	ModelInfo					GetInfo () const;
-	Geometry::BoundingBox		GetBoundingBox () const;
-	Geometry::BoundingSphere	GetBoundingSphere () const;
+	unsigned int				GetVersion () const;
+	ModelSnapshotConstPtr		GetSnapshot () const;
 
 private:
+	static const size_t ShardCount = 16;
+
+	class MeshRefShard
+	{
+	public:
+		mutable std::mutex								mutex;
+		std::unordered_map<MeshId, MeshRefConstPtr>		meshRefs;
+	};
+
+	MeshRefShard&								GetMeshRefShard (MeshId meshId);
+	const MeshRefShard&							GetMeshRefShard (MeshId meshId) const;
+	std::vector<std::pair<MeshId, MeshRefConstPtr>>	CollectMeshRefs (unsigned int& collectedVersion) const;
+
 	SharedData<MeshGeometryId, MeshGeometry>	geometries;
 	SharedData<MeshMaterialsId, MeshMaterials>	materials;
-	std::unordered_map<MeshId, MeshRef>			meshRefs;
+	std::array<MeshRefShard, ShardCount>		meshRefShards;
+
+	std::atomic<MeshId>							nextMeshId;
+	std::atomic<unsigned int>					version;
 
-	MeshId		nextMeshId;
-	MaterialId	nextMaterialId;
+	mutable std::mutex							snapshotMutex;
+	mutable ModelSnapshotConstPtr				snapshot;
 };
 
 }
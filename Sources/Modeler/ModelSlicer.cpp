@@ -0,0 +1,256 @@
+#include "ModelSlicer.hpp"
+#include "ParallelTasks.hpp"
+#include "Geometry.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Modeler
+{
+
+class SliceMesh
+{
+public:
+	SliceMesh (const MeshGeometryConstPtr& geometry) :
+		geometry (geometry),
+		vertices (),
+		heights ()
+	{
+	}
+
+	MeshGeometryConstPtr		geometry;
+	std::vector<glm::dvec3>		vertices;
+	std::vector<double>			heights;
+};
+
+class SliceTriangle
+{
+public:
+	SliceTriangle (unsigned int meshIndex, unsigned int triangleIndex) :
+		meshIndex (meshIndex),
+		triangleIndex (triangleIndex)
+	{
+	}
+
+	unsigned int	meshIndex;
+	unsigned int	triangleIndex;
+};
+
+class SliceSegment
+{
+public:
+	SliceSegment () :
+		startKey (0),
+		endKey (0),
+		start (),
+		end ()
+	{
+	}
+
+	uint64_t		startKey;
+	uint64_t		endKey;
+	glm::dvec3		start;
+	glm::dvec3		end;
+};
+
+static uint64_t GetEdgeKey (unsigned int v1, unsigned int v2)
+{
+	if (v1 > v2) {
+		std::swap (v1, v2);
+	}
+	return ((uint64_t) v1 << 32) | (uint64_t) v2;
+}
+
+static bool IsSamePoint (const glm::dvec3& a, const glm::dvec3& b)
+{
+	return Geometry::IsZero (glm::distance (a, b));
+}
+
+static bool CutTriangle (const SliceMesh& mesh, const MeshTriangle& triangle, double offset, SliceSegment& segment)
+{
+	// the segment starts where the boundary of the triangle goes from above
+	// to below the plane, so the solid is on the left side of the segment
+	const unsigned int vertices[3] = { triangle.v1, triangle.v2, triangle.v3 };
+	bool startFound = false;
+	bool endFound = false;
+	for (size_t i = 0; i < 3; i++) {
+		unsigned int v1 = vertices[i];
+		unsigned int v2 = vertices[(i + 1) % 3];
+		double h1 = mesh.heights[v1] - offset;
+		double h2 = mesh.heights[v2] - offset;
+		bool isAbove1 = h1 >= 0.0;
+		bool isAbove2 = h2 >= 0.0;
+		if (isAbove1 == isAbove2) {
+			continue;
+		}
+		glm::dvec3 point = mesh.vertices[v1] + (mesh.vertices[v2] - mesh.vertices[v1]) * (h1 / (h1 - h2));
+		if (isAbove1) {
+			segment.startKey = GetEdgeKey (v1, v2);
+			segment.start = point;
+			startFound = true;
+		} else {
+			segment.endKey = GetEdgeKey (v1, v2);
+			segment.end = point;
+			endFound = true;
+		}
+	}
+	return startFound && endFound;
+}
+
+static void AddPolylineVertex (SlicePolyline& polyline, const glm::dvec3& vertex)
+{
+	if (!polyline.vertices.empty () && IsSamePoint (polyline.vertices.back (), vertex)) {
+		return;
+	}
+	polyline.vertices.push_back (vertex);
+}
+
+static void ConnectSegments (const std::vector<SliceSegment>& segments, std::vector<SlicePolyline>& polylines)
+{
+	std::unordered_map<uint64_t, size_t> segmentByStartKey;
+	std::unordered_set<uint64_t> endKeys;
+	segmentByStartKey.reserve (segments.size ());
+	endKeys.reserve (segments.size ());
+	for (size_t i = 0; i < segments.size (); i++) {
+		segmentByStartKey.insert ({ segments[i].startKey, i });
+		endKeys.insert (segments[i].endKey);
+	}
+
+	std::vector<bool> visited (segments.size (), false);
+	auto CreatePolyline = [&] (size_t firstSegment) {
+		SlicePolyline polyline;
+		size_t current = firstSegment;
+		while (true) {
+			visited[current] = true;
+			AddPolylineVertex (polyline, segments[current].start);
+			auto found = segmentByStartKey.find (segments[current].endKey);
+			if (found != segmentByStartKey.end () && found->second == firstSegment) {
+				polyline.isClosed = true;
+				break;
+			}
+			if (found == segmentByStartKey.end () || visited[found->second]) {
+				AddPolylineVertex (polyline, segments[current].end);
+				break;
+			}
+			current = found->second;
+		}
+		if (polyline.isClosed && polyline.vertices.size () > 1 && IsSamePoint (polyline.vertices.front (), polyline.vertices.back ())) {
+			polyline.vertices.pop_back ();
+		}
+		if (polyline.vertices.size () > 1) {
+			polylines.push_back (polyline);
+		}
+	};
+
+	// open polylines are started from their first segment, the rest are loops
+	for (size_t i = 0; i < segments.size (); i++) {
+		if (!visited[i] && endKeys.find (segments[i].startKey) == endKeys.end ()) {
+			CreatePolyline (i);
+		}
+	}
+	for (size_t i = 0; i < segments.size (); i++) {
+		if (!visited[i]) {
+			CreatePolyline (i);
+		}
+	}
+}
+
+SlicePolyline::SlicePolyline () :
+	vertices (),
+	isClosed (false)
+{
+}
+
+ModelSlice::ModelSlice (double offset) :
+	offset (offset),
+	polylines ()
+{
+}
+
+std::vector<ModelSlice> SliceModel (const ModelView& model, const glm::dvec3& normal, const std::vector<double>& offsets)
+{
+	std::vector<ModelSlice> slices;
+	for (double offset : offsets) {
+		slices.push_back (ModelSlice (offset));
+	}
+	if (offsets.empty () || Geometry::IsZero (glm::length (normal))) {
+		return slices;
+	}
+
+	std::vector<size_t> sliceOrder (offsets.size ());
+	for (size_t i = 0; i < offsets.size (); i++) {
+		sliceOrder[i] = i;
+	}
+	std::sort (sliceOrder.begin (), sliceOrder.end (), [&] (size_t a, size_t b) {
+		return offsets[a] < offsets[b];
+	});
+	std::vector<double> sortedOffsets (offsets.size ());
+	for (size_t i = 0; i < sliceOrder.size (); i++) {
+		sortedOffsets[i] = offsets[sliceOrder[i]];
+	}
+
+	// a triangle is cut by the planes with offsets in the (min, max] range of
+	// its vertex heights, so every triangle is assigned to its planes by two
+	// binary searches in the sorted offsets
+	glm::dvec3 unitNormal = glm::normalize (normal);
+	std::vector<std::unique_ptr<SliceMesh>> meshes;
+	std::vector<std::vector<SliceTriangle>> sliceTriangles (offsets.size ());
+	model.EnumerateMeshRefs ([&] (MeshId, const MeshRefConstPtr& meshRef) {
+		const MeshGeometry& geometry = model.GetMeshGeometry (*meshRef);
+		const glm::dmat4& transformation = meshRef->GetTransformation ();
+		std::unique_ptr<SliceMesh> mesh (new SliceMesh (meshRef->GetGeometryPtr ()));
+		mesh->vertices.reserve (geometry.VertexCount ());
+		mesh->heights.reserve (geometry.VertexCount ());
+		geometry.EnumerateVertices (transformation, [&] (const glm::dvec3& vertex) {
+			mesh->vertices.push_back (vertex);
+			mesh->heights.push_back (glm::dot (unitNormal, vertex));
+		});
+
+		unsigned int meshIndex = (unsigned int) meshes.size ();
+		for (unsigned int triangleIndex = 0; triangleIndex < geometry.TriangleCount (); triangleIndex++) {
+			const MeshTriangle& triangle = geometry.GetTriangle (triangleIndex);
+			double h1 = mesh->heights[triangle.v1];
+			double h2 = mesh->heights[triangle.v2];
+			double h3 = mesh->heights[triangle.v3];
+			double minHeight = std::min (std::min (h1, h2), h3);
+			double maxHeight = std::max (std::max (h1, h2), h3);
+			auto first = std::upper_bound (sortedOffsets.begin (), sortedOffsets.end (), minHeight);
+			auto last = std::upper_bound (first, sortedOffsets.end (), maxHeight);
+			for (auto it = first; it != last; ++it) {
+				sliceTriangles[it - sortedOffsets.begin ()].push_back (SliceTriangle (meshIndex, triangleIndex));
+			}
+		}
+		meshes.push_back (std::move (mesh));
+	});
+
+	RunParallelTasks (sortedOffsets.size (), 0, [&] (size_t sortedIndex) {
+		const std::vector<SliceTriangle>& triangles = sliceTriangles[sortedIndex];
+		ModelSlice& slice = slices[sliceOrder[sortedIndex]];
+		double offset = sortedOffsets[sortedIndex];
+
+		// triangles are grouped by mesh, and segments of different meshes are never connected
+		std::vector<SliceSegment> segments;
+		size_t first = 0;
+		while (first < triangles.size ()) {
+			unsigned int meshIndex = triangles[first].meshIndex;
+			const SliceMesh& mesh = *meshes[meshIndex];
+			segments.clear ();
+			size_t current = first;
+			for (; current < triangles.size () && triangles[current].meshIndex == meshIndex; current++) {
+				SliceSegment segment;
+				if (CutTriangle (mesh, mesh.geometry->GetTriangle (triangles[current].triangleIndex), offset, segment)) {
+					segments.push_back (segment);
+				}
+			}
+			ConnectSegments (segments, slice.polylines);
+			first = current;
+		}
+	});
+
+	return slices;
+}
+
+}
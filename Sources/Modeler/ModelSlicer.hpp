@@ -0,0 +1,40 @@
+#ifndef MODELER_MODELSLICER_HPP
+#define MODELER_MODELSLICER_HPP
+
+#include "IncludeGLM.hpp"
+#include "Model.hpp"
+
+#include <vector>
+
+namespace Modeler
+{
+
+class SlicePolyline
+{
+public:
+	SlicePolyline ();
+
+	std::vector<glm::dvec3>		vertices;
+	bool						isClosed;
+};
+
+class ModelSlice
+{
+public:
+	ModelSlice (double offset);
+
+	double						offset;
+	std::vector<SlicePolyline>	polylines;
+};
+
+// Slices the model with parallel planes. The planes are the points where the
+// dot product with the normal equals the offsets. Vertices lying exactly on a
+// plane are handled as if they were above it, so every cut triangle results
+// in exactly one segment. Segments are connected through the mesh edges they
+// cross, so closed meshes result in closed polylines. Polylines of closed
+// meshes are counterclockwise around the solid when viewed from the normal.
+std::vector<ModelSlice>		SliceModel (const ModelView& model, const glm::dvec3& normal, const std::vector<double>& offsets);
+
+}
+
+#endif
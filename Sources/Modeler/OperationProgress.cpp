@@ -0,0 +1,84 @@
+#include "OperationProgress.hpp"
+
+#include <algorithm>
+
+namespace Modeler
+{
+
+OperationProgress::OperationProgress () :
+	OperationProgress (nullptr)
+{
+}
+
+OperationProgress::OperationProgress (const ProgressCallback& callback) :
+	OperationProgress (callback, nullptr)
+{
+}
+
+OperationProgress::OperationProgress (const ProgressCallback& callback, const CancelCheck& cancelCheck) :
+	cancelled (false),
+	progress (0.0),
+	callback (callback),
+	cancelCheck (cancelCheck),
+	parent (nullptr),
+	rangeStart (0.0),
+	rangeEnd (1.0)
+{
+}
+
+OperationProgress::OperationProgress (OperationProgress* parent, double rangeStart, double rangeEnd) :
+	cancelled (false),
+	progress (0.0),
+	callback (nullptr),
+	cancelCheck (nullptr),
+	parent (parent),
+	rangeStart (rangeStart),
+	rangeEnd (rangeEnd)
+{
+}
+
+void OperationProgress::Cancel ()
+{
+	cancelled.store (true);
+}
+
+bool OperationProgress::IsCancelled () const
+{
+	if (cancelled.load ()) {
+		return true;
+	}
+	if (cancelCheck != nullptr && cancelCheck ()) {
+		cancelled.store (true);
+		return true;
+	}
+	return IsOperationCancelled (parent);
+}
+
+void OperationProgress::SetProgress (double newProgress)
+{
+	double clampedProgress = std::min (std::max (newProgress, 0.0), 1.0);
+	progress.store (clampedProgress);
+	if (callback != nullptr) {
+		callback (clampedProgress);
+	}
+	SetOperationProgress (parent, rangeStart + clampedProgress * (rangeEnd - rangeStart));
+}
+
+double OperationProgress::GetProgress () const
+{
+	return progress.load ();
+}
+
+bool IsOperationCancelled (const OperationProgress* progress)
+{
+	return progress != nullptr && progress->IsCancelled ();
+}
+
+void SetOperationProgress (OperationProgress* progress, double newProgress)
+{
+	if (progress != nullptr) {
+		progress->SetProgress (newProgress);
+	}
+}
+
+}
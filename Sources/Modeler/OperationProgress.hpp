@@ -0,0 +1,55 @@
+#ifndef MODELER_OPERATIONPROGRESS_HPP
+#define MODELER_OPERATIONPROGRESS_HPP
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace Modeler
+{
+
+// Shared state of a long running operation. The operation reports its progress
+// between zero and one, and checks regularly if it is cancelled. The caller can
+// poll the progress or get it in a callback, and can cancel the operation from
+// an other thread. The callback is called from the threads of the operation.
+// A sub operation gets a child progress, it reports into a range of its parent
+// and it is cancelled together with its parent. An optional cancel check is
+// polled whenever the operation checks for cancellation, so the caller can
+// cancel an operation running on its own thread, a positive answer is kept.
+class OperationProgress
+{
+public:
+	using ProgressCallback = std::function<void (double)>;
+	using CancelCheck = std::function<bool ()>;
+
+	OperationProgress ();
+	OperationProgress (const ProgressCallback& callback);
+	OperationProgress (const ProgressCallback& callback, const CancelCheck& cancelCheck);
+	OperationProgress (OperationProgress* parent, double rangeStart, double rangeEnd);
+
+	void		Cancel ();
+	bool		IsCancelled () const;
+
+	void		SetProgress (double newProgress);
+	double		GetProgress () const;
+
+private:
+	mutable std::atomic<bool>	cancelled;
+	std::atomic<double>		progress;
+	ProgressCallback		callback;
+	CancelCheck				cancelCheck;
+	OperationProgress*		parent;
+	double					rangeStart;
+	double					rangeEnd;
+};
+
+using OperationProgressPtr = std::shared_ptr<OperationProgress>;
+
+// Operations take the progress as an optional pointer, these functions do
+// nothing without a progress.
+bool	IsOperationCancelled (const OperationProgress* progress);
+void	SetOperationProgress (OperationProgress* progress, double newProgress);
+
+}
+
+#endif
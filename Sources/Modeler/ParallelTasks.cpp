@@ -0,0 +1,129 @@
+#include "ParallelTasks.hpp"
+
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <exception>
+
+namespace Modeler
+{
+
+class TaskRange
+{
+public:
+	TaskRange () :
+		mutex (),
+		begin (0),
+		end (0)
+	{
+	}
+
+	std::mutex	mutex;
+	size_t		begin;
+	size_t		end;
+};
+
+static bool TakeTask (TaskRange& range, size_t& task)
+{
+	std::lock_guard<std::mutex> lock (range.mutex);
+	if (range.begin == range.end) {
+		return false;
+	}
+	task = range.begin++;
+	return true;
+}
+
+static bool StealTasks (std::vector<std::unique_ptr<TaskRange>>& ranges, size_t thief)
+{
+	for (size_t i = 1; i < ranges.size (); i++) {
+		TaskRange& victim = *ranges[(thief + i) % ranges.size ()];
+		size_t stolenBegin = 0;
+		size_t stolenEnd = 0;
+		{
+			std::lock_guard<std::mutex> lock (victim.mutex);
+			if (victim.begin == victim.end) {
+				continue;
+			}
+			stolenBegin = victim.begin + (victim.end - victim.begin) / 2;
+			stolenEnd = victim.end;
+			victim.end = stolenBegin;
+		}
+		TaskRange& own = *ranges[thief];
+		std::lock_guard<std::mutex> lock (own.mutex);
+		own.begin = stolenBegin;
+		own.end = stolenEnd;
+		return true;
+	}
+	return false;
+}
+
+unsigned int GetHardwareThreadCount ()
+{
+	unsigned int threadCount = std::thread::hardware_concurrency ();
+	if (threadCount == 0) {
+		return 1;
+	}
+	return threadCount;
+}
+
+void RunParallelTasks (size_t taskCount, unsigned int threadCount, const std::function<void (size_t)>& task)
+{
+	if (threadCount == 0) {
+		threadCount = GetHardwareThreadCount ();
+	}
+	if (threadCount > taskCount) {
+		threadCount = (unsigned int) taskCount;
+	}
+	if (threadCount <= 1) {
+		for (size_t i = 0; i < taskCount; i++) {
+			task (i);
+		}
+		return;
+	}
+
+	std::vector<std::unique_ptr<TaskRange>> ranges;
+	for (unsigned int i = 0; i < threadCount; i++) {
+		std::unique_ptr<TaskRange> range (new TaskRange ());
+		range->begin = taskCount * i / threadCount;
+		range->end = taskCount * (i + 1) / threadCount;
+		ranges.push_back (std::move (range));
+	}
+
+	std::atomic<bool> failed (false);
+	std::mutex exceptionMutex;
+	std::exception_ptr exception = nullptr;
+	auto worker = [&] (size_t threadIndex) {
+		try {
+			size_t taskIndex = 0;
+			while (!failed) {
+				if (TakeTask (*ranges[threadIndex], taskIndex)) {
+					task (taskIndex);
+				} else if (!StealTasks (ranges, threadIndex)) {
+					break;
+				}
+			}
+		} catch (...) {
+			std::lock_guard<std::mutex> lock (exceptionMutex);
+			if (exception == nullptr) {
+				exception = std::current_exception ();
+			}
+			failed = true;
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (unsigned int i = 1; i < threadCount; i++) {
+		threads.push_back (std::thread (worker, i));
+	}
+	worker (0);
+	for (std::thread& thread : threads) {
+		thread.join ();
+	}
+	if (exception != nullptr) {
+		std::rethrow_exception (exception);
+	}
+}
+
+}
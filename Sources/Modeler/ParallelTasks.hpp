@@ -0,0 +1,22 @@
+#ifndef MODELER_PARALLELTASKS_HPP
+#define MODELER_PARALLELTASKS_HPP
+
+#include <functional>
+#include <cstddef>
+
+namespace Modeler
+{
+
+unsigned int	GetHardwareThreadCount ();
+
+// Runs the tasks with the given index range on multiple threads. Every thread
+// starts with a contiguous range of tasks, and a thread running out of work
+// steals the second half of the remaining range of another thread. If a task
+// throws, the threads stop taking new tasks, and after every thread finished
+// the first exception is rethrown on the calling thread. With a thread count
+// of zero every hardware thread is used.
+void			RunParallelTasks (size_t taskCount, unsigned int threadCount, const std::function<void (size_t)>& task);
+
+}
+
+#endif
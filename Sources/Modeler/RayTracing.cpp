@@ -28,7 +28,7 @@ Geometry::Ray GetScreenRay (const Camera& camera, const glm::dvec2& screenSize,
 	return Geometry::Ray (camera.GetEye (), rayDirection);
 }
 
-std::vector<RayModelIntersection> GetRayModelRayIntersections (const Model& model, const Geometry::Ray& ray)
+std::vector<RayModelIntersection> GetRayModelRayIntersections (const ModelView& model, const Geometry::Ray& ray)
 {
 	std::vector<RayModelIntersection> intersections;
 	model.EnumerateMeshes ([&] (MeshId meshId, const MeshRef& meshRef) {
@@ -21,7 +21,7 @@ public:
 };
 
 Geometry::Ray						GetScreenRay (const Camera& camera, const glm::dvec2& screenSize, const glm::dvec2& screenPos);
-std::vector<RayModelIntersection>	GetRayModelRayIntersections (const Model& model, const Geometry::Ray& ray);
+std::vector<RayModelIntersection>	GetRayModelRayIntersections (const ModelView& model, const Geometry::Ray& ray);
 
 }
 
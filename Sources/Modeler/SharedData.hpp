@@ -4,74 +4,137 @@
 #include "Checksum.hpp"
 
 #include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <array>
 
 namespace Modeler
 {
 
+// Data is distributed into shards by checksum, and every shard has its own lock,
+// so references can be added and removed from multiple threads at the same time.
+// Ids encode the shard index, so an id lookup touches only one shard. Data is
+// returned by shared pointer, so it stays valid after its entry is removed.
+// Ids are never reused, not even after clearing.
 template <typename IdType, typename DataType>
 class SharedData
 {
 public:
-	SharedData () :
-		nextDataId (0)
-	{
+	using DataConstPtr = std::shared_ptr<const DataType>;
 
+	SharedData ()
+	{
 	}
 
-	const DataType& GetData (IdType id) const
+	SharedData (const SharedData& rhs) = delete;
+	SharedData& operator= (const SharedData& rhs) = delete;
+
+	DataConstPtr GetDataPtr (IdType id) const
 	{
-		return idToData.at (id);
+		const Shard& shard = GetShardOfId (id);
+		std::lock_guard<std::mutex> lock (shard.mutex);
+		return shard.idToData.at (id).data;
 	}
 
 	size_t DataCount () const
 	{
-		return idToData.size ();
+		size_t count = 0;
+		for (const Shard& shard : shards) {
+			std::lock_guard<std::mutex> lock (shard.mutex);
+			count += shard.idToData.size ();
+		}
+		return count;
 	}
 
-	IdType AddReference (const DataType& data, const Checksum& checksum)
+	IdType AddReference (const DataConstPtr& data, const Checksum& checksum)
 	{
+		size_t shardIndex = std::hash<Checksum> () (checksum) % ShardCount;
+		Shard& shard = shards[shardIndex];
+		std::lock_guard<std::mutex> lock (shard.mutex);
+
 		IdType id = -1;
-		auto foundData = checkSumToId.find (checksum);
-		if (foundData == checkSumToId.end ()) {
-			id = nextDataId++;
-			idToData.insert ({ id, data });
-			dataRefCount.insert ({ id, 1 });
-			checkSumToId.insert ({ checksum, id });
-			idToChecksum.insert ({ id, checksum });
+		auto foundData = shard.checkSumToId.find (checksum);
+		if (foundData == shard.checkSumToId.end ()) {
+			id = (IdType) (shard.nextIndex++ * ShardCount + shardIndex);
+			shard.idToData.insert ({ id, DataEntry (data, checksum) });
+			shard.checkSumToId.insert ({ checksum, id });
 		} else {
 			id = foundData->second;
-			dataRefCount[id] += 1;
+			shard.idToData.at (id).refCount += 1;
 		}
 		return id;
 	}
 
 	void RemoveReference (IdType id)
 	{
-		dataRefCount[id] -= 1;
-		if (dataRefCount[id] == 0) {
-			idToData.erase (id);
-			dataRefCount.erase (id);
-			checkSumToId.erase (idToChecksum.at (id));
-			idToChecksum.erase (id);
+		Shard& shard = GetShardOfId (id);
+		std::lock_guard<std::mutex> lock (shard.mutex);
+
+		DataEntry& entry = shard.idToData.at (id);
+		entry.refCount -= 1;
+		if (entry.refCount == 0) {
+			shard.checkSumToId.erase (entry.checksum);
+			shard.idToData.erase (id);
 		}
 	}
 
 	void Clear ()
 	{
-		idToData.clear ();
-		dataRefCount.clear ();
-		checkSumToId.clear ();
-		idToChecksum.clear ();
-		nextDataId = 0;
+		for (Shard& shard : shards) {
+			std::lock_guard<std::mutex> lock (shard.mutex);
+			shard.idToData.clear ();
+			shard.checkSumToId.clear ();
+		}
 	}
 
 private:
-	std::unordered_map<IdType, DataType>	idToData;
-	std::unordered_map<IdType, int>			dataRefCount;
-	std::unordered_map<Checksum, IdType>	checkSumToId;
-	std::unordered_map<IdType, Checksum>	idToChecksum;
+	static const size_t ShardCount = 16;
+
+	class DataEntry
+	{
+	public:
+		DataEntry (const DataConstPtr& data, const Checksum& checksum) :
+			data (data),
+			checksum (checksum),
+			refCount (1)
+		{
+
+		}
+
+		DataConstPtr	data;
+		Checksum		checksum;
+		int				refCount;
+	};
+
+	class Shard
+	{
+	public:
+		Shard () :
+			mutex (),
+			idToData (),
+			checkSumToId (),
+			nextIndex (0)
+		{
+
+		}
+
+		mutable std::mutex							mutex;
+		std::unordered_map<IdType, DataEntry>		idToData;
+		std::unordered_map<Checksum, IdType>		checkSumToId;
+		size_t										nextIndex;
+	};
+
+	const Shard& GetShardOfId (IdType id) const
+	{
+		return shards[(size_t) id % ShardCount];
+	}
+
+	Shard& GetShardOfId (IdType id)
+	{
+		return shards[(size_t) id % ShardCount];
+	}
 
-	IdType									nextDataId;
+	std::array<Shard, ShardCount>	shards;
 };
 
 }
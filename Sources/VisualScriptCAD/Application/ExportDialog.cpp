@@ -131,7 +131,7 @@ BEGIN_EVENT_TABLE (ImageSettingsDialog, wxDialog)
 EVT_BUTTON (wxID_ANY, ImageSettingsDialog::OnButtonClick)
 END_EVENT_TABLE ()
 
-ExportDialog::ExportDialog (wxWindow* parent, const Modeler::Model& model, const RenderScene& scene, const ExportSettings& exportSettings) :
+ExportDialog::ExportDialog (wxWindow* parent, const Modeler::ModelView& model, const RenderScene& scene, const ExportSettings& exportSettings) :
 	wxDialog (parent, wxID_ANY, L"Export Model", wxDefaultPosition, wxDefaultSize, wxDEFAULT_DIALOG_STYLE),
 	model (model),
 	scene (scene),
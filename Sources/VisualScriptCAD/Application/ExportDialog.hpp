@@ -19,7 +19,7 @@ public:
 		ExportButtonId = 1100
 	};
 
-	ExportDialog (wxWindow* parent, const Modeler::Model& model, const RenderScene& scene, const ExportSettings& exportSettings);
+	ExportDialog (wxWindow* parent, const Modeler::ModelView& model, const RenderScene& scene, const ExportSettings& exportSettings);
 
 	const ExportSettings&	GetExportSettings () const;
 	void					OnChoice (wxCommandEvent& evt);
@@ -28,7 +28,7 @@ public:
 private:
 	void					UpdateControls ();
 
-	const Modeler::Model&	model;
+	const Modeler::ModelView&	model;
 	const RenderScene&		scene;
 	ExportSettings			exportSettings;
 
@@ -13,6 +13,8 @@
 #include "VersionInfo.hpp"
 #include "ApplicationHeaderIO.hpp"
 #include "XMLUtilities.hpp"
+#include "MemoryUsage.hpp"
+#include "PreviewBooleanShape.hpp"
 
 #include "VisualScriptLogicMain.hpp"
 #include "ExpressionEditor.hpp"
@@ -20,8 +22,11 @@
 
 #include <wx/filename.h>
 #include <wx/stdpaths.h>
+#include <wx/progdlg.h>
 #include <locale>
 #include <codecvt>
+#include <future>
+#include <chrono>
 
 static const std::vector<std::pair<std::wstring, std::wstring>> exampleFiles = {
 	{ L"Simple Box", L"simple_box.vsc" },
@@ -95,6 +100,7 @@ void EditorModelBridge::UpdateModel ()
 		return;
 	}
 
+	modelControl->SetModelSnapshot (evalData->GetModel ().GetSnapshot ());
 	for (Modeler::MeshId meshId : evalData->GetDeletedMeshes ()) {
 		modelControl->RemoveMesh (meshId);
 	}
@@ -170,6 +176,8 @@ MenuBar::MenuBar () :
 	wxMenu* modelMenu = new wxMenu ();
 	modelMenu->Append (CommandId::Model_Info, "Information...");
 	modelMenu->Append (CommandId::Model_Export, "Export...");
+	modelMenu->AppendSeparator ();
+	modelMenu->AppendCheckItem (CommandId::Model_PreviewBooleans, "Preview Booleans");
 	Append (modelMenu, L"&Model");
 
 	wxMenu* aboutMenu = new wxMenu ();
@@ -466,26 +474,87 @@ void MainWindow::ProcessCommand (CommandId commandId)
 			break;
 		case Model_Info:
 			{
-				const Modeler::Model& model = evaluationData->GetModel ();
-				Modeler::ModelInfo modelInfo = model.GetInfo ();
+				Modeler::ModelSnapshotConstPtr modelSnapshot = evaluationData->GetModel ().GetSnapshot ();
+				Modeler::ModelInfo modelInfo = modelSnapshot->GetInfo ();
+				Modeler::MassProperties massProperties = modelSnapshot->CalcMassProperties ();
 				std::wstring modelInfoText = L"";
 				modelInfoText += L"Mesh geometry count: " + std::to_wstring (modelInfo.meshGeometryCount) + L"\n";
 				modelInfoText += L"Mesh count: " + std::to_wstring (modelInfo.meshCount) + L"\n";
 				modelInfoText += L"Vertex count: " + std::to_wstring (modelInfo.vertexCount) + L"\n";
 				modelInfoText += L"Triangle count: " + std::to_wstring (modelInfo.triangleCount) + L"\n";
+				modelInfoText += L"\n";
+				glm::dvec3 centroid = massProperties.GetCentroid ();
+				modelInfoText += L"Surface area: " + std::to_wstring (massProperties.area) + L"\n";
+				modelInfoText += L"Volume: " + std::to_wstring (massProperties.volume) + L"\n";
+				modelInfoText += L"Centroid: " + std::to_wstring (centroid.x) + L", " + std::to_wstring (centroid.y) + L", " + std::to_wstring (centroid.z) + L"\n";
+				modelInfoText += L"\n";
+				modelInfoText += L"Geometry memory: " + Modeler::FormatMemorySize (modelInfo.geometryMemoryUsage) + L"\n";
+				modelInfoText += L"Material memory: " + Modeler::FormatMemorySize (modelInfo.materialsMemoryUsage) + L"\n";
+				modelInfoText += L"Mesh memory: " + Modeler::FormatMemorySize (modelInfo.meshMemoryUsage) + L"\n";
+				modelInfoText += L"Render memory: " + Modeler::FormatMemorySize (modelControl->GetRenderScene ().GetModel ().CalcMemoryUsage ()) + L"\n";
+				if (Modeler::IsMemoryTrackingEnabled ()) {
+					modelInfoText += L"\n";
+					for (int i = 0; i < Modeler::MemorySubsystemCount; i++) {
+						Modeler::MemorySubsystem subsystem = (Modeler::MemorySubsystem) i;
+						modelInfoText += Modeler::GetMemorySubsystemName (subsystem) + L" memory (tracked): " + Modeler::FormatMemorySize (Modeler::GetTrackedMemory (subsystem)) + L"\n";
+					}
+				}
 				InfoDialog modelInfoDialog (this, L"Model Information", modelInfoText);
 				modelInfoDialog.ShowModal ();
 			}
 			break;
 		case Model_Export:
 			{
-				const Modeler::Model& model = evaluationData->GetModel ();
-				ExportDialog modelExportDialog (this, model, modelControl->GetRenderScene (), userSettings.exportSettings);
+				Modeler::ModelSnapshotConstPtr modelSnapshot = evaluationData->GetModel ().GetSnapshot ();
+				Modeler::Model exactModel;
+				Modeler::OperationProgress progress;
+				std::future<bool> exactResult = std::async (std::launch::async, [&] () {
+					return CreateExactModel (*modelSnapshot, exactModel, &progress);
+				});
+				{
+					wxProgressDialog progressDialog (L"Export", L"Calculating boolean operations...", 100, this, wxPD_APP_MODAL | wxPD_CAN_ABORT | wxPD_AUTO_HIDE);
+					while (exactResult.wait_for (std::chrono::milliseconds (50)) != std::future_status::ready) {
+						if (!progressDialog.Update ((int) (progress.GetProgress () * 100.0))) {
+							progress.Cancel ();
+						}
+					}
+				}
+				// the future rethrows the exception of the calculation, it must not
+				// leave the event handler
+				bool exactSucceeded = false;
+				try {
+					exactSucceeded = exactResult.get ();
+				} catch (...) {
+					wxMessageDialog messageDialog (this, L"Failed to calculate the exact model.", L"Error!", wxICON_ERROR | wxOK);
+					messageDialog.ShowModal ();
+					break;
+				}
+				if (progress.IsCancelled ()) {
+					break;
+				}
+				if (!exactSucceeded) {
+					wxMessageDialog messageDialog (this, L"Failed to calculate some boolean operations exactly.\nThe preview result will be exported for them.", L"Warning", wxICON_WARNING | wxOK);
+					messageDialog.ShowModal ();
+				}
+				ExportDialog modelExportDialog (this, exactModel, modelControl->GetRenderScene (), userSettings.exportSettings);
 				if (modelExportDialog.ShowModal () == wxID_OK) {
 					userSettings.exportSettings = modelExportDialog.GetExportSettings ();
 				}
 			}
 			break;
+		case Model_PreviewBooleans:
+			{
+				if (evaluationData->GetBooleanMode () == BooleanMode::Preview) {
+					evaluationData->SetBooleanMode (BooleanMode::Exact);
+				} else {
+					evaluationData->SetBooleanMode (BooleanMode::Preview);
+				}
+				// the cached values of the boolean nodes belong to the previous mode,
+				// invalidating them invalidates every node depending on them
+				editor->InvalidateAllNodes ();
+				editor->ManualUpdate ();
+			}
+			break;
 		case About_GitHub:
 			{
 				wxLaunchDefaultBrowser ("https://github.com/kovacsv/VisualScriptCAD");
@@ -570,6 +639,7 @@ void MainWindow::UpdateMenuBar ()
 {
 	WXAS::NodeEditorControl* editor = nodeEditorControl->GetEditor ();
  	menuBar->UpdateStatus (userSettings);
+	menuBar->Check (CommandId::Model_PreviewBooleans, evaluationData->GetBooleanMode () == BooleanMode::Preview);
 	toolBar->UpdateStatus (splitViewMode, editor->GetUpdateMode ());
 }
 
@@ -33,6 +33,7 @@ enum CommandId
 	Tool_Mode_Automatic			= 21,
 	Tool_Mode_Manual			= 22,
 	Tool_Mode_Update			= 23,
+	Model_PreviewBooleans		= 24,
 	File_OpenExample_First		= 100,
 	File_OpenRecent_First		= 200
 };
@@ -5,11 +5,43 @@
 
 #include "ModelEvaluationData.hpp"
 
+#include <wx/thread.h>
+
+#include <chrono>
+
 ModelUpdater::~ModelUpdater ()
 {
 
 }
 
+// Operations check for cancellation very often, and from their worker threads
+// too, so the key state is queried only on the main thread, and only after
+// some time passed since the previous query.
+class EscapeKeyCheck
+{
+public:
+	EscapeKeyCheck () :
+		lastCheck ()
+	{
+	}
+
+	bool operator() ()
+	{
+		if (!wxIsMainThread ()) {
+			return false;
+		}
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now ();
+		if (now - lastCheck < std::chrono::milliseconds (20)) {
+			return false;
+		}
+		lastCheck = now;
+		return wxGetKeyState (WXK_ESCAPE);
+	}
+
+private:
+	std::chrono::steady_clock::time_point lastCheck;
+};
+
 class NodeEditorUIEnvironment : public WXAS::NodeEditorUIEnvironment
 {
 public:
@@ -18,19 +50,44 @@ public:
 								std::shared_ptr<NUIE::SkinParams> skinParams,
 								std::shared_ptr<NUIE::EventHandlers> eventHandlers,
 								NE::EvaluationEnv& evaluationEnv,
+								const std::shared_ptr<ModelEvaluationData>& evalData,
 								ModelUpdater& modelUpdater) :
 		WXAS::NodeEditorUIEnvironment (nodeEditorControl, stringSettings, skinParams, eventHandlers, evaluationEnv),
+		evalData (evalData),
 		modelUpdater (modelUpdater)
 	{
 	}
 
+	// Every evaluation gets its own progress, so a new evaluation cancels the
+	// operations of the previous one. The evaluation blocks the main thread, so
+	// key events are not processed during it. Pressing escape is polled instead
+	// whenever a long operation checks for cancellation, and the progress keeps
+	// the cancellation once the key was seen.
+	virtual void OnEvaluationBegin () override
+	{
+		WXAS::NodeEditorUIEnvironment::OnEvaluationBegin ();
+		if (evalData == nullptr) {
+			return;
+		}
+		evalData->SetOperationProgress (Modeler::OperationProgressPtr (new Modeler::OperationProgress (nullptr, EscapeKeyCheck ())));
+	}
+
+	virtual void OnEvaluationEnd () override
+	{
+		if (evalData != nullptr) {
+			evalData->SetOperationProgress (nullptr);
+		}
+		WXAS::NodeEditorUIEnvironment::OnEvaluationEnd ();
+	}
+
 	virtual void OnValuesRecalculated () override
 	{
 		modelUpdater.UpdateModel ();
 	}
 
 private:
-	ModelUpdater& modelUpdater;
+	std::shared_ptr<ModelEvaluationData>	evalData;
+	ModelUpdater&							modelUpdater;
 };
 
 NodeEditorDropTarget::NodeEditorDropTarget (WXAS::NodeEditorControl* nodeEditorControl) :
@@ -59,7 +116,7 @@ NodeEditorControl::NodeEditorControl (wxWindow *parent, const std::shared_ptr<NE
 			NE::StringSettingsPtr (new NE::BasicStringSettings (NE::GetDefaultStringSettings ())),
 			NUIE::SkinParamsPtr (new NUIE::BasicSkinParams (NUIE::GetDefaultSkinParams ())),
 			NUIE::EventHandlersPtr (new WXAS::NodeEditorEventHandlers (nodeEditorControl)),
-			evalEnv, modelUpdater
+			evalEnv, std::dynamic_pointer_cast<ModelEvaluationData> (evalData), modelUpdater
 		)
 	);
 
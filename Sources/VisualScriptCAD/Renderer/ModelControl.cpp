@@ -26,7 +26,7 @@ SelectionUpdater::~SelectionUpdater ()
 
 ModelControl::ModelControl (wxWindow *parent, const Modeler::Model& model, SelectionUpdater& selectionUpdater) :
 	wxGLCanvas (parent, wxID_ANY, canvasAttributes, wxDefaultPosition, wxDefaultSize, wxFULL_REPAINT_ON_RESIZE),
-	model (model),
+	modelSnapshot (model.GetSnapshot ()),
 	selectionUpdater (selectionUpdater),
 	glContext (nullptr),
 	renderModelConverter (),
@@ -53,9 +53,14 @@ ModelControl::~ModelControl ()
 	}
 }
 
+void ModelControl::SetModelSnapshot (const Modeler::ModelSnapshotConstPtr& newModelSnapshot)
+{
+	modelSnapshot = newModelSnapshot;
+}
+
 void ModelControl::AddMesh (Modeler::MeshId meshId)
 {
-	renderModelConverter.AddMeshToRenderModel (model, meshId, renderScene.GetModel ());
+	renderModelConverter.AddMeshToRenderModel (*modelSnapshot, meshId, renderScene.GetModel ());
 	Refresh ();
 }
 
@@ -76,7 +81,7 @@ void ModelControl::FitToWindow ()
 {
 	WXAS::BusyCursorGuard busyCursor;
 	wxSize clientSize = GetClientSize ();
-	Geometry::BoundingSphere boundingSphere = model.GetBoundingSphere ();
+	Geometry::BoundingSphere boundingSphere = modelSnapshot->GetBoundingSphere ();
 	renderScene.FitToWindow (clientSize.x, clientSize.y, boundingSphere);
 	Refresh ();
 }
@@ -201,11 +206,11 @@ void ModelControl::SelectNodeOfMesh (const wxPoint& mousePosition)
 	Geometry::Ray ray = Modeler::GetScreenRay (renderScene.GetCamera (), screenSize, screenPos);
 	
 	NE::NodeCollection nodesToSelect;
-	std::vector<Modeler::RayModelIntersection> intersections = Modeler::GetRayModelRayIntersections (model, ray);
+	std::vector<Modeler::RayModelIntersection> intersections = Modeler::GetRayModelRayIntersections (*modelSnapshot, ray);
 	if (!intersections.empty ()) {
 		const Modeler::RayModelIntersection& firstIntersection = intersections.front ();
-		const Modeler::MeshRef& meshRef = model.GetMesh (firstIntersection.meshId);
-		Modeler::UserDataConstPtr userData = meshRef.GetUserData ("nodeid");
+		Modeler::MeshRefConstPtr meshRef = modelSnapshot->GetMesh (firstIntersection.meshId);
+		Modeler::UserDataConstPtr userData = meshRef->GetUserData ("nodeid");
 		if (userData == nullptr) {
 			throw std::logic_error ("no user data in mesh");
 		}
@@ -26,6 +26,7 @@ public:
 	ModelControl (wxWindow *parent, const Modeler::Model& model, SelectionUpdater& selectionUpdater);
 	virtual ~ModelControl ();
 
+	void							SetModelSnapshot (const Modeler::ModelSnapshotConstPtr& newModelSnapshot);
 	void							AddMesh (Modeler::MeshId meshId);
 	void							RemoveMesh (Modeler::MeshId meshId);
 	void							Clear ();
@@ -53,7 +54,7 @@ private:
 	bool							InitContext ();
 	void							SelectNodeOfMesh (const wxPoint& mousePosition);
 
-	const Modeler::Model&			model;
+	Modeler::ModelSnapshotConstPtr	modelSnapshot;
 	SelectionUpdater&				selectionUpdater;
 
 	wxGLContext*					glContext;
@@ -23,13 +23,13 @@ RenderModelConverter::RenderModelConverter () :
 {
 }
 
-void RenderModelConverter::AddMeshToRenderModel (const Modeler::Model& model, Modeler::MeshId meshId, RenderModel& renderModel)
+void RenderModelConverter::AddMeshToRenderModel (const Modeler::ModelView& model, Modeler::MeshId meshId, RenderModel& renderModel)
 {
-	const Modeler::MeshRef& meshRef = model.GetMesh (meshId);
-	MeshUniqueId meshUniqueId (meshRef.GetGeometryId (), meshRef.GetMaterialsId ());
+	Modeler::MeshRefConstPtr meshRef = model.GetMesh (meshId);
+	MeshUniqueId meshUniqueId (meshRef->GetGeometryId (), meshRef->GetMaterialsId ());
 	if (meshIdToRenderMeshId.find (meshUniqueId) == meshIdToRenderMeshId.end ()) {
 		RenderMesh renderMesh;
-		ConvertMeshRefToRenderMesh (model, meshRef, renderMesh);
+		ConvertMeshRefToRenderMesh (model, *meshRef, renderMesh);
 		renderModel.AddRenderMesh (nextRenderMeshId, renderMesh);
 		meshIdToRenderMeshId.insert ({ meshUniqueId, nextRenderMeshId });
 		renderMeshIdToMeshId.insert ({ nextRenderMeshId, meshUniqueId });
@@ -37,7 +37,7 @@ void RenderModelConverter::AddMeshToRenderModel (const Modeler::Model& model, Mo
 	}
 	RenderMeshId renderMeshId = meshIdToRenderMeshId.at (meshUniqueId);
 	RenderMeshInstanceId instanceId = meshId;
-	renderModel.AddRenderMeshInstance (renderMeshId, instanceId, RenderMeshInstance (glm::mat4 (meshRef.GetTransformation ())));
+	renderModel.AddRenderMeshInstance (renderMeshId, instanceId, RenderMeshInstance (glm::mat4 (meshRef->GetTransformation ())));
 }
 
 void RenderModelConverter::RemoveMeshFromRenderModel (Modeler::MeshId meshId, RenderModel& renderModel)
@@ -57,19 +57,20 @@ void RenderModelConverter::Clear ()
 	renderMeshIdToMeshId.clear ();
 }
 
-void RenderModelConverter::ConvertMeshRefToRenderMesh (const Modeler::Model& model, const Modeler::MeshRef& meshRef, RenderMesh& renderMesh)
+void RenderModelConverter::ConvertMeshRefToRenderMesh (const Modeler::ModelView& model, const Modeler::MeshRef& meshRef, RenderMesh& renderMesh)
 {
 	const Modeler::MeshGeometry& geometry = model.GetMeshGeometry (meshRef);
 	const Modeler::MeshMaterials& materials = model.GetMeshMaterials (meshRef);
 
 	std::unordered_map<Modeler::MaterialId, size_t> materialToRenderGeometry;
-	EnumerateTrianglesByMaterial (geometry, materials, [&] (Modeler::MaterialId materialId, const std::vector<unsigned int>& triangles) {
-		if (materialToRenderGeometry.find (materialId) == materialToRenderGeometry.end ()) {
-			renderMesh.AddRenderGeometry (RenderGeometry (MaterialToRenderMaterial (materials.GetMaterial (materialId))));
-			materialToRenderGeometry.insert ({ materialId, renderMesh.RenderGeometryCount () - 1 });
+	for (unsigned int rangeIndex = 0; rangeIndex < materials.TriangleRangeCount (); rangeIndex++) {
+		const Modeler::TriangleMaterialRange& range = materials.GetTriangleRange (rangeIndex);
+		if (materialToRenderGeometry.find (range.material) == materialToRenderGeometry.end ()) {
+			renderMesh.AddRenderGeometry (RenderGeometry (MaterialToRenderMaterial (materials.GetMaterial (range.material))));
+			materialToRenderGeometry.insert ({ range.material, renderMesh.RenderGeometryCount () - 1 });
 		}
-		RenderGeometry& renderGeometry = renderMesh.GetRenderGeometry (materialToRenderGeometry[materialId]);
-		for (unsigned int triangleId : triangles) {
+		RenderGeometry& renderGeometry = renderMesh.GetRenderGeometry (materialToRenderGeometry[range.material]);
+		for (unsigned int triangleId = range.first; triangleId < range.first + range.count; triangleId++) {
 			const Modeler::MeshTriangle& triangle = geometry.GetTriangle (triangleId);
 			glm::vec3 v1 = geometry.GetVertex (triangle.v1);
 			glm::vec3 v2 = geometry.GetVertex (triangle.v2);
@@ -79,7 +80,7 @@ void RenderModelConverter::ConvertMeshRefToRenderMesh (const Modeler::Model& mod
 			glm::vec3 n3 = geometry.GetNormal (triangle.n3);
 			renderGeometry.AddTriangle (v1, v2, v3, n1, n2, n3);
 		}
-	});
+	}
 }
 
 RenderMaterial RenderModelConverter::MaterialToRenderMaterial (const Modeler::Material& material)
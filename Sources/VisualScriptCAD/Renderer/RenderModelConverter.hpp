@@ -34,13 +34,13 @@ class RenderModelConverter
 public:
 	RenderModelConverter ();
 
-	void			AddMeshToRenderModel (const Modeler::Model& model, Modeler::MeshId meshId, RenderModel& renderModel);
+	void			AddMeshToRenderModel (const Modeler::ModelView& model, Modeler::MeshId meshId, RenderModel& renderModel);
 	void			RemoveMeshFromRenderModel (Modeler::MeshId meshId, RenderModel& renderModel);
 
 	void			Clear ();
 
 private:
-	void			ConvertMeshRefToRenderMesh (const Modeler::Model& model, const Modeler::MeshRef& meshRef, RenderMesh& renderMesh);
+	void			ConvertMeshRefToRenderMesh (const Modeler::ModelView& model, const Modeler::MeshRef& meshRef, RenderMesh& renderMesh);
 	RenderMaterial	MaterialToRenderMaterial (const Modeler::Material& material);
 
 	std::unordered_map<MeshUniqueId, RenderMeshId>	meshIdToRenderMeshId;
@@ -284,6 +284,11 @@ void RenderGeometry::EnumerateVertices (const std::function<void (const glm::vec
 	}
 }
 
+size_t RenderGeometry::CalcMemoryUsage () const
+{
+	return sizeof (RenderGeometry) + Modeler::CalcVectorMemoryUsage (triangleVertices) + Modeler::CalcVectorMemoryUsage (triangleNormals);
+}
+
 RenderMeshInstance::RenderMeshInstance (const glm::mat4& transformation) :
 	transformation (transformation)
 {
@@ -348,6 +353,16 @@ void RenderMesh::EnumerateInstances (const std::function<void (const RenderMeshI
 	}
 }
 
+size_t RenderMesh::CalcMemoryUsage () const
+{
+	size_t memoryUsage = sizeof (RenderMesh);
+	for (const RenderGeometry& geometry : geometries) {
+		memoryUsage += geometry.CalcMemoryUsage ();
+	}
+	memoryUsage += instances.size () * sizeof (RenderMeshInstance);
+	return memoryUsage;
+}
+
 RenderModel::RenderModel ()
 {
 
@@ -403,6 +418,15 @@ void RenderModel::EnumerateRenderMeshes (const std::function<void (const RenderM
 	}
 }
 
+size_t RenderModel::CalcMemoryUsage () const
+{
+	size_t memoryUsage = sizeof (RenderModel);
+	for (const auto& it : renderMeshes) {
+		memoryUsage += it.second.CalcMemoryUsage ();
+	}
+	return memoryUsage;
+}
+
 void RenderModel::Clear ()
 {
 	renderMeshes.clear ();
@@ -586,6 +610,11 @@ RenderModel& RenderScene::GetModel ()
 	return model;
 }
 
+const RenderModel& RenderScene::GetModel () const
+{
+	return model;
+}
+
 void RenderScene::OnMouseMove (MouseButton mouseButton, int diffX, int diffY)
 {
 	if (mouseButton == MouseButton::Left) {
@@ -3,6 +3,7 @@
 
 #include "Camera.hpp"
 #include "UserSettings.hpp"
+#include "MemoryUsage.hpp"
 
 #include <glad/glad.h>
 #include <vector>
@@ -76,13 +77,14 @@ public:
 	void						DrawBuffers () const;
 
 	void						EnumerateVertices (const std::function<void (const glm::vec3&)>& processor) const;
+	size_t						CalcMemoryUsage () const;
 
 private:
 	void						AddVertex (const glm::vec3& v);
 	void						AddNormal (const glm::vec3& n);
 
-	std::vector<float>			triangleVertices;
-	std::vector<float>			triangleNormals;
+	Modeler::TrackedVector<float, Modeler::MemorySubsystem::Render>	triangleVertices;
+	Modeler::TrackedVector<float, Modeler::MemorySubsystem::Render>	triangleNormals;
 	RenderMaterial				triangleMaterial;
 
 	mutable unsigned int		vertexArrayObject;
@@ -117,6 +119,7 @@ public:
 
 	void				EnumerateRenderGeometries (const std::function<void (const RenderGeometry&)>& processor) const;
 	void				EnumerateInstances (const std::function<void (const RenderMeshInstance&)>& processor) const;
+	size_t				CalcMemoryUsage () const;
 
 private:
 	std::vector<RenderGeometry>										geometries;
@@ -138,6 +141,7 @@ public:
 	const RenderMesh&	GetRenderMesh (RenderMeshId meshId) const;
 	bool				ContainsRenderMesh (RenderMeshId meshId) const;
 	void				EnumerateRenderMeshes (const std::function<void (const RenderMesh&)>& processor) const;
+	size_t				CalcMemoryUsage () const;
 
 	void				Clear ();
 
@@ -200,6 +204,7 @@ public:
 	void					SetCamera (const Modeler::Camera& newCamera);
 
 	RenderModel&			GetModel ();
+	const RenderModel&		GetModel () const;
 
 	void					OnMouseMove (MouseButton mouseButton, int diffX, int diffY);
 	void					OnMouseWheel (int rotation);
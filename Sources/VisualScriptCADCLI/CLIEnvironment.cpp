@@ -5,9 +5,39 @@
 #include "NUIE_DrawingContext.hpp"
 #include "NUIE_EventHandlers.hpp"
 
+#include <fstream>
+
 namespace CLI
 {
 
+bool FileIO::ReadBufferFromFile (const std::wstring& fileName, std::vector<char>& buffer) const
+{
+	std::ifstream file;
+	file.open (fileName, std::ios::binary);
+	if (!file.is_open ()) {
+		return false;
+	}
+
+	buffer.assign (std::istreambuf_iterator<char> (file), std::istreambuf_iterator<char> ());
+	file.close ();
+
+	return true;
+}
+
+bool FileIO::WriteBufferToFile (const std::wstring& fileName, const std::vector<char>& buffer) const
+{
+	std::ofstream file;
+	file.open (fileName, std::ios::binary);
+	if (!file.is_open ()) {
+		return false;
+	}
+
+	file.write (buffer.data (), buffer.size ());
+	file.close ();
+
+	return true;
+}
+
 NodeUIEnvironment::NodeUIEnvironment (const NE::EvaluationDataPtr& evalData) :
 	NUIE::NodeUIEnvironment (),
 	evaluationEnv (evalData)
@@ -3,10 +3,18 @@
 
 #include "NE_EvaluationEnv.hpp"
 #include "NUIE_NodeUIEnvironment.hpp"
+#include "NUIE_NodeEditor.hpp"
 
 namespace CLI
 {
 
+class FileIO : public NUIE::ExternalFileIO
+{
+public:
+	virtual bool	ReadBufferFromFile (const std::wstring& fileName, std::vector<char>& buffer) const override;
+	virtual bool	WriteBufferToFile (const std::wstring& fileName, const std::vector<char>& buffer) const override;
+};
+
 class NodeUIEnvironment : public NUIE::NodeUIEnvironment
 {
 public:
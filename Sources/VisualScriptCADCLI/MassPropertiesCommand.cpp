@@ -0,0 +1,41 @@
+#include "MassPropertiesCommand.hpp"
+
+#include "NUIE_NodeEditor.hpp"
+#include "ModelEvaluationData.hpp"
+#include "ApplicationHeaderIO.hpp"
+
+#include "CLIEnvironment.hpp"
+
+#include <iostream>
+#include <iomanip>
+
+MassPropertiesCommand::MassPropertiesCommand () :
+	CLI::Command (L"mass_properties", 1)
+{
+}
+
+bool MassPropertiesCommand::Do (const std::vector<std::wstring>& parameters) const
+{
+	std::wstring vscFileName = parameters[0];
+
+	std::shared_ptr<ModelEvaluationData> evalData (new ModelEvaluationData ());
+	CLI::NodeUIEnvironment env (evalData);
+	NUIE::NodeEditor nodeEditor (env);
+
+	CLI::FileIO fileIO;
+	ApplicationHeaderIO headerIO;
+
+	if (!nodeEditor.Open (vscFileName, &fileIO, &headerIO)) {
+		return false;
+	}
+
+	Modeler::ModelSnapshotConstPtr modelSnapshot = evalData->GetModel ().GetSnapshot ();
+	Modeler::MassProperties massProperties = modelSnapshot->CalcMassProperties ();
+	glm::dvec3 centroid = massProperties.GetCentroid ();
+	std::wcout << std::fixed << std::setprecision (6);
+	std::wcout << L"Surface area: " << massProperties.area << std::endl;
+	std::wcout << L"Volume: " << massProperties.volume << std::endl;
+	std::wcout << L"Centroid: " << centroid.x << L" " << centroid.y << L" " << centroid.z << std::endl;
+
+	return true;
+}
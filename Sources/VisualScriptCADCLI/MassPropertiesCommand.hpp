@@ -0,0 +1,14 @@
+#ifndef MASSPROPERTIESCOMMAND_HPP
+#define MASSPROPERTIESCOMMAND_HPP
+
+#include "CLICommand.hpp"
+
+class MassPropertiesCommand : public CLI::Command
+{
+public:
+	MassPropertiesCommand ();
+
+	virtual bool Do (const std::vector<std::wstring>& parameters) const override;
+};
+
+#endif
@@ -0,0 +1,48 @@
+#include "MemoryReportCommand.hpp"
+
+#include "NUIE_NodeEditor.hpp"
+#include "MemoryUsage.hpp"
+#include "ModelEvaluationData.hpp"
+#include "ApplicationHeaderIO.hpp"
+
+#include "CLIEnvironment.hpp"
+
+#include <iostream>
+
+MemoryReportCommand::MemoryReportCommand () :
+	CLI::Command (L"memory_report", 1)
+{
+}
+
+bool MemoryReportCommand::Do (const std::vector<std::wstring>& parameters) const
+{
+	std::wstring vscFileName = parameters[0];
+
+	std::shared_ptr<ModelEvaluationData> evalData (new ModelEvaluationData ());
+	CLI::NodeUIEnvironment env (evalData);
+	NUIE::NodeEditor nodeEditor (env);
+
+	CLI::FileIO fileIO;
+	ApplicationHeaderIO headerIO;
+
+	if (!nodeEditor.Open (vscFileName, &fileIO, &headerIO)) {
+		return false;
+	}
+
+	Modeler::ModelSnapshotConstPtr modelSnapshot = evalData->GetModel ().GetSnapshot ();
+	Modeler::ModelInfo modelInfo = modelSnapshot->GetInfo ();
+	std::wcout << L"Mesh geometry count: " << modelInfo.meshGeometryCount << std::endl;
+	std::wcout << L"Mesh count: " << modelInfo.meshCount << std::endl;
+	std::wcout << L"Geometry memory: " << Modeler::FormatMemorySize (modelInfo.geometryMemoryUsage) << std::endl;
+	std::wcout << L"Material memory: " << Modeler::FormatMemorySize (modelInfo.materialsMemoryUsage) << std::endl;
+	std::wcout << L"Mesh memory: " << Modeler::FormatMemorySize (modelInfo.meshMemoryUsage) << std::endl;
+	std::wcout << L"Total memory: " << Modeler::FormatMemorySize (modelSnapshot->CalcMemoryUsage ()) << std::endl;
+	if (Modeler::IsMemoryTrackingEnabled ()) {
+		for (int i = 0; i < Modeler::MemorySubsystemCount; i++) {
+			Modeler::MemorySubsystem subsystem = (Modeler::MemorySubsystem) i;
+			std::wcout << Modeler::GetMemorySubsystemName (subsystem) << L" memory (tracked): " << Modeler::FormatMemorySize (Modeler::GetTrackedMemory (subsystem)) << std::endl;
+		}
+	}
+
+	return true;
+}
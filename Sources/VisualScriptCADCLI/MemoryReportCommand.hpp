@@ -0,0 +1,14 @@
+#ifndef MEMORYREPORTCOMMAND_HPP
+#define MEMORYREPORTCOMMAND_HPP
+
+#include "CLICommand.hpp"
+
+class MemoryReportCommand : public CLI::Command
+{
+public:
+	MemoryReportCommand ();
+
+	virtual bool Do (const std::vector<std::wstring>& parameters) const override;
+};
+
+#endif
@@ -9,38 +9,6 @@
 
 #include <fstream>
 
-class FileIO : public NUIE::ExternalFileIO
-{
-public:
-	virtual bool ReadBufferFromFile (const std::wstring& fileName, std::vector<char>& buffer) const override
-	{
-		std::ifstream file;
-		file.open (fileName, std::ios::binary);
-		if (!file.is_open ()) {
-			return false;
-		}
-
-		buffer.assign (std::istreambuf_iterator<char> (file), std::istreambuf_iterator<char> ());
-		file.close ();
-
-		return true;
-	}
-
-	virtual bool WriteBufferToFile (const std::wstring& fileName, const std::vector<char>& buffer) const override
-	{
-		std::ofstream file;
-		file.open (fileName, std::ios::binary);
-		if (!file.is_open ()) {
-			return false;
-		}
-
-		file.write (buffer.data (), buffer.size ());
-		file.close ();
-
-		return true;
-	}
-};
-
 class ModelWriter : public Modeler::ModelWriter
 {
 public:
@@ -89,7 +57,7 @@ bool OpenExportCommand::Do (const std::vector<std::wstring>& parameters) const
 	CLI::NodeUIEnvironment env (evalData);
 	NUIE::NodeEditor nodeEditor (env);
 
-	FileIO fileIO;
+	CLI::FileIO fileIO;
 	ApplicationHeaderIO headerIO;
 
 	if (!nodeEditor.Open (vscFileName, &fileIO, &headerIO)) {
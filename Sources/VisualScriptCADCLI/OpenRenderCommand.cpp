@@ -0,0 +1,112 @@
+#include "OpenRenderCommand.hpp"
+
+#include "NUIE_NodeEditor.hpp"
+#include "ImageRenderer.hpp"
+#include "ModelEvaluationData.hpp"
+#include "ApplicationHeaderIO.hpp"
+
+#include "CLIEnvironment.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cwchar>
+#include <cerrno>
+
+static const Modeler::Camera DefaultCamera (glm::dvec3 (-2.0, -3.0, 1.5), glm::dvec3 (0.0, 0.0, 0.0), glm::dvec3 (0.0, 0.0, 1.0), 45.0, 0.1, 10000.0);
+
+// Uncompressed 32 bit targa image. Rows are stored from bottom to top,
+// so the pixels of the renderer can be written without flipping.
+static bool WriteTargaFile (const std::wstring& fileName, int width, int height, const std::vector<unsigned char>& pixels)
+{
+	std::ofstream file (fileName, std::ios::binary);
+	if (!file.is_open ()) {
+		return false;
+	}
+
+	unsigned char header[18] = { 0 };
+	header[2] = 2;
+	header[12] = (unsigned char) (width & 0xFF);
+	header[13] = (unsigned char) ((width >> 8) & 0xFF);
+	header[14] = (unsigned char) (height & 0xFF);
+	header[15] = (unsigned char) ((height >> 8) & 0xFF);
+	header[16] = 32;
+	header[17] = 8;
+	file.write ((const char*) header, sizeof (header));
+
+	std::vector<unsigned char> bgraPixels (pixels.size ());
+	for (size_t i = 0; i < pixels.size (); i += 4) {
+		bgraPixels[i + 0] = pixels[i + 2];
+		bgraPixels[i + 1] = pixels[i + 1];
+		bgraPixels[i + 2] = pixels[i + 0];
+		bgraPixels[i + 3] = pixels[i + 3];
+	}
+	file.write ((const char*) bgraPixels.data (), bgraPixels.size ());
+	return file.good ();
+}
+
+// Image sizes are whole numbers that fit in the 16 bit fields of the targa
+// header, anything else in the parameter is rejected.
+static bool ParseImageSize (const std::wstring& text, int& size)
+{
+	if (text.empty ()) {
+		return false;
+	}
+	const wchar_t* begin = text.c_str ();
+	wchar_t* end = nullptr;
+	errno = 0;
+	long value = std::wcstol (begin, &end, 10);
+	if (errno != 0 || end != begin + text.length ()) {
+		return false;
+	}
+	if (value <= 0 || value > 0xFFFF) {
+		return false;
+	}
+	size = (int) value;
+	return true;
+}
+
+OpenRenderCommand::OpenRenderCommand () :
+	CLI::Command (L"open_render_tga", 4)
+{
+}
+
+bool OpenRenderCommand::Do (const std::vector<std::wstring>& parameters) const
+{
+	std::wstring vscFileName = parameters[0];
+	std::wstring tgaFileName = parameters[1];
+	int width = 0;
+	int height = 0;
+	if (!ParseImageSize (parameters[2], width)) {
+		std::wcout << L"Invalid image width: " << parameters[2] << std::endl;
+		return false;
+	}
+	if (!ParseImageSize (parameters[3], height)) {
+		std::wcout << L"Invalid image height: " << parameters[3] << std::endl;
+		return false;
+	}
+
+	std::shared_ptr<ModelEvaluationData> evalData (new ModelEvaluationData ());
+	CLI::NodeUIEnvironment env (evalData);
+	NUIE::NodeEditor nodeEditor (env);
+
+	CLI::FileIO fileIO;
+	ApplicationHeaderIO headerIO;
+
+	if (!nodeEditor.Open (vscFileName, &fileIO, &headerIO)) {
+		return false;
+	}
+
+	Modeler::ModelSnapshotConstPtr modelSnapshot = evalData->GetModel ().GetSnapshot ();
+	Modeler::Camera camera = DefaultCamera;
+	Geometry::BoundingSphere boundingSphere = modelSnapshot->GetBoundingSphere ();
+	if (boundingSphere.IsValid ()) {
+		camera.ZoomToSphere (boundingSphere.GetCenter (), boundingSphere.GetRadius (), width, height);
+	}
+
+	std::vector<unsigned char> pixels ((size_t) width * (size_t) height * 4);
+	Modeler::ImageRenderer renderer (*modelSnapshot);
+	renderer.RenderImage (camera, width, height, Modeler::ImageRenderSettings (), pixels.data ());
+
+	return WriteTargaFile (tgaFileName, width, height, pixels);
+}
@@ -0,0 +1,14 @@
+#ifndef OPENRENDERCOMMAND_HPP
+#define OPENRENDERCOMMAND_HPP
+
+#include "CLICommand.hpp"
+
+class OpenRenderCommand : public CLI::Command
+{
+public:
+	OpenRenderCommand ();
+
+	virtual bool Do (const std::vector<std::wstring>& parameters) const override;
+};
+
+#endif
@@ -5,6 +5,9 @@
 #include "NodeRegistry.hpp"
 #include "CLICommand.hpp"
 #include "OpenExportCommand.hpp"
+#include "MemoryReportCommand.hpp"
+#include "OpenRenderCommand.hpp"
+#include "MassPropertiesCommand.hpp"
 
 #ifdef DEBUG
 #pragma comment(lib, "NodeEngineDebug.lib")
@@ -34,6 +37,9 @@ int wmain (int argc, wchar_t* argv[])
 
 	CLI::CommandHandler commandHandler;
 	commandHandler.RegisterCommand (CLI::CommandPtr (new OpenExportCommand ()));
+	commandHandler.RegisterCommand (CLI::CommandPtr (new MemoryReportCommand ()));
+	commandHandler.RegisterCommand (CLI::CommandPtr (new OpenRenderCommand ()));
+	commandHandler.RegisterCommand (CLI::CommandPtr (new MassPropertiesCommand ()));
 
 	std::wstring commandName = argv[1];
 	CLI::CommandPtr command = commandHandler.GetCommand (commandName);
@@ -0,0 +1,396 @@
+#include "AnalysisNodes.hpp"
+
+#include "NE_SingleValues.hpp"
+#include "ShapeNode.hpp"
+#include "Basic3DNodeValues.hpp"
+#include "GLMReadWrite.hpp"
+#include "Interference.hpp"
+#include "MeshDistance.hpp"
+#include "ParallelTasks.hpp"
+
+#include <unordered_map>
+#include <memory>
+
+NE::DynamicSerializationInfo	InterferenceValue::serializationInfo (NE::ObjectId ("{6A0E7C51-3B8D-4C1E-9F27-5D84A1B2C390}"), NE::ObjectVersion (1), InterferenceValue::CreateSerializableInstance);
+NE::DynamicSerializationInfo	InterferenceNode::serializationInfo (NE::ObjectId ("{B3F9D2E4-7A61-4E08-8C5B-21D6F04A9E7C}"), NE::ObjectVersion (1), InterferenceNode::CreateSerializableInstance);
+NE::DynamicSerializationInfo	MassPropertiesValue::serializationInfo (NE::ObjectId ("{97C4B2E0-1F5D-4A83-8E6B-D2A07F39C15E}"), NE::ObjectVersion (1), MassPropertiesValue::CreateSerializableInstance);
+NE::DynamicSerializationInfo	MassPropertiesNode::serializationInfo (NE::ObjectId ("{2B8F6D41-C3E7-4950-A1F4-7E5C90D8B36A}"), NE::ObjectVersion (1), MassPropertiesNode::CreateSerializableInstance);
+NE::DynamicSerializationInfo	PointDistanceNode::serializationInfo (NE::ObjectId ("{4C2D8E19-6B7A-4F35-A0D1-93E5B7C62F84}"), NE::ObjectVersion (1), PointDistanceNode::CreateSerializableInstance);
+NE::DynamicSerializationInfo	ClosestPointNode::serializationInfo (NE::ObjectId ("{E81A5F3C-2D94-47B6-B5C8-0F7D1E6A3924}"), NE::ObjectVersion (1), ClosestPointNode::CreateSerializableInstance);
+
+static std::unique_ptr<Modeler::MeshDistanceQuery> CreateDistanceQuery (const NE::ValueConstPtr& pointsValue, const NE::ValueConstPtr& shapeValue, std::vector<glm::dvec3>& points)
+{
+	if (!NE::IsComplexType<PointValue> (pointsValue) || !NE::IsComplexType<ShapeValue> (shapeValue)) {
+		return nullptr;
+	}
+
+	std::vector<Modeler::ShapePtr> shapes;
+	NE::FlatEnumerate (shapeValue, [&] (const NE::ValueConstPtr& val) {
+		shapes.push_back (ShapeValue::Get (val));
+	});
+	if (shapes.size () != 1 || shapes[0] == nullptr) {
+		return nullptr;
+	}
+
+	NE::FlatEnumerate (pointsValue, [&] (const NE::ValueConstPtr& val) {
+		points.push_back (glm::dvec3 (CoordinateValue::Get (val)));
+	});
+	return std::unique_ptr<Modeler::MeshDistanceQuery> (new Modeler::MeshDistanceQuery (shapes[0]->GenerateMesh ()));
+}
+
+ShapeInterference::ShapeInterference () :
+	ShapeInterference (0, 0, 0)
+{
+
+}
+
+ShapeInterference::ShapeInterference (int aShapeIndex, int bShapeIndex, int contactCount) :
+	aShapeIndex (aShapeIndex),
+	bShapeIndex (bShapeIndex),
+	contactCount (contactCount)
+{
+
+}
+
+InterferenceValue::InterferenceValue () :
+	InterferenceValue (ShapeInterference ())
+{
+
+}
+
+InterferenceValue::InterferenceValue (const ShapeInterference& val) :
+	NE::GenericValue<ShapeInterference> (val)
+{
+
+}
+
+NE::ValuePtr InterferenceValue::Clone () const
+{
+	return NE::ValuePtr (new InterferenceValue (val));
+}
+
+std::wstring InterferenceValue::ToString (const NE::StringSettings&) const
+{
+	std::wstring result;
+	result += L"Interference (";
+	result += std::to_wstring (val.aShapeIndex) + L", ";
+	result += std::to_wstring (val.bShapeIndex) + L", ";
+	if (val.contactCount > 0) {
+		result += std::to_wstring (val.contactCount) + L" contacts";
+	} else {
+		result += L"contained";
+	}
+	result += L")";
+	return result;
+}
+
+NE::Stream::Status InterferenceValue::Read (NE::InputStream& inputStream)
+{
+	NE::ObjectHeader header (inputStream);
+	NE::GenericValue<ShapeInterference>::Read (inputStream);
+	inputStream.Read (val.aShapeIndex);
+	inputStream.Read (val.bShapeIndex);
+	inputStream.Read (val.contactCount);
+	return inputStream.GetStatus ();
+}
+
+NE::Stream::Status InterferenceValue::Write (NE::OutputStream& outputStream) const
+{
+	NE::ObjectHeader header (outputStream, serializationInfo);
+	NE::GenericValue<ShapeInterference>::Write (outputStream);
+	outputStream.Write (val.aShapeIndex);
+	outputStream.Write (val.bShapeIndex);
+	outputStream.Write (val.contactCount);
+	return outputStream.GetStatus ();
+}
+
+InterferenceNode::InterferenceNode () :
+	InterferenceNode (L"", NUIE::Point ())
+{
+
+}
+
+InterferenceNode::InterferenceNode (const std::wstring& name, const NUIE::Point& position) :
+	BI::BasicUINode (name, position)
+{
+
+}
+
+void InterferenceNode::Initialize ()
+{
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("shapes"), L"Shapes", NE::ValuePtr (nullptr), NE::OutputSlotConnectionMode::Multiple)));
+	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (NE::SlotId ("interferences"), L"Interferences")));
+}
+
+NE::ValueConstPtr InterferenceNode::Calculate (NE::EvaluationEnv& env) const
+{
+	NE::ValueConstPtr shapesValue = NE::FlattenValue (EvaluateInputSlot (NE::SlotId ("shapes"), env));
+	if (!NE::IsComplexType<ShapeValue> (shapesValue)) {
+		return nullptr;
+	}
+
+	std::vector<Modeler::ShapePtr> shapes;
+	NE::FlatEnumerate (shapesValue, [&] (const NE::ValueConstPtr& val) {
+		shapes.push_back (ShapeValue::Get (val));
+	});
+	for (const Modeler::ShapePtr& shape : shapes) {
+		if (shape == nullptr) {
+			return nullptr;
+		}
+	}
+
+	// the model keeps the generated mesh buffers as they are, nothing is copied
+	Modeler::Model model;
+	std::unordered_map<Modeler::MeshId, int> meshIdToShapeIndex;
+	for (int shapeIndex = 0; shapeIndex < (int) shapes.size (); shapeIndex++) {
+		Modeler::MeshId meshId = model.AddMesh (shapes[shapeIndex]->GenerateMesh ());
+		meshIdToShapeIndex.insert ({ meshId, shapeIndex });
+	}
+
+	NE::ListValuePtr result (new NE::ListValue ());
+	std::vector<Modeler::MeshInterference> interferences = Modeler::GetMeshInterferences (model);
+	for (const Modeler::MeshInterference& interference : interferences) {
+		int aShapeIndex = meshIdToShapeIndex.at (interference.aMeshId);
+		int bShapeIndex = meshIdToShapeIndex.at (interference.bMeshId);
+		ShapeInterference shapeInterference (std::min (aShapeIndex, bShapeIndex), std::max (aShapeIndex, bShapeIndex), (int) interference.contactCount);
+		result->Push (NE::ValuePtr (new InterferenceValue (shapeInterference)));
+	}
+	return result;
+}
+
+NE::Stream::Status InterferenceNode::Read (NE::InputStream& inputStream)
+{
+	NE::ObjectHeader header (inputStream);
+	BI::BasicUINode::Read (inputStream);
+	return inputStream.GetStatus ();
+}
+
+NE::Stream::Status InterferenceNode::Write (NE::OutputStream& outputStream) const
+{
+	NE::ObjectHeader header (outputStream, serializationInfo);
+	BI::BasicUINode::Write (outputStream);
+	return outputStream.GetStatus ();
+}
+
+MassPropertiesValue::MassPropertiesValue () :
+	MassPropertiesValue (Modeler::MassProperties ())
+{
+
+}
+
+MassPropertiesValue::MassPropertiesValue (const Modeler::MassProperties& val) :
+	NE::GenericValue<Modeler::MassProperties> (val)
+{
+
+}
+
+NE::ValuePtr MassPropertiesValue::Clone () const
+{
+	return NE::ValuePtr (new MassPropertiesValue (val));
+}
+
+std::wstring MassPropertiesValue::ToString (const NE::StringSettings& stringSettings) const
+{
+	glm::dvec3 centroid = val.GetCentroid ();
+	std::wstring result;
+	result += L"Mass Properties (";
+	result += L"area " + NE::DoubleToString (val.area, stringSettings) + L", ";
+	result += L"volume " + NE::DoubleToString (val.volume, stringSettings) + L", ";
+	result += L"centroid (";
+	result += NE::DoubleToString (centroid.x, stringSettings) + L", ";
+	result += NE::DoubleToString (centroid.y, stringSettings) + L", ";
+	result += NE::DoubleToString (centroid.z, stringSettings);
+	result += L"))";
+	return result;
+}
+
+NE::Stream::Status MassPropertiesValue::Read (NE::InputStream& inputStream)
+{
+	NE::ObjectHeader header (inputStream);
+	NE::GenericValue<Modeler::MassProperties>::Read (inputStream);
+	inputStream.Read (val.area);
+	inputStream.Read (val.volume);
+	ReadVector (inputStream, val.firstMoment);
+	for (int i = 0; i < 3; i++) {
+		ReadVector (inputStream, val.secondMoment[i]);
+	}
+	return inputStream.GetStatus ();
+}
+
+NE::Stream::Status MassPropertiesValue::Write (NE::OutputStream& outputStream) const
+{
+	NE::ObjectHeader header (outputStream, serializationInfo);
+	NE::GenericValue<Modeler::MassProperties>::Write (outputStream);
+	outputStream.Write (val.area);
+	outputStream.Write (val.volume);
+	WriteVector (outputStream, val.firstMoment);
+	for (int i = 0; i < 3; i++) {
+		WriteVector (outputStream, val.secondMoment[i]);
+	}
+	return outputStream.GetStatus ();
+}
+
+MassPropertiesNode::MassPropertiesNode () :
+	MassPropertiesNode (L"", NUIE::Point ())
+{
+
+}
+
+MassPropertiesNode::MassPropertiesNode (const std::wstring& name, const NUIE::Point& position) :
+	BI::BasicUINode (name, position)
+{
+
+}
+
+void MassPropertiesNode::Initialize ()
+{
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("shapes"), L"Shapes", NE::ValuePtr (nullptr), NE::OutputSlotConnectionMode::Multiple)));
+	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (NE::SlotId ("massproperties"), L"Mass Properties")));
+}
+
+NE::ValueConstPtr MassPropertiesNode::Calculate (NE::EvaluationEnv& env) const
+{
+	NE::ValueConstPtr shapesValue = NE::FlattenValue (EvaluateInputSlot (NE::SlotId ("shapes"), env));
+	if (!NE::IsComplexType<ShapeValue> (shapesValue)) {
+		return nullptr;
+	}
+
+	std::vector<Modeler::ShapePtr> shapes;
+	NE::FlatEnumerate (shapesValue, [&] (const NE::ValueConstPtr& val) {
+		shapes.push_back (ShapeValue::Get (val));
+	});
+	std::vector<Modeler::Mesh> meshes;
+	for (const Modeler::ShapePtr& shape : shapes) {
+		if (shape == nullptr) {
+			return nullptr;
+		}
+		meshes.push_back (shape->GenerateMesh ());
+	}
+
+	std::vector<Modeler::MassProperties> massProperties (meshes.size ());
+	Modeler::RunParallelTasks (meshes.size (), 0, [&] (size_t taskIndex) {
+		massProperties[taskIndex] = Modeler::CalcMeshMassProperties (meshes[taskIndex].GetGeometry (), meshes[taskIndex].GetTransformation ());
+	});
+
+	NE::ListValuePtr result (new NE::ListValue ());
+	for (const Modeler::MassProperties& properties : massProperties) {
+		result->Push (NE::ValuePtr (new MassPropertiesValue (properties)));
+	}
+	return result;
+}
+
+NE::Stream::Status MassPropertiesNode::Read (NE::InputStream& inputStream)
+{
+	NE::ObjectHeader header (inputStream);
+	BI::BasicUINode::Read (inputStream);
+	return inputStream.GetStatus ();
+}
+
+NE::Stream::Status MassPropertiesNode::Write (NE::OutputStream& outputStream) const
+{
+	NE::ObjectHeader header (outputStream, serializationInfo);
+	BI::BasicUINode::Write (outputStream);
+	return outputStream.GetStatus ();
+}
+
+PointDistanceNode::PointDistanceNode () :
+	PointDistanceNode (L"", NUIE::Point ())
+{
+
+}
+
+PointDistanceNode::PointDistanceNode (const std::wstring& name, const NUIE::Point& position) :
+	BI::BasicUINode (name, position)
+{
+
+}
+
+void PointDistanceNode::Initialize ()
+{
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("points"), L"Points", NE::ValuePtr (nullptr), NE::OutputSlotConnectionMode::Multiple)));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("shape"), L"Shape", NE::ValuePtr (nullptr), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (NE::SlotId ("distances"), L"Distances")));
+}
+
+NE::ValueConstPtr PointDistanceNode::Calculate (NE::EvaluationEnv& env) const
+{
+	NE::ValueConstPtr pointsValue = NE::FlattenValue (EvaluateInputSlot (NE::SlotId ("points"), env));
+	NE::ValueConstPtr shapeValue = NE::FlattenValue (EvaluateInputSlot (NE::SlotId ("shape"), env));
+	std::vector<glm::dvec3> points;
+	std::unique_ptr<Modeler::MeshDistanceQuery> query = CreateDistanceQuery (pointsValue, shapeValue, points);
+	if (query == nullptr || query->IsEmpty ()) {
+		return nullptr;
+	}
+
+	NE::ListValuePtr result (new NE::ListValue ());
+	std::vector<double> distances = query->GetSignedDistances (points, 0);
+	for (double distance : distances) {
+		result->Push (NE::ValuePtr (new NE::DoubleValue (distance)));
+	}
+	return result;
+}
+
+NE::Stream::Status PointDistanceNode::Read (NE::InputStream& inputStream)
+{
+	NE::ObjectHeader header (inputStream);
+	BI::BasicUINode::Read (inputStream);
+	return inputStream.GetStatus ();
+}
+
+NE::Stream::Status PointDistanceNode::Write (NE::OutputStream& outputStream) const
+{
+	NE::ObjectHeader header (outputStream, serializationInfo);
+	BI::BasicUINode::Write (outputStream);
+	return outputStream.GetStatus ();
+}
+
+ClosestPointNode::ClosestPointNode () :
+	ClosestPointNode (L"", NUIE::Point ())
+{
+
+}
+
+ClosestPointNode::ClosestPointNode (const std::wstring& name, const NUIE::Point& position) :
+	BI::BasicUINode (name, position)
+{
+
+}
+
+void ClosestPointNode::Initialize ()
+{
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("points"), L"Points", NE::ValuePtr (nullptr), NE::OutputSlotConnectionMode::Multiple)));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("shape"), L"Shape", NE::ValuePtr (nullptr), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (NE::SlotId ("closestpoints"), L"Closest Points")));
+}
+
+NE::ValueConstPtr ClosestPointNode::Calculate (NE::EvaluationEnv& env) const
+{
+	NE::ValueConstPtr pointsValue = NE::FlattenValue (EvaluateInputSlot (NE::SlotId ("points"), env));
+	NE::ValueConstPtr shapeValue = NE::FlattenValue (EvaluateInputSlot (NE::SlotId ("shape"), env));
+	std::vector<glm::dvec3> points;
+	std::unique_ptr<Modeler::MeshDistanceQuery> query = CreateDistanceQuery (pointsValue, shapeValue, points);
+	if (query == nullptr || query->IsEmpty ()) {
+		return nullptr;
+	}
+
+	NE::ListValuePtr result (new NE::ListValue ());
+	std::vector<Modeler::MeshClosestPoint> closestPoints = query->GetClosestPoints (points, 0);
+	for (const Modeler::MeshClosestPoint& closestPoint : closestPoints) {
+		result->Push (NE::ValuePtr (new PointValue (glm::vec3 (closestPoint.point))));
+	}
+	return result;
+}
+
+NE::Stream::Status ClosestPointNode::Read (NE::InputStream& inputStream)
+{
+	NE::ObjectHeader header (inputStream);
+	BI::BasicUINode::Read (inputStream);
+	return inputStream.GetStatus ();
+}
+
+NE::Stream::Status ClosestPointNode::Write (NE::OutputStream& outputStream) const
+{
+	NE::ObjectHeader header (outputStream, serializationInfo);
+	BI::BasicUINode::Write (outputStream);
+	return outputStream.GetStatus ();
+}
@@ -0,0 +1,115 @@
+#ifndef ANALYSISNODES_HPP
+#define ANALYSISNODES_HPP
+
+#include "NE_GenericValue.hpp"
+#include "BI_BasicUINode.hpp"
+#include "Model.hpp"
+#include "MassProperties.hpp"
+
+class ShapeInterference
+{
+public:
+	ShapeInterference ();
+	ShapeInterference (int aShapeIndex, int bShapeIndex, int contactCount);
+
+	int		aShapeIndex;
+	int		bShapeIndex;
+	int		contactCount;
+};
+
+class InterferenceValue : public NE::GenericValue<ShapeInterference>
+{
+	DYNAMIC_SERIALIZABLE (InterferenceValue);
+
+public:
+	InterferenceValue ();
+	InterferenceValue (const ShapeInterference& val);
+
+	virtual NE::ValuePtr		Clone () const override;
+	virtual std::wstring		ToString (const NE::StringSettings& stringSettings) const override;
+	virtual NE::Stream::Status	Read (NE::InputStream& inputStream) override;
+	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
+};
+
+// Checks which shapes of the input list collide, without calculating any
+// boolean geometry. Shapes are identified by their index in the list.
+class InterferenceNode : public BI::BasicUINode
+{
+	DYNAMIC_SERIALIZABLE (InterferenceNode);
+
+public:
+	InterferenceNode ();
+	InterferenceNode (const std::wstring& name, const NUIE::Point& position);
+
+	virtual void				Initialize () override;
+	virtual NE::ValueConstPtr	Calculate (NE::EvaluationEnv& env) const override;
+
+	virtual NE::Stream::Status	Read (NE::InputStream& inputStream) override;
+	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
+};
+
+class MassPropertiesValue : public NE::GenericValue<Modeler::MassProperties>
+{
+	DYNAMIC_SERIALIZABLE (MassPropertiesValue);
+
+public:
+	MassPropertiesValue ();
+	MassPropertiesValue (const Modeler::MassProperties& val);
+
+	virtual NE::ValuePtr		Clone () const override;
+	virtual std::wstring		ToString (const NE::StringSettings& stringSettings) const override;
+	virtual NE::Stream::Status	Read (NE::InputStream& inputStream) override;
+	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
+};
+
+// Calculates the surface area, volume, centroid and inertia tensor of every
+// input shape. The shapes are processed in parallel.
+class MassPropertiesNode : public BI::BasicUINode
+{
+	DYNAMIC_SERIALIZABLE (MassPropertiesNode);
+
+public:
+	MassPropertiesNode ();
+	MassPropertiesNode (const std::wstring& name, const NUIE::Point& position);
+
+	virtual void				Initialize () override;
+	virtual NE::ValueConstPtr	Calculate (NE::EvaluationEnv& env) const override;
+
+	virtual NE::Stream::Status	Read (NE::InputStream& inputStream) override;
+	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
+};
+
+// Calculates the signed distance of the input points from the surface of the
+// shape, points inside the shape have negative distance.
+class PointDistanceNode : public BI::BasicUINode
+{
+	DYNAMIC_SERIALIZABLE (PointDistanceNode);
+
+public:
+	PointDistanceNode ();
+	PointDistanceNode (const std::wstring& name, const NUIE::Point& position);
+
+	virtual void				Initialize () override;
+	virtual NE::ValueConstPtr	Calculate (NE::EvaluationEnv& env) const override;
+
+	virtual NE::Stream::Status	Read (NE::InputStream& inputStream) override;
+	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
+};
+
+// Calculates the closest point on the surface of the shape for every input point.
+class ClosestPointNode : public BI::BasicUINode
+{
+	DYNAMIC_SERIALIZABLE (ClosestPointNode);
+
+public:
+	ClosestPointNode ();
+	ClosestPointNode (const std::wstring& name, const NUIE::Point& position);
+
+	virtual void				Initialize () override;
+	virtual NE::ValueConstPtr	Calculate (NE::EvaluationEnv& env) const override;
+
+	virtual NE::Stream::Status	Read (NE::InputStream& inputStream) override;
+	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
+};
+
+#endif
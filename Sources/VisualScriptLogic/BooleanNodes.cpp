@@ -6,13 +6,64 @@
 #include "ModelEvaluationData.hpp"
 #include "TransformationNodes.hpp"
 #include "MaterialNode.hpp"
+#include "PreviewBooleanShape.hpp"
+#include "ExactBooleanShape.hpp"
 
 #include "IncludeGLM.hpp"
 
 NE::DynamicSerializationInfo	BooleanNode::serializationInfo (NE::ObjectId ("{558DB17B-A907-4A10-A187-6C317921BB53}"), NE::ObjectVersion (1), BooleanNode::CreateSerializableInstance);
 NE::DynamicSerializationInfo	UnionNode::serializationInfo (NE::ObjectId ("{F13DD277-9E5F-4CC2-A06A-2194AB5B9BD3}"), NE::ObjectVersion (1), UnionNode::CreateSerializableInstance);
 
-static Modeler::ShapePtr ShapeUnionFromValue (const NE::ValueConstPtr& shapesValue)
+static BooleanMode GetBooleanMode (NE::EvaluationEnv& env)
+{
+	if (!env.IsDataType<ModelEvaluationData> ()) {
+		return BooleanMode::Exact;
+	}
+	std::shared_ptr<ModelEvaluationData> evalData = env.GetData<ModelEvaluationData> ();
+	return evalData->GetBooleanMode ();
+}
+
+static Modeler::OperationProgress* GetOperationProgress (NE::EvaluationEnv& env)
+{
+	if (!env.IsDataType<ModelEvaluationData> ()) {
+		return nullptr;
+	}
+	std::shared_ptr<ModelEvaluationData> evalData = env.GetData<ModelEvaluationData> ();
+	return evalData->GetOperationProgress ();
+}
+
+// Exact operations are deferred, so a node used only as an operand of an other
+// boolean node is calculated as part of the rewritten tree of that node. The
+// result of an enabled node is shown, so it is calculated immediately, and the
+// node fails instead of the model update. The mesh of the result is converted
+// from its exact surface, which can fail too. The converted mesh is kept by the
+// exact result, so it is not converted again.
+static bool CalculateExactShape (const Modeler::ShapePtr& shape, CGALOperations::BooleanDiagnostic& diagnostic, Modeler::OperationProgress* progress)
+{
+	std::shared_ptr<const ExactBooleanShape> exactShape = std::dynamic_pointer_cast<const ExactBooleanShape> (shape);
+	if (exactShape->GenerateExactShape (diagnostic, progress) == nullptr) {
+		return false;
+	}
+	try {
+		shape->GenerateMesh ();
+	} catch (const std::exception&) {
+		diagnostic = CGALOperations::BooleanDiagnostic (CGALOperations::BooleanDiagnostic::Status::CalculationFailed, 0, Modeler::MeshValidation ());
+		return false;
+	}
+	return true;
+}
+
+// A failed exact operation results in the text of its diagnostic, so the
+// reason is shown as the value of the node. Other failures have no value.
+static NE::ValueConstPtr CreateFailedValue (const CGALOperations::BooleanDiagnostic& diagnostic)
+{
+	if (diagnostic.status == CGALOperations::BooleanDiagnostic::Status::Success || diagnostic.status == CGALOperations::BooleanDiagnostic::Status::Cancelled) {
+		return nullptr;
+	}
+	return NE::ValuePtr (new NE::StringValue (diagnostic.ToString ()));
+}
+
+static Modeler::ShapePtr ShapeUnionFromValue (const NE::ValueConstPtr& shapesValue, BooleanMode booleanMode)
 {
 	if (!NE::IsComplexType<ShapeValue> (shapesValue)) {
 		return nullptr;
@@ -23,7 +74,12 @@ static Modeler::ShapePtr ShapeUnionFromValue (const NE::ValueConstPtr& shapesVal
 		shapes.push_back (ShapeValue::Get (val));
 	});
 
-	Modeler::ShapePtr shape = CGALOperations::ShapeUnion (shapes);
+	Modeler::ShapePtr shape = nullptr;
+	if (booleanMode == BooleanMode::Preview) {
+		shape = PreviewShapeUnion (shapes);
+	} else {
+		shape = Modeler::ShapePtr (new ExactBooleanShape (glm::dmat4 (1.0), ExactBooleanShape::Operation::Union, shapes));
+	}
 	if (shape == nullptr || !shape->Check ()) {
 		return nullptr;
 	}
@@ -61,25 +117,38 @@ NE::ValueConstPtr BooleanNode::Calculate (NE::EvaluationEnv& env) const
 		return nullptr;
 	}
 
-	Modeler::ShapePtr aShape = ShapeUnionFromValue (aShapesValue);
+	BooleanMode booleanMode = GetBooleanMode (env);
+	Modeler::ShapePtr aShape = ShapeUnionFromValue (aShapesValue, booleanMode);
 	if (aShape == nullptr || !aShape->Check ()) {
 		return nullptr;
 	}
 
-	Modeler::ShapePtr bShape = ShapeUnionFromValue (bShapesValue);
+	Modeler::ShapePtr bShape = ShapeUnionFromValue (bShapesValue, booleanMode);
 	if (bShape == nullptr || !bShape->Check ()) {
 		return nullptr;
 	}
 
 	Modeler::ShapePtr shape = nullptr;
-	if (operation == Operation::Difference) {
-		shape = CGALOperations::ShapeDifference (aShape, bShape);
-	} else if (operation == Operation::Intersection) {
-		shape = CGALOperations::ShapeIntersection (aShape, bShape);
+	if (booleanMode == BooleanMode::Preview) {
+		if (operation == Operation::Difference) {
+			shape = PreviewShapeDifference (aShape, bShape);
+		} else if (operation == Operation::Intersection) {
+			shape = PreviewShapeIntersection (aShape, bShape);
+		}
+	} else {
+		if (operation == Operation::Difference) {
+			shape = Modeler::ShapePtr (new ExactBooleanShape (glm::dmat4 (1.0), ExactBooleanShape::Operation::Difference, { aShape, bShape }));
+		} else if (operation == Operation::Intersection) {
+			shape = Modeler::ShapePtr (new ExactBooleanShape (glm::dmat4 (1.0), ExactBooleanShape::Operation::Intersection, { aShape, bShape }));
+		}
 	}
 	if (shape == nullptr || !shape->Check ()) {
 		return nullptr;
 	}
+	CGALOperations::BooleanDiagnostic diagnostic;
+	if (booleanMode == BooleanMode::Exact && IsEnabled () && !CalculateExactShape (shape, diagnostic, GetOperationProgress (env))) {
+		return CreateFailedValue (diagnostic);
+	}
 
 	NE::ListValuePtr result (new NE::ListValue ());
 	NE::FlatEnumerate (transformationValue, [&] (const NE::ValueConstPtr& val) {
@@ -135,10 +204,15 @@ NE::ValueConstPtr UnionNode::Calculate (NE::EvaluationEnv& env) const
 		return nullptr;
 	}
 
-	Modeler::ShapePtr shape = ShapeUnionFromValue (shapesValue);
+	BooleanMode booleanMode = GetBooleanMode (env);
+	Modeler::ShapePtr shape = ShapeUnionFromValue (shapesValue, booleanMode);
 	if (shape == nullptr || !shape->Check ()) {
 		return nullptr;
 	}
+	CGALOperations::BooleanDiagnostic diagnostic;
+	if (booleanMode == BooleanMode::Exact && IsEnabled () && !CalculateExactShape (shape, diagnostic, GetOperationProgress (env))) {
+		return CreateFailedValue (diagnostic);
+	}
 
 	NE::ListValuePtr result (new NE::ListValue ());
 	NE::FlatEnumerate (transformationValue, [&] (const NE::ValueConstPtr& val) {
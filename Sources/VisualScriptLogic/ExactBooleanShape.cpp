@@ -0,0 +1,117 @@
+#include "ExactBooleanShape.hpp"
+#include "PreviewBooleanShape.hpp"
+
+#include <stdexcept>
+
+static Modeler::ShapeConstPtr GetExactShape (const Modeler::ShapeConstPtr& shape, CGALOperations::BooleanDiagnostic& diagnostic, Modeler::OperationProgress* progress)
+{
+	std::shared_ptr<const ExactBooleanShape> exactShape = std::dynamic_pointer_cast<const ExactBooleanShape> (shape);
+	if (exactShape != nullptr) {
+		return exactShape->GenerateExactShape (diagnostic, progress);
+	}
+	std::shared_ptr<const PreviewBooleanShape> previewShape = std::dynamic_pointer_cast<const PreviewBooleanShape> (shape);
+	if (previewShape != nullptr) {
+		return CalculateExactBooleanShape (*previewShape, diagnostic, progress);
+	}
+	return shape;
+}
+
+ExactBooleanShape::ExactResult::ExactResult () :
+	calculated (false),
+	shape (nullptr),
+	diagnostic ()
+{
+}
+
+ExactBooleanShape::ExactBooleanShape (const glm::dmat4& transformation, Operation operation, const std::vector<Modeler::ShapeConstPtr>& operands) :
+	Modeler::BooleanShape (transformation, operation, operands),
+	exactResult (new ExactResult ())
+{
+}
+
+ExactBooleanShape::~ExactBooleanShape ()
+{
+}
+
+Modeler::ShapePtr ExactBooleanShape::Clone () const
+{
+	return Modeler::ShapePtr (new ExactBooleanShape (*this));
+}
+
+std::wstring ExactBooleanShape::ToString () const
+{
+	return L"Boolean";
+}
+
+Modeler::Mesh ExactBooleanShape::GenerateMesh () const
+{
+	CGALOperations::BooleanDiagnostic diagnostic;
+	Modeler::ShapeConstPtr exactShape = GenerateExactShape (diagnostic, nullptr);
+	if (exactShape == nullptr) {
+		throw std::runtime_error ("failed to calculate the exact boolean operation");
+	}
+	return exactShape->GenerateMesh ();
+}
+
+Modeler::ShapeConstPtr ExactBooleanShape::GenerateExactShape (CGALOperations::BooleanDiagnostic& diagnostic, Modeler::OperationProgress* progress) const
+{
+	if (!exactResult->calculated) {
+		ExactBooleanShape localShape (glm::dmat4 (1.0), operation, operands);
+		CGALOperations::BooleanDiagnostic localDiagnostic;
+		Modeler::ShapeConstPtr localResult = CalculateExactBooleanShape (localShape, localDiagnostic, progress);
+		if (localDiagnostic.status == CGALOperations::BooleanDiagnostic::Status::Cancelled || Modeler::IsOperationCancelled (progress)) {
+			diagnostic = CGALOperations::BooleanDiagnostic (CGALOperations::BooleanDiagnostic::Status::Cancelled, 0, Modeler::MeshValidation ());
+			return nullptr;
+		}
+		if (localResult == nullptr && localDiagnostic.status == CGALOperations::BooleanDiagnostic::Status::Success) {
+			localDiagnostic = CGALOperations::BooleanDiagnostic (CGALOperations::BooleanDiagnostic::Status::CalculationFailed, 0, Modeler::MeshValidation ());
+		}
+		exactResult->calculated = true;
+		exactResult->shape = localResult;
+		exactResult->diagnostic = localDiagnostic;
+	}
+
+	diagnostic = exactResult->diagnostic;
+	if (exactResult->shape == nullptr || transformation == glm::dmat4 (1.0)) {
+		return exactResult->shape;
+	}
+	return exactResult->shape->Transform (transformation);
+}
+
+Modeler::ShapeConstPtr CalculateExactBooleanShape (const Modeler::BooleanShape& shape, CGALOperations::BooleanDiagnostic& diagnostic, Modeler::OperationProgress* progress)
+{
+	std::vector<Modeler::ShapeConstPtr> rewrittenOperands = shape.GetRewrittenOperands ();
+	double progressStep = 1.0 / (double) (rewrittenOperands.size () + 1);
+	std::vector<Modeler::ShapeConstPtr> exactOperands;
+	for (size_t i = 0; i < rewrittenOperands.size (); i++) {
+		Modeler::OperationProgress operandProgress (progress, i * progressStep, (i + 1) * progressStep);
+		Modeler::ShapeConstPtr exactOperand = GetExactShape (rewrittenOperands[i], diagnostic, &operandProgress);
+		if (exactOperand == nullptr) {
+			return nullptr;
+		}
+		exactOperands.push_back (exactOperand);
+	}
+
+	Modeler::OperationProgress operationProgress (progress, rewrittenOperands.size () * progressStep, 1.0);
+	Modeler::ShapePtr exactShape = nullptr;
+	if (shape.GetOperation () == Modeler::BooleanShape::Operation::Difference) {
+		Modeler::ShapeConstPtr toolShape = exactOperands[1];
+		double differenceProgressStart = 0.0;
+		if (exactOperands.size () > 2) {
+			Modeler::OperationProgress unionProgress (&operationProgress, 0.0, 0.5);
+			std::vector<Modeler::ShapeConstPtr> tools (exactOperands.begin () + 1, exactOperands.end ());
+			toolShape = CGALOperations::ShapeUnion (tools, diagnostic, &unionProgress);
+			if (toolShape == nullptr) {
+				return nullptr;
+			}
+			differenceProgressStart = 0.5;
+		}
+		Modeler::OperationProgress differenceProgress (&operationProgress, differenceProgressStart, 1.0);
+		exactShape = CGALOperations::ShapeDifference (exactOperands[0], toolShape, diagnostic, &differenceProgress);
+	} else if (shape.GetOperation () == Modeler::BooleanShape::Operation::Intersection) {
+		exactShape = CGALOperations::ShapeIntersection (exactOperands[0], exactOperands[1], diagnostic, &operationProgress);
+	} else if (shape.GetOperation () == Modeler::BooleanShape::Operation::Union) {
+		exactShape = CGALOperations::ShapeUnion (exactOperands, diagnostic, &operationProgress);
+	}
+	return exactShape;
+}
@@ -0,0 +1,49 @@
+#ifndef EXACTBOOLEANSHAPE_HPP
+#define EXACTBOOLEANSHAPE_HPP
+
+#include "BooleanShape.hpp"
+#include "BooleanOperations.hpp"
+#include "OperationProgress.hpp"
+
+#include <vector>
+
+// Result of a boolean operation in exact mode. The operation is calculated
+// only when its result is needed, so an operation used only as an operand of
+// an other one is merged into the rewritten operand tree of that one, and the
+// tree is calculated once. The result is calculated without the transformation
+// of the shape, so it is kept for the transformed copies of the shape too.
+
+class ExactBooleanShape : public Modeler::BooleanShape
+{
+public:
+	ExactBooleanShape (const glm::dmat4& transformation, Operation operation, const std::vector<Modeler::ShapeConstPtr>& operands);
+	virtual ~ExactBooleanShape ();
+
+	virtual Modeler::ShapePtr	Clone () const override;
+	virtual std::wstring		ToString () const override;
+	virtual Modeler::Mesh		GenerateMesh () const override;
+
+	// A cancelled calculation is not kept, so it runs again when the result is
+	// needed next time. Failures are kept with their diagnostic.
+	Modeler::ShapeConstPtr		GenerateExactShape (CGALOperations::BooleanDiagnostic& diagnostic, Modeler::OperationProgress* progress) const;
+
+private:
+	class ExactResult
+	{
+	public:
+		ExactResult ();
+
+		bool								calculated;
+		Modeler::ShapeConstPtr				shape;
+		CGALOperations::BooleanDiagnostic	diagnostic;
+	};
+
+	std::shared_ptr<ExactResult>	exactResult;
+};
+
+// Calculates the exact result of a deferred boolean operation from its
+// rewritten operand tree, the deferred operands of the tree are calculated
+// recursively. The operands and the operation get equal parts of the progress.
+Modeler::ShapeConstPtr	CalculateExactBooleanShape (const Modeler::BooleanShape& shape, CGALOperations::BooleanDiagnostic& diagnostic, Modeler::OperationProgress* progress);
+
+#endif
@@ -13,7 +13,10 @@ const NE::NodeId& NodeIdUserData::GetNodeId () const
 ModelEvaluationData::ModelEvaluationData () :
 	model (),
 	addedMeshes (),
-	deletedMeshes ()
+	deletedMeshes (),
+	booleanMode (BooleanMode::Exact),
+	operationProgress (nullptr),
+	operationProgressMutex ()
 {
 }
 
@@ -34,12 +37,50 @@ Modeler::MeshId ModelEvaluationData::AddMesh (const Modeler::Mesh& mesh, const N
 	return meshId;
 }
 
+void ModelEvaluationData::SetMeshUserData (Modeler::MeshId meshId, const std::string& key, const Modeler::UserDataConstPtr& data)
+{
+	model.SetMeshUserData (meshId, key, data);
+}
+
 void ModelEvaluationData::RemoveMesh (Modeler::MeshId meshId)
 {
 	model.RemoveMesh (meshId);
 	deletedMeshes.insert (meshId);
 }
 
+BooleanMode ModelEvaluationData::GetBooleanMode () const
+{
+	return booleanMode;
+}
+
+void ModelEvaluationData::SetBooleanMode (BooleanMode newBooleanMode)
+{
+	booleanMode = newBooleanMode;
+}
+
+Modeler::OperationProgress* ModelEvaluationData::GetOperationProgress () const
+{
+	std::lock_guard<std::mutex> lock (operationProgressMutex);
+	return operationProgress.get ();
+}
+
+void ModelEvaluationData::SetOperationProgress (const Modeler::OperationProgressPtr& newOperationProgress)
+{
+	std::lock_guard<std::mutex> lock (operationProgressMutex);
+	if (operationProgress != nullptr && operationProgress != newOperationProgress) {
+		operationProgress->Cancel ();
+	}
+	operationProgress = newOperationProgress;
+}
+
+void ModelEvaluationData::CancelOperation ()
+{
+	std::lock_guard<std::mutex> lock (operationProgressMutex);
+	if (operationProgress != nullptr) {
+		operationProgress->Cancel ();
+	}
+}
+
 const std::unordered_set<Modeler::MeshId>& ModelEvaluationData::GetAddedMeshes () const
 {
 	return addedMeshes;
@@ -58,6 +99,7 @@ void ModelEvaluationData::ClearAddedDeletedMeshes ()
 
 void ModelEvaluationData::Clear ()
 {
+	CancelOperation ();
 	model.Clear ();
 	ClearAddedDeletedMeshes ();
 }
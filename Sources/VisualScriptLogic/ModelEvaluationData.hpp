@@ -4,6 +4,9 @@
 #include "NE_NodeId.hpp"
 #include "NE_EvaluationEnv.hpp"
 #include "Model.hpp"
+#include "OperationProgress.hpp"
+
+#include <mutex>
 
 class NodeIdUserData : public Modeler::UserData
 {
@@ -16,6 +19,12 @@ private:
 	NE::NodeId nodeId;
 };
 
+enum class BooleanMode
+{
+	Exact,
+	Preview
+};
+
 class ModelEvaluationData : public NE::EvaluationData
 {
 public:
@@ -24,8 +33,19 @@ public:
 
 	const Modeler::Model&						GetModel () const;
 	Modeler::MeshId								AddMesh (const Modeler::Mesh& mesh, const NE::NodeId& nodeId);
+	void										SetMeshUserData (Modeler::MeshId meshId, const std::string& key, const Modeler::UserDataConstPtr& data);
 	void										RemoveMesh (Modeler::MeshId meshId);
 
+	BooleanMode									GetBooleanMode () const;
+	void										SetBooleanMode (BooleanMode newBooleanMode);
+
+	// Long running operations of the nodes check this progress, so the
+	// evaluation can be cancelled from an other thread. It can be null.
+	// Setting a new progress or clearing the data cancels the previous one.
+	Modeler::OperationProgress*					GetOperationProgress () const;
+	void										SetOperationProgress (const Modeler::OperationProgressPtr& newOperationProgress);
+	void										CancelOperation ();
+
 	const std::unordered_set<Modeler::MeshId>&	GetAddedMeshes () const;
 	const std::unordered_set<Modeler::MeshId>&	GetDeletedMeshes () const;
 	void										ClearAddedDeletedMeshes ();
@@ -36,6 +56,9 @@ private:
 	Modeler::Model							model;
 	std::unordered_set<Modeler::MeshId>		addedMeshes;
 	std::unordered_set<Modeler::MeshId>		deletedMeshes;
+	BooleanMode								booleanMode;
+	Modeler::OperationProgressPtr			operationProgress;
+	mutable std::mutex						operationProgressMutex;
 };
 
 #endif
@@ -10,8 +10,10 @@
 #include "Basic3DTransformationNodes.hpp"
 #include "TransformationNodes.hpp"
 #include "BooleanNodes.hpp"
+#include "AnalysisNodes.hpp"
 #include "ExpressionNode.hpp"
 #include "PrismNode.hpp"
+#include "SubdivisionNode.hpp"
 
 static NUIE::NodeRegistry nodeRegistry;
 static bool initialized = false;
@@ -103,6 +105,9 @@ const NUIE::NodeRegistry& GetNodeRegistry ()
 		nodeRegistry.RegisterNode (L"Shape Nodes", L"Platonic",
 			[] (const NUIE::Point& position) { return NUIE::UINodePtr (new PlatonicNode (L"Platonic", position)); }
 		);
+		nodeRegistry.RegisterNode (L"Shape Nodes", L"Subdivision",
+			[] (const NUIE::Point& position) { return NUIE::UINodePtr (new SubdivisionNode (L"Subdivision", position)); }
+		);
 		nodeRegistry.RegisterNode (L"Matrix Nodes", L"Translation Matrix",
 			[] (const NUIE::Point& position) { return NUIE::UINodePtr (new TranslationMatrixNode (L"Translation Matrix", position)); }
 		);
@@ -142,6 +147,18 @@ const NUIE::NodeRegistry& GetNodeRegistry ()
 		nodeRegistry.RegisterNode (L"Boolean Nodes", L"Union",
 			[] (const NUIE::Point& position) { return NUIE::UINodePtr (new UnionNode (L"Union", position)); }
 		);
+		nodeRegistry.RegisterNode (L"Analysis Nodes", L"Interference",
+			[] (const NUIE::Point& position) { return NUIE::UINodePtr (new InterferenceNode (L"Interference", position)); }
+		);
+		nodeRegistry.RegisterNode (L"Analysis Nodes", L"Mass Properties",
+			[] (const NUIE::Point& position) { return NUIE::UINodePtr (new MassPropertiesNode (L"Mass Properties", position)); }
+		);
+		nodeRegistry.RegisterNode (L"Analysis Nodes", L"Point Distance",
+			[] (const NUIE::Point& position) { return NUIE::UINodePtr (new PointDistanceNode (L"Point Distance", position)); }
+		);
+		nodeRegistry.RegisterNode (L"Analysis Nodes", L"Closest Point",
+			[] (const NUIE::Point& position) { return NUIE::UINodePtr (new ClosestPointNode (L"Closest Point", position)); }
+		);
 		nodeRegistry.RegisterNode (L"Other Nodes", L"Viewer",
 			[] (const NUIE::Point& position) { return NUIE::UINodePtr (new BI::MultiLineViewerNode (L"Viewer", position, 5)); }
 		);
@@ -0,0 +1,124 @@
+#include "PreviewBooleanShape.hpp"
+#include "BasicShapes.hpp"
+#include "BSPBooleanOperations.hpp"
+#include "BooleanOperations.hpp"
+#include "ExactBooleanShape.hpp"
+
+PreviewBooleanShape::PreviewBooleanShape (const glm::dmat4& transformation, Operation operation, const std::vector<Modeler::ShapeConstPtr>& operands, const Modeler::Mesh& previewMesh) :
+	Modeler::BooleanShape (transformation, operation, operands),
+	previewMesh (previewMesh)
+{
+}
+
+PreviewBooleanShape::~PreviewBooleanShape ()
+{
+}
+
+Modeler::ShapePtr PreviewBooleanShape::Clone () const
+{
+	return Modeler::ShapePtr (new PreviewBooleanShape (*this));
+}
+
+std::wstring PreviewBooleanShape::ToString () const
+{
+	return L"Boolean Preview";
+}
+
+Modeler::Mesh PreviewBooleanShape::GenerateMesh () const
+{
+	Modeler::Mesh result = previewMesh;
+	result.AddTransformation (transformation);
+	return result;
+}
+
+Modeler::ShapeConstPtr PreviewBooleanShape::GenerateExactShape (Modeler::OperationProgress* progress) const
+{
+	CGALOperations::BooleanDiagnostic diagnostic;
+	return CalculateExactBooleanShape (*this, diagnostic, progress);
+}
+
+bool PreviewBooleanShape::GenerateExactMesh (Modeler::Mesh& exactMesh, Modeler::OperationProgress* progress) const
+{
+	Modeler::ShapeConstPtr exactShape = GenerateExactShape (progress);
+	if (exactShape == nullptr) {
+		return false;
+	}
+	try {
+		exactMesh = exactShape->GenerateMesh ();
+	} catch (const std::exception&) {
+		return false;
+	}
+	return true;
+}
+
+ExactMeshUserData::ExactMeshUserData (const std::shared_ptr<const PreviewBooleanShape>& shape) :
+	shape (shape)
+{
+}
+
+bool ExactMeshUserData::GenerateExactMesh (Modeler::Mesh& exactMesh, Modeler::OperationProgress* progress) const
+{
+	return shape->GenerateExactMesh (exactMesh, progress);
+}
+
+Modeler::ShapePtr PreviewShapeDifference (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape)
+{
+	Modeler::Mesh previewMesh;
+	if (!BSPOperations::MeshDifference (aShape->GenerateMesh (), bShape->GenerateMesh (), previewMesh)) {
+		return nullptr;
+	}
+	return Modeler::ShapePtr (new PreviewBooleanShape (glm::dmat4 (1.0), PreviewBooleanShape::Operation::Difference, { aShape, bShape }, previewMesh));
+}
+
+Modeler::ShapePtr PreviewShapeIntersection (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape)
+{
+	Modeler::Mesh previewMesh;
+	if (!BSPOperations::MeshIntersection (aShape->GenerateMesh (), bShape->GenerateMesh (), previewMesh)) {
+		return nullptr;
+	}
+	return Modeler::ShapePtr (new PreviewBooleanShape (glm::dmat4 (1.0), PreviewBooleanShape::Operation::Intersection, { aShape, bShape }, previewMesh));
+}
+
+Modeler::ShapePtr PreviewShapeUnion (const std::vector<Modeler::ShapeConstPtr>& shapes)
+{
+	std::vector<Modeler::Mesh> meshes;
+	for (const Modeler::ShapeConstPtr& shape : shapes) {
+		meshes.push_back (shape->GenerateMesh ());
+	}
+	Modeler::Mesh previewMesh;
+	if (!BSPOperations::MeshUnion (meshes, previewMesh)) {
+		return nullptr;
+	}
+	return Modeler::ShapePtr (new PreviewBooleanShape (glm::dmat4 (1.0), PreviewBooleanShape::Operation::Union, shapes, previewMesh));
+}
+
+bool CreateExactModel (const Modeler::ModelView& model, Modeler::Model& exactModel, Modeler::OperationProgress* progress)
+{
+	size_t exactMeshCount = 0;
+	model.EnumerateMeshes ([&] (Modeler::MeshId, const Modeler::MeshRef& meshRef) {
+		if (meshRef.GetUserData ("exactmesh") != nullptr) {
+			exactMeshCount++;
+		}
+	});
+
+	bool success = true;
+	size_t exactMeshIndex = 0;
+	exactModel.Clear ();
+	model.EnumerateMeshes ([&] (Modeler::MeshId, const Modeler::MeshRef& meshRef) {
+		std::shared_ptr<const ExactMeshUserData> exactMeshData = std::dynamic_pointer_cast<const ExactMeshUserData> (meshRef.GetUserData ("exactmesh"));
+		if (exactMeshData != nullptr && !Modeler::IsOperationCancelled (progress)) {
+			Modeler::OperationProgress meshProgress (progress, (double) exactMeshIndex / (double) exactMeshCount, (double) (exactMeshIndex + 1) / (double) exactMeshCount);
+			exactMeshIndex++;
+			Modeler::Mesh exactMesh;
+			if (exactMeshData->GenerateExactMesh (exactMesh, &meshProgress)) {
+				exactModel.AddMesh (exactMesh);
+				return;
+			}
+			success = false;
+		}
+		// the data of the other meshes is shared with the original model
+		Modeler::Mesh mesh (model.GetMeshGeometryPtr (meshRef), model.GetMeshMaterialsPtr (meshRef), meshRef.GetTransformation ());
+		exactModel.AddMesh (mesh);
+	});
+	return success && !Modeler::IsOperationCancelled (progress);
+}
@@ -0,0 +1,50 @@
+#ifndef PREVIEWBOOLEANSHAPE_HPP
+#define PREVIEWBOOLEANSHAPE_HPP
+
+#include "BooleanShape.hpp"
+#include "Model.hpp"
+#include "UserData.hpp"
+#include "OperationProgress.hpp"
+
+#include <vector>
+
+// Result of a boolean operation calculated by the fast BSP engine. It keeps
+// its operands, so the exact result can be calculated later on demand from
+// the rewritten operand tree.
+
+class PreviewBooleanShape : public Modeler::BooleanShape
+{
+public:
+	PreviewBooleanShape (const glm::dmat4& transformation, Operation operation, const std::vector<Modeler::ShapeConstPtr>& operands, const Modeler::Mesh& previewMesh);
+	virtual ~PreviewBooleanShape ();
+
+	virtual Modeler::ShapePtr	Clone () const override;
+	virtual std::wstring		ToString () const override;
+	virtual Modeler::Mesh		GenerateMesh () const override;
+
+	Modeler::ShapeConstPtr		GenerateExactShape (Modeler::OperationProgress* progress) const;
+	bool						GenerateExactMesh (Modeler::Mesh& exactMesh, Modeler::OperationProgress* progress) const;
+
+private:
+	Modeler::Mesh	previewMesh;
+};
+
+class ExactMeshUserData : public Modeler::UserData
+{
+public:
+	ExactMeshUserData (const std::shared_ptr<const PreviewBooleanShape>& shape);
+
+	bool GenerateExactMesh (Modeler::Mesh& exactMesh, Modeler::OperationProgress* progress) const;
+
+private:
+	std::shared_ptr<const PreviewBooleanShape> shape;
+};
+
+Modeler::ShapePtr	PreviewShapeDifference (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape);
+Modeler::ShapePtr	PreviewShapeIntersection (const Modeler::ShapeConstPtr& aShape, const Modeler::ShapeConstPtr& bShape);
+Modeler::ShapePtr	PreviewShapeUnion (const std::vector<Modeler::ShapeConstPtr>& shapes);
+
+// The progress can be null, a cancelled calculation returns false.
+bool				CreateExactModel (const Modeler::ModelView& model, Modeler::Model& exactModel, Modeler::OperationProgress* progress);
+
+#endif
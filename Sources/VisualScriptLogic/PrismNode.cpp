@@ -5,6 +5,7 @@
 #include "Basic3DNodeValues.hpp"
 #include "MaterialNode.hpp"
 #include "Triangulation.hpp"
+#include "EarClippingTriangulator.hpp"
 #include "BasicShapes.hpp"
 #include "VisualScriptLogicMain.hpp"
 
@@ -104,7 +105,8 @@ NE::ValueConstPtr PrismNode::Calculate (NE::EvaluationEnv& env) const
 		return nullptr;
 	}
 
-	Modeler::TriangulatorPtr triangulator (new CGALTriangulator ());
+	// the constrained triangulation is used only for polygons the ear clipping can't handle
+	Modeler::TriangulatorPtr triangulator (new Modeler::EarClippingTriangulator (Modeler::TriangulatorPtr (new CGALTriangulator ())));
 	std::vector<glm::dvec2> basePoints;
 	NE::FlatEnumerate (basePointsValue, [&] (const NE::ValueConstPtr& value) {
 		basePoints.push_back (Point2DValue::Get (value));
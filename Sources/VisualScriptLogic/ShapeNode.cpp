@@ -3,6 +3,7 @@
 #include "MaterialNode.hpp"
 #include "TransformationNodes.hpp"
 #include "ModelEvaluationData.hpp"
+#include "PreviewBooleanShape.hpp"
 
 NE::DynamicSerializationInfo	ShapeValue::serializationInfo (NE::ObjectId ("{3C6EA711-831F-4A16-AC74-6A43A1AB7ACD}"), NE::ObjectVersion (1), ShapeValue::CreateSerializableInstance);
 NE::SerializationInfo			ShapeNode::serializationInfo (NE::ObjectVersion (1));
@@ -72,8 +73,7 @@ void ShapeNode::RegisterParameters (NUIE::NodeParameterList& parameterList) cons
 
 void ShapeNode::ProcessCalculatedValue (const NE::ValueConstPtr& value, NE::EvaluationEnv& env) const
 {
-	std::shared_ptr<BI::EnableDisableFeature> enableDisable = GetEnableDisableFeature (this);
-	if (enableDisable->GetState () == BI::EnableDisableFeature::State::Enabled) {
+	if (IsEnabled ()) {
 		OnCalculated (value, env);
 	}
 }
@@ -98,8 +98,7 @@ void ShapeNode::OnDisabled (NE::EvaluationEnv& env) const
 void ShapeNode::OnFeatureChange (const NUIE::FeatureId& featureId, NE::EvaluationEnv& env) const
 {
 	if (featureId == BI::EnableDisableFeatureId) {
-		std::shared_ptr<BI::EnableDisableFeature> enableDisable = GetEnableDisableFeature (this);
-		if (enableDisable->GetState () == BI::EnableDisableFeature::State::Enabled) {
+		if (IsEnabled ()) {
 			OnEnabled (env);
 		} else {
 			OnDisabled (env);
@@ -128,7 +127,19 @@ void ShapeNode::AddItem (NE::EvaluationEnv& env) const
 		const ShapeValue* shapeValue = NE::Value::Cast<ShapeValue> (innerValue.get ());
 		if (shapeValue != nullptr && shapeValue->GetValue () != nullptr) {
 			Modeler::ShapePtr shape = shapeValue->GetValue ();
-			Modeler::MeshId meshId = evalData->AddMesh (shape->GenerateMesh (), GetId ());
+			// exact results of nodes enabled later are calculated here, a
+			// failed calculation has no mesh
+			Modeler::Mesh mesh;
+			try {
+				mesh = shape->GenerateMesh ();
+			} catch (const std::exception&) {
+				return;
+			}
+			Modeler::MeshId meshId = evalData->AddMesh (mesh, GetId ());
+			std::shared_ptr<const PreviewBooleanShape> previewShape = std::dynamic_pointer_cast<const PreviewBooleanShape> (shape);
+			if (previewShape != nullptr) {
+				evalData->SetMeshUserData (meshId, "exactmesh", Modeler::UserDataConstPtr (new ExactMeshUserData (previewShape)));
+			}
 			meshes.insert (meshId);
 		}
 	});
@@ -162,6 +173,12 @@ NE::Stream::Status ShapeNode::Write (NE::OutputStream& outputStream) const
 	return outputStream.GetStatus ();
 }
 
+bool ShapeNode::IsEnabled () const
+{
+	std::shared_ptr<BI::EnableDisableFeature> enableDisable = GetEnableDisableFeature (this);
+	return enableDisable->GetState () == BI::EnableDisableFeature::State::Enabled;
+}
+
 void ShapeNode::DrawInplace (NUIE::NodeUIDrawingEnvironment& env) const
 {
 	std::shared_ptr<BI::EnableDisableFeature> enableDisable = GetEnableDisableFeature (this);
@@ -42,6 +42,7 @@ public:
 	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
 
 protected:
+	bool						IsEnabled () const;
 	virtual void				DrawInplace (NUIE::NodeUIDrawingEnvironment& env) const override;
 
 private:
@@ -0,0 +1,101 @@
+#include "SubdivisionNode.hpp"
+#include "NE_SingleValues.hpp"
+#include "BI_BuiltInFeatures.hpp"
+#include "NUIE_NodeCommonParameters.hpp"
+#include "Basic3DNodeValues.hpp"
+#include "ModelEvaluationData.hpp"
+#include "BasicShapes.hpp"
+#include "LoopSubdivision.hpp"
+
+#include "IncludeGLM.hpp"
+
+NE::DynamicSerializationInfo	SubdivisionNode::serializationInfo (NE::ObjectId ("{4E7B2C1D-8A3F-4D6B-B1E9-5C2A7F3D9E04}"), NE::ObjectVersion (1), SubdivisionNode::CreateSerializableInstance);
+
+// every step quadruples the triangle count, so the steps are limited to keep
+// the result in memory
+static const int MaxSubdivisionSteps = 6;
+
+static Modeler::OperationProgress* GetOperationProgress (NE::EvaluationEnv& env)
+{
+	if (!env.IsDataType<ModelEvaluationData> ()) {
+		return nullptr;
+	}
+	std::shared_ptr<ModelEvaluationData> evalData = env.GetData<ModelEvaluationData> ();
+	return evalData->GetOperationProgress ();
+}
+
+SubdivisionNode::SubdivisionNode () :
+	SubdivisionNode (L"", NUIE::Point ())
+{
+
+}
+
+SubdivisionNode::SubdivisionNode (const std::wstring& name, const NUIE::Point& position) :
+	ShapeNode (name, position)
+{
+
+}
+
+void SubdivisionNode::Initialize ()
+{
+	ShapeNode::Initialize ();
+	RegisterFeature (NUIE::NodeFeaturePtr (new BI::ValueCombinationFeature ()));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("shape"), L"Shape", nullptr, NE::OutputSlotConnectionMode::Single)));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("steps"), L"Steps", NE::ValuePtr (new NE::IntValue (1)), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("creaseangle"), L"Crease Angle", NE::ValuePtr (new NE::FloatValue (180.0)), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (NE::SlotId ("shape"), L"Shape")));
+}
+
+void SubdivisionNode::RegisterParameters (NUIE::NodeParameterList& parameterList) const
+{
+	ShapeNode::RegisterParameters (parameterList);
+	NUIE::RegisterSlotDefaultValueNodeParameter<SubdivisionNode, NE::IntValue> (parameterList, L"Steps", NUIE::ParameterType::Integer, NE::SlotId ("steps"));
+	NUIE::RegisterSlotDefaultValueNodeParameter<SubdivisionNode, NE::FloatValue> (parameterList, L"Crease Angle", NUIE::ParameterType::Float, NE::SlotId ("creaseangle"));
+}
+
+NE::ValueConstPtr SubdivisionNode::Calculate (NE::EvaluationEnv& env) const
+{
+	NE::ValueConstPtr shapeValue = EvaluateInputSlot (NE::SlotId ("shape"), env);
+	NE::ValueConstPtr stepsValue = EvaluateInputSlot (NE::SlotId ("steps"), env);
+	NE::ValueConstPtr creaseAngleValue = EvaluateInputSlot (NE::SlotId ("creaseangle"), env);
+	if (!NE::IsComplexType<ShapeValue> (shapeValue) || !NE::IsComplexType<NE::NumberValue> (stepsValue) || !NE::IsComplexType<NE::NumberValue> (creaseAngleValue)) {
+		return nullptr;
+	}
+
+	Modeler::OperationProgress* progress = GetOperationProgress (env);
+	NE::ListValuePtr result (new NE::ListValue ());
+	bool isValid = BI::CombineValues (this, {shapeValue, stepsValue, creaseAngleValue}, [&] (const NE::ValueCombination& combination) {
+		int steps = NE::NumberValue::ToInteger (combination.GetValue (1));
+		if (steps < 0 || steps > MaxSubdivisionSteps) {
+			return false;
+		}
+		Modeler::ShapePtr shape (ShapeValue::Get (combination.GetValue (0)));
+		double creaseAngle = glm::radians (NE::NumberValue::ToDouble (combination.GetValue (2)));
+		Modeler::Mesh resultMesh;
+		if (!Modeler::SubdivideMesh (shape->GenerateMesh (), (unsigned int) steps, creaseAngle, 0, resultMesh, progress)) {
+			return false;
+		}
+		Modeler::ShapePtr subdivided (new Modeler::MeshShape (glm::dmat4 (1.0), resultMesh));
+		result->Push (NE::ValuePtr (new ShapeValue (subdivided)));
+		return true;
+	});
+
+	if (!isValid) {
+		return nullptr;
+	}
+	return result;
+}
+
+NE::Stream::Status SubdivisionNode::Read (NE::InputStream& inputStream)
+{
+	NE::ObjectHeader header (inputStream);
+	ShapeNode::Read (inputStream);
+	return inputStream.GetStatus ();
+}
+
+NE::Stream::Status SubdivisionNode::Write (NE::OutputStream& outputStream) const
+{
+	NE::ObjectHeader header (outputStream, serializationInfo);
+	ShapeNode::Write (outputStream);
+	return outputStream.GetStatus ();
+}
@@ -25,6 +25,13 @@ def IsEqualBox (current, reference):
 		return False
 	return True
 	
+def GetSurfaceArea (cliPath, examplePath):
+	output = subprocess.check_output ([cliPath, 'mass_properties', examplePath])
+	for line in output.decode ('utf-16').splitlines ():
+		if line.startswith ('Surface area: '):
+			return float (line[len ('Surface area: '):])
+	return None
+
 def Main (argv):
 	if len (argv) != 2:
 		print ('usage: compatiblitytest.py <msBuildConfiguration>')
@@ -102,8 +109,8 @@ def Main (argv):
 		if not IsEqualBox (boundingBox, example['boundingBox']):
 			Error ('Bounding box checking failed: ' + str (boundingBox))
 			return 1
-		surface = model.GetSurface ()
-		if not IsEqual (surface, example['surface']):
+		surface = GetSurfaceArea (cliPath, examplePath)
+		if surface == None or not IsEqual (surface, example['surface']):
 			Error ('Surface checking failed: ' + str (surface))
 			return 1
 